@@ -86,5 +86,13 @@ namespace Exception {
       const char* what() const throw() { return s.c_str(); }
    };
 
+   struct FileFormatException : public std::exception
+   {
+      std::string s;
+      FileFormatException(std::string file, std::string reason) : s("The file " + file + " can not be read: " + reason) {}
+      ~FileFormatException() throw () {}
+      const char* what() const throw() { return s.c_str(); }
+   };
+
 } // Exception
 } // Ilvo
@@ -60,6 +60,12 @@ namespace Exception {
         const char* what() const throw() { return s.c_str(); }
     };
 
+    /** @brief Error reply of the server (e.g. WRONGTYPE), the reply was read entirely */
+    struct RedisErrorReplyException : public RedisCommandExectionException
+    {
+        RedisErrorReplyException(std::string error) : RedisCommandExectionException(error) {}
+    };
+
     struct RedisVariableBadDefaultValueCastExceptions : public std::exception
     {
         std::string s;
@@ -38,6 +38,8 @@ namespace Core {
         std::unique_ptr<Utils::Peripheral::Peripheral> peripheral;
         /** @brief Variable keeps track if GPS is found */
         bool gpsfound;
+        /** @brief Receive time of the last traced fix, a trace is only started for a new fix */
+        std::chrono::steady_clock::time_point tracedFix;
 
         /** @brief Translation matrix */
         Eigen::Vector3d rawR;
@@ -49,6 +51,9 @@ namespace Core {
         Eigen::Vector3d rawTCov;
     public:
         GpsDevice(const std::string ns);
+        GpsDevice(const std::string ns, std::shared_ptr<Utils::Redis::LocalStore> store);
+        /** @brief GPS device on a given peripheral instead of the one of the platform settings, e.g. a replay */
+        GpsDevice(const std::string ns, std::shared_ptr<Utils::Redis::LocalStore> store, std::unique_ptr<Utils::Peripheral::Peripheral> peripheral);
         ~GpsDevice() = default;
  
         void init() override;
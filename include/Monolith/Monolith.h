@@ -0,0 +1,84 @@
+/**
+ * @file Monolith.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Single process running the core loops as threads
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <Utils/Redis/VariableManager.h>
+#include <Utils/Redis/LocalStore.h>
+#include <Utils/Redis/RedisMirror.h>
+#include <ThirdParty/json.hpp>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+namespace Ilvo {
+namespace Core {
+
+    /** @brief Core loop of the monolith, an item of 'loops' of the 'monolith' section in config.json */
+    struct MonolithLoop
+    {
+        /** @brief Process name of the core loop, e.g. ilvo-navigation */
+        std::string name;
+        /** @brief Period of the loop, the period of the process if zero */
+        std::chrono::milliseconds period = std::chrono::milliseconds(0);
+        /** @brief CPU the thread is pinned to, no affinity if negative */
+        int cpu = -1;
+
+        static MonolithLoop fromJson(const nlohmann::json& j);
+    };
+
+    /**
+     * @brief Host of the core loops in one process
+     *
+     * @details The core loops (robot plc, gps, navigation, operation, simulation) are separate processes that exchange
+     * their variables through Redis. On small field computers the monolith runs them as threads of one process instead.
+     * The loops share a LocalStore, a variable written in a tick is read by the next tick of the other loops without 
+     * serialisation or a round trip to the server. A RedisMirror copies the store to the Redis server in the background
+     * for the other clients (system manager, user interface, ...) and their writes back into the store.
+     * 
+     * Each loop runs its variable manager in its own thread, with its own platform state and log file, at the rate and 
+     * on the CPU of the 'monolith' section of config.json:
+     *      "monolith": {"mirror_period": 20, "loops": [{"name": "ilvo-navigation", "period": 20, "cpu": 2}, ...]}
+     * Without the section all core loops run at the rate of their process. The separate processes remain available,
+     * the system manager starts ilvo-monolith instead of the processes in its 'Hosts' list when its 'AutoStart' is set in
+     * redis.init.json. The loops of config.json have to match the 'Hosts' list.
+     */
+    class Monolith
+    {
+    private:
+        nlohmann::json jConfig;
+        std::vector<MonolithLoop> loops;
+        std::chrono::milliseconds mirrorPeriod;
+
+        std::shared_ptr<Utils::Redis::LocalStore> store;
+        std::unique_ptr<Utils::Redis::RedisMirror> mirror;
+        std::vector<std::thread> threads;
+        /** @brief Number of loops stopped by an exception */
+        std::atomic<int> failures;
+
+        void runLoop(const MonolithLoop& loop);
+    public:
+        /** @brief Monolith of the configuration of $ILVO_PATH */
+        Monolith();
+        ~Monolith() = default;
+
+        /** @brief Variable manager of a core loop by its process name, null if the name is unknown */
+        static std::unique_ptr<Utils::Redis::VariableManager> createManager(const std::string& name, std::shared_ptr<Utils::Redis::LocalStore> store);
+
+        /** @brief Run the loops until SIGINT or until a loop fails, returns the exit code of the process */
+        int run();
+    };
+
+} // Core
+} // Ilvo
@@ -17,6 +17,8 @@
 #include <Navigation/NavigationControl.h>
 #include <Utils/Timing/Logic.h>
 #include <Utils/Redis/VariableManager.h>
+#include <Utils/Redis/TrajectPublisher.h>
+#include <Utils/Logging/TelemetryStream.h>
 
 namespace Ilvo {
 namespace Core {
@@ -31,8 +33,10 @@ namespace Core {
     {
     private:       
         // edge detectors
-        /** @brief Edge detector for field updates */
+        /** @brief Edge detector for field updates, fed by the change events of 'pc.field.updated' */
         Utils::Timing::EdgeDetector edgeDetectorField;
+        /** @brief A rising edge of the field update was received since the previous tick */
+        bool fieldUpdated;
         /** @brief Edge detector for automatic mode */
         Utils::Timing::EdgeDetector edgeDetectorAutomode;
         /** @brief Edge detector for algorithm mode */
@@ -47,6 +51,8 @@ namespace Core {
         std::shared_ptr<Utils::Settings::Traject> traject;
         /** @brief Position of the robot in respect to the traject */
         std::shared_ptr<Utils::Settings::PositionData> position;
+        /** @brief Writes the encoded traject to redis ('traject') outside the control loop */
+        std::unique_ptr<Utils::Redis::TrajectPublisher> trajectPublisher;
 
         void resetPosition();
         void updatePosition();
@@ -59,8 +65,16 @@ namespace Core {
         bool autoModeReset;
         /** @brief Automatic mode error (will be processed in the next cycle) */
         bool autoModeError;
+
+        /** @brief Binary telemetry of the control loop signals */
+        std::unique_ptr<Utils::Logging::TelemetryStream> telemetry;
+        /** @brief Record the control loop signals of this tick */
+        void recordTelemetry(bool activeAuto);
+        /** @brief Trace context of the fix of the control variables ('pc.navigation.trace'), null if not configured */
+        Utils::Redis::VariablePtr traceVariable;
     public:
         Navigation(const std::string ns);
+        Navigation(const std::string ns, std::shared_ptr<Utils::Redis::LocalStore> store);
         ~Navigation() = default;
 
         void init() override;
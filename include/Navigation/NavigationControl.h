@@ -20,6 +20,7 @@
 #include <Utils/Geometry/Transform.h>
 #include <Utils/Settings/Platform.h>
 #include <Utils/Pid/PidController.h>
+#include <Utils/Pid/MpcController.h>
 #include <Utils/Timing/Logic.h>
 
 namespace Ilvo {
@@ -52,6 +53,15 @@ namespace Core {
         /** @brief Pid controller for pure pursuit) */
         Utils::Pid::PidController purepursuitController;
 
+        /** @brief Line following algorithm, MPC if 'pc.mpc.enable' is set */
+        Utils::Settings::LineFollowingMode lineFollowingMode = Utils::Settings::PUREPURSUIT;
+        /** @brief Model predictive path tracker, created for the horizon of 'pc.mpc.horizon' */
+        std::unique_ptr<Utils::Pid::MpcController> mpc;
+        /** @brief Curvature of the path per step of the MPC horizon */
+        std::vector<double> mpcCurvature;
+        /** @brief The last MPC solve exceeded its budget and pure pursuit steers */
+        bool mpcFallback = false;
+
         /** @brief Velocity operation data used during creep operation */
         Utils::Settings::VelocityVector creepVelocity;
         /** @brief Stops the robot's linear operation */
@@ -95,6 +105,14 @@ namespace Core {
 
         /** @brief The robot drives using the pure pursuit algorithm */
         void purePursuit();
+        /**
+         * @brief Angular velocity of the model predictive path tracker
+         *
+         * @param velocity longitudinal velocity of the robot
+         * @param angularVelocity angular velocity of the MPC
+         * @return true if the MPC line following mode is active and the MPC solved within its budget
+         */
+        bool modelPredictive(double velocity, double& angularVelocity);
         /** @brief The robot drives straight line (no algorithm) */
         bool straightLine(double deaccerationDistance=0.5);
         /** @brief The robot spins (rotates in place) */
@@ -19,7 +19,9 @@
 #include <Utils/Settings/Platform.h>
 #include <Utils/Redis/VariableManager.h>
 #include <Utils/Settings/Field.h>
+#include <Utils/Geometry/CoverageMap.h>
 #include <map>
+#include <memory>
 
 namespace Ilvo {
 namespace Core {
@@ -58,6 +60,13 @@ namespace Core {
         Utils::Timing::EdgeDetector slowDownEdge;
         /** @brief Instructions from the controller to disable the implement ImplementControl, the robot is e.g. in spinning mode */
         bool disableImplement;
+
+        /** @brief As-applied coverage of the continuous tasks of the field, by task name */
+        std::map<std::string, std::unique_ptr<Utils::Geometry::CoverageMap>> coverageMaps;
+        /** @brief Field of the coverage maps */
+        std::string coverageField;
+        /** @brief Edge detector of the coverage reset command */
+        Utils::Timing::EdgeDetector coverageResetEdge;
     public:
         ImplementControl();
         ~ImplementControl() = default;
@@ -68,7 +77,16 @@ namespace Core {
         void init(Utils::Redis::VariableManager* manager, std::shared_ptr<Utils::Settings::Traject> traject, std::shared_ptr<Utils::Settings::PositionData> position);
         /** update the ImplementControl */
         void update(bool autoMode);
+        /** @brief Coverage maps of the continuous tasks that worked since the field was loaded, by task name */
+        const std::map<std::string, std::unique_ptr<Utils::Geometry::CoverageMap>>& getCoverageMaps() const;
     private:
+        /**
+         * @brief Coverage map of the task, nullptr if the coverage is disabled
+         *
+         * @details The tiles are kept in $ILVO_PATH/coverage/<field>/<task>, so the coverage of the field continues
+         * after a restart. A simulation on virtual time keeps them in memory.
+         */
+        Utils::Geometry::CoverageMap* coverage(Utils::Settings::Task& task);
         /** @brief Update hitch ImplementControl */
         void updateHitch(Utils::Settings::Task& task);
         /** @brief Update continuous ImplementControl */
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <memory>
+#include <chrono>
 
 #include <Utils/Timing/Clk.h>
 #include <Operation/ImplementControl.h>
@@ -21,6 +22,9 @@
 namespace Ilvo {
 namespace Core {
 
+    /** @brief Maximal number of coverage tiles (64 KiB each) written per export, a backlog is spread over the exports */
+    const size_t COVERAGE_TILES_PER_EXPORT = 16;
+
     /**
      * @brief Operation variable manager.
      * 
@@ -30,8 +34,10 @@ namespace Core {
     {
     private:       
         // edge detectors
-        /** @brief Edge detector for field updates */
+        /** @brief Edge detector for field updates, fed by the change events of 'pc.field.updated' */
         Utils::Timing::EdgeDetector edgeDetectorField;
+        /** @brief A rising edge of the field update was received since the previous tick */
+        bool fieldUpdated;
         /** @brief Edge detector for automatic mode */
         Utils::Timing::EdgeDetector edgeDetectorAutomode;
 
@@ -41,14 +47,38 @@ namespace Core {
         /** @brief Position of the robot in respect to the traject */
         std::shared_ptr<Utils::Settings::PositionData> position;
 
-        /** @brief Set the Redis Json implement states */
+        // implement visualization
+        /** @brief The implements changed (traject load), the implement states are written regardless of the sections */
+        bool implStatesOutdated;
+        /** @brief Time of the last write of the implement states */
+        std::chrono::steady_clock::time_point implStatesTime;
+        /**
+         * @brief Set the Redis Json implement states
+         * 
+         * @details Only written when a section moved or changed its activation, at most 'pc.implement.ui_frequency'
+         * times per second (0 is every tick). The sections that did not change keep their visualization.
+         */
         void setRedisJsonImplStates();
+        /** @brief Time of the last write of the coverage */
+        std::chrono::steady_clock::time_point coverageTime;
+        /** @brief Tiles of every coverage map in Redis, by task name */
+        nlohmann::json jCoverage;
+        /**
+         * @brief Write the coverage tiles that changed to Redis, at most 'pc.coverage.ui_frequency' times per second
+         * 
+         * @details The tile '<tx>_<ty>' of a task is the json 'coverage.<task>.<tx>_<ty>' (see CoverageMap::exportTile),
+         * the json 'coverage' lists the tiles per task: {"<task>": {"resolution": 0.1, "tiles": ["0_0", ...]}}.
+         * An export writes at most COVERAGE_TILES_PER_EXPORT tiles, the others (e.g. the tiles of the directory after
+         * a restart) follow in the next exports and are only listed once written.
+         */
+        void setRedisCoverage();
 
         // Controllers
         /** @brief Implement controller */
         ImplementControl implementControl;
     public:
         Operation(const std::string ns);
+        Operation(const std::string ns, std::shared_ptr<Utils::Redis::LocalStore> store);
         ~Operation() = default;
 
         void init() override;
@@ -15,6 +15,7 @@
 #include <Utils/Redis/VariableManager.h>
 #include <Utils/Timing/Logic.h>
 #include <Utils/Settings/Field.h>
+#include <Simulation/VehiclePlant.h>
 
 namespace Ilvo {
 namespace Core {
@@ -32,7 +33,7 @@ namespace Core {
         /** 
          * @brief Edge detector for field updates
          * 
-         * @details If a pulse of the field update variable is detected the new field is loaded
+         * @details If a pulse of the field update variable is detected the new field is loaded, fed by its change events
          */
         Utils::Timing::EdgeDetector edgeDetectorField;
         std::shared_ptr<Utils::Settings::Field> field;
@@ -49,9 +50,20 @@ namespace Core {
          * @details If a pulse of the notification acknowledge Redis variable is detected, the discrete operation is set as finished.
         */
         Utils::Timing::EdgeDetector notificationAcknowledgeEdge;
+
+        /** @brief Actuator, ground and GNSS models between the velocity commands and the simulated state */
+        VehiclePlant plant;
+        /** 
+         * @brief True robot reference state when the GNSS model is active 
+         * 
+         * @details The published states are the measured states, the kinematics integrate the true state.
+         */
+        Eigen::Affine3d trueRobotRef;
+        bool trueRobotRefValid;
         
     public:
         Simulation(const std::string ns);
+        Simulation(const std::string ns, std::shared_ptr<Utils::Redis::LocalStore> store);
         ~Simulation() = default;
 
         void init() override;
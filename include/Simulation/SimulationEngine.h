@@ -0,0 +1,97 @@
+/**
+ * @file SimulationEngine.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Headless faster than real time simulation
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <ThirdParty/json.hpp>
+
+namespace Ilvo {
+namespace Core {
+
+    /** @brief Period of one simulation tick, equal to the period of the variable managers */
+    const std::chrono::milliseconds SIMULATION_TICK = std::chrono::milliseconds(20);
+    /** @brief Notification of the navigation when the end of the traject is reached */
+    const std::string SIMULATION_END_OF_TRAJECT = "End of Traject is reached!";
+
+    /**
+     * @brief Scenario of a headless simulation
+     *
+     * @details A scenario is one robot (settings of `ilvo_path`) on one field with a set of variables,
+     * e.g. the pure pursuit and lateral PID gains to tune.
+     */
+    struct SimulationScenario
+    {
+        std::string name;
+        /** @brief Field name, the pc.field.name of redis.init.json if empty */
+        std::string field;
+        /** @brief Navigation mode (AlgorithmMode), the pc.navigation.mode of redis.init.json if negative */
+        int navigationMode = -1;
+        /** @brief Maximal simulated time [s] */
+        double duration = 600.0;
+        /** @brief Resolution of the coverage raster [m] */
+        double coverageResolution = 0.25;
+        /** @brief Robot configuration directory, $ILVO_PATH if empty */
+        std::string ilvoPath;
+        /** @brief Redis variables that override redis.init.json, e.g. {"pc.purepursuit.carrot_distance": 2.5} */
+        nlohmann::json variables = nlohmann::json::object();
+
+        static SimulationScenario fromJson(const nlohmann::json& j);
+    };
+
+    /** @brief Metrics of a simulated scenario */
+    struct SimulationResult
+    {
+        std::string name;
+        /** @brief The end of the traject is reached */
+        bool endReached = false;
+        /** @brief Last notification of the navigation, explains why the automatic mode stopped */
+        std::string notification;
+        /** @brief Error message if the scenario could not be simulated */
+        std::string error;
+
+        size_t ticks = 0;
+        /** @brief Simulated time [s] */
+        double simulatedTime = 0.0;
+        /** @brief Wall time of the simulation [s] */
+        double wallTime = 0.0;
+
+        /** @brief Lateral distance to the path [m] */
+        double distanceErrorRms = 0.0, distanceErrorMean = 0.0, distanceErrorMax = 0.0;
+        /** @brief Orientation error to the path [deg] */
+        double orientationErrorRms = 0.0, orientationErrorMean = 0.0, orientationErrorMax = 0.0;
+        /** @brief Fraction of the geofence covered by active implement sections */
+        double coverage = 0.0;
+
+        nlohmann::json toJson() const;
+    };
+
+    /**
+     * @brief Headless simulation engine
+     *
+     * @details Runs the Simulation, Navigation and Operation variable managers in one process on an in-process store
+     * and a virtual clock. Every tick the virtual clock advances SIMULATION_TICK and the managers are stepped
+     * in the order of the control loop (kinematics, navigation, implement), so a field is simulated as fast as
+     * the controllers can be computed. The Platform is a singleton, one engine runs per process.
+     */
+    class SimulationEngine
+    {
+    private:
+        SimulationScenario scenario;
+    public:
+        SimulationEngine(SimulationScenario scenario);
+        ~SimulationEngine() = default;
+
+        SimulationResult run();
+    };
+
+} // Core
+} // Ilvo
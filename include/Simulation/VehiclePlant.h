@@ -0,0 +1,147 @@
+/**
+ * @file VehiclePlant.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Vehicle dynamics, actuator and GNSS models of the simulated platform
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <Utils/Settings/Plant.h>
+#include <ThirdParty/Eigen/Geometry>
+
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace Ilvo {
+namespace Core {
+
+    /** @brief Velocities in the robot frame: longitudinal (y) [m/s], lateral (x) [m/s] and angular (z) [rad/s] */
+    struct PlantVelocity
+    {
+        double longitudinal = 0.0;
+        double lateral = 0.0;
+        double angular = 0.0;
+    };
+
+    /** @brief Model that transforms the velocities of the platform during one simulation step */
+    class PlantModel
+    {
+    public:
+        virtual ~PlantModel() = default;
+
+        /**
+         * @brief Apply the model on the velocities
+         *
+         * @param velocity velocities, updated in place
+         * @param ts step time [s]
+         */
+        virtual void apply(PlantVelocity& velocity, double ts) = 0;
+    };
+
+    /** @brief First order lag followed by a jerk and an acceleration limit on one velocity */
+    class ActuatorDynamics
+    {
+    private:
+        Utils::Settings::Actuator settings;
+        double velocity;
+        double acceleration;
+    public:
+        ActuatorDynamics(Utils::Settings::Actuator settings);
+        ~ActuatorDynamics() = default;
+
+        /** @brief Step the actuator towards the command and return the actual velocity */
+        double update(double command, double ts);
+    };
+
+    /** @brief Actuator dynamics of the longitudinal, lateral and angular velocity */
+    class ActuatorModel : public PlantModel
+    {
+    private:
+        ActuatorDynamics longitudinal, lateral, angular;
+    public:
+        ActuatorModel(const Utils::Settings::Plant& plant);
+
+        void apply(PlantVelocity& velocity, double ts) override;
+    };
+
+    /** @brief Skid-steer slip, the ground velocities are a fraction of the track velocities */
+    class SlipModel : public PlantModel
+    {
+    private:
+        double longitudinalSlip, angularSlip;
+    public:
+        SlipModel(const Utils::Settings::Plant& plant);
+
+        void apply(PlantVelocity& velocity, double ts) override;
+    };
+
+    /**
+     * @brief Sideways creep of the platforms that drive laterally (PP_SPINNING_180)
+     *
+     * @details The creep is a constant lateral velocity plus a velocity proportional to the turn rate.
+     */
+    class CreepModel : public PlantModel
+    {
+    private:
+        double creepVelocity, creepGain;
+    public:
+        CreepModel(const Utils::Settings::Plant& plant);
+
+        void apply(PlantVelocity& velocity, double ts) override;
+    };
+
+    /** @brief GNSS receiver with gaussian position and heading noise and a fixed latency */
+    class GnssModel
+    {
+    private:
+        double noise, headingNoise, latency;
+        std::mt19937 generator;
+        std::normal_distribution<double> distribution;
+        /** @brief Past true raw gps states with their age [s] */
+        std::deque<std::pair<double, Eigen::Affine3d>> buffer;
+    public:
+        GnssModel(const Utils::Settings::Plant& plant);
+
+        bool isIdeal() const;
+        void reset();
+        /** @brief Add the true raw gps state of this step and return the measured raw gps state */
+        Eigen::Affine3d measure(const Eigen::Affine3d& raw, double ts);
+    };
+
+    /**
+     * @brief Plant of the simulated platform
+     *
+     * @details The commanded velocities pass through the actuator models, the result is what the platform
+     * reports in its monitor velocities. The ground models (slip, creep) then give the velocities that move the
+     * platform and the GNSS model returns the measured position. Without "plant" settings every model is
+     * skipped and the platform follows the commands instantly and exactly.
+     */
+    class VehiclePlant
+    {
+    private:
+        std::vector<std::unique_ptr<PlantModel>> actuatorModels;
+        std::vector<std::unique_ptr<PlantModel>> groundModels;
+        GnssModel gnss;
+    public:
+        VehiclePlant(const Utils::Settings::Plant& plant, bool lateral);
+        ~VehiclePlant() = default;
+
+        /** @brief Velocities the actuators realize from the commanded velocities */
+        PlantVelocity actuate(const PlantVelocity& command, double ts);
+        /** @brief Velocities the platform moves with over the ground */
+        PlantVelocity move(const PlantVelocity& actuated, double ts);
+        /** @brief Measured raw gps state of the true raw gps state */
+        Eigen::Affine3d measure(const Eigen::Affine3d& raw, double ts);
+
+        bool hasGnssModel() const;
+        void resetGnss();
+    };
+
+} // Core
+} // Ilvo
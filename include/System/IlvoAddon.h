@@ -2,9 +2,11 @@
 
 #include <Utils/Docker/DockerClient.h>
 #include <Utils/Docker/DockerRegistry.h>
+#include <Utils/Docker/DockerEventStream.h>
 #include <System/IlvoJob.h>
 
 #include <string>
+#include <vector>
 #include <chrono>
 
 namespace Ilvo {
@@ -18,6 +20,8 @@ namespace Core {
         nlohmann::json dockerConfig;
         Ilvo::Utils::Docker::DockerRegistry dockerRegistry;
         Ilvo::Utils::Docker::DockerClient& dockerClient;
+        /** @brief The container state is kept up to date by the docker events, runs() does not inspect the container */
+        bool eventDriven;
 
         /**
          * @brief Create a new docker container in the system if it does not exist already
@@ -25,6 +29,17 @@ namespace Core {
          * @param imageName: name of the docker image
          */
         void createContainer(const std::string& imageName);
+        /** @brief Use the listed container of the add-on if it runs the image of the add-on */
+        void adoptContainer(const nlohmann::json& container);
+        /**
+         * @brief Handle the response of a container creation
+         * 
+         * @param retry: a missing image or name conflict is retried after a pull
+         * @return true: the image has to be pulled and the creation retried
+         */
+        bool applyCreation(const nlohmann::json& docCreate, const std::string& imageName, bool retry);
+        void applyPull(const nlohmann::json& docPull);
+        void applyStart(const nlohmann::json& docStart);
     public:
         IlvoAddon(nlohmann::json ilvoAddon, Utils::Docker::DockerClient& dockerClient);
         ~IlvoAddon();
@@ -32,8 +47,27 @@ namespace Core {
         nlohmann::json toJson();
 
         bool runs();
+        /** @brief Inspect the container state with the docker API */
+        bool inspect();
+        /** @brief Update the container state with the result of a (batched) container inspection */
+        bool applyInspection(const nlohmann::json& docInspect);
+        const std::string& getContainerId();
+        void setEventDriven(bool eventDriven);
+        /**
+         * @brief Update the cached container state with a docker event
+         * 
+         * @return true: the event belongs to the container of this add-on and changed its state
+         */
+        bool applyEvent(const Utils::Docker::ContainerEvent& event);
         void start();
         void stop();
+        /**
+         * @brief Start the add-ons concurrently
+         * 
+         * @details The containers are listed once, the missing containers are created, pulled and started with
+         * parallel requests instead of one blocking request after the other.
+         */
+        static void startAll(const std::vector<IlvoAddon*>& addons, Utils::Docker::DockerClient& dockerClient);
         
         void pull();
         void updateSoftware();
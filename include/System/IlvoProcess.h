@@ -11,7 +11,9 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <chrono>
+#include <sys/types.h>
 
 #include <ThirdParty/json.hpp>
 #include <System/IlvoJob.h>
@@ -24,21 +26,37 @@ namespace Core {
     {
     private:
         bool checkHeartbeat;
+        /** @brief Processes that have to be ready before this process is started */
+        std::vector<std::string> dependsOn;
+        /** @brief Processes that run inside this process, e.g. the core loops of ilvo-monolith */
+        std::vector<std::string> hosts;
         boost::process::ipstream pipe_stream;
         boost::process::child process;
+        /** @brief Process file descriptor, readable when the process exits, -1 if not supported by the kernel */
+        int pidfd;
 
         Utils::Timing::TimeEdgeDetector heartbeatHealthDetector;
+
+        void openPidFd();
+        void closePidFd();
     public:
         IlvoProcess(nlohmann::json ilvoProcess);
         ~IlvoProcess();
 
         nlohmann::json toJson();
 
+        /** @brief Terminate the running programs with the name of this process, e.g. left over from a previous system manager */
         void kill();
         bool exists();
+        /** @brief Pids of the running programs with the name of this process, found in /proc */
+        std::vector<pid_t> findPids();
 
         std::string getName();
         int getExitCode();
+        int getPidFd();
+        bool getCheckHeartbeat();
+        const std::vector<std::string>& getDependsOn();
+        const std::vector<std::string>& getHosts();
 
         bool runs();
         bool heartbeatHealthy(bool heartbeatValue);
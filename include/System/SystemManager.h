@@ -12,6 +12,7 @@
 
 #include <Utils/Redis/VariableManager.h>
 #include <Utils/Docker/DockerClient.h>
+#include <Utils/Docker/DockerEventStream.h>
 #include <Utils/Timing/Logic.h>
 #include <System/IlvoProcess.h>
 #include <System/IlvoAddon.h>
@@ -29,6 +30,8 @@ namespace Core {
      * 
      * @details The system manager maintains the processes and add-ons in the system based on configuration in the Redis database ('ilvoAddons' and 'ilvoProcesses').
      * It enables the user to start and stop processes and add-ons, as well as update the software or alter configuration.
+     * The core loops run as separate processes, or as threads of ilvo-monolith when its 'AutoStart' is set. The processes in
+     * the 'Hosts' list of ilvo-monolith are then not started.
      */
     class SystemManager: public Utils::Redis::VariableManager 
     {
@@ -39,6 +42,10 @@ namespace Core {
         std::chrono::system_clock::time_point startTime;
 
         Utils::Timing::SinglePulseGenerator fieldPulseGenerator;
+        /** @brief A field update was raised, the pulse is generated until it ends */
+        bool fieldPulseActive;
+        /** @brief The system configuration was written since it was last read (keyspace event) */
+        bool systemChanged;
 
         /**
          * @brief Update the entire software package
@@ -47,9 +54,49 @@ namespace Core {
          */
         void updateSoftware();
         Utils::Docker::DockerClient dockerClient;
+        /** @brief Container state changes of the add-ons, the containers are only inspected when the stream is down */
+        Utils::Docker::DockerEventStream dockerEvents;
 
         std::map<std::string, std::unique_ptr<IlvoProcess>> processes = {};
         std::map<std::string, std::unique_ptr<IlvoAddon>> addons = {};
+        /** @brief Host of the processes that run inside an auto start process, e.g. the core loops of ilvo-monolith */
+        std::map<std::string, std::string> hostedBy;
+
+        /** @brief Last system configuration read from or written to the redis database */
+        nlohmann::json systemJson;
+        /** @brief Maximum time to wait for the first tick of a started process before its dependents are started */
+        std::chrono::milliseconds readyTimeout;
+
+        /** @brief Map the processes in the 'Hosts' list of the auto start processes to their host */
+        void updateHosts();
+
+        /**
+         * @brief Start the auto start processes in dependency order
+         * 
+         * @details Redis is available, the system manager itself is connected. A process is started as soon as the processes 
+         * in its 'DependsOn' list are ready, processes without dependencies are started at once. A process is ready when it
+         * publishes its first completed tick on '<process>-tick'. The heartbeat is no ready signal, it only toggles after a
+         * pulse period. A process that exits or does not become ready within the ready timeout no longer blocks its dependents.
+         * A hosted process is not started, a dependency on it is a dependency on its host. The host is ready when all its
+         * hosted processes published their first tick.
+         */
+        void startProcesses();
+
+        /**
+         * @brief Restart the processes that exited or lost their heartbeat
+         * 
+         * @details Exited processes are detected with one poll on their pidfds, the heartbeats are read in one request.
+         * A hosted process has no pid, its host is restarted when its heartbeat stops. A process that is no auto start process
+         * is only supervised after a start command.
+         * @return true: a process was restarted
+         */
+        bool superviseProcesses();
+        /**
+         * @brief Update the add-on states with the docker events
+         * 
+         * @return true: the state of an add-on changed
+         */
+        bool superviseAddons();
 
         void restartContainer(const std::string containerName);
         void updateContainer(const std::string containerName);
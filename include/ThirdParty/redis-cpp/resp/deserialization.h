@@ -129,7 +129,10 @@ public:
             return;
         }
         if (length < 1)
+        {
+            std::getline(stream, string);
             return;
+        }
         data_.resize(static_cast<typename buffer_type::size_type>(length));
         stream.read(&data_[0], length);
         std::getline(stream, string);
@@ -16,6 +16,16 @@
 #include <curl/curl.h>
 #include <ThirdParty/json.hpp>
 
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
 namespace Ilvo {
 namespace Utils {
 namespace Docker {
@@ -33,6 +43,13 @@ std::string param( const std::string& param_name, bool param_value);
 std::string param( const std::string& param_name, int param_value);
 std::string param( const std::string& param_name, nlohmann::json& param_value);
 
+/**
+ * @brief Client of the docker engine API
+ * 
+ * @details All requests are performed by one worker thread on a persistent curl multi handle, the connections to the
+ * docker socket are kept alive and reused. The *_async methods return a future, the other methods block until the
+ * response is received. The socket path is /var/run/docker.sock or $ILVO_DOCKER_SOCKET.
+ */
 class DockerClient{
     public :
         DockerClient();
@@ -40,6 +57,9 @@ class DockerClient{
         explicit DockerClient(std::string host, std::string api_version);
         ~DockerClient();
 
+        DockerClient(DockerClient const&) = delete;
+        void operator=(DockerClient const&) = delete;
+
         /*
         * System
         */
@@ -71,16 +91,48 @@ class DockerClient{
         nlohmann::json attach_to_container(const std::string& container_id, bool logs=false, bool stream=false, bool o_stdin=false, bool o_stdout=false, bool o_stderr=false);
 
         bool exists_container(const std::string& container_id);
+        /** @brief Summary (Id, Image, Names, State) of the container with exactly this name, null if not found */
+        nlohmann::json find_container(const std::string& name);
+
+        /*
+        * Async
+        */
+        std::future<nlohmann::json> pull_image_async(nlohmann::json& parameters, const std::string& image_name);
+        std::future<nlohmann::json> inspect_container_async(const std::string& container_id);
+        std::future<nlohmann::json> create_container_async(nlohmann::json& parameters, const std::string& name="");
+        std::future<nlohmann::json> start_container_async(const std::string& container_id);
+        std::future<nlohmann::json> stop_container_async(const std::string& container_id);
+        /** @brief Inspect the containers in parallel, the results are in the order of the ids */
+        std::vector<nlohmann::json> inspect_containers(const std::vector<std::string>& container_ids);
 
         const std::string& get_last_command() const;
     private:
+        struct Request;
+
         std::string last_command;
         std::string host_uri;
         std::string api_version{"v1.44"};
+        std::string socket_path{"/var/run/docker.sock"};
         bool is_remote;
-        CURL *curl{};
-        CURLcode res{};
 
+        CURLM *multi{};
+        std::thread worker;
+        std::atomic<bool> running{false};
+        std::mutex mutex;
+        /** @brief Requests waiting for the worker */
+        std::deque<std::shared_ptr<Request>> queue;
+        /** @brief Requests in progress on the multi handle */
+        std::map<CURL*, std::shared_ptr<Request>> active;
+        /** @brief Easy handles of finished requests, reused for the next requests */
+        std::vector<CURL*> idle;
+
+        void init();
+        void run();
+        void perform(std::shared_ptr<Request> request);
+        void finish(CURL* easy, CURLcode result);
+
+        std::future<nlohmann::json> request(Method method, const std::string& path, unsigned success_code = 200, nlohmann::json add_body=nlohmann::json(), nlohmann::json add_headers=nlohmann::json());
+        std::future<nlohmann::json> requestJson(Method method, const std::string& path, unsigned success_code = 200, nlohmann::json add_body=nlohmann::json(), nlohmann::json add_headers=nlohmann::json());
         nlohmann::json requestAndParse(Method method, const std::string& path, unsigned success_code = 200, nlohmann::json add_body=nlohmann::json(), nlohmann::json add_headers=nlohmann::json());
         nlohmann::json requestAndParseJson(Method method, const std::string& path, unsigned success_code = 200, nlohmann::json add_body=nlohmann::json(), nlohmann::json add_headers=nlohmann::json());
 
@@ -0,0 +1,98 @@
+/**
+ * @file DockerEventStream.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Long-lived subscription on the docker container events
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <ThirdParty/json.hpp>
+#include <curl/curl.h>
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
+namespace Ilvo {
+namespace Utils {
+namespace Docker {
+
+    /** @brief Container event of the docker events stream, e.g. start, die, destroy */
+    struct ContainerEvent
+    {
+        std::string id;
+        std::string name;
+        std::string action;
+        int exitCode = 0;
+        /** @brief Unix time of the event [s] */
+        long time = 0;
+
+        static bool parse(const nlohmann::json& j, ContainerEvent& event);
+    };
+
+    /**
+     * @brief Docker container events received on a background thread
+     *
+     * @details Keeps one `GET /events` request open on the docker socket, the events are queued and
+     * taken by the system manager in its tick. When the connection drops, the stream reconnects and
+     * replays the missed events with the `since` parameter.
+     */
+    class DockerEventStream
+    {
+    private:
+        std::string host_uri;
+        std::string socket_path;
+
+        std::thread thread;
+        std::atomic<bool> running;
+        std::atomic<bool> isConnected;
+        std::atomic<bool> resync;
+        std::chrono::milliseconds reconnectPeriod;
+        std::mutex mutex;
+        std::condition_variable stopCondition;
+
+        std::vector<ContainerEvent> events;
+        std::string lineBuffer;
+        long lastEventTime;
+
+        void run();
+        void processLine(const std::string& line);
+
+        static size_t WriteCallback(void *contents, size_t size, size_t nmemb, void *userp);
+        static size_t HeaderCallback(char *buffer, size_t size, size_t nitems, void *userp);
+        static int ProgressCallback(void *clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow);
+    public:
+        /** @brief Events of the local docker daemon, socket of $ILVO_DOCKER_SOCKET and api version of $ILVO_DOCKER_API_VERSION */
+        DockerEventStream();
+        DockerEventStream(std::string socket_path, std::string api_version, std::chrono::milliseconds reconnectPeriod = std::chrono::seconds(2));
+        ~DockerEventStream();
+
+        DockerEventStream(DockerEventStream const&) = delete;
+        void operator=(DockerEventStream const&) = delete;
+
+        void start();
+        void stop();
+
+        /** @brief The events request is open, container state changes are received */
+        bool connected() const;
+        /**
+         * @brief Events may have been missed, e.g. on the first connection
+         *
+         * @return true once after every (re)connection, the cached container states should be inspected again
+         */
+        bool resyncRequired();
+        /** @brief Take the events received since the previous call */
+        std::vector<ContainerEvent> poll();
+    };
+
+}   // namespace Docker
+}   // namespace Utils
+}   // namespace Ilvo
@@ -0,0 +1,83 @@
+/**
+ * @file CsvFile.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Memory-mapped reader of csv files
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <Utils/File/File.h>
+
+namespace Ilvo {
+namespace Utils {
+namespace File {
+
+    /** @brief Bytes of the file a thread parses at once */
+    const size_t CSV_CHUNK_SIZE = 1 << 20;
+
+    /** @brief Numeric columns of the rows of a csv file */
+    struct CsvColumns
+    {
+        /** @brief Values of every requested column, in the order of the request */
+        std::vector<std::vector<double>> values;
+        /** @brief First row of every series, the last element is the number of rows */
+        std::vector<size_t> seriesStart;
+    };
+
+    /**
+     * @brief Csv file with a header line, decoded from a memory-mapped file
+     *
+     * @details The rows end at the first empty line. Fields may be quoted to hold the delimiter, a quote in a quoted
+     * field is written twice; a quoted field can not hold a line break, since the rows are parsed in chunks of
+     * CSV_CHUNK_SIZE that are split on line boundaries and run on the TaskPool.
+     */
+    class CsvFile
+    {
+    private:
+        MappedFile file;
+        char delimiter;
+        std::vector<std::string> columns;
+        /** @brief Offset of the first row */
+        size_t body;
+
+        /** @brief Offsets of the chunks of the rows, the last element is the end of the file */
+        std::vector<size_t> chunks() const;
+    public:
+        /**
+         * @brief Map the file and read the header line
+         *
+         * @throws PathNotFoundException if the file does not exist
+         */
+        CsvFile(const std::string& filename, char delimiter=',');
+        ~CsvFile() = default;
+
+        CsvFile(CsvFile const&) = delete;
+        void operator=(CsvFile const&) = delete;
+
+        /** @brief Names of the columns of the header */
+        const std::vector<std::string>& getColumns() const;
+        /** @brief Index of the first column with one of the names, case insensitive, -1 if none */
+        int findColumn(const std::vector<std::string>& names) const;
+
+        /**
+         * @brief Parse the columns of all rows as numbers into contiguous arrays
+         *
+         * @details A missing or empty value is NaN. Consecutive rows with the same value in the series column form a
+         * series, without a series column all rows are one series.
+         * @throws FileFormatException if a value is not a number
+         */
+        CsvColumns readColumns(const std::vector<size_t>& columns, int seriesColumn=-1) const;
+        /** @brief All fields of all rows, without their quotes */
+        std::vector<std::vector<std::string>> readRows() const;
+    };
+
+} // namespace Ilvo
+} // namespace Utils
+} // namespace File
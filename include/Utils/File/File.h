@@ -37,6 +37,37 @@ namespace File {
      */
     void removeCharacters(std::string& s, const std::vector<char>& removeChars);
 
+    /**
+     * @brief Read-only memory mapping of a file
+     * 
+     * @details The pages are loaded on access, the readers decode the data in place instead of copying it into
+     * buffers first.
+     */
+    class MappedFile
+    {
+    private:
+        std::string filename;
+        const char* begin;
+        size_t length;
+    public:
+        MappedFile();
+        /**
+         * @throws PathNotFoundException if the file can not be opened
+         * @throws FileFormatException if the file can not be mapped
+         */
+        MappedFile(const std::string& filename);
+        MappedFile(MappedFile&& other);
+        MappedFile& operator=(MappedFile&& other);
+        MappedFile(MappedFile const&) = delete;
+        void operator=(MappedFile const&) = delete;
+        ~MappedFile();
+
+        const std::string& getFilename() const;
+        const char* data() const;
+        size_t size() const;
+        bool empty() const;
+    };
+
 } // namespace Ilvo
 } // namespace Utils
 } // namespace File
\ No newline at end of file
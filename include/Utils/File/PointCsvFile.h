@@ -16,8 +16,10 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 #include <Utils/Geometry/Point.h>
 #include <Utils/File/PointData.h>
+#include <Utils/File/CsvFile.h>
 
 namespace Ilvo {
 namespace Utils {
@@ -26,17 +28,21 @@ namespace File {
     /**
      * @brief Loads a csv file and converts it to PointData.
      * 
+     * @details The rows of a series column with the same value form a serie, without that column all rows are one
+     * serie. The fields of the rows are only split into strings on the first getDataLines().
      */
     class PointCsvFile : public PointData
     {
     private:
         std::string csv_file;
         std::map<std::string, int> column_names;
-        std::vector<std::vector<std::string>> data_lines;
+        mutable std::vector<std::vector<std::string>> data_lines;
+        std::unique_ptr<CsvFile> csv;
         
-        void readPointFile(std::vector<std::string>& xFields, std::vector<std::string>& yFields);
+        void readPointFile(std::vector<std::string>& xFields, std::vector<std::string>& yFields, const std::vector<std::string>& seriesFields);
     public:
-        void init(const std::string& filename, std::vector<std::string>& xFields, std::vector<std::string>& yFields);
+        void init(const std::string& filename, std::vector<std::string>& xFields, std::vector<std::string>& yFields,
+                  const std::vector<std::string>& seriesFields={});
         const std::map<std::string, int>& getColumnNames() const;
         const std::vector<std::vector<std::string>>& getDataLines() const;
 
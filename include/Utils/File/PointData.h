@@ -24,22 +24,21 @@ namespace File {
 
     enum ShapeFieldType { INT, BOOL, STRING, DOUBLE };
 
+    /** @brief Attribute of a shape, the member of the type holds the value */
     class ShapeFieldData {
         public:
-            union {
-                int i;
-                bool b;
-                double d;
-                std::string s;
-            };
+            int i = 0;
+            bool b = false;
+            double d = 0.0;
+            std::string s;
             std::string name;
             ShapeFieldType type;
 
-            ShapeFieldData(std::string name, int v): name(name), i(v) { type = INT; }; 
-            ShapeFieldData(std::string name, bool v): name(name), b(v) { type = BOOL; }; 
-            ShapeFieldData(std::string name, double v): name(name), d(v) { type = DOUBLE; }; 
-            ShapeFieldData(std::string name, std::string v): name(name), s(v) { type = STRING; };
-            ~ShapeFieldData() {};
+            ShapeFieldData(std::string name, int v): i(v), name(name) { type = INT; }; 
+            ShapeFieldData(std::string name, bool v): b(v), name(name) { type = BOOL; }; 
+            ShapeFieldData(std::string name, double v): d(v), name(name) { type = DOUBLE; }; 
+            ShapeFieldData(std::string name, std::string v): s(v), name(name) { type = STRING; };
+            ~ShapeFieldData() = default;
     };
 
     typedef std::shared_ptr<ShapeFieldData> ShapeFieldDataPtr;
@@ -52,14 +51,15 @@ namespace File {
         std::vector<std::vector<ShapeFieldDataPtr>> metadata;
     public:
         PointData(bool polygon);
-        ~PointData() = default;
+        virtual ~PointData() = default;
 
         const std::vector<std::vector<Geometry::PointPtr>>& getAllPoints();
         int getNumSeries();
         bool hasMultiple();
 
         std::vector<Geometry::PointPtr>& getPoints(uint serie);
-        std::vector<ShapeFieldDataPtr>& getFields(uint i);
+        /** @brief Attributes of a serie, a reader may only decode them on the first call */
+        virtual std::vector<ShapeFieldDataPtr>& getFields(uint i);
         int getNumPoints(uint i);
         int getNumFields(uint i);
         bool isPolygon(uint i);
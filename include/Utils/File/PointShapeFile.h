@@ -12,12 +12,11 @@
 
 #include <string>
 #include <vector>
-#include <map>
+#include <memory>
 #include <iostream>
 #include <Utils/Geometry/Point.h>
 #include <Utils/File/PointData.h>
-
-#include <ThirdParty/shapefil.h>
+#include <Utils/File/ShapeFile.h>
 
 #include <boost/geometry/geometry.hpp>
 #include <boost/geometry/geometries/geometries.hpp>
@@ -30,6 +29,7 @@ namespace File {
     /**
      * @brief Loads a shapefile and converts it to PointData.
      * 
+     * @details The attributes of a serie are decoded from the mapped .dbf file on the first getFields() of the serie.
      */
     class PointShapeFile : public PointData
     {
@@ -39,10 +39,15 @@ namespace File {
 
         int utmZone;
 
+        std::unique_ptr<ShapeFile> shapes;
+        /** @brief Record of the .dbf file of every serie */
+        std::vector<size_t> records;
+        std::vector<bool> decoded;
+
         void readShapefile();
-        void loadDbfFields(DBFHandle handle, int i);
     public:
         void init(const std::string& filename);
+        std::vector<ShapeFieldDataPtr>& getFields(uint i) override;
 
         PointShapeFile(bool polygon, int utmZone);
         ~PointShapeFile() = default;
@@ -0,0 +1,123 @@
+/**
+ * @file ShapeFile.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Memory-mapped reader of ESRI shapefiles (.shp and .dbf)
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <Utils/File/File.h>
+#include <Utils/File/PointData.h>
+
+namespace Ilvo {
+namespace Utils {
+namespace File {
+
+    /** @brief Shape types of the .shp format */
+    enum ShapeType { NULL_SHAPE = 0, POINT = 1, POLYLINE = 3, POLYGON = 5, MULTIPOINT = 8,
+                     POINTZ = 11, POLYLINEZ = 13, POLYGONZ = 15, MULTIPOINTZ = 18,
+                     POINTM = 21, POLYLINEM = 23, POLYGONM = 25, MULTIPOINTM = 28 };
+
+    /** @brief Column of the .dbf file */
+    struct ShapeField
+    {
+        std::string name;
+        /** @brief dBase type: 'C' string, 'N' or 'F' number, 'L' logical, 'D' date */
+        char dbfType;
+        ShapeFieldType type;
+        /** @brief Offset of the column in a record */
+        size_t offset;
+        size_t width;
+        int decimals;
+    };
+
+    /**
+     * @brief Shapefile decoded from memory-mapped files
+     *
+     * @details The vertices of all shapes are decoded in one pass over the .shp file into contiguous x and y arrays,
+     * shapes and parts index into them (part p of shape s spans the vertices [partStart[p], partStart[p + 1]) and
+     * shape s the parts [shapeStart[s], shapeStart[s + 1])). A point is a shape of one part with one vertex, a null
+     * shape has no parts. The Z and M values are skipped.
+     *
+     * The .dbf file stays mapped, an attribute is only decoded when it is read, per value or per column. The field
+     * types follow shapelib: 'N' without decimals and narrower than 10 characters is an INT, other numbers DOUBLE.
+     */
+    class ShapeFile
+    {
+    private:
+        MappedFile shp;
+        MappedFile dbf;
+
+        int shapeType;
+        std::vector<double> xs, ys;
+        std::vector<uint32_t> partStart;
+        std::vector<uint32_t> shapeStart;
+
+        std::vector<ShapeField> fields;
+        size_t numRecords;
+        size_t headerLength;
+        size_t recordLength;
+
+        void readShp();
+        void readDbfHeader();
+        const char* record(size_t r) const;
+    public:
+        /**
+         * @brief Map and decode the .shp file and the header of the .dbf file next to it
+         *
+         * @throws PathNotFoundException if the .shp file does not exist, the .dbf file is optional
+         * @throws FileFormatException if a file is truncated or holds an unsupported shape type
+         */
+        ShapeFile(const std::string& shpFile);
+        ~ShapeFile() = default;
+
+        ShapeFile(ShapeFile const&) = delete;
+        void operator=(ShapeFile const&) = delete;
+
+        int getShapeType() const;
+        size_t getNumShapes() const;
+        size_t getNumParts(size_t shape) const;
+        size_t getNumVertices() const;
+        /** @brief First vertex of part p of the shape, the part ends at the first vertex of part p + 1 */
+        size_t partBegin(size_t shape, size_t p) const;
+        size_t partEnd(size_t shape, size_t p) const;
+        const std::vector<double>& getX() const;
+        const std::vector<double>& getY() const;
+
+        /**
+         * @brief Convert the vertices in longitude/latitude to UTM, in one batch
+         *
+         * @details A vertex with x <= 180 or y <= 90 is geographic. The zone is taken from the first geographic
+         * vertex if utmZone is not a valid zone.
+         * @return true if a vertex was converted
+         */
+        bool toUtm(int utmZone);
+
+        size_t getNumRecords() const;
+        const std::vector<ShapeField>& getFields() const;
+        /** @brief Index of the column, -1 if the .dbf file has no column with the name */
+        int findField(const std::string& name) const;
+        bool isDeleted(size_t record) const;
+        /** @brief Characters of the value, without the padding */
+        std::string_view getRaw(size_t record, size_t field) const;
+        std::string getString(size_t record, size_t field) const;
+        int getInt(size_t record, size_t field) const;
+        double getDouble(size_t record, size_t field) const;
+        bool getBool(size_t record, size_t field) const;
+        /** @brief Numeric column of all records, 0 for empty values */
+        std::vector<double> getDoubleColumn(size_t field) const;
+        /** @brief Attributes of a record, without the date fields (like shapelib) */
+        std::vector<ShapeFieldDataPtr> getFieldData(size_t record) const;
+    };
+
+} // namespace Ilvo
+} // namespace Utils
+} // namespace File
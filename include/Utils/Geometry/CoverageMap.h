@@ -0,0 +1,122 @@
+/**
+ * @file CoverageMap.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief As-applied coverage of the sections, in memory-mapped tiles
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <ThirdParty/json.hpp>
+#include <Utils/Geometry/Polygon.h>
+
+namespace Ilvo {
+namespace Utils {
+namespace Geometry {
+
+    /** @brief Number of cells of a tile side */
+    const int COVERAGE_TILE_SIZE = 256;
+    /** @brief Maximal number of cells of a sweep, a larger sweep is a jump of the footprint and only covers the footprint */
+    const int64_t COVERAGE_MAX_SWEEP_CELLS = 1 << 16;
+
+    /**
+     * @brief Count of the passes of the sections over every cell of a UTM grid
+     *
+     * @details The grid is aligned with the UTM origin and split in tiles of COVERAGE_TILE_SIZE² cells with a saturating
+     * 8 bit count. Tiles are created when a footprint reaches them and are memory-mapped on a file '<tx>_<ty>.tile' of
+     * the directory, so the coverage of a field persists between the runs of the process. Without a directory the
+     * tiles are anonymous memory.
+     *
+     * A sweep is the path of one footprint (a section polygon) over consecutive ticks. cover() counts the cells whose
+     * center lies in the convex hull of the previous and current footprint, but not in the previous footprint: the
+     * area entered since the previous tick. Every cell is so counted once per pass, and the time of an update only
+     * depends on the swept area, not on the size of the field.
+     */
+    class CoverageMap
+    {
+    private:
+        /** @brief Memory-mapped counts of a tile */
+        struct Tile
+        {
+            uint8_t* cells;
+            int64_t tx, ty;
+        };
+
+        double resolution;
+        std::string directory;
+        std::unordered_map<uint64_t, Tile> tiles;
+        /** @brief Tiles changed since the previous takeChangedTiles() */
+        std::set<uint64_t> changedTiles;
+        /** @brief Previous footprint of every sweep */
+        std::unordered_map<int, bgPolygon2D> sweeps;
+
+        static uint64_t tileKey(int64_t tx, int64_t ty);
+        Tile& tile(int64_t tx, int64_t ty);
+        const Tile* findTile(int64_t tx, int64_t ty) const;
+        void mapTile(int64_t tx, int64_t ty);
+        void unmapTiles();
+
+        /** @brief Area entered by the sweep, the footprint if the sweep did not start or jumped */
+        bgPolygon2D sweptArea(int sweep, const bgPolygon2D& footprint, const bgPolygon2D*& previous) const;
+        /** @brief Call f(i, j) for the cells with a center inside the convex area, but not inside the excluded area */
+        template<typename F>
+        void forEachCell(const bgPolygon2D& area, const bgPolygon2D* exclude, F f) const;
+    public:
+        /**
+         * @brief Coverage with cells of resolution [m], in memory-mapped tiles of the directory
+         *
+         * @details The existing tiles of the directory are mapped, unless they have another resolution, then they are
+         * removed. An empty directory keeps the tiles in memory.
+         *
+         * @throws std::runtime_error if the directory or a tile can not be created or mapped
+         */
+        CoverageMap(double resolution, const std::string& directory="");
+        ~CoverageMap();
+
+        CoverageMap(CoverageMap const&) = delete;
+        void operator=(CoverageMap const&) = delete;
+
+        double getResolution() const;
+        const std::string& getDirectory() const;
+
+        /** @brief Number of passes over the cell of the point */
+        int count(double x, double y) const;
+        /** @brief Fraction of the cells the footprint entered since the previous cover() of the sweep that is covered */
+        double overlap(int sweep, const bgPolygon2D& footprint) const;
+        /** @brief Count a pass over the cells the footprint entered since the previous cover(), returns the number of cells */
+        size_t cover(int sweep, const bgPolygon2D& footprint);
+        /** @brief End the sweep, for a footprint that is lifted; the next cover() counts the whole footprint */
+        void lift(int sweep);
+        /** @brief Remove all tiles, also from the directory */
+        void clear();
+
+        /** @brief Keys of all tiles */
+        std::vector<uint64_t> getTiles() const;
+        /**
+         * @brief Keys of the tiles changed since the previous call, the first call includes the tiles of the directory
+         *
+         * @details At most count tiles are taken, in the order of their keys; the others stay changed for the next call.
+         */
+        std::vector<uint64_t> takeChangedTiles(size_t count=SIZE_MAX);
+        /**
+         * @brief Tile for the UI: {"x", "y", "resolution", "size", "counts"}
+         *
+         * @details (x, y) is the UTM corner of the tile with the lowest coordinates, "counts" the base64 encoded counts
+         * of the size² cells, row by row from that corner.
+         */
+        nlohmann::json exportTile(uint64_t key) const;
+        /** @brief Name of the tile, '<tx>_<ty>' */
+        static std::string tileName(uint64_t key);
+    };
+
+} // namespace Ilvo
+} // namespace Utils
+} // namespace Geometry
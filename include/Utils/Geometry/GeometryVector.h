@@ -33,7 +33,6 @@ namespace Geometry {
     template<class T>
     class GeometryVector : public std::vector<T> {
         private:
-            int closestIdx = -1;
             Eigen::MatrixXd m;
 
         public:
@@ -50,52 +49,6 @@ namespace Geometry {
                 }
             } 
 
-            std::vector<T> nearby(Point& p, int windowSize=10)
-            {
-                int halfWindowSize = std::floor(windowSize / 2);
-
-                int startIdx, endIdx;
-
-                // search entire array to closest point if closestIdx is smaller than one.
-                if (closestIdx < 0) {
-                    closestIdx = 0;
-                    startIdx = 0;
-                    endIdx = this->size() - 1;
-                } else {
-                    startIdx = std::max(closestIdx - halfWindowSize, 0);
-                    endIdx = std::min(closestIdx + halfWindowSize, (int)(this->size() - 1));
-                }
-
-                // search closest point
-                for (int i = startIdx; i <= endIdx; i++) {
-                    T geometry = this->at(i);
-                    T closestGeometry = this->at(closestIdx);
-                    if (geometry->distance(p) < closestGeometry->distance(p)) {
-                        closestIdx = i;
-                    }
-                }
-
-                startIdx = std::max({closestIdx - halfWindowSize, 0});
-                endIdx = std::min({closestIdx + halfWindowSize, (int)(this->size() - 1)});
-
-                return std::vector<T>(this->begin() + startIdx, this->begin() + endIdx);
-            }   
-
-            // std::vector<PointPtr> nearbyDistance(Point& p, double distance=5.0)
-            // {
-            //     Eigen::MatrixXd mX = Eigen::MatrixXd::Constant(this->size(), 1, p.x());
-            //     Eigen::MatrixXd mY = Eigen::MatrixXd::Constant(this->size(), 1, p.y());
-            //     Eigen::MatrixXd mMaxDistance = Eigen::MatrixXd::Constant(this->size(), 1, distance);
-            //     Eigen::MatrixXd mDistance = (m.col(0) - mX).transpose() * (m.col(0) - mX) + (m.col(1) - mY).transpose() * (m.col(1) - mY);
-
-            //     std::vector<double> mDistanceFiltered(mDistance.array());
-            //     std::vector<PointPtr> nearbyPoints;
-
-
-            //     return nearbyPoints;
-            // }
-
-
             ~GeometryVector() = default;
     };
 
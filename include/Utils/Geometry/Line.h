@@ -58,6 +58,10 @@ namespace Geometry {
             double corner(Line line);
             Point intersection(Line line);
             std::vector<PointPtr> interpolate(double interpolationDistance, bool curvy=false) const;
+            /** @brief number of points of the interpolation */
+            int interpolationLength(double interpolationDistance) const;
+            /** @brief interpolation into the interpolationLength() points from the output, curvy points get the radius */
+            void interpolate(double interpolationDistance, std::vector<PointPtr>::iterator output, bool curvy=false, double radius=0.0) const;
 
             Line& operator= (const Line& from);
     };
@@ -0,0 +1,61 @@
+/**
+ * @file PathEncoding.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Compact text encoding of paths
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <Utils/Geometry/Point.h>
+
+namespace Ilvo {
+namespace Utils {
+namespace Geometry {
+
+    /**
+     * @brief Encoded polyline of UTM coordinates
+     *
+     * @details The encoded polyline algorithm on the coordinates relative to an origin: every point is the difference
+     * (x, y) with the previous point, in units of 10^-precision m, as zigzag varints of 5 bits per printable character.
+     * The first point is relative to the origin, which keeps the values within 32 bits for any field. A decoder of
+     * encoded polylines with the same precision returns (x, y) pairs in the place of (lat, lon), the origin is added
+     * to them. A path of points 10 cm apart takes about 4 characters per point.
+     */
+    class PathEncoder
+    {
+    private:
+        Point origin;
+        double factor;
+        long long previousX, previousY;
+        std::string encoded;
+
+        void addValue(long long value);
+    public:
+        PathEncoder(const Point& origin, int precision=3);
+        ~PathEncoder() = default;
+
+        void add(double x, double y);
+        void add(const Point& point);
+        /** @brief Number of characters of the encoded points */
+        size_t size() const;
+        const std::string& str() const;
+    };
+
+    /** @brief Encode the points relative to the origin */
+    std::string encodePath(const std::vector<PointPtr>& points, const Point& origin, int precision=3);
+    /**
+     * @brief Decode an encoded path, the coordinates are rounded to the precision
+     *
+     * @throws std::invalid_argument if the path ends in the middle of a value or of a point
+     */
+    std::vector<Point> decodePath(const std::string& encoded, const Point& origin, int precision=3);
+
+} // namespace Ilvo
+} // namespace Utils
+} // namespace Geometry
@@ -0,0 +1,79 @@
+/**
+ * @file PathMatcher.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Map matching of points onto the segments of a path
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <Utils/Geometry/Point.h>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+namespace Ilvo {
+namespace Utils {
+namespace Geometry {
+
+    /**
+     * @brief Projection of a point on a path
+     *
+     */
+    class PathMatch
+    {
+    public:
+        /** @brief index of the segment [index, index+1] of the path */
+        int index;
+        /** @brief distance along the path from its first point to the projection [m] */
+        double along;
+        /** @brief distance of the point to the path, positive to the left [m] */
+        double offset;
+        /** @brief projection of the point on the path */
+        Point point;
+
+        PathMatch() : index(0), along(0.0), offset(0.0) {}
+        ~PathMatch() = default;
+    };
+
+    /**
+     * @brief Projects points on the closest segment of a path
+     *
+     * @details The segments are indexed in a packed R-tree of their bounding boxes, a match only computes the
+     * projection on the segments whose box is closer than the best projection so far. A point that is equally close
+     * to two segments is matched on the first one.
+     */
+    class PathMatcher
+    {
+    private:
+        typedef boost::geometry::model::box<bgPoint2D> bgBox;
+        typedef std::pair<bgBox, int> SegmentBox;
+
+        std::vector<bgPoint2D> vertices;
+        /** @brief distance along the path to every vertex [m] */
+        std::vector<double> cumulative;
+        boost::geometry::index::rtree<SegmentBox, boost::geometry::index::rstar<16>> segments;
+
+        PathMatch project(const bgPoint2D& point, int index) const;
+    public:
+        PathMatcher();
+        PathMatcher(const std::vector<PointPtr>& path);
+        ~PathMatcher() = default;
+
+        bool empty() const;
+        /** @brief length of the path [m] */
+        double length() const;
+
+        /** @brief projection of the point on the closest segment */
+        PathMatch match(const Point& point) const;
+        /** @brief projection of every point, matched in parallel for large batches */
+        std::vector<PathMatch> match(const std::vector<PointPtr>& points) const;
+    };
+
+} // namespace Ilvo
+} // namespace Utils
+} // namespace Geometry
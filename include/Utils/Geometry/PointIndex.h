@@ -0,0 +1,62 @@
+/**
+ * @file PointIndex.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Spatial index for box, radius and nearest neighbour queries on points
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <Utils/Geometry/Point.h>
+
+namespace Ilvo {
+namespace Utils {
+namespace Geometry {
+
+    /**
+     * @brief Uniform grid over a set of points
+     *
+     * @details The grid has a few points per cell and at most a few cells per point, so sparse maps with far away
+     * clusters do not blow up the grid. The coordinates are stored per cell in separate x and y arrays, a query scans
+     * the contiguous ranges of the cells it overlaps. Queries return the indices of the points in the vector the
+     * index was built from.
+     */
+    class PointIndex
+    {
+    private:
+        double x0, y0;
+        double cellSize;
+        int nx, ny;
+        /** @brief coordinates of the points ordered per cell */
+        std::vector<double> xs, ys;
+        /** @brief index of the points in the source vector, ordered per cell */
+        std::vector<int> ids;
+        /** @brief start of every cell in xs, ys and ids, the last element is the number of points */
+        std::vector<int> cellStart;
+
+        int cellX(double x) const;
+        int cellY(double y) const;
+    public:
+        PointIndex();
+        PointIndex(const std::vector<PointPtr>& points);
+        ~PointIndex() = default;
+
+        size_t size() const;
+        bool empty() const;
+
+        /** @brief indices of the points in the box [minX, maxX] x [minY, maxY], in ascending order */
+        void inBox(double minX, double minY, double maxX, double maxY, std::vector<int>& result) const;
+        /** @brief indices of the points within the radius of the center, in ascending order */
+        void inRadius(const Point& center, double radius, std::vector<int>& result) const;
+        /** @brief indices of the k points closest to the point, closest first */
+        std::vector<int> nearest(const Point& point, int k) const;
+    };
+
+} // namespace Ilvo
+} // namespace Utils
+} // namespace Geometry
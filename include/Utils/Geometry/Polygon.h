@@ -18,6 +18,7 @@
 #include <Utils/Geometry/Geometry.h>
 #include <Utils/Geometry/Line.h>
 #include <Utils/Settings/State.h>
+#include <Utils/Geometry/UtmProjection.h>
 
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
@@ -44,13 +45,16 @@ namespace Geometry {
         // virtual functions of Geometry
         Point center() const;
         double distance(const Point& p) const;
-        void update(Settings::TransformMatrix matrix, double width, double height);
-        void update(Settings::TransformMatrix matrix, double width, double up, double down);
+        void update(const Settings::TransformMatrix& matrix, double width, double height);
+        void update(const Settings::TransformMatrix& matrix, double width, double up, double down);
+        /** @brief Set the 4 corners of a rectangle, the columns, and close it; the points are overwritten in place */
+        void update(const Eigen::Matrix<double, 2, 4>& corners);
 
         const bgPolygon2D& geometry() const;
         nlohmann::json toJson() const;
 
         void contour(std::vector<std::vector<double>>& robotLatLng, std::vector<std::vector<double>>& robotXY, int zone=-1) const;
+        void contour(std::vector<std::vector<double>>& robotLatLng, std::vector<std::vector<double>>& robotXY, const LocalTangentPlane& plane) const;
     };
 
     inline std::ostream & operator<<(std::ostream & Str, Polygon& polygon) { 
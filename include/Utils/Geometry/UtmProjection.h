@@ -0,0 +1,103 @@
+/**
+ * @file UtmProjection.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Batch conversion between UTM and latitude/longitude
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+
+namespace Ilvo {
+namespace Utils {
+namespace Geometry {
+
+    /**
+     * @brief UTM projection of one zone
+     *
+     * @details Same series as the scalar routines in ThirdParty/UTM.hpp, but the ellipsoid and zone constants are
+     * computed once and the conversions work on arrays (x[], y[] -> lat[], lon[]) without branches or pow calls,
+     * so the compiler can vectorise the loops. Latitude and longitude are in degrees.
+     */
+    class UtmProjection
+    {
+    private:
+        int zone;
+        bool southhemi;
+        /** @brief Longitude of the central meridian [rad] */
+        double lambda0;
+        /** @brief Second eccentricity squared */
+        double ep2;
+        /** @brief Coefficients of the arc length of the meridian */
+        double alpha, beta, gamma, delta, epsilon;
+        /** @brief Coefficients of the footpoint latitude */
+        double alpha_, beta_, gamma_, delta_, epsilon_;
+    public:
+        UtmProjection(int zone, bool southhemi=false);
+        ~UtmProjection() = default;
+
+        /**
+         * @brief Get the cached projection of a zone (northern hemisphere)
+         *
+         * @param zone UTM zone in [1, 60]
+         * @return const UtmProjection&
+         */
+        static const UtmProjection& get(int zone);
+        /** @brief UTM zone of a longitude (degrees) */
+        static int zoneOf(double lon);
+        /** @brief Check if the zone is a valid UTM zone */
+        static bool isValidZone(int zone);
+
+        int getZone() const;
+
+        /** @brief Convert n UTM coordinates to latitude/longitude (degrees) */
+        void toLatLon(const double* x, const double* y, double* lat, double* lon, size_t n) const;
+        /** @brief Convert n latitude/longitude (degrees) coordinates to UTM */
+        void toUtm(const double* lat, const double* lon, double* x, double* y, size_t n) const;
+
+        void toLatLon(double x, double y, double& lat, double& lon) const;
+        void toUtm(double lat, double lon, double& x, double& y) const;
+    };
+
+    /**
+     * @brief Local tangent plane approximation of the UTM to latitude/longitude conversion
+     *
+     * @details Second order expansion around an origin, valid within a radius. The maximal error within the radius
+     * is measured against the exact projection at construction, points outside the radius or an approximation
+     * above the tolerance fall back on the exact projection. Suited for robot and implement contours that span
+     * a few meters around the robot.
+     */
+    class LocalTangentPlane
+    {
+    private:
+        const UtmProjection& projection;
+        double x0, y0;
+        double radius;
+        double lat0, lon0;
+        /** @brief Coefficients of d = c[0]*dx + c[1]*dy + c[2]*dx^2 + c[3]*dx*dy + c[4]*dy^2 */
+        double cLat[5], cLon[5];
+        /** @brief Maximal error within the radius [m] */
+        double maxError;
+        bool valid;
+    public:
+        LocalTangentPlane(const UtmProjection& projection, double x0, double y0, double radius=100.0, double tolerance=1e-3);
+        ~LocalTangentPlane() = default;
+
+        /** @brief True if the approximation is within the tolerance */
+        bool isValid() const;
+        /** @brief Maximal error within the radius [m] */
+        double getMaxError() const;
+
+        /** @brief Convert n UTM coordinates to latitude/longitude (degrees) */
+        void toLatLon(const double* x, const double* y, double* lat, double* lon, size_t n) const;
+    };
+
+} // namespace Ilvo
+} // namespace Utils
+} // namespace Geometry
@@ -0,0 +1,162 @@
+/**
+ * @file LatencyTrace.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Latency tracing of a GNSS fix through the core processes
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include <boost/filesystem.hpp>
+#include <ThirdParty/json.hpp>
+
+
+namespace Ilvo {
+namespace Utils {
+namespace Logging {
+
+    const size_t TRACE_SPAN_CAPACITY = 2048;
+    const size_t TRACE_LATENCY_WINDOW = 1024;
+    /** @brief Upper bounds of the buckets of the latency histogram [ms], the last bucket is unbounded */
+    const std::vector<double> TRACE_LATENCY_BUCKETS = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000};
+
+    /**
+     * @brief Monotonic time [us] of the trace spans
+     *
+     * @details The steady clock of Linux (CLOCK_MONOTONIC) is shared by the processes of the host, so the stamps of the
+     * processes can be compared. It is the real time, also when the control loops run on a virtual clock.
+     */
+    int64_t traceNow();
+    int64_t traceTime(std::chrono::steady_clock::time_point t);
+
+    /**
+     * @brief Trace context of a GNSS fix
+     *
+     * @details The context is attached to the fix by its source (the GPS device or the simulation) and carried with
+     * the states and variables derived from it: 'trace' of the 'gps.raw.state' json and the 'pc.navigation.trace'
+     * variable written with the navigation control variables.
+     */
+    struct TraceContext
+    {
+        /** @brief Sequence number of the fix, 0 without a trace */
+        int64_t seq = 0;
+        /** @brief Time the fix was received [us], see traceNow */
+        int64_t stamp = 0;
+
+        bool valid() const { return seq > 0; }
+        bool operator==(const TraceContext& other) const { return seq == other.seq && stamp == other.stamp; }
+
+        nlohmann::json toJson() const;
+        /** @brief Context of a json object with 'seq' and 'stamp', invalid if they are missing */
+        static TraceContext fromJson(const nlohmann::json& j);
+        /** @brief Compact form "<seq>:<stamp>" for a string variable */
+        std::string toString() const;
+        static TraceContext fromString(const std::string& s);
+    };
+
+    /** @brief Flow of a span in the trace of a fix, links the spans of the processes in the trace viewer */
+    enum class TraceFlow {BEGIN, STEP, END};
+
+    /**
+     * @brief Latency tracer of a process
+     *
+     * @details Records a span per fix handled by the process and the age of the fix at the end of the span.
+     * The spans are kept in a ring buffer and written in the Chrome trace (Perfetto) json format to
+     * `$ILVO_PATH/logs/<name>.trace.json`, on demand with flush or periodically by the export thread. The files of the
+     * processes share the monotonic clock, their 'traceEvents' can be concatenated into one trace, the flow events follow
+     * a fix from the GPS to the PLC. The ages of the last TRACE_LATENCY_WINDOW fixes form the rolling latency histogram.
+     */
+    class LatencyTracer
+    {
+    private:
+        struct Span
+        {
+            std::string name;
+            TraceContext trace;
+            int64_t start;
+            int64_t end;
+            TraceFlow flow;
+        };
+
+        std::string name;
+        boost::filesystem::path traceDir;
+        int pid;
+        int tid;
+
+        /** @brief Ring buffer of the spans, next is the position of the next span */
+        std::vector<Span> spans;
+        size_t next;
+        size_t count;
+        bool unwritten;
+
+        /** @brief Ring buffer of the ages of the fixes [us] */
+        std::vector<int64_t> ages;
+        size_t nextAge;
+        size_t countAge;
+
+        /** @brief Guards the ring buffers and the export error, the export thread reads them */
+        mutable std::mutex spanMutex;
+        /** @brief Last failed write of the trace file, empty if none */
+        std::string exportError;
+        std::thread exporter;
+        std::condition_variable exportWake;
+        bool exporting;
+
+        /** @brief Copy of the spans of the buffer from old to new, the lock is held */
+        std::vector<Span> orderedSpans() const;
+        /** @brief Spans in the Chrome trace json format, from old to new */
+        nlohmann::json toChromeTrace(const std::vector<Span>& ordered) const;
+    public:
+        LatencyTracer(std::string name, size_t capacity = TRACE_SPAN_CAPACITY, size_t window = TRACE_LATENCY_WINDOW);
+        LatencyTracer(const LatencyTracer& other) = delete;  // delete copy constructor
+        ~LatencyTracer();
+
+        /**
+         * @brief Record the span of a fix in this process
+         *
+         * @param spanName name of the span, e.g. the process name
+         * @param trace trace context of the fix
+         * @param start start of the span [us]
+         * @param end end of the span [us], the age of the fix is end - trace.stamp
+         * @param flow position of the process in the trace of the fix
+         */
+        void record(const std::string& spanName, const TraceContext& trace, int64_t start, int64_t end, TraceFlow flow = TraceFlow::STEP);
+        /** @brief Number of fixes in the latency window */
+        size_t samples() const;
+
+        /**
+         * @brief Rolling latency histogram of the ages of the last fixes
+         *
+         * @return json with 'count', 'p50', 'p90', 'p99' and 'max' [ms] and 'buckets', the counts per TRACE_LATENCY_BUCKETS upper bound
+         */
+        nlohmann::json histogram() const;
+        /** @brief Spans in the Chrome trace json format */
+        nlohmann::json toChromeTrace() const;
+        boost::filesystem::path getFilePath() const;
+        /**
+         * @brief Write the spans to the trace file if spans were recorded since the previous write
+         *
+         * @return false: the file could not be written, see takeExportError
+         */
+        bool flush();
+        /** @brief Write the trace file every period in a thread of the tracer, the last spans are written when it stops */
+        void startExport(std::chrono::milliseconds period);
+        void stopExport();
+        /** @brief Error of the last failed write, empty if none, the error is cleared */
+        std::string takeExportError();
+    };
+
+}
+}
+}
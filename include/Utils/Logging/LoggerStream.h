@@ -15,6 +15,7 @@
 #include <ctime>
 #include <iomanip>
 #include <map>
+#include <mutex>
 #include <iostream>
 #include <memory>
 
@@ -46,6 +47,8 @@ namespace Logging {
         std::string fName;
         boost::filesystem::path logDir;
         std::ofstream fstream;
+        /** @brief Guards the file and terminal output, e.g. the traject publisher logs beside the control thread */
+        std::mutex streamMutex;
 
         bool terminalOutput;
 
@@ -58,6 +61,8 @@ namespace Logging {
 
         // static instance wich will point to the instance of this class
         static std::shared_ptr<LoggerStream> instancePtr;
+        /** @brief Instance of a thread that runs a core loop in the monolith, the process instance if null */
+        static thread_local std::shared_ptr<LoggerStream> threadInstancePtr;
 
         void setFileName();
     public:
@@ -66,6 +71,8 @@ namespace Logging {
         ~LoggerStream();
 
         static void createInstance(std::string name, bool terminalOutput = false);
+        /** @brief Log the calling thread to its own file, e.g. a core loop of the monolith to the file of its process */
+        static void createThreadInstance(std::string name, bool terminalOutput = false);
         /**
          * @brief Get the Instance object
          * 
@@ -77,6 +84,7 @@ namespace Logging {
         
         template<typename T>
         LoggerStream& operator<< (const T& s) {
+            std::lock_guard<std::mutex> lock(streamMutex);
             fstream << s;
             fstream.flush();
             if (terminalOutput) std::cout << s;
@@ -0,0 +1,161 @@
+/**
+ * @file Metrics.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Prometheus metrics of the process and their HTTP endpoint
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <functional>
+
+#include <ThirdParty/json.hpp>
+
+
+namespace Ilvo {
+namespace Utils {
+namespace Logging {
+
+    /** @brief Labels of a metric, e.g. {{"process", "ilvo-navigation"}} */
+    typedef std::vector<std::pair<std::string, std::string>> MetricLabels;
+
+    /** @brief Bounds of the latency histograms [s], from 100 us to 1 s */
+    const std::vector<double> METRIC_LATENCY_BUCKETS = {0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0};
+
+    /** @brief Monotonically increasing counter */
+    class MetricCounter
+    {
+    private:
+        std::atomic<uint64_t> value{0};
+    public:
+        inline void inc(uint64_t n = 1) { value.fetch_add(n, std::memory_order_relaxed); }
+        uint64_t get() const { return value.load(std::memory_order_relaxed); }
+    };
+
+    /** @brief Value that goes up and down */
+    class MetricGauge
+    {
+    private:
+        std::atomic<double> value{0.0};
+    public:
+        inline void set(double v) { value.store(v, std::memory_order_relaxed); }
+        double get() const { return value.load(std::memory_order_relaxed); }
+    };
+
+    /** @brief Histogram with fixed bucket bounds, the counts are per bucket and summed when rendered */
+    class MetricHistogram
+    {
+    private:
+        std::vector<double> bounds;
+        /** @brief Count per bound and a last bucket for +Inf */
+        std::unique_ptr<std::atomic<uint64_t>[]> counts;
+        std::atomic<double> sum{0.0};
+    public:
+        MetricHistogram(const std::vector<double>& bounds);
+
+        inline void observe(double v) {
+            size_t i = 0;
+            while (i < bounds.size() && v > bounds[i]) i++;
+            counts[i].fetch_add(1, std::memory_order_relaxed);
+            // fetch_add of a floating point atomic is C++20
+            double current = sum.load(std::memory_order_relaxed);
+            while (!sum.compare_exchange_weak(current, current + v, std::memory_order_relaxed)) {}
+        }
+        const std::vector<double>& getBounds() const { return bounds; }
+        /** @brief Cumulative counts per bound, the last is the total count */
+        std::vector<uint64_t> cumulativeCounts() const;
+        double getSum() const { return sum.load(std::memory_order_relaxed); }
+    };
+
+    /**
+     * @brief Registry of the metrics of the process
+     *
+     * @details The metrics are registered once, e.g. when a variable manager is constructed or in a function local
+     * static, and updated on the hot path with relaxed atomic operations: an update does not lock or allocate.
+     * Registering a metric with the name and labels of an existing metric returns the existing one, so the core loops of
+     * the monolith share the metrics without a label of their own. The registry is rendered in the Prometheus text
+     * exposition format.
+     */
+    class MetricsRegistry
+    {
+    private:
+        enum class Type {COUNTER, GAUGE, HISTOGRAM};
+        struct Family
+        {
+            std::string help;
+            Type type;
+            std::vector<std::pair<MetricLabels, std::shared_ptr<void>>> metrics;
+        };
+
+        std::mutex mutex;
+        /** @brief Metric families by name, in the order of the name */
+        std::map<std::string, Family> families;
+
+        template<typename T>
+        T& add(const std::string& name, const std::string& help, Type type, const MetricLabels& labels, std::function<std::shared_ptr<T>()> create);
+        static std::string labelString(const MetricLabels& labels, const std::string& extra = "");
+    public:
+        MetricsRegistry() = default;
+        MetricsRegistry(const MetricsRegistry& other) = delete;
+
+        static MetricsRegistry& getInstance();
+
+        MetricCounter& counter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+        MetricGauge& gauge(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+        MetricHistogram& histogram(const std::string& name, const std::string& help, const MetricLabels& labels = {},
+                                   const std::vector<double>& bounds = METRIC_LATENCY_BUCKETS);
+
+        /** @brief All metrics in the Prometheus text exposition format (version 0.0.4) */
+        std::string render();
+    };
+
+    /**
+     * @brief HTTP endpoint of the metrics registry
+     *
+     * @details Serves `GET /metrics` in its own thread. The port of a process is set in config.json, e.g.
+     * `"protocols": {"metrics": {"ilvo-navigation": 9102, "ilvo-monolith": 9100}}`, processes without a port have no
+     * endpoint.
+     */
+    class MetricsServer
+    {
+    private:
+        int listenFd;
+        int wakePipe[2];
+        int port;
+        std::thread thread;
+
+        static std::unique_ptr<MetricsServer> instancePtr;
+        static std::mutex instanceMutex;
+
+        void run();
+        void serve(int client);
+    public:
+        /** @param port: port to listen on, 0 for a free port */
+        MetricsServer(int port);
+        MetricsServer(const MetricsServer& other) = delete;
+        ~MetricsServer();
+
+        int getPort() const;
+
+        /**
+         * @brief Start the endpoint of the process once, with the port of 'protocols.metrics' of the process
+         *
+         * @return true the endpoint runs, also when it was started before, e.g. by the monolith
+         */
+        static bool start(const nlohmann::ordered_json& protocols, const std::string& processName);
+    };
+
+}
+}
+}
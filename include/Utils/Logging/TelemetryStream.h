@@ -0,0 +1,135 @@
+/**
+ * @file TelemetryStream.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Binary telemetry stream for high rate control loop signals
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <cstdint>
+#include <memory>
+
+#include <boost/filesystem.hpp>
+
+
+namespace Ilvo {
+namespace Utils {
+namespace Logging {
+
+    const int TELEMETRY_FILE_MAX_SIZE = 50 * 1024 * 1024;  // 50 MB
+    const size_t TELEMETRY_BLOCK_SIZE = 250;  // 5 seconds at the default 20 ms tick
+    const char TELEMETRY_MAGIC[8] = {'I', 'L', 'V', 'O', 'T', 'L', 'M', '1'};
+
+    /** @brief Storage type of a telemetry channel. */
+    enum TelemetryType : uint8_t {
+        FLOAT64,
+        INT32,
+        BOOL
+    };
+
+    /** @brief Telemetry channel (column) of the fixed schema. */
+    struct TelemetryChannel {
+        std::string name;
+        TelemetryType type;
+    };
+
+    /**
+     * @brief Binary telemetry stream
+     *
+     * @details Records one row per tick with a fixed schema of channels to `$ILVO_PATH/logs/<name>.tlm`.
+     * Rows are buffered column wise and written per block, so recording a tick is a few stores in memory.
+     *
+     * File layout (little endian):
+     * - header: magic "ILVOTLM1", uint32 channel count, per channel: uint8 type, uint16 name length, name
+     * - block: uint32 row count, int64 timestamps [us since epoch], per channel a column of row count values
+     *
+     * When the file exceeds TELEMETRY_FILE_MAX_SIZE it is moved to `<name>.tlm1` and a new file is started.
+     */
+    class TelemetryStream
+    {
+    private:
+        std::string fName;
+        boost::filesystem::path telemetryDir;
+        std::ofstream fstream;
+
+        std::vector<TelemetryChannel> channels;
+        size_t blockSize;
+
+        /** @brief Values of the row that is being recorded */
+        std::vector<double> row;
+        /** @brief Buffered timestamps of the current block */
+        std::vector<int64_t> timestamps;
+        /** @brief Buffered columns of the current block */
+        std::vector<std::vector<double>> columns;
+
+        void open();
+        void rotate();
+        void writeHeader();
+    public:
+        TelemetryStream(std::string name, std::vector<TelemetryChannel> channels, size_t blockSize = TELEMETRY_BLOCK_SIZE);
+        TelemetryStream(const TelemetryStream& other) = delete;  // delete copy constructor
+        ~TelemetryStream();
+
+        /**
+         * @brief Get the index of a channel, use it to set values without a name lookup
+         *
+         * @param name name of the channel
+         * @return size_t index in the schema
+         */
+        size_t channel(const std::string& name) const;
+        const std::vector<TelemetryChannel>& getChannels() const;
+        boost::filesystem::path getFilePath() const;
+
+        /** @brief Set a value of the current row */
+        template<typename T>
+        inline void set(size_t channel, T value) {
+            row[channel] = static_cast<double>(value);
+        }
+        /** @brief Append the current row to the block, the block is written when it is full */
+        void commit();
+        /** @brief Write the buffered rows to the file */
+        void flush();
+    };
+
+    /**
+     * @brief Reader of telemetry files
+     *
+     * @details Used to convert the binary telemetry files offline.
+     */
+    class TelemetryReader
+    {
+    private:
+        std::ifstream fstream;
+        std::vector<TelemetryChannel> channels;
+    public:
+        TelemetryReader(boost::filesystem::path path);
+        ~TelemetryReader() = default;
+
+        const std::vector<TelemetryChannel>& getChannels() const;
+
+        /**
+         * @brief Read the next block of the file
+         *
+         * @param timestamps timestamps of the rows [us since epoch]
+         * @param columns values per channel
+         * @return true a block is read
+         * @return false end of the file
+         */
+        bool readBlock(std::vector<int64_t>& timestamps, std::vector<std::vector<double>>& columns);
+        /** @brief Write the whole file as csv, one row per tick */
+        void toCsv(std::ostream& out);
+    };
+
+    typedef std::shared_ptr<TelemetryStream> TelemetryStreamPtr;
+
+}
+}
+}
@@ -12,6 +12,7 @@
 
 #include <Utils/Nmea/Nmea.h>
 #include <vector>
+#include <chrono>
 
 namespace Ilvo {
 namespace Utils {
@@ -29,6 +30,9 @@ namespace Nmea {
         bool updated_hrp = false;
         bool updated_hdt = false;
 
+        /** @brief Time the GGA line (the fix) was received */
+        std::chrono::steady_clock::time_point received;
+
         NmeaMessagePack() = default;
         ~NmeaMessagePack() = default;
         NmeaMessagePack(const NmeaMessagePack& other);
@@ -0,0 +1,110 @@
+/**
+ * @file MpcController.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Model predictive path tracker
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace Ilvo {
+namespace Utils {
+namespace Pid {
+
+    /** @brief Horizon lengths of the MPC, a fixed-size QP is compiled for each */
+    const std::vector<int> MPC_HORIZONS = {10, 20, 30, 40};
+
+    /** @brief Weights, limits and compute budget of the MPC */
+    struct MpcSettings
+    {
+        /** @brief Step time of the prediction [s] */
+        double dt = 0.1;
+        /** @brief Weight of the lateral error [1/m^2] */
+        double qLateral = 1.0;
+        /** @brief Weight of the heading error [1/rad^2] */
+        double qHeading = 0.5;
+        /** @brief Weight of the angular velocity [s^2/rad^2] */
+        double rAngular = 0.05;
+        /** @brief Weight of the change of the angular velocity between steps [s^2/rad^2] */
+        double rRate = 0.5;
+        /** @brief Limit of the angular velocity [rad/s] */
+        double maxAngular = 0.5;
+        /** @brief Compute budget of a solve */
+        std::chrono::microseconds budget{2000};
+        /** @brief Iteration limit of the projected gradient method */
+        int maxIterations = 500;
+        /** @brief Convergence tolerance on the angular velocities [rad/s] */
+        double tolerance = 1e-5;
+
+        bool operator==(const MpcSettings& other) const {
+            return dt == other.dt && qLateral == other.qLateral && qHeading == other.qHeading && rAngular == other.rAngular &&
+                   rRate == other.rRate && maxAngular == other.maxAngular && budget == other.budget &&
+                   maxIterations == other.maxIterations && tolerance == other.tolerance;
+        }
+    };
+
+    /** @brief Solution of the MPC */
+    struct MpcResult
+    {
+        /** @brief The solve converged within the budget, the angular velocity can be applied */
+        bool valid = false;
+        /** @brief Angular velocity of the first step [rad/s] */
+        double angular = 0.0;
+        /** @brief Iterations of the projected gradient method, 0 if the unconstrained solution is within the limits */
+        int iterations = 0;
+        /** @brief Compute time of the solve [us] */
+        double solveTime = 0.0;
+    };
+
+    /**
+     * @brief Model predictive path tracker of a robot that steers with its angular velocity
+     *
+     * @details The error of the robot to the path (lateral error e and heading error h) is predicted with the
+     * kinematic model linearized at the path
+     *     e[k+1] = e[k] + v dt h[k] + v dt^2/2 (w[k] - v c[k])
+     *     h[k+1] = h[k] + dt (w[k] - v c[k])
+     * with the angular velocity w as input and the curvature c of the path ahead of the robot. The quadratic cost of the
+     * errors and the angular velocities over the horizon is condensed into a QP in the angular velocities with a box
+     * constraint on the angular velocity. The QP has a fixed size per horizon and is solved without allocations: the
+     * unconstrained solution (Cholesky) when it is within the limits, the accelerated projected gradient method else.
+     * The gradient method warm starts from the previous solution shifted by one step and stops when the compute budget
+     * is spent, the result is then invalid and the caller falls back on another controller.
+     */
+    class MpcController
+    {
+    public:
+        virtual ~MpcController() = default;
+
+        /** @brief MPC of the horizon, one of MPC_HORIZONS */
+        static std::unique_ptr<MpcController> create(int horizon);
+
+        virtual int getHorizon() const = 0;
+        virtual void setSettings(const MpcSettings& settings) = 0;
+        virtual const MpcSettings& getSettings() const = 0;
+
+        /**
+         * @brief Solve the MPC
+         *
+         * @param lateral lateral error [m], positive left of the path
+         * @param heading heading error [rad], positive counterclockwise of the path
+         * @param velocity longitudinal velocity [m/s]
+         * @param curvature curvature of the path per step of the horizon [1/m], positive to the left, getHorizon() values
+         * @return the angular velocity of the first step
+         */
+        virtual MpcResult solve(double lateral, double heading, double velocity, const double* curvature) = 0;
+        /** @brief Angular velocity applied instead of the solution, e.g. by the fallback, the rate cost of the next solve starts from it */
+        virtual void applied(double angular) = 0;
+        /** @brief Forget the previous solution, e.g. when the path changes */
+        virtual void reset() = 0;
+    };
+
+}
+}
+}
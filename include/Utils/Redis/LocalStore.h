@@ -0,0 +1,117 @@
+/**
+ * @file LocalStore.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief In-process key value store
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ThirdParty/json.hpp>
+
+
+namespace Ilvo {
+namespace Utils {
+namespace Redis {
+
+    /**
+     * @brief In-process replacement of the Redis server
+     *
+     * @details Holds the string and json variables of the processes that share it, with the subset of commands
+     * used by the RedisStream (GET, SET, MGET, MSET, HMGET, HGETALL, HSET, DEL, TYPE, KEYS, JSON.GET, JSON.SET, PUBLISH, SUBSCRIBE, PSUBSCRIBE).
+     * Used when several variable managers run in one process, e.g. in the simulation engine.
+     * Subscriber callbacks are called synchronously by publish. Writes publish keyspace notifications 
+     * ('__keyspace@0__:<key>') to the pattern subscribers, like a Redis server with 'notify-keyspace-events K$hgd'.
+     * The change and publish hooks follow the writes and messages without the matching of the pattern subscribers.
+     */
+    class LocalStore
+    {
+    private:
+        std::mutex mutex;
+        std::unordered_map<std::string, std::string> values;
+        std::unordered_map<std::string, nlohmann::json> jsonValues;
+        std::unordered_map<std::string, std::unordered_map<std::string, std::string>> hashValues;
+        std::map<std::string, std::vector<std::function<void(const std::string_view&)>>> subscribers;
+
+        struct PatternSubscriber
+        {
+            int id;
+            std::string pattern;
+            std::function<void(const std::string& channel, const std::string_view& message)> callback;
+        };
+        std::vector<PatternSubscriber> patternSubscribers;
+        int nextPatternId = 0;
+
+        std::function<void(const std::string& key)> changeHook;
+        std::function<void(const std::string& channel, const std::string& message)> publishHook;
+
+        /** @brief Call the change hook and publish the keyspace notifications of written keys, called without the lock */
+        void notifyKeyspace(const std::vector<std::string>& keys, const std::string& event);
+        /** @brief Call the subscribers of a channel, returns the number of subscribers */
+        int deliver(const std::string& channel, const std::string& message);
+    public:
+        LocalStore() = default;
+        LocalStore(const LocalStore& other) = delete;
+        ~LocalStore() = default;
+
+        bool exists(const std::string& key);
+        /** @brief All keys (string, hash and json) */
+        std::vector<std::string> keys();
+        /** @brief Type of a key like the TYPE command: "string", "hash", "ReJSON-RL" or "none" */
+        std::string type(const std::string& key);
+        /** @brief Get a variable, empty string if the variable is nil */
+        std::string get(const std::string& key);
+        void set(const std::string& key, const std::string& value);
+        /** @brief Get multiple variables, nil variables are empty strings */
+        std::vector<std::string> mget(const std::vector<std::string>& keys);
+        /** @brief Get multiple variables into values from offset on, the strings of values keep their capacity, nil marks the missing ones */
+        void mget(const std::vector<std::string>& keys, std::vector<std::string>& values, std::vector<bool>& nil, size_t offset);
+        /** @brief Set multiple variables, the vector alternates keys and values */
+        void mset(const std::vector<std::string>& keyValues);
+        /** @brief Get multiple fields of a hash, nil fields are empty strings */
+        std::vector<std::string> hmget(const std::string& key, const std::vector<std::string>& fields);
+        /** @brief Get multiple fields of a hash into values from offset on, the strings of values keep their capacity, nil marks the missing ones */
+        void hmget(const std::string& key, const std::vector<std::string>& fields, std::vector<std::string>& values, std::vector<bool>& nil, size_t offset);
+        /** @brief All fields of a hash, alternating fields and values */
+        std::vector<std::string> hgetall(const std::string& key);
+        /** @brief Set multiple fields of a hash, the vector alternates fields and values */
+        void hset(const std::string& key, const std::vector<std::string>& fieldValues);
+        /** @brief Delete fields of a hash, the hash is deleted with its last field, returns the number of deleted fields */
+        int hdel(const std::string& key, const std::vector<std::string>& fields);
+        /** @brief Delete variables (string, hash and json), returns the number of deleted keys */
+        int del(const std::vector<std::string>& keys);
+
+        /** @brief Get a json variable, null if the variable does not exist */
+        nlohmann::json getJson(const std::string& key);
+        void setJson(const std::string& key, const nlohmann::json& value);
+
+        /** @brief Publish a message to the subscribers of a channel, returns the number of subscribers */
+        int publish(const std::string& channel, const std::string& message);
+        void subscribe(const std::string& channel, std::function<void(const std::string_view&)> callback);
+        void unsubscribe(const std::string& channel);
+        /** @brief Subscribe the channels matching a glob-style pattern, returns the id of the subscription */
+        int psubscribe(const std::string& pattern, std::function<void(const std::string& channel, const std::string_view& message)> callback);
+        void punsubscribe(int id);
+
+        /** @brief Called with the key of every write, without the lock, e.g. to mirror the store. Null removes the hook */
+        void setChangeHook(std::function<void(const std::string& key)> hook);
+        /** @brief Called with every published message, the keyspace notifications excluded. Null removes the hook */
+        void setPublishHook(std::function<void(const std::string& channel, const std::string& message)> hook);
+    };
+
+    typedef std::shared_ptr<LocalStore> LocalStorePtr;
+
+}
+}
+}
@@ -32,30 +32,54 @@ namespace Redis {
         /** @brief Buffer for control data */
         unsigned char *controlData;
 
-        // Count information
-        int byteCount;
-        int bitCount;
-        std::string previousEntity;
-
-        void resetCount();
-        void beginCount(VariablePtr var);
-        void endCount(VariablePtr var);
-
         // Plc
         std::unique_ptr<Plc> plcPtr;
 
+        /** @brief Data types of the PLC, the variable types are resolved once instead of in every cycle */
+        enum class PlcDataType {INT8, UINT8, INT16, UINT16, INT32, UINT32, FLOAT, LFLOAT, STRING, BOOL};
+        /** @brief Variable with its type and position in a data block of the PLC */
+        struct PlcField
+        {
+            VariablePtr var;
+            PlcDataType type;
+            int byte;
+            int bit;
+        };
+
         /** @brief Variables to monitor in the plc */
         std::vector<VariablePtr> plcMonitorVariables;
         /** @brief Variables to control in the plc */
         std::vector<VariablePtr> plcControlVariables;
+        std::vector<PlcField> plcMonitorFields;
+        std::vector<PlcField> plcControlFields;
         /** @brief Remaining variables (only in the pc) */
         std::vector<VariablePtr> pcVariables;
+        /** @brief Trace context of the fix of the control variables ('pc.navigation.trace'), null if not configured */
+        VariablePtr traceVariable;
+
+        /** @brief Metrics of the data block reads or writes */
+        struct PlcIoMetrics
+        {
+            Utils::Logging::MetricHistogram& duration;
+            Utils::Logging::MetricCounter& errors;
+            /** @brief Snap7 error code of the last failed read or write */
+            Utils::Logging::MetricGauge& errorCode;
+
+            /** @brief Metrics of the operation 'op', "read" or "write", registered at the first call */
+            static PlcIoMetrics of(const std::string& op);
+        };
+        PlcIoMetrics plcRead;
+        PlcIoMetrics plcWrite;
 
         /** @brief Summarize all variables and their bit and byte positions in the plc */
         void printRapport(Utils::Logging::LoggerStream& logger, std::vector<VariablePtr>& variables);
         void setSize(PlcType plcType);
+        static std::vector<PlcField> toFields(const std::vector<VariablePtr>& variables);
+        /** @brief Split the variables in monitor, control and pc variables */
+        void groupVariables();
     public:
         PlcVariableManager(std::string processName);
+        PlcVariableManager(std::string processName, std::shared_ptr<LocalStore> store);
         ~PlcVariableManager();
 
         /** @brief Write the control variables to the plc (these could be updated by the pc) */
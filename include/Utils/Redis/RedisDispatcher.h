@@ -0,0 +1,172 @@
+/**
+ * @file RedisDispatcher.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Multiplexed Redis pub/sub on a dedicated connection
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <Utils/Redis/LocalStore.h>
+
+#include <string>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <set>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
+
+namespace Ilvo {
+namespace Utils {
+namespace Redis {
+
+    /** @brief Message of a channel, the pattern is empty for a channel subscription */
+    struct RedisMessage
+    {
+        std::string pattern;
+        std::string channel;
+        std::string message;
+    };
+
+    typedef std::function<void(const RedisMessage&)> RedisMessageCallback;
+
+    /**
+     * @brief Bounded lock-free queue of messages, multiple producers and a single consumer
+     *
+     * @details The cells are reused, a warm queue allocates nothing for messages that fit in the strings of the cells.
+     */
+    class RedisMessageQueue
+    {
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            RedisMessage message;
+        };
+        std::unique_ptr<Cell[]> cells;
+        size_t mask;
+        std::atomic<size_t> enqueuePosition;
+        std::atomic<size_t> dequeuePosition;
+        std::atomic<size_t> dropped;
+    public:
+        /** @param capacity: rounded up to a power of two */
+        RedisMessageQueue(size_t capacity);
+
+        /** @brief Add a message, false and counted as dropped if the queue is full */
+        bool push(std::string_view pattern, std::string_view channel, std::string_view message);
+        /** @brief Take the oldest message queued before the position until, only called by the consumer */
+        bool pop(RedisMessage& message, size_t until = SIZE_MAX);
+        /** @brief Position after the last queued message */
+        size_t position() const;
+        /** @brief Number of dropped messages since the previous call */
+        size_t takeDropped();
+    };
+
+    /**
+     * @brief Redis pub/sub with a single dispatcher thread and callbacks at the tick boundary
+     *
+     * @details The subscriptions share one dedicated connection, the main connection of the RedisStream is never used
+     * for pub/sub. The dispatcher thread only queues the received messages. dispatch() calls the callbacks on the thread
+     * of the process, e.g. at the start of a tick, so the callbacks can use the variables without locking.
+     * When the connection drops the dispatcher reconnects and subscribes again. Messages may have been missed,
+     * so after every (re)connection each callback is called once with an empty message. The same happens at the
+     * dispatch after the queue was full and messages were dropped.
+     * On a LocalStore the messages of the store are queued the same way.
+     */
+    class RedisDispatcher
+    {
+    private:
+        std::string ip;
+        int port;
+        std::shared_ptr<LocalStore> store;
+
+        struct Subscription
+        {
+            int id;
+            bool isPattern;
+            std::string name;
+            RedisMessageCallback callback;
+        };
+        /** @brief Subscriptions, only used by the thread that calls subscribe and dispatch */
+        std::vector<Subscription> subscriptions;
+        int nextId;
+
+        /** @brief Shared with the callbacks of the local store, they can still be running when the dispatcher is destroyed */
+        std::shared_ptr<RedisMessageQueue> queue;
+        RedisMessage received;
+
+        std::thread thread;
+        std::atomic<bool> running;
+        std::atomic<bool> isConnected;
+        std::chrono::milliseconds reconnectPeriod;
+        std::mutex mutex;
+        std::condition_variable stopCondition;
+        /** @brief Channels and patterns of the connection and the commands to send, guarded by the mutex */
+        std::multiset<std::string> channels;
+        std::multiset<std::string> patterns;
+        std::vector<std::vector<std::string>> pendingCommands;
+        int wakeFd[2];
+        /** @brief Subscriptions of the local store per channel ('c:') or pattern ('p:') */
+        std::map<std::string, int> storeSubscriptions;
+
+        void start();
+        void run();
+        void request(std::vector<std::string> command);
+        int add(bool isPattern, const std::string& name, RedisMessageCallback callback);
+        /** @brief Call the callbacks of the subscriptions of the message, every callback for an empty message */
+        void deliver(const RedisMessage& message);
+    public:
+        /** @brief Dispatcher with its own connection to the Redis server, connected at the first subscription */
+        RedisDispatcher(std::string ip, int port, std::chrono::milliseconds reconnectPeriod = std::chrono::seconds(1));
+        /** @brief Dispatcher on an in-process store */
+        RedisDispatcher(std::shared_ptr<LocalStore> store);
+        ~RedisDispatcher();
+
+        RedisDispatcher(RedisDispatcher const&) = delete;
+        void operator=(RedisDispatcher const&) = delete;
+
+        /** @brief Subscribe a channel, returns the id of the subscription */
+        int subscribe(const std::string& channel, RedisMessageCallback callback);
+        /** @brief Subscribe the channels matching a glob-style pattern, returns the id of the subscription */
+        int psubscribe(const std::string& pattern, RedisMessageCallback callback);
+        void unsubscribe(int id);
+
+        /** 
+         * @brief Call the callbacks of the messages received since the previous dispatch, returns the number of messages 
+         * 
+         * @param until: only the messages queued before, see queued()
+         */
+        size_t dispatch(size_t until = SIZE_MAX);
+        /** 
+         * @brief Position of the queue after the last received message
+         * 
+         * @details A keyspace notification can arrive after the variables were read. Taking the position before reading
+         * and dispatching up to it afterwards calls the callbacks with values at least as new as the notifications.
+         */
+        size_t queued() const;
+        /** @brief Call every callback once with an empty message at the next dispatch, e.g. to poll without events */
+        void resync();
+
+        /** @brief The subscription connection is up, or the dispatcher runs on a local store */
+        bool connected() const;
+
+        /** @brief Pattern of the keyspace notifications of a key in any database, special glob characters are escaped */
+        static std::string keyspacePattern(const std::string& key);
+    };
+
+    typedef std::shared_ptr<RedisDispatcher> RedisDispatcherPtr;
+
+}
+}
+}
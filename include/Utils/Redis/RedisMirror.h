@@ -0,0 +1,116 @@
+/**
+ * @file RedisMirror.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Asynchronous mirror between an in-process store and the Redis server
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <Utils/Redis/LocalStore.h>
+#include <Utils/Redis/RedisStream.h>
+#include <Utils/Redis/RedisDispatcher.h>
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
+
+namespace Ilvo {
+namespace Utils {
+namespace Redis {
+
+    /**
+     * @brief Mirror of a LocalStore on the Redis server
+     *
+     * @details The core loops of the monolith share a LocalStore, the other clients of the robot (the system manager,
+     * the user interface, node-red, ...) use the Redis server. The mirror copies the keys written in the store to the
+     * server and the keys written by the other clients into the store, in its own thread so the core loops never wait
+     * on the network. The messages published in the store are published on the server.
+     *
+     * The writes of the other clients are followed with the keyspace notifications of the server. The notifications of
+     * the writes of the mirror itself are counted and skipped, and a key is only copied when its value differs from the
+     * value last exchanged, so the copies do not echo between the store and the server. Without keyspace notifications
+     * all keys of the server are read again every second. After a connection error the mirror connects again and
+     * writes all keys of the store to the server.
+     */
+    class RedisMirror
+    {
+    private:
+        std::shared_ptr<LocalStore> store;
+        nlohmann::json redis;
+        /** @brief Store in place of the Redis server, e.g. in the tests */
+        std::shared_ptr<LocalStore> server;
+        RedisStream rs;
+        RedisDispatcher dispatcher;
+        std::chrono::milliseconds period;
+        bool keyspaceEvents;
+
+        /** @brief Keys written and messages published in the store since the previous sync, guarded by the mutex */
+        std::mutex mutex;
+        std::unordered_set<std::string> dirty;
+        std::vector<std::pair<std::string, std::string>> published;
+
+        /** @brief Keys changed on the server since the previous sync, an empty key to read all keys */
+        std::vector<std::string> changed;
+        std::chrono::steady_clock::time_point lastPull;
+
+        std::thread thread;
+        std::atomic<bool> running;
+        std::condition_variable stopCondition;
+
+        /** @brief Type and value of a key of the store, empty if the key does not exist */
+        std::string storeValue(const std::string& key);
+        /** @brief Copy a key of the server into the store if it was changed */
+        void pullKey(const std::string& key);
+        /** @brief Follow the writes and messages of the store and the keyspace notifications of the server */
+        void init();
+        void run();
+    protected:
+        /** @brief Type and value of a key last exchanged between the store and the server */
+        std::unordered_map<std::string, std::string> mirrored;
+        /** @brief Keyspace notifications still to come of the keys written by the mirror */
+        std::unordered_map<std::string, int> echoes;
+
+        /** @brief Connect again after an error, the keys of the store overwrite those of the server */
+        void reconnect();
+    public:
+        /**
+         * @param store: store of the core loops
+         * @param redis: configuration of the Redis server, 'protocols.redis' of config.json
+         * @param period: period of the synchronisation
+         */
+        RedisMirror(std::shared_ptr<LocalStore> store, const nlohmann::json& redis, std::chrono::milliseconds period);
+        /**
+         * @param store: store of the core loops
+         * @param server: store in place of the Redis server
+         * @param period: period of the synchronisation
+         */
+        RedisMirror(std::shared_ptr<LocalStore> store, std::shared_ptr<LocalStore> server, std::chrono::milliseconds period);
+        virtual ~RedisMirror();
+
+        RedisMirror(RedisMirror const&) = delete;
+        void operator=(RedisMirror const&) = delete;
+
+        /** @brief Copy all keys of the server into the store, e.g. before the core loops start */
+        void pull();
+        /** @brief Copy the changes of the store to the server and the changes of the server to the store once */
+        void sync();
+        /** @brief Synchronise every period in a thread */
+        void start();
+        void stop();
+    };
+
+}
+}
+}
@@ -15,11 +15,12 @@
 #include <memory>
 #include <iomanip>
 #include <Utils/String/String.h>
+#include <Utils/Redis/LocalStore.h>
+#include <Utils/Redis/RespReader.h>
 #include <ThirdParty/json.hpp>
 #include <ThirdParty/redis-cpp/stream.h>
 #include <ThirdParty/redis-cpp/execute.h>
 #include <boost/algorithm/string/join.hpp>
-#include <boost/thread.hpp>
 
 
 namespace Ilvo {
@@ -30,6 +31,8 @@ namespace Redis {
      * @brief Redis client
      * 
      * @details This class is used to communicate with a Redis server, enabling reading and writing of single variables or json objects.
+     * When it is constructed on a LocalStore, the same commands are executed on the in-process store instead.
+     * Subscriptions are made with the RedisDispatcher, which has its own connection.
      */
     class RedisStream
     {
@@ -40,13 +43,24 @@ namespace Redis {
         int port;
         
         std::shared_ptr<std::iostream> stream;
+        /** @brief In-process store, replaces the Redis server if set */
+        std::shared_ptr<LocalStore> store;
 
-        std::map<std::string, std::pair<std::shared_ptr<boost::thread>, std::shared_ptr<std::atomic<bool>>>> subscriberThreads;
+        /** @brief Reused request, reader and local store values of the view reads */
+        std::string request;
+        RespReader reader;
+        std::vector<std::string> storeValues;
+        std::vector<bool> storeNil;
+        std::vector<std::string_view> storeViews;
+        const std::vector<std::string_view>& storeValueViews(size_t count);
+        /** @brief Replace the connection, e.g. when a reply was read partly and the next replies are out of step */
+        void dropConnection();
     public:
         RedisStream() = default;
         RedisStream(nlohmann::json j);
         RedisStream(std::string ip, int port);
-        ~RedisStream();
+        RedisStream(std::shared_ptr<LocalStore> store);
+        ~RedisStream() = default;
 
         /** @brief Checks if redis variable exists */
         bool isRedisValueNil(std::string name);
@@ -68,6 +82,11 @@ namespace Redis {
         {
             if (sizeof ... (args) != 2)  throw Exception::RedisCommandExectionException("Invalid number of arguments for GET");
             std::string cmd = "SET";
+            if (store) {
+                std::vector<std::string> v {(std::stringstream() << std::setprecision(10) << args).str() ...};
+                store->set(v[0], v[1]);
+                return false;
+            }
             auto response = rediscpp::execute(*(stream), cmd, (std::stringstream() << std::setprecision(10) << args).str() ... );
             // LoggerStream::getInstance() << DEBUG << "Redis: " << redisCmdToStr(cmd, (std::stringstream() << std::setprecision(10) << args).str() ... ) << std::endl;;
             return response.as_string().compare("OK") != 0;
@@ -75,13 +94,56 @@ namespace Redis {
 
         /** @brief set multiple redis variables based on a vector */
         bool setRedisValues(std::vector<std::string> values);
-        rediscpp::deserialization::array::items_type getRedisValues(std::vector<std::string> values);
+        /** @brief Get multiple redis variables, nil variables are empty strings */
+        std::vector<std::string> getRedisValues(std::vector<std::string> values);
+        /** 
+         * @brief Get fields of multiple redis hashes, nil fields are empty strings
+         * 
+         * @details The HMGET commands of all hashes are pipelined, the hashes are read in one round trip.
+         */
+        std::vector<std::vector<std::string>> getRedisHashValues(const std::vector<std::string>& keys, const std::vector<std::vector<std::string>>& fields);
+        /** 
+         * @brief Get multiple redis variables as views, nil variables are null views (data() is nullptr)
+         * 
+         * @details The reply is decoded in a reused buffer, a warm read allocates nothing. 
+         * The views are valid until the next view read on this stream. A string set to "" is an empty view that is
+         * not null.
+         */
+        const std::vector<std::string_view>& getRedisValueViews(const std::vector<std::string>& keys);
+        /** 
+         * @brief Get fields of multiple redis hashes as views, the fields of all hashes follow each other
+         * 
+         * @details The HMGET commands are pipelined and decoded like getRedisValueViews.
+         */
+        const std::vector<std::string_view>& getRedisHashValueViews(const std::vector<std::string>& keys, const std::vector<std::vector<std::string>>& fields);
+        /** 
+         * @brief Set fields of multiple redis hashes and flat redis variables
+         * 
+         * @details The HSET commands of the hashes with fields to set and the MSET of the flat variables are pipelined.
+         * @param keys: hash keys
+         * @param fieldValues: per hash, alternating fields and values
+         * @param flatValues: alternating keys and values of flat redis variables
+         * @return true if one of the commands failed
+         */
+        bool setRedisHashValues(const std::vector<std::string>& keys, const std::vector<std::vector<std::string>>& fieldValues, const std::vector<std::string>& flatValues);
+
+        /** @brief Type of a redis key: "string", "hash", "ReJSON-RL" or "none" */
+        std::string getRedisType(const std::string& key);
+        /** @brief Keys matching a glob-style pattern, iterated with SCAN so the server is not blocked */
+        std::vector<std::string> getRedisKeys(const std::string& pattern = "*");
+        /** @brief All fields of a redis hash, alternating fields and values sorted by field */
+        std::vector<std::string> getRedisHashAll(const std::string& key);
+        /** @brief Delete fields of a redis hash, returns the number of deleted fields */
+        int delRedisHashFields(const std::string& key, const std::vector<std::string>& fields);
 
         /** @brief Get one or multiple redis variables */
         template<typename ... Args>
         std::string getRedisValue(Args... args) { 
             if (sizeof ... (args) != 1) throw Exception::RedisCommandExectionException("Invalid number of arguments for GET");
             std::string cmd = "GET";  
+            if (store) {
+                return store->get(args ...);
+            }
             rediscpp::value response = rediscpp::execute(*(stream), cmd, args ...  );
             // LoggerStream::getInstance() << DEBUG << "Redis: " << redisCmdToStr(cmd, args ... ) << " - ";
             try {
@@ -98,6 +160,9 @@ namespace Redis {
         int delRedisValues(Args&& ... args)
         {
             std::string cmd = "DEL";  
+            if (store) {
+                return store->del({std::string(args) ...});
+            }
             auto response = rediscpp::execute(*(stream), cmd, args ... );
             return response.as_integer();
         }
@@ -113,16 +178,22 @@ namespace Redis {
         template <typename T>
         int publishRedisValue(std::string name, T value) {
             std::string valueStr = Utils::String::toRedisString<T>(value);
+            if (store) {
+                return store->publish(name, valueStr);
+            }
             auto response = rediscpp::execute(*(stream), "PUBLISH", name, valueStr);
             return response.as<int>();
         }
 
-        /** @brief Subscribe a redis variable */
-        void subscribeRedisValue(std::string& name, std::function<void(const std::string_view&)>& callback);
-        /** @brief Unsubscribe a redis variable */
-        void detachSubscribeRedisValue(std::string& name);
-        /** @brief clear subscription record */
-        void unsubscribeRedisValue(std::string& name);
+        /**
+         * @brief Enable the keyspace notifications of the server, used by the RedisDispatcher
+         *
+         * @details Adds the keyspace channels of the string, hash, generic and module (RedisJSON) events to
+         * notify-keyspace-events (K$hgd, K$hg on servers before 7.0), the other event classes are left as they are.
+         *
+         * @return false if the configuration of the server can not be changed
+         */
+        bool enableKeyspaceEvents();
     };
 
 }
@@ -0,0 +1,77 @@
+/**
+ * @file RespReader.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Allocation free RESP encoding and decoding of bulk variable reads
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iostream>
+
+
+namespace Ilvo {
+namespace Utils {
+namespace Redis {
+
+    /**
+     * @brief RESP reader of array replies over a reusable receive buffer
+     *
+     * @details The elements of the array replies (e.g. of MGET and HMGET) are copied into one buffer and handed out as
+     * string views. The buffers keep their capacity, so reading the same variable table again allocates nothing.
+     * The views are valid until the next begin().
+     */
+    class RespReader
+    {
+    private:
+        /** @brief Received elements, back to back */
+        std::string buffer;
+        /** @brief Offset and length of the elements in the buffer, length npos for nil elements */
+        std::vector<std::pair<size_t, size_t>> spans;
+        std::vector<std::string_view> views;
+        /** @brief Header line of the current reply */
+        std::string line;
+
+        void readLine(std::istream& is);
+        /** @brief Read the elements of the array reply whose header is the current line */
+        size_t readElements(std::istream& is);
+    public:
+        RespReader() = default;
+
+        /** @brief Start reading a new batch of replies */
+        void begin();
+        /**
+         * @brief Read an array reply of bulk strings and append its elements
+         *
+         * @return the number of elements of the array
+         * @throws RedisErrorReplyException on an error reply, RedisCommandExectionException on an unexpected reply type
+         */
+        size_t readArray(std::istream& is);
+        /**
+         * @brief Read the array replies of count pipelined commands and append their elements
+         *
+         * @details An error reply (e.g. WRONGTYPE) is thrown after the replies of all commands are read, the connection
+         * stays in step with the commands.
+         * @return the number of elements of the arrays
+         * @throws RedisErrorReplyException on the first error reply, RedisCommandExectionException on an unexpected reply
+         * type, the following replies are then not read
+         */
+        size_t readArrays(std::istream& is, size_t count);
+        /** @brief Elements of the replies since begin(), nil elements are null views, empty strings are empty views that are not null */
+        const std::vector<std::string_view>& values();
+
+        /** @brief Append a command with its arguments to a RESP request, e.g. MGET of keys */
+        static void appendCommand(std::string& request, std::string_view cmd, const std::vector<std::string>& args);
+        /** @brief Append a command on a key with its arguments to a RESP request, e.g. HMGET of a key and fields */
+        static void appendCommand(std::string& request, std::string_view cmd, std::string_view key, const std::vector<std::string>& args);
+    };
+
+}
+}
+}
@@ -0,0 +1,96 @@
+/**
+ * @file TrajectPublisher.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Publication of the encoded traject to Redis in a thread of its own
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <Utils/Redis/LocalStore.h>
+#include <Utils/Settings/Traject.h>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+
+
+namespace Ilvo {
+namespace Utils {
+namespace Redis {
+
+    /**
+     * @brief Writes the traject to Redis as encoded paths (see Geometry::PathEncoder)
+     *
+     * @details publish() copies the point vectors of the traject and returns, the thread of the publisher encodes them
+     * once and writes them on a connection of its own. The json 'traject' holds the encoded raw points, corners,
+     * geofence and skeletons and the layout of the interpolations. The interpolations are split in chunks of at most
+     * chunkSize points, 'traject.linear.<version>.<i>' and 'traject.curvy.<version>.<i>', every chunk is relative to the
+     * origin so it decodes on its own:
+     *
+     *     {"name": "blok3", "version": 2, "precision": 3, "origin": {"x": ..., "y": ...}, "interpolation": "curvy",
+     *      "raw": "...", "corners": "...", "geofence": "...",
+     *      "linear": {"points": 51200, "chunks": 13, "skeleton": "..."}, "curvy": {...}}
+     *
+     * The chunks are written before the json, and the version is published on the channel 'traject' after it. A client
+     * never reads the chunks of another version than its json: the chunks of the previous version are kept until the
+     * next one is written, older ones are deleted. The versions continue the version of the json of a previous run.
+     * A change of the current interpolation only rewrites the json.
+     */
+    class TrajectPublisher
+    {
+    private:
+        std::string ip;
+        int port;
+        std::shared_ptr<LocalStore> store;
+        size_t chunkSize;
+
+        /** @brief Copy of the traject to encode */
+        struct Snapshot
+        {
+            std::string name;
+            std::vector<Geometry::PointPtr> raw, corners, geofence;
+            std::vector<Geometry::PointPtr> skeleton[2], interpolation[2];
+        };
+
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+        bool stopping;
+        bool busy;
+        /** @brief Latest traject to publish, an older one that was not taken yet is dropped */
+        std::unique_ptr<Snapshot> pending;
+        /** @brief Current interpolation to publish, guarded by the mutex */
+        Settings::InterpolationType interpolationType;
+        bool interpolationChanged;
+
+        void run();
+    public:
+        /** @brief Publisher with its own connection to the Redis server */
+        TrajectPublisher(std::string ip, int port, size_t chunkSize = 4096);
+        /** @brief Publisher on an in-process store */
+        TrajectPublisher(std::shared_ptr<LocalStore> store, size_t chunkSize = 4096);
+        ~TrajectPublisher();
+
+        TrajectPublisher(TrajectPublisher const&) = delete;
+        void operator=(TrajectPublisher const&) = delete;
+
+        /** @brief Publish a loaded traject */
+        void publish(Settings::Traject& traject);
+        /** @brief Publish the current interpolation of the traject */
+        void setInterpolation(Settings::InterpolationType type);
+        /** @brief Wait until everything is written, false on timeout */
+        bool waitIdle(std::chrono::milliseconds timeout);
+    };
+
+}
+}
+}
@@ -11,11 +11,13 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <variant>
 #include <ThirdParty/json.hpp>
 #include <Utils/Timing/Clk.h>
 #include <Utils/String/String.h>
+#include <Utils/Redis/VariableSchema.h>
 #include <cstdlib>
 #include <iostream>
 #include <Exceptions/RedisExceptions.hpp>
@@ -25,10 +27,6 @@ namespace Ilvo {
 namespace Utils {
 namespace Redis {
 
-    enum PlcType {MONITOR, CONTROL, NONE};
-
-    extern std::map<std::string, int> typeSizeMap;
-
     /**
      * @brief A redis variable in the system
      * 
@@ -42,7 +40,12 @@ namespace Redis {
         std::string entity;
         std::string group;
         PlcType plcType;
+        /** @brief Position in the monitor or control data block of the PLC, -1 for pc variables */
+        int plcByte;
+        int plcBit;
         bool updated;
+        /** @brief Type of the value, resolved once from the variable type */
+        enum class ValueType {INT, DOUBLE, BOOL, STRING, UNKNOWN} valueType;
         std::variant<double, bool, int, uint, std::string> value;
     public:
         Variable(std::string name, std::string group, std::string entity, std::string type, PlcType plcType);
@@ -53,12 +56,16 @@ namespace Redis {
         const std::string& getEntity() const;
         const std::string& getGroup() const;
         const PlcType& getPlcType() const;
+        int getPlcByte() const;
+        int getPlcBit() const;
+        void setPlcOffset(int byte, int bit);
         const int getSize();
 
         bool isUpdated();
         void setUpdated(bool updated);
 
-        void setValueString(std::string valueStr);
+        /** @brief Parse the value from a redis string, e.g. a view in the receive buffer of the RedisStream */
+        void setValueString(std::string_view valueStr);
         void setDefaultValue();
         std::string getValueAsString();
 
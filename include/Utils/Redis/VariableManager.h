@@ -11,11 +11,15 @@
 #include <atomic>
 #include <map>
 #include <Utils/Redis/Variable.h>
+#include <Utils/Redis/VariableSchema.h>
 #include <Utils/Redis/RedisStream.h>
+#include <Utils/Redis/RedisDispatcher.h>
 #include <Utils/String/String.h>
 #include <Exceptions/RedisExceptions.hpp>
 #include <Utils/Settings/Platform.h>
 #include <Utils/Timing/Logic.h>
+#include <Utils/Logging/LatencyTrace.h>
+#include <Utils/Logging/Metrics.h>
 
 namespace Ilvo {
 namespace Utils {
@@ -23,6 +27,16 @@ namespace Redis {
 
     typedef std::map<std::string, VariablePtr> VariableMap;
 
+    /** 
+     * @brief Storage layout of the variables in redis, set by 'layout' of 'protocols.redis' in config.json
+     * 
+     * @details FLAT: one string key per variable (default). 
+     * HASH: one hash per entity, e.g. 'plc.monitor.hitch_fb.feedback_sections.7' is field 'feedback_sections.7' of 
+     * hash 'plc.monitor.hitch_fb'. A read or write cycle sends the long entity names once per entity instead of once per
+     * variable and the redis database holds a hash per entity instead of a key per variable. With 'flat_mirror' the written variables are also set 
+     * as flat keys, for consumers that read the flat layout. Flat keys written by other clients are not read in the hash layout.
+     */
+    enum class RedisLayout {FLAT, HASH};
 
     /** @brief Signal handler function to handle proper shutdown of program */
     void signalInterrupt(int);
@@ -47,28 +61,90 @@ namespace Redis {
         Utils::Timing::PulseGenerator heartbeatPulse;
 
         RedisStream rs;
+        /** @brief Pub/sub of the process, its callbacks are called in the tick after reading the variables */
+        std::unique_ptr<RedisDispatcher> dispatcher;
+        /** @brief The server publishes keyspace notifications, else the change callbacks are called every tick */
+        bool keyspaceEvents;
         /** @brief Map of redis variables */
         VariableMap variableMap;
         /** @brief Map of redis variable keys for ordering */
         std::vector<std::string> variableMapKeyOrder;
+        /** @brief Redis variables in the order of variableMapKeyOrder, avoids map lookups in the read and write cycle */
+        std::vector<VariablePtr> variableOrder;
+        /** @brief Redis variables by the index of their key in the compiled schema, null if the configuration lacks the variable */
+        std::vector<VariablePtr> schemaVariables;
+        /** @brief The variables of $ILVO_PATH are those of the compiled schema, they were loaded without expanding the configuration */
+        bool compiledSchema;
+
+        /** @brief Storage layout of the variables in redis */
+        RedisLayout layout;
+        /** @brief Also write the flat keys of the variables in the hash layout */
+        bool flatMirror;
+        /** @brief Redis hashes of the hash layout, with their fields and the indices of the variables in variableOrder */
+        std::vector<std::string> hashKeys;
+        std::vector<std::vector<std::string>> hashFields;
+        std::vector<std::vector<size_t>> hashIndices;
+        /** @brief Per variable of variableOrder the index of its hash in hashKeys, -1 for flat keys (e.g. the heartbeat) */
+        std::vector<int> variableHash;
 
         /** @brief Composed variable types defined in configuration json file */
         nlohmann::ordered_json jTypes;
         /** @brief Redis configuration defined in configuration json file */
         nlohmann::ordered_json jConfig;
+
+        /** @brief Trace context of the GNSS fix the outputs of this tick derive from, read by updatePlatformState */
+        Utils::Logging::TraceContext trace;
+        /** @brief Spans and rolling latency histogram of the traced fixes, the histogram is published as '<process>.latency' */
+        Utils::Logging::LatencyTracer tracer;
+        /** @brief Start the trace of a fix produced by this process, received at stamp [us] */
+        void startTrace(int64_t stamp);
+        /** @brief No span of this process was recorded yet for the trace context */
+        bool isTraceNew() const;
+        /** @brief Record a span of this process for the trace context, see LatencyTracer::record */
+        void traceSpan(const std::string& name, int64_t start, int64_t end, Utils::Logging::TraceFlow flow);
     private:
+        /** @brief Sequence number of the last fix started by this process */
+        int64_t traceSeq;
+        /** @brief The trace context was started by this process */
+        bool traceOrigin;
+        /** @brief Trace context of the last recorded span */
+        Utils::Logging::TraceContext tracedContext;
+        std::chrono::steady_clock::time_point lastLatencyPublish;
+        /** @brief Record the span of the tick for a new trace, publish the histogram and log the trace file errors every second */
+        void traceTick(int64_t tickStart);
+        /** @brief Start the export thread of the trace file if 'trace' of the protocols of config.json enables it */
+        void startTraceExport();
+
+        /** @brief Metrics of the tick and the redis round trips, labelled with the process name */
+        Utils::Logging::MetricHistogram* tickDuration;
+        Utils::Logging::MetricCounter* tickOverruns;
+        Utils::Logging::MetricHistogram* redisReadDuration;
+        Utils::Logging::MetricHistogram* redisWriteDuration;
+        /** @brief Register the metrics of the process and start the metrics endpoint of config.json */
+        void registerMetrics();
+
+        /** @brief Load the variable types and configuration of $ILVO_PATH */
+        void loadConfig();
         // load variables
         /** @brief Load redis variables */
         void load();
-        void loadVariables(std::string name, const nlohmann::ordered_json& variable, PlcType plcType=PlcType::NONE, std::string group="", std::string entity="");
-        void addVariable(std::string name, std::string group, std::string entity, std::string type, PlcType plcType);
+        void addVariable(std::string name, std::string group, std::string entity, std::string type, PlcType plcType, int plcByte=-1, int plcBit=-1);
+        VariablePtr getSchemaVariable(size_t index, const char* name);
+        /** @brief Group the variables per entity into the redis hashes of the hash layout */
+        void loadHashes();
+        /** @brief Set a variable of variableOrder from a redis value, nil values are logged */
+        void setValueString(size_t index, std::string_view valueStr);
     public:
         VariableManager(std::string processName, std::chrono::milliseconds processPeriod);
         VariableManager(std::string processName);
+        /** @brief Variable manager on an in-process store instead of the Redis server */
+        VariableManager(std::string processName, std::shared_ptr<LocalStore> store);
         virtual ~VariableManager() = default;
         
         // platform
         Utils::Settings::Platform& getPlatform();
+        /** @brief Change the period of the update cycle, e.g. the rate of a core loop in the monolith */
+        void setPeriod(std::chrono::milliseconds processPeriod);
 
         // Variable getters and setters by type
         /** @brief Read all redis variables */
@@ -78,6 +154,17 @@ namespace Redis {
 
         /** @brief Get a redis variable by key */
         VariablePtr getVariable(std::string key);
+        /** @brief Get a redis variable of the compiled schema, e.g. getVariable(Vars::pc_field_updated) */
+        template<typename T, size_t Index>
+        VariablePtr getVariable(const VariableKey<T, Index>& key) { return getSchemaVariable(Index, key.name); }
+        /** @brief Get the value of a redis variable of the compiled schema with the type of the schema */
+        template<typename T, size_t Index>
+        T getValue(const VariableKey<T, Index>& key) { return getVariable(key)->template getValue<T>(); }
+        /** @brief Set the value of a redis variable of the compiled schema, the value is converted to the type of the schema */
+        template<typename T, size_t Index>
+        void setValue(const VariableKey<T, Index>& key, const typename VariableKey<T, Index>::type& value) { getVariable(key)->template setValue<T>(value); }
+        /** @brief The variables were loaded from the compiled schema instead of the expansion at runtime */
+        bool usesCompiledSchema() const;
 
         /** @brief Check if a redis variable key exists */
         bool existsVariable(std::string key);
@@ -93,10 +180,32 @@ namespace Redis {
         void updatePlatformState();
 
         RedisStream& getStream();
+        RedisDispatcher& getDispatcher();
+
+        /**
+         * @brief Call the callback in the tick when a redis key is written, after the variables are read
+         *
+         * @details Driven by the keyspace notifications of the server. The callback is also called once after subscribing
+         * and after a reconnection of the dispatcher, and every tick when the notifications are unavailable. It may be
+         * called without a change of the value, e.g. when the same value is written again, so it evaluates the state
+         * instead of assuming a change.
+         *
+         * @return the id of the subscription of the dispatcher
+         */
+        int onKeyChanged(const std::string& key, std::function<void()> callback);
+        /** @brief Call the callback in the tick when a variable is written, in the hash layout when its hash is written */
+        int onVariableChanged(const std::string& name, std::function<void(VariablePtr)> callback);
+        /** @brief Call the callback in the tick when a variable of the compiled schema is written */
+        template<typename T, size_t Index>
+        int onVariableChanged(const VariableKey<T, Index>& key, std::function<void(VariablePtr)> callback) { 
+            return onVariableChanged(getVariable(key)->getName(), callback); 
+        }
 
         // pure virtual for operation
         virtual void serverTick() = 0;
         virtual void init() {};
+        /** @brief Execute one update cycle: read, serverTick, heartbeat, write and publish the start time on '<process>-tick' */
+        void tick();
         void run();
     };
 
@@ -0,0 +1,88 @@
+/**
+ * @file VariableSchema.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Expansion of the variables of config.json and types.json into a flat variable table
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <cstddef>
+#include <ThirdParty/json.hpp>
+
+namespace Ilvo {
+namespace Utils {
+namespace Redis {
+
+    enum PlcType {MONITOR, CONTROL, NONE};
+
+    /** @brief Size of the variable types in the PLC data blocks [bytes] */
+    extern std::map<std::string, int> typeSizeMap;
+
+    /** @brief Variable of the expanded configuration, with its position in the PLC data block */
+    struct VariableSpec
+    {
+        std::string name;
+        std::string group;
+        std::string entity;
+        std::string type;
+        PlcType plcType;
+        /** @brief Byte and bit offset in the monitor or control data block, -1 for pc variables */
+        int byteOffset = -1;
+        int bitOffset = -1;
+    };
+
+    /** @brief Variable of the compiled schema, see VariableSchemaGenerated.h */
+    struct VariableDescriptor
+    {
+        const char* name;
+        const char* group;
+        const char* entity;
+        const char* type;
+        PlcType plcType;
+        int byteOffset;
+        int bitOffset;
+    };
+
+    /**
+     * @brief Key of a variable of the compiled schema
+     *
+     * @details The keys are generated in the Vars namespace, e.g. `getValue(Vars::pc_field_updated)`. A misspelled
+     * variable does not compile, the value has the type of the schema and the variable is found by its index instead
+     * of its name.
+     */
+    template<typename T, size_t Index>
+    struct VariableKey
+    {
+        using type = T;
+        static constexpr size_t index = Index;
+        const char* name;
+    };
+
+    /**
+     * @brief Expand the variables of the configuration with the composed types
+     *
+     * @details The variables are ordered as 'plc.monitor', 'plc.control' and 'pc'. Arrays are expanded into one variable
+     * per element and the PLC offsets are assigned in the order of the data blocks.
+     *
+     * @param variables: 'variables' of config.json
+     * @param types: types.json
+     */
+    std::vector<VariableSpec> expandVariables(const nlohmann::ordered_json& variables, const nlohmann::ordered_json& types);
+
+    /** @brief Size of the monitor or control data block of the variables [bytes] */
+    int plcDataSize(const std::vector<VariableSpec>& specs, PlcType plcType);
+
+    /** @brief Fingerprint of the variables and types, equal fingerprints expand to the same variable table */
+    uint64_t schemaFingerprint(const nlohmann::ordered_json& variables, const nlohmann::ordered_json& types);
+
+} // Redis
+} // Utils
+} // Ilvo
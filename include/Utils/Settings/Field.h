@@ -49,6 +49,7 @@ namespace Settings {
 
         Field& operator=(const Field& other);
 
+        const std::string& getName() const;
         const std::vector<Geometry::PointPtr>& getTrajectPoints() const;
         const Geometry::Polygon& getGeofence() const;
         std::vector<Task>& getTasks();
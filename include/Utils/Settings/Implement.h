@@ -19,6 +19,11 @@ namespace Ilvo {
 namespace Utils {
 namespace Settings {
 
+/** @brief Minimal number of sections to visualize the implement in a local tangent plane, for less sections the setup costs more than it saves */
+const size_t TANGENT_PLANE_MIN_SECTIONS = 4;
+/** @brief Displacement [m] of a section vertex that changes the visualization of the implement */
+const double VISUALIZATION_EPSILON = 0.01;
+
 class Implement
 {
 private:
@@ -44,6 +49,10 @@ public:
     nlohmann::json toStateFullJson();
 
     nlohmann::json visualizeJson(int zone=-1) const;
+    /** @brief True if a section moved more than VISUALIZATION_EPSILON or changed its activation since the last visualize() */
+    bool visualizationChanged() const;
+    /** @brief visualizeJson() of which only the changed sections are recalculated */
+    nlohmann::json visualize(int zone=-1);
 };
 
 } // namespace
@@ -0,0 +1,70 @@
+/**
+ * @file ImplementKinematics.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Kinematic chain from the hitch to the sections of an implement
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <vector>
+#include <Utils/Settings/Hitch.h>
+#include <Utils/Settings/Section.h>
+#include <ThirdParty/Eigen/Geometry>
+
+namespace Ilvo {
+namespace Utils {
+namespace Settings {
+
+    /**
+     * @brief Transforms and footprint corners of the sections on a hitch
+     *
+     * @details The chain from the hitch reference to a section, the hinge of the hitch times the parallel transform of
+     * the section, only depends on the hitch angle and the parallel angle of the section. It is cached and only
+     * recalculated for the sections of which an angle changed. An update composes the cached chain with the state of
+     * the hitch and calculates the corners of all footprints in one pass over fixed-size matrices, into storage that
+     * is only allocated when the number of sections changes.
+     *
+     * The reference and parallel transforms of a section are fixed after loading, a new section is recognized by its
+     * address.
+     */
+    class ImplementKinematics
+    {
+    private:
+        double hitchAngle;
+        double linkLength;
+        Eigen::Affine3d hinge;
+
+        std::vector<const Section*> sections;
+        std::vector<double> parallelAngles;
+        /** @brief Transform from the hitch reference to every section */
+        std::vector<Eigen::Affine3d> chain;
+        /** @brief Transform from the world to every section */
+        std::vector<Eigen::Affine3d> transforms;
+        /** @brief Corners of the footprints, 4 columns per section */
+        Eigen::Matrix2Xd corners;
+    public:
+        ImplementKinematics();
+        ~ImplementKinematics() = default;
+
+        /**
+         * @brief Update the transforms and footprints of the sections for the current state of the hitch
+         *
+         * @return The number of sections of which the chain was recalculated
+         * @throws std::invalid_argument if the width of a section is not positive
+         */
+        size_t update(Hitch& hitch, double hitchAngle, const std::vector<SectionPtr>& sections);
+
+        size_t getNumSections() const;
+        /** @brief World transform of the section, the state of the section */
+        const Eigen::Affine3d& getTransform(size_t section) const;
+        /** @brief Corners of the footprint of the section: (-width/2, -down), (width/2, -down), (width/2, up), (-width/2, up) */
+        Eigen::Matrix<double, 2, 4> getCorners(size_t section) const;
+    };
+
+} // namespace Ilvo
+} // namespace Utils
+} // namespace Settings
@@ -17,6 +17,7 @@
 #include <ThirdParty/json.hpp>
 #include <ThirdParty/UTM.hpp>
 #include <Utils/Geometry/Point.h>
+#include <Utils/Geometry/UtmProjection.h>
 
 namespace Ilvo {
 namespace Utils {
@@ -159,7 +160,6 @@ namespace Settings {
 
             inline nlohmann::json toJson(int zone=-1) const {
                 nlohmann::json j;
-                double lat, lng;
 
                 j["heading"] = heading;
                 
@@ -175,17 +175,16 @@ namespace Settings {
                 j["closest"]["xy"] = {closestPoint.x(), closestPoint.y()};
                 j["carrot"]["xy"] = {carrotPoint.x(), carrotPoint.y()};
 
-                if ((1 <= zone) && (zone <= 60)) {
-                    Geometry::UTMXYToLatLon(headCurrentPoint.x(), headCurrentPoint.y(), zone, false, lat, lng);
-                    j["headCurrent"]["latlng"] = {Ilvo::Utils::Geometry::RadToDeg(lat), Ilvo::Utils::Geometry::RadToDeg(lng)};
-                    Geometry::UTMXYToLatLon(headClosestPoint.x(), headClosestPoint.y(), zone, false, lat, lng);
-                    j["headClosest"]["latlng"] = {Ilvo::Utils::Geometry::RadToDeg(lat), Ilvo::Utils::Geometry::RadToDeg(lng)};
-                    Geometry::UTMXYToLatLon(currentPoint.x(), currentPoint.y(), zone, false, lat, lng);
-                    j["current"]["latlng"] = {Ilvo::Utils::Geometry::RadToDeg(lat), Ilvo::Utils::Geometry::RadToDeg(lng)};
-                    Geometry::UTMXYToLatLon(closestPoint.x(), closestPoint.y(), zone, false, lat, lng);
-                    j["closest"]["latlng"] = {Ilvo::Utils::Geometry::RadToDeg(lat), Ilvo::Utils::Geometry::RadToDeg(lng)};
-                    Geometry::UTMXYToLatLon(carrotPoint.x(), carrotPoint.y(), zone, false, lat, lng);
-                    j["carrot"]["latlng"] = {Ilvo::Utils::Geometry::RadToDeg(lat), Ilvo::Utils::Geometry::RadToDeg(lng)};
+                if (Geometry::UtmProjection::isValidZone(zone)) {
+                    const double x[5] = {headCurrentPoint.x(), headClosestPoint.x(), currentPoint.x(), closestPoint.x(), carrotPoint.x()};
+                    const double y[5] = {headCurrentPoint.y(), headClosestPoint.y(), currentPoint.y(), closestPoint.y(), carrotPoint.y()};
+                    double lat[5], lng[5];
+                    Geometry::UtmProjection::get(zone).toLatLon(x, y, lat, lng, 5);
+                    j["headCurrent"]["latlng"] = {lat[0], lng[0]};
+                    j["headClosest"]["latlng"] = {lat[1], lng[1]};
+                    j["current"]["latlng"] = {lat[2], lng[2]};
+                    j["closest"]["latlng"] = {lat[3], lng[3]};
+                    j["carrot"]["latlng"] = {lat[4], lng[4]};
                 }
                 return j;
             }
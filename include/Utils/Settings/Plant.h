@@ -0,0 +1,98 @@
+/**
+ * @file Plant.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Plant model settings of the simulated platform loaded from the settings json file
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <ThirdParty/json.hpp>
+#include <ostream>
+
+namespace Ilvo {
+namespace Utils {
+namespace Settings {
+
+    /**
+     * @brief Dynamics of one velocity actuator
+     *
+     * @details A zero value disables the corresponding effect, the default actuator follows the command instantly.
+     */
+    class Actuator
+    {
+    public:
+        /** @brief Time constant of the first order lag [s] */
+        double time_constant;
+        /** @brief Maximal acceleration [unit/s^2] */
+        double max_acceleration;
+        /** @brief Maximal jerk [unit/s^3] */
+        double max_jerk;
+
+        Actuator();
+        Actuator(nlohmann::json j);
+        ~Actuator() = default;
+
+        bool isIdeal() const;
+
+        nlohmann::json toJson() const;
+    };
+
+    /**
+     * @brief Plant model of the platform, used by the simulation
+     *
+     * @details Optional "plant" section of the settings.json file:
+     * {
+     *   "actuators": {"longitudinal": {...}, "lateral": {...}, "angular": {...}},
+     *   "slip": {"longitudinal": 0.05, "angular": 0.1},
+     *   "creep": {"velocity": 0.01, "gain": 0.05},
+     *   "gnss": {"noise": 0.02, "heading_noise": 0.3, "latency": 0.1, "seed": 1}
+     * }
+     * A missing section or parameter keeps the ideal platform that follows the velocity commands instantly and exactly.
+     */
+    class Plant
+    {
+    public:
+        Actuator longitudinal;
+        Actuator lateral;
+        Actuator angular;
+
+        /** @brief Longitudinal slip ratio of the tracks or wheels [0-1] */
+        double longitudinal_slip;
+        /** @brief Angular slip ratio of the skid-steer turn [0-1] */
+        double angular_slip;
+
+        /** @brief Constant sideways creep velocity, e.g. on a slope [m/s] */
+        double creep_velocity;
+        /** @brief Sideways creep velocity per angular velocity [m/rad] */
+        double creep_gain;
+
+        /** @brief Standard deviation of the GNSS position noise [m] */
+        double gnss_noise;
+        /** @brief Standard deviation of the GNSS heading noise [deg] */
+        double gnss_heading_noise;
+        /** @brief GNSS latency [s] */
+        double gnss_latency;
+        /** @brief Seed of the GNSS noise generator, reproducible simulations */
+        unsigned int gnss_seed;
+
+        Plant();
+        Plant(nlohmann::json j);
+        ~Plant() = default;
+
+        bool isIdeal() const;
+
+        nlohmann::json toJson() const;
+    };
+
+    inline std::ostream& operator<<(std::ostream& os, const Plant& p) {
+        os << p.toJson().dump();
+        return os;
+    }
+
+} // namespace
+} // namespace
+} // namespace
@@ -15,6 +15,7 @@
 #include <Utils/Settings/Robot.h>
 #include <Utils/Settings/Hitch.h>
 #include <Utils/Settings/Gps.h>
+#include <Utils/Settings/Plant.h>
 #include <string>
 #include <memory>
 
@@ -80,17 +81,31 @@ namespace Settings {
         return os;
     }
 
+    /**
+     * @brief Platform settings and state of the robot
+     * 
+     * @details One instance per process. A core loop of the monolith creates an instance for its thread, it has its own
+     * platform state like it has in its own process.
+     */
     class Platform
     {
     public:
         static Platform& getInstance() {
+            if (threadInstancePtr) {
+                return *threadInstancePtr;
+            }
             static Platform instance_;
             return instance_;
         }
+        /** @brief Platform state of the calling thread, e.g. a core loop of the monolith */
+        static void createThreadInstance();
 
         Platform(Platform const&) = delete;
         void operator=(Platform const&)  = delete;
     private:
+        /** @brief Instance of a thread that runs a core loop in the monolith, the process instance if null */
+        static thread_local std::unique_ptr<Platform> threadInstancePtr;
+
         Platform();
         Platform(const std::string& baseFilePath);
 
@@ -103,6 +118,8 @@ namespace Settings {
         std::vector<AutoMode> auto_modes;
         std::vector<Hitch> hitches;
         Gps gps;
+        /** @brief Plant model used by the simulation, ideal if the settings have no "plant" section */
+        Plant plant;
 
         bool navModesContainsId(AlgorithmMode id);
         bool autoModesContainsId(AutoModeId id);
@@ -30,6 +30,14 @@ private:
     // no json settings variable
     double parallel_angle;
     Geometry::Polygon p;
+    // visualization cache
+    /** @brief Contour and activation of the last visualization, the json is rebuilt when they changed */
+    nlohmann::json visualization;
+    std::vector<Geometry::bgPoint2D> visualizedContour;
+    bool visualizedActive;
+
+    template<typename Projection>
+    const nlohmann::json& visualize(const Projection& projection);
 public:
     std::string id;
     double width;
@@ -56,16 +64,32 @@ public:
 
     void clearActivationGeometry();
     void addActivationGeometry(Geometry::PointPtr g);
+    /** @brief Add a point with the transform of getWorldToSectionTransform(), computed once for all points of a geometry */
+    void addActivationGeometry(Geometry::PointPtr g, const Eigen::Affine3d& worldToSection);
+    /** @brief Transform of the world to the section on the ground (zero height), the inverse of the section state */
+    Eigen::Affine3d getWorldToSectionTransform();
     void setActivationGeometry(Geometry::PolygonPtr g);
 
     Eigen::Affine3d getParallelTransform();
     const Geometry::Polygon& getPolygon() const;
     void reset();
     void updatePolygon();
+    /** @brief Set the polygon to the corners of the footprint calculated by ImplementKinematics, instead of updatePolygon() */
+    void setFootprint(const Eigen::Matrix<double, 2, 4>& corners);
 
     nlohmann::json prepareJson() const;
 
     nlohmann::json visualizeJson(int zone=-1) const;
+    nlohmann::json visualizeJson(const Geometry::LocalTangentPlane& plane) const;
+
+    /**
+     * @brief True if a vertex of the polygon moved more than epsilon [m] or the activation changed since the last
+     * visualize() call
+     */
+    bool visualizationChanged(double epsilon) const;
+    /** @brief visualizeJson(), only recalculated when visualizationChanged(epsilon) */
+    const nlohmann::json& visualize(int zone, double epsilon);
+    const nlohmann::json& visualize(const Geometry::LocalTangentPlane& plane, double epsilon);
 };
 
 typedef std::shared_ptr<Section> SectionPtr;
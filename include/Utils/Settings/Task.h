@@ -16,8 +16,12 @@
 #include <Utils/Geometry/Polygon.h>
 #include <Utils/Geometry/GeometryVector.h>
 #include <Utils/Geometry/Point.h>
+#include <Utils/Geometry/PathMatcher.h>
+#include <Utils/Geometry/PointIndex.h>
+#include <Utils/Geometry/CoverageMap.h>
 #include <Utils/Settings/Platform.h>
 #include <Utils/Settings/Implement.h>
+#include <Utils/Settings/ImplementKinematics.h>
 #include <Utils/File/PointData.h>
 #include <Utils/Redis/VariableManager.h>
 
@@ -51,15 +55,23 @@ namespace Settings {
         std::string type;
         Hitch& hitch;  // keep reference to same hitch instance as in platform
         Implement implement;
+        ImplementKinematics kinematics;
+        /** @brief Variables of the hitch angle and the parallel angle of every section, built on the first update */
+        std::string hitchAngleName;
+        std::vector<std::string> sectionFeedbackNames;
 
         std::string taskmappath;
         GeometryType geometryType;
         std::variant<Geometry::PolygonVector,Geometry::PointVector> polygons, points;
+        /** @brief spatial index of the points of a point task map */
+        Geometry::PointIndex pointIndex;
+        /** @brief points of the task map inside the envelope of a section */
+        std::vector<int> candidates;
 
         void initVariant(Utils::File::PointData& f);
-        std::vector<Geometry::IndexPointPtr> discr_path_points;
-        static bool compareClosePoints(Geometry::IndexPointPtr p1, Geometry::IndexPointPtr p2);
-        static bool equalClosePoints(Geometry::IndexPointPtr p1, Geometry::IndexPointPtr p2);
+        std::vector<Geometry::PathMatch> discr_path_points;
+        static bool compareClosePoints(const Geometry::PathMatch& p1, const Geometry::PathMatch& p2);
+        static bool equalClosePoints(const Geometry::PathMatch& p1, const Geometry::PathMatch& p2);
 
     public:
         Task(std::string baseFilePath, nlohmann::json task, int gpsZoneId);
@@ -68,7 +80,13 @@ namespace Settings {
         int nextDiscreteImplementIndex;
 
         void updateState(Redis::VariableManager* manager);
-        bool updateSections(Redis::VariableManager* manager, bool disable=false);
+        /**
+         * @brief Activate the sections and record the active ones in the coverage
+         *
+         * @details A section on the task map is switched off when at least the overlap fraction of the ground it
+         * entered is covered already, an overlap of 0 never switches a section off.
+         */
+        bool updateSections(Redis::VariableManager* manager, bool disable=false, Geometry::CoverageMap* coverage=nullptr, double overlap=0.0);
         bool cardanEnabled(Redis::VariableManager* manager, bool disable=false);
         void activateSection(std::string id, bool value);
 
@@ -85,8 +103,9 @@ namespace Settings {
         bool isType(std::string type);
         const std::string& getName();
 
-        void createPathPointsDiscr(std::vector<Geometry::PointPtr> trajectPoints);
-        const std::vector<Geometry::IndexPointPtr>& getPathPointsDiscr();
+        /** @brief projects the discrete task points on the path, ordered along the path */
+        void createPathPointsDiscr(const Geometry::PathMatcher& matcher);
+        const std::vector<Geometry::PathMatch>& getPathPointsDiscr();
         
         const GeometryType& getGeometryType();
         template<class T>
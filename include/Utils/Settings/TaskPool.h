@@ -0,0 +1,83 @@
+/**
+ * @file TaskPool.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Pool of worker threads for the data parallel loading of the settings
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Ilvo {
+namespace Utils {
+namespace Settings {
+
+    /**
+     * @brief Worker threads that run the iterations of a loop in chunks
+     *
+     * @details The caller of parallelFor works along and returns when all the chunks are done. One loop runs at a
+     * time: a loop that is started from a worker or while another loop runs is run on the calling thread. The chunks
+     * of an iteration range do not depend on the number of workers, results that are written to the index of the
+     * iteration are the same as the ones of a sequential loop.
+     */
+    class TaskPool
+    {
+    private:
+        std::vector<std::thread> workers;
+        /** @brief Serializes the loops */
+        std::mutex loopMutex;
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        bool stopping;
+        /** @brief Generation of the current loop, the workers wait for a new one */
+        unsigned long generation;
+
+        // current loop
+        const std::function<void(size_t, size_t)>* body;
+        size_t count;
+        size_t grain;
+        std::atomic<size_t> next;
+        /** @brief Workers that are still in the current loop */
+        int active;
+        std::exception_ptr error;
+
+        void work();
+        void runChunks();
+    public:
+        /** @brief Pool with the number of workers, 0 for one less than the hardware threads (the caller works along) */
+        explicit TaskPool(unsigned workers=0);
+        ~TaskPool();
+
+        TaskPool(const TaskPool&) = delete;
+        TaskPool& operator=(const TaskPool&) = delete;
+
+        /** @brief Pool of the process */
+        static TaskPool& getInstance();
+
+        /** @brief Threads that run a loop, the workers and the caller */
+        unsigned getConcurrency() const;
+
+        /**
+         * @brief Runs body(begin, end) over the chunks of grain iterations of [0, count)
+         *
+         * @details The first exception of a chunk is rethrown when the running chunks are done.
+         */
+        void parallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& body, size_t grain=1);
+    };
+
+} // namespace Ilvo
+} // namespace Utils
+} // namespace Settings
@@ -20,6 +20,7 @@
 #include <cstdlib>
 #include <Utils/Geometry/Point.h>
 #include <Utils/Geometry/Line.h>
+#include <Utils/Geometry/PathMatcher.h>
 #include <Utils/Geometry/Angle.h>
 #include <Utils/Settings/Field.h>
 #include <Utils/Settings/Navigation.h>
@@ -54,6 +55,12 @@ namespace Settings {
         std::vector<Geometry::PointPtr> skeletonCurvy;
         /** @brief list of corners of the traject */
         std::vector<Geometry::CornerPointPtr> corners;
+        /** @brief segment index of the current interpolation, matcherLinear or matcherCurvy */
+        Geometry::PathMatcher* matcher;
+        /** @brief segment index of the linear traject */
+        Geometry::PathMatcher matcherLinear;
+        /** @brief segment index of the curvy traject */
+        Geometry::PathMatcher matcherCurvy;
 
         friend std::ostream& operator<<(std::ostream& os, const Traject& t);
     public:
@@ -70,7 +77,10 @@ namespace Settings {
         Field& getField();
 
         const std::vector<Geometry::PointPtr>& getInterpolation(InterpolationType type=InterpolationType::CURRENT) const;
+        const std::vector<Geometry::PointPtr>& getSkeleton(InterpolationType type=InterpolationType::CURRENT) const;
         InterpolationType getInterpolationType() const;
+        /** @brief map matching on the segments of the current interpolation */
+        const Geometry::PathMatcher& getPathMatcher() const;
         void setInterpolation(InterpolationType type);
 
         int rawPointsLength();
@@ -94,6 +104,8 @@ namespace Settings {
         double absPathOrientation(int idx);
         /** @brief returns the line of the path in the traject on the index*/
         Geometry::Line pathLine(int idx);
+        /** @brief returns the curvature of the path (1/m, positive to the left) over the distance after the index*/
+        double pathCurvature(int idx, double distance);
         /** 
          * @brief returns 1 if the point is left to the line in the traject on the index
          * 
@@ -107,8 +119,8 @@ namespace Settings {
         bool insideFirstTask(Geometry::Point point);
         /** @brief checks if the point is inside any task */
         bool insideAnyTask(Geometry::Point point);
-        /** @brief returns the distance to the next discrete measurement point */
-        double distanceToNextDiscrPoint(Task& task, double interpolationDistance);
+        /** @brief returns the distance along the path to the next discrete measurement point */
+        double distanceToNextDiscrPoint(Task& task);
         /** @brief increments the discrete measurement point, for the next point to drive to */
         void incrDiscrPoint(Task& task);
         /** @brief resets the discrete measurement point, the closest discrete measurement point will be executed next */
@@ -46,6 +46,8 @@ namespace Timing {
         void start();
         /** @brief Poll time of the update cycle */
         double poll();
+        /** @brief Start time of the update cycle in milliseconds since the epoch, virtual under a virtual clock */
+        double getStartTime();
         /** @brief Stop the update cycle */
         void stop();
 
@@ -0,0 +1,88 @@
+/**
+ * @file VirtualClock.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Virtual time for faster than real time simulation
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <chrono>
+
+
+namespace Ilvo {
+namespace Utils {
+namespace Timing {
+
+    /**
+     * @brief Clock that only advances when it is stepped
+     *
+     * @details When a virtual clock is active on a thread, the timing of that thread (Clk, timers, pulse generators,
+     * PID controllers) runs on the virtual time and Clk::stop() does not sleep. The simulation engine steps the clock
+     * with the period of the process, so thousands of ticks can be executed per second.
+     */
+    class VirtualClock
+    {
+    private:
+        /** @brief Wall clock time at the creation of the virtual clock */
+        std::chrono::system_clock::time_point systemStart;
+        /** @brief Steady clock time at the creation of the virtual clock */
+        std::chrono::steady_clock::time_point steadyStart;
+        /** @brief Virtual time elapsed since the creation */
+        std::chrono::nanoseconds elapsed;
+    public:
+        VirtualClock() :
+            systemStart(std::chrono::system_clock::now()),
+            steadyStart(std::chrono::steady_clock::now()),
+            elapsed(0)
+        {}
+        ~VirtualClock() = default;
+
+        /** @brief Advance the virtual time */
+        void advance(std::chrono::nanoseconds dt) { elapsed += dt; }
+        /** @brief Virtual time elapsed since the creation */
+        std::chrono::nanoseconds getElapsed() const { return elapsed; }
+
+        std::chrono::system_clock::time_point systemNow() const {
+            return systemStart + std::chrono::duration_cast<std::chrono::system_clock::duration>(elapsed);
+        }
+        std::chrono::steady_clock::time_point steadyNow() const {
+            return steadyStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(elapsed);
+        }
+    };
+
+    /** @brief Virtual clock of the current thread, nullptr if the thread runs on the wall clock */
+    inline thread_local VirtualClock* activeVirtualClock = nullptr;
+
+    /**
+     * @brief Activate a virtual clock on the current thread for the lifetime of the scope
+     */
+    class VirtualClockScope
+    {
+    private:
+        VirtualClock* previous;
+    public:
+        VirtualClockScope(VirtualClock& clock) : previous(activeVirtualClock) { activeVirtualClock = &clock; }
+        VirtualClockScope(const VirtualClockScope& other) = delete;
+        ~VirtualClockScope() { activeVirtualClock = previous; }
+    };
+
+    /** @brief True if the current thread runs on a virtual clock */
+    inline bool isVirtualTime() {
+        return activeVirtualClock != nullptr;
+    }
+    /** @brief Current system time, virtual if a virtual clock is active */
+    inline std::chrono::system_clock::time_point systemNow() {
+        return activeVirtualClock ? activeVirtualClock->systemNow() : std::chrono::system_clock::now();
+    }
+    /** @brief Current steady time, virtual if a virtual clock is active */
+    inline std::chrono::steady_clock::time_point steadyNow() {
+        return activeVirtualClock ? activeVirtualClock->steadyNow() : std::chrono::steady_clock::now();
+    }
+
+} // namespace Ilvo
+} // namespace Utils
+} // namespace Timing
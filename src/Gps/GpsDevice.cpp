@@ -1,7 +1,9 @@
 #include <Gps/GpsDevice.h>
+#include <Utils/Redis/VariableSchemaGenerated.h>
 #include <Utils/Timing/Timing.h>
 #include <Utils/Geometry/Angle.h>
 #include <Utils/Settings/State.h>
+#include <Utils/Geometry/UtmProjection.h>
 #include <Utils/Nmea/Nmea.h>
 #include <Utils/Logging/LoggerStream.h>
 #include <Exceptions/FileExceptions.hpp>
@@ -24,6 +26,19 @@ GpsDevice::GpsDevice(const string ns) :
     gpsfound(false)
 {
 }
+
+GpsDevice::GpsDevice(const string ns, shared_ptr<LocalStore> store) : 
+    VariableManager(ns, store), 
+    gpsfound(false)
+{
+    setPeriod(2ms);
+}
+
+GpsDevice::GpsDevice(const string ns, shared_ptr<LocalStore> store, unique_ptr<Utils::Peripheral::Peripheral> peripheral) : 
+    GpsDevice(ns, store)
+{
+    this->peripheral = std::move(peripheral);
+}
  
 
 void GpsDevice::init() {
@@ -33,7 +48,9 @@ void GpsDevice::init() {
     setRedisJsonStates(platform, rawState);
 
     // Connect to gps platform
-    if (platform.gps.device.compare("socket") == 0) {
+    if (peripheral) {
+        LoggerStream::getInstance() << INFO << "Connecting to the given GPS peripheral";
+    } else if (platform.gps.device.compare("socket") == 0) {
         LoggerStream::getInstance() << INFO << "Connecting to Stonex GPS on IP " << platform.gps.ip << " on port " << platform.gps.udp_port;
         peripheral = make_unique<Stonex>(platform.gps.ip, platform.gps.udp_port);
     } else if (platform.gps.device.compare("serial") == 0) {
@@ -71,7 +88,8 @@ void GpsDevice::serverTick() {
         x = 0;
         y = 0;
     } else {
-        LatLonToUTMXY(lat, lng, platform.gps.utm_zone, x, y);
+        int zone = UtmProjection::isValidZone(platform.gps.utm_zone) ? platform.gps.utm_zone : UtmProjection::zoneOf(lng);
+        UtmProjection::get(zone).toUtm(lat, lng, x, y);
     }
 
 
@@ -79,20 +97,20 @@ void GpsDevice::serverTick() {
     double fix = lines->gga->getValue<int>("fix");
     double time = lines->gga->getValue<long>("time");
 
-    getVariable("pc.gps.fix")->setValue<int>(fix);
+    setValue(Vars::pc_gps_fix, fix);
 
     // Update robot state
     rawT = Vector3d(x, y, height);
     // VTG line
     double gpsBaseLinearVelocity = lines->vtg->getValue<double>("ground_speed_km_per_h");
-    getVariable("pc.gps.ground_speed")->setValue<double>(gpsBaseLinearVelocity);
+    setValue(Vars::pc_gps_ground_speed, gpsBaseLinearVelocity);
     // HDT line
     // double yaw = constrainAngle(360 - lines->hdt->getValue<double>("heading") + platform.gps.antenna_rotation); 
     // rawR = Vector3d(rawR.x(), rawR.y(), yaw);
     // HRP line
     double yaw = constrainAngle(360 - lines->hrp->getValue<double>("heading") + platform.gps.antenna_rotation); 
     // Slope mode 0.0 -> auto, 1.0 -> manual positive, -1.0 -> manual negative
-    double slopeMode = getVariable("pc.gps.slope_mode")->getValue<double>();
+    double slopeMode = getValue(Vars::pc_gps_slope_mode);
     double slopeCorrection = (slopeMode == 0.0) ? -sgn(platform.gps.antenna_rotation) : slopeMode;
     // pitch is roll on robot
     double roll = slopeCorrection * lines->hrp->getValue<double>("pitch");  
@@ -107,9 +125,14 @@ void GpsDevice::serverTick() {
     rawRCov = Vector3d(varPitch, varRoll, varYaw);
 
     int hrp_mode = lines->hrp->getValue<int>("mode");
-    getVariable("pc.gps.hrp_mode")->setValue<double>(hrp_mode);
-
-    if ( !getVariable("pc.simulation.active")->getValue<bool>() ) {
+    setValue(Vars::pc_gps_hrp_mode, hrp_mode);
+
+    if ( !getValue(Vars::pc_simulation_active) ) {
+        // the pack of the previous tick can be received again, its fix is already traced
+        if (lines->received != tracedFix) {
+            tracedFix = lines->received;
+            startTrace(traceTime(lines->received));
+        }
         State rawState(rawT, rawR, rawTCov, rawRCov);
         Vector3d r = rawState.getR().asVector();
         Vector3d t = rawState.getT().asVector();
@@ -126,17 +149,3 @@ void GpsDevice::serverTick() {
     }
 
 }
-
-int main() {
-    // First check if ILVO_PATH environment variable is set
-    if (getenv("ILVO_PATH") == NULL) { 
-        throw EnvVariableNotFoundException("$ILVO_PATH");
-    }
-
-    string procName = "ilvo-gps";
-    LoggerStream::createInstance(procName);
-    LoggerStream::getInstance() << INFO << "GpsDevice Logger started";
-    GpsDevice gps(procName);
-    gps.run();
-    return 0;    
-}
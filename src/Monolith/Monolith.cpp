@@ -0,0 +1,132 @@
+#include <Monolith/Monolith.h>
+#include <Navigation/Navigation.h>
+#include <Operation/Operation.h>
+#include <Simulation/Simulation.h>
+#include <Gps/GpsDevice.h>
+#include <Utils/Redis/PlcVariableManager.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <Utils/Logging/Metrics.h>
+#include <Utils/Settings/Platform.h>
+#include <Exceptions/FileExceptions.hpp>
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <pthread.h>
+#include <signal.h>
+
+using namespace Ilvo::Core;
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Utils::Logging;
+using namespace Ilvo::Utils::Settings;
+using namespace Ilvo::Exception;
+
+using namespace std;
+using namespace nlohmann;
+
+namespace {
+    /** @brief Core loops of the monolith without a 'monolith' section, in the order of the control loop */
+    const vector<string> defaultLoops = {"ilvo-robot-plc", "ilvo-gps", "ilvo-navigation", "ilvo-operation", "ilvo-simulation"};
+}
+
+
+MonolithLoop MonolithLoop::fromJson(const json& j)
+{
+    MonolithLoop loop;
+    loop.name = j.at("name").get<string>();
+    loop.period = chrono::milliseconds(j.value("period", 0));
+    loop.cpu = j.value("cpu", -1);
+    return loop;
+}
+
+
+Monolith::Monolith() :
+    failures(0)
+{
+    string pathConfig = string(getenv("ILVO_PATH")) + "/config.json";
+    if (!boost::filesystem::exists(pathConfig)) {
+        throw PathNotFoundException(pathConfig);
+    }
+    jConfig = json::parse(std::ifstream(pathConfig));
+
+    json jMonolith = jConfig.value("monolith", json::object());
+    mirrorPeriod = chrono::milliseconds(jMonolith.value("mirror_period", 20));
+    if (jMonolith.contains("loops")) {
+        for (const json& jLoop: jMonolith["loops"]) {
+            loops.push_back(MonolithLoop::fromJson(jLoop));
+        }
+    } else {
+        for (const string& name: defaultLoops) {
+            loops.push_back({name});
+        }
+    }
+}
+
+unique_ptr<VariableManager> Monolith::createManager(const string& name, shared_ptr<LocalStore> store)
+{
+    if (name == "ilvo-robot-plc") return make_unique<PlcVariableManager>(name, store);
+    if (name == "ilvo-gps") return make_unique<GpsDevice>(name, store);
+    if (name == "ilvo-navigation") return make_unique<Navigation>(name, store);
+    if (name == "ilvo-operation") return make_unique<Operation>(name, store);
+    if (name == "ilvo-simulation") return make_unique<Simulation>(name, store);
+    return nullptr;
+}
+
+void Monolith::runLoop(const MonolithLoop& loop)
+{
+    // thread names are limited to 15 characters
+    pthread_setname_np(pthread_self(), loop.name.substr(0, 15).c_str());
+    LoggerStream::createThreadInstance(loop.name);
+    LoggerStream::getInstance() << INFO << loop.name << " Logger started in the monolith";
+
+    if (loop.cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(loop.cpu, &cpus);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+            LoggerStream::getInstance() << WARN << "Could not pin " << loop.name << " to CPU " << loop.cpu;
+        }
+    }
+
+    try {
+        // the platform state of the loop, the managers of the other loops do not share it
+        Platform::createThreadInstance();
+        unique_ptr<VariableManager> manager = createManager(loop.name, store);
+        if (!manager) {
+            throw runtime_error("Unknown core loop \"" + loop.name + "\"");
+        }
+        if (loop.period.count() > 0) {
+            manager->setPeriod(loop.period);
+        }
+        manager->run();
+    } catch (std::exception& e) {
+        LoggerStream::getInstance() << ERROR << loop.name << " stopped: " << e.what();
+        failures++;
+        // stop the other loops, the system manager restarts ilvo-monolith like a failed process
+        signalInterrupt(SIGINT);
+    }
+}
+
+int Monolith::run()
+{
+    // one endpoint for the loops, before their managers start the endpoints of the separate processes
+    MetricsServer::start(jConfig["protocols"], "ilvo-monolith");
+    store = make_shared<LocalStore>();
+    mirror = make_unique<RedisMirror>(store, jConfig["protocols"]["redis"], mirrorPeriod);
+    // the loops start from the variables of the server
+    mirror->pull();
+    mirror->start();
+
+    for (const MonolithLoop& loop: loops) {
+        LoggerStream::getInstance() << INFO << "Starting " << loop.name << (loop.cpu >= 0 ? " on CPU " + to_string(loop.cpu) : "");
+        threads.emplace_back(&Monolith::runLoop, this, loop);
+    }
+    for (std::thread& thread: threads) {
+        thread.join();
+    }
+    threads.clear();
+
+    // the loops no longer write the store
+    mirror->stop();
+    LoggerStream::getInstance() << INFO << "Monolith stopped, " << failures << " loops failed";
+    return failures > 0 ? 1 : 0;
+}
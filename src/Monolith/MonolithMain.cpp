@@ -0,0 +1,23 @@
+#include <Monolith/Monolith.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <Exceptions/FileExceptions.hpp>
+
+using namespace Ilvo::Exception;
+using namespace Ilvo::Core;
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+
+
+int main() {
+    // First check if ILVO_PATH environment variable is set
+    if (getenv("ILVO_PATH") == NULL) { 
+        throw EnvVariableNotFoundException("$ILVO_PATH");
+    }
+
+    string procName = "ilvo-monolith";
+    LoggerStream::createInstance(procName);
+    LoggerStream::getInstance() << INFO << "Monolith Logger started";
+    Monolith monolith;
+    return monolith.run();
+}
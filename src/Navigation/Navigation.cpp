@@ -1,4 +1,5 @@
 #include <Navigation/Navigation.h>
+#include <Utils/Redis/VariableSchemaGenerated.h>
 #include <boost/filesystem.hpp>
 #include <ThirdParty/json.hpp>
 #include <Utils/Settings/Field.h>
@@ -19,12 +20,46 @@ using namespace nlohmann;
 using namespace Eigen;
 using namespace boost::filesystem;
 
+/** @brief Channels of the navigation telemetry, in the order of the schema. */
+enum NavigationTelemetry {
+    TLM_X, TLM_Y, TLM_HEADING,
+    TLM_CLOSEST_INDEX, TLM_CARROT_INDEX,
+    TLM_DISTANCE_ERROR, TLM_ORIENTATION_ERROR, TLM_ALPHA,
+    TLM_SS_P, TLM_SS_I, TLM_SS_D, TLM_SS_VALUE,
+    TLM_ROUGH_P, TLM_ROUGH_I, TLM_ROUGH_D, TLM_ROUGH_VALUE,
+    TLM_PP_P, TLM_PP_I, TLM_PP_D, TLM_PP_VALUE,
+    TLM_VELOCITY_LONGITUDINAL, TLM_VELOCITY_LATERAL, TLM_VELOCITY_ANGULAR,
+    TLM_FSM_STATE, TLM_STEADY_STATE, TLM_AUTO
+};
+
+const vector<TelemetryChannel> navigationTelemetryChannels = {
+    {"x", FLOAT64}, {"y", FLOAT64}, {"heading", FLOAT64},
+    {"closest_index", INT32}, {"carrot_index", INT32},
+    {"distance_error", FLOAT64}, {"orientation_error", FLOAT64}, {"alpha", FLOAT64},
+    {"steady_state.proportional", FLOAT64}, {"steady_state.integral", FLOAT64}, {"steady_state.derivative", FLOAT64}, {"steady_state.value", FLOAT64},
+    {"rough.proportional", FLOAT64}, {"rough.integral", FLOAT64}, {"rough.derivative", FLOAT64}, {"rough.value", FLOAT64},
+    {"purepursuit.proportional", FLOAT64}, {"purepursuit.integral", FLOAT64}, {"purepursuit.derivative", FLOAT64}, {"purepursuit.value", FLOAT64},
+    {"velocity.longitudinal", FLOAT64}, {"velocity.lateral", FLOAT64}, {"velocity.angular", FLOAT64},
+    {"fsm_state", INT32}, {"steady_state", BOOL}, {"auto", BOOL}
+};
+
 
 Navigation::Navigation(const string ns) : 
     VariableManager(ns),
+    fieldUpdated(false),
     autoModeReset(false),
     autoModeError(false)
 { 
+    trajectPublisher = make_unique<TrajectPublisher>(jConfig["protocols"]["redis"]["ip"], jConfig["protocols"]["redis"]["port"]);
+}
+
+Navigation::Navigation(const string ns, shared_ptr<LocalStore> store) : 
+    VariableManager(ns, store),
+    fieldUpdated(false),
+    autoModeReset(false),
+    autoModeError(false)
+{ 
+    trajectPublisher = make_unique<TrajectPublisher>(store);
 }
 
 void Navigation::init()
@@ -33,6 +68,45 @@ void Navigation::init()
     traject = make_unique<Traject>();
     position = make_unique<PositionData>();
     navigationControl.init(this, traject, position);
+    telemetry = make_unique<TelemetryStream>(processName, navigationTelemetryChannels);
+    traceVariable = existsVariable("pc.navigation.trace") ? getVariable("pc.navigation.trace") : nullptr;
+    onVariableChanged(Vars::pc_field_updated, [this](VariablePtr var) {
+        edgeDetectorField.detect(var->getValue<bool>());
+        fieldUpdated |= edgeDetectorField.rising;
+    });
+}
+
+void Navigation::recordTelemetry(bool activeAuto)
+{
+    const AlgorithmData& algorithm = navigationControl.getAlgorithmData();
+
+    telemetry->set(TLM_X, position->currentPoint.x());
+    telemetry->set(TLM_Y, position->currentPoint.y());
+    telemetry->set(TLM_HEADING, position->heading);
+    telemetry->set(TLM_CLOSEST_INDEX, position->closestPoint.index);
+    telemetry->set(TLM_CARROT_INDEX, position->carrotPoint.index);
+    telemetry->set(TLM_DISTANCE_ERROR, getValue(Vars::pc_path_distance_error));
+    telemetry->set(TLM_ORIENTATION_ERROR, getValue(Vars::pc_path_orientation_error));
+    telemetry->set(TLM_ALPHA, algorithm.alpha);
+    telemetry->set(TLM_SS_P, getValue(Vars::pc_lateral_controller_steady_state_proportional));
+    telemetry->set(TLM_SS_I, getValue(Vars::pc_lateral_controller_steady_state_integral));
+    telemetry->set(TLM_SS_D, getValue(Vars::pc_lateral_controller_steady_state_derivative));
+    telemetry->set(TLM_SS_VALUE, getValue(Vars::pc_lateral_controller_steady_state_value));
+    telemetry->set(TLM_ROUGH_P, getValue(Vars::pc_lateral_controller_rough_proportional));
+    telemetry->set(TLM_ROUGH_I, getValue(Vars::pc_lateral_controller_rough_integral));
+    telemetry->set(TLM_ROUGH_D, getValue(Vars::pc_lateral_controller_rough_derivative));
+    telemetry->set(TLM_ROUGH_VALUE, getValue(Vars::pc_lateral_controller_rough_value));
+    telemetry->set(TLM_PP_P, getValue(Vars::pc_purepursuit_pid_proportional));
+    telemetry->set(TLM_PP_I, getValue(Vars::pc_purepursuit_pid_integral));
+    telemetry->set(TLM_PP_D, getValue(Vars::pc_purepursuit_pid_derivative));
+    telemetry->set(TLM_PP_VALUE, getValue(Vars::pc_purepursuit_pid_value));
+    telemetry->set(TLM_VELOCITY_LONGITUDINAL, getValue(Vars::plc_control_navigation_velocity_longitudinal));
+    telemetry->set(TLM_VELOCITY_LATERAL, getValue(Vars::plc_control_navigation_velocity_lateral));
+    telemetry->set(TLM_VELOCITY_ANGULAR, getValue(Vars::plc_control_navigation_velocity_angular));
+    telemetry->set(TLM_FSM_STATE, algorithm.fsmState);
+    telemetry->set(TLM_STEADY_STATE, algorithm.steadyState);
+    telemetry->set(TLM_AUTO, activeAuto);
+    telemetry->commit();
 }
 
 void Navigation::updatePosition()
@@ -46,16 +120,16 @@ void Navigation::updatePosition()
 
     if (algorithmMode == AlgorithmMode::EXTERNAL) {
         // set path related parameters to zero
-        getVariable("pc.path.orientation")->setValue<double>(0.0);
-        getVariable("pc.path.orientation_error")->setValue<double>(0.0);
-        getVariable("pc.path.distance_error")->setValue<double>(0.0);
+        setValue(Vars::pc_path_orientation, 0.0);
+        setValue(Vars::pc_path_orientation_error, 0.0);
+        setValue(Vars::pc_path_distance_error, 0.0);
     } else {
         // update path related parameters
         // update closest point
         double distanceToClosestPoint = position->currentPoint.distance(position->closestPoint);
         if (distanceToClosestPoint < position->resetPathDistance) {
             // if the robot is close to the path only update the closest point close to the current point
-            int indexdiff = min(traject->interpolationLength() - position->closestPoint.index, int(1.5 / getVariable("pc.purepursuit.inter_point_distance")->getValue<double>()));
+            int indexdiff = min(traject->interpolationLength() - position->closestPoint.index, int(1.5 / getValue(Vars::pc_purepursuit_inter_point_distance)));
             position->closestPoint = traject->closestPoint(position->currentPoint, position->closestPoint.index, position->closestPoint.index+indexdiff);
         } else {
             // update the closest point in the whole path, also update the corners
@@ -65,13 +139,13 @@ void Navigation::updatePosition()
         
         // set the orientaiton and deviation parameters of the path
         double pathOrientation = toRobotFrame(traject->absPathOrientation(position->closestPoint.index));
-        getVariable("pc.path.orientation")->setValue<double>(pathOrientation);
+        setValue(Vars::pc_path_orientation, pathOrientation);
         Line line = traject->pathLine(position->closestPoint.index);
-        getVariable("pc.path.distance_error")->setValue<double>(traject->isPointLeft(position->closestPoint.index, position->currentPoint) * line.distance(position->currentPoint));
+        setValue(Vars::pc_path_distance_error, traject->isPointLeft(position->closestPoint.index, position->currentPoint) * line.distance(position->currentPoint));
 
         double robotOrientation = position->robotRefState.getR().asVector()[2];
         double orientationError = calcSmallestAngle(robotOrientation, pathOrientation);
-        getVariable("pc.path.orientation_error")->setValue<double>(orientationError);
+        setValue(Vars::pc_path_orientation_error, orientationError);
     }
 }
 
@@ -83,8 +157,8 @@ void Navigation::resetPosition()
 
     LoggerStream::getInstance() << INFO << "Reset position data";
     // The closest point will be the start indexInPath
-    double carrotDistance = getVariable("pc.purepursuit.carrot_distance")->getValue<double>();
-    double interpolationDistance = getVariable("pc.purepursuit.inter_point_distance")->getValue<double>();
+    double carrotDistance = getValue(Vars::pc_purepursuit_carrot_distance);
+    double interpolationDistance = getValue(Vars::pc_purepursuit_inter_point_distance);
     position->currentPoint = position->robotRefState.getT();
     position->carrotPoint = traject->closestPoint(position->currentPoint, position->closestPoint.index, position->closestPoint.index + (int)(carrotDistance / interpolationDistance) + 10, carrotDistance);
     position->closestPoint = traject->closestPoint(position->currentPoint);
@@ -94,14 +168,14 @@ void Navigation::resetPosition()
     LoggerStream::getInstance() << DEBUG << "Previous corner: " << position->corners.previousCorner.cornerIndex << ", Next corner: " << position->corners.nextCorner.cornerIndex;
     position->resetPathDistance = RESET_PATH_DISTANCE_DEFAULT;
 
-    getVariable("pc.implement.disable")->setValue(false);  // Ensure that implement operation is enabled when starting
+    setValue(Vars::pc_implement_disable, false);  // Ensure that implement operation is enabled when starting
 }
 
 
 void Navigation::serverTick() 
 {
     // update redis operation
-    getVariable("plc.control.navigation.heartbeat")->setValue<bool>(heartbeatPulse.getValue());
+    setValue(Vars::plc_control_navigation_heartbeat, heartbeatPulse.getValue());
 
     // check if hitch is busy
     bool hitchBusy = false;
@@ -110,46 +184,46 @@ void Navigation::serverTick()
     }
 
     // detect edges
-    bool activeAuto = getVariable("pc.simulation.auto")->getValue<bool>() || 
-        getVariable("plc.monitor.state.auto")->getValue<bool>() || 
-        getVariable("plc.monitor.state.aware")->getValue<bool>() ||
-        getVariable("plc.monitor.state.steer")->getValue<bool>() || 
-        getVariable("plc.monitor.state.throttle")->getValue<bool>();
-    edgeDetectorField.detect( getVariable("pc.field.updated")->getValue<bool>());
+    bool activeAuto = getValue(Vars::pc_simulation_auto) || 
+        getValue(Vars::plc_monitor_state_auto) || 
+        getValue(Vars::plc_monitor_state_aware) ||
+        getValue(Vars::plc_monitor_state_steer) || 
+        getValue(Vars::plc_monitor_state_throttle);
     edgeDetectorAutomode.detect( activeAuto );
+    bool fieldRising = fieldUpdated;
+    fieldUpdated = false;
 
     // reset traject
-    if (edgeDetectorField.rising || traject->empty()) {
+    if (fieldRising || traject->empty()) {
         // load the traject
-        algorithmMode = static_cast<AlgorithmMode>(getVariable("pc.navigation.mode")->getValue<int>());
-        traject->load(Field::checkFieldName(getVariable("pc.field.name")->getValue<string>()), 
+        algorithmMode = static_cast<AlgorithmMode>(getValue(Vars::pc_navigation_mode));
+        traject->load(Field::checkFieldName(getValue(Vars::pc_field_name)), 
                     getPlatform().gps.utm_zone, 
-                    getVariable("pc.navigation.spin_angle")->getValue<double>(),
-                    getVariable("pc.purepursuit.inter_point_distance")->getValue<double>(),
-                    getVariable("pc.navigation.turning_radius")->getValue<double>(),
+                    getValue(Vars::pc_navigation_spin_angle),
+                    getValue(Vars::pc_purepursuit_inter_point_distance),
+                    getValue(Vars::pc_navigation_turning_radius),
                     algorithmModeToInterpolationType[algorithmMode]);
 
         if (traject->empty()) {
             LoggerStream::getInstance() << DEBUG << "Traject loaded failed";
         } else {
             LoggerStream::getInstance() << DEBUG << "Traject loaded successfully";
+            trajectPublisher->publish(*traject);
         }
-
-        // takes too long to write this to redis skip it for now
-        // getStream().setRedisJsonValue("traject", traject->toJson());
     }
     if (traject->empty()) {
         // Stop the robot navigation
-        getVariable("plc.control.navigation.end_reached")->setValue<bool>(true);
+        setValue(Vars::plc_control_navigation_end_reached, true);
         return;
     }
 
     // set the interpolation type if change in algorithm mode
-    algorithmMode = static_cast<AlgorithmMode>(getVariable("pc.navigation.mode")->getValue<int>());
+    algorithmMode = static_cast<AlgorithmMode>(getValue(Vars::pc_navigation_mode));
     changeDetectorAlgorithmMode.detect(algorithmMode);
     if (changeDetectorAlgorithmMode.changed) {
         LoggerStream::getInstance() << INFO << "Navigation mode changed to " << algorithmMode;
         traject->setInterpolation(algorithmModeToInterpolationType[algorithmMode]);
+        trajectPublisher->setInterpolation(traject->getInterpolationType());
         resetPosition();
         navigationControl.reset();
         if (algorithmMode == AlgorithmMode::EXTERNAL) {
@@ -163,29 +237,29 @@ void Navigation::serverTick()
         autoModeReset = true;
         if (trajectEndReachedPulse.generatePulse(300ms)) {
             LoggerStream::getInstance() << DEBUG <<"Pulse to terminate auto mode";
-            getVariable("plc.control.navigation.end_reached")->setValue<bool>(true);
-            getVariable("pc.simulation.auto")->setValue<bool>(false);
+            setValue(Vars::plc_control_navigation_end_reached, true);
+            setValue(Vars::pc_simulation_auto, false);
             navigationControl.setVelocityOperation();  // reset velocities
         } else {
-            getVariable("plc.control.navigation.end_reached")->setValue<bool>(false);
+            setValue(Vars::plc_control_navigation_end_reached, false);
             autoModeReset = false;
             autoModeError = false;
         }
     }
 
     // detect creation or loading of new field.
-    if (edgeDetectorAutomode.rising || edgeDetectorField.rising) {
+    if (edgeDetectorAutomode.rising || fieldRising) {
         LoggerStream::getInstance() << INFO <<"Resetting the field: ";
         if (edgeDetectorAutomode.rising) {
             LoggerStream::getInstance() << INFO <<"Auto mode is started.";
-        } else if (edgeDetectorField.rising) {
+        } else if (fieldRising) {
             LoggerStream::getInstance() << INFO <<"New traject is set";
         }
         
         try {
 	        navigationControl.reset();
         } catch(const TrajectLengthIsZero& e) {
-            getVariable("pc.execution.notification")->setValue(e.what());
+            setValue(Vars::pc_execution_notification, e.what());
             autoModeError = true;
         } 
     }
@@ -200,23 +274,23 @@ void Navigation::serverTick()
         try {
             navigationControl.update(algorithmMode, edgeDetectorAutomode.rising);
         } catch(const TrajectLengthIsZero& e) {
-            getVariable("pc.execution.notification")->setValue("Traject is empty!");
+            setValue(Vars::pc_execution_notification, "Traject is empty!");
             autoModeError = true;
         } catch(const NoRtkFix& e) {
-            getVariable("pc.execution.notification")->setValue("No RTK Fix!");
-            getVariable("plc.monitor.state.auto")->setValue<bool>(false);
+            setValue(Vars::pc_execution_notification, "No RTK Fix!");
+            setValue(Vars::plc_monitor_state_auto, false);
             autoModeError = true;
         } catch(const RobotOutsideGeofence& e) {
-            getVariable("pc.execution.notification")->setValue("Robot outside geofence!");
+            setValue(Vars::pc_execution_notification, "Robot outside geofence!");
             autoModeError = true;
         } catch(const WrongRobotOrientation& e) {
-            getVariable("pc.execution.notification")->setValue("Wrong robot orientation! Rotate to the orientation of the traject!");
+            setValue(Vars::pc_execution_notification, "Wrong robot orientation! Rotate to the orientation of the traject!");
             autoModeError = true;
         } catch(const EndOfTrajectIsReached& e)  {
-            getVariable("pc.execution.notification")->setValue("End of Traject is reached!");
+            setValue(Vars::pc_execution_notification, "End of Traject is reached!");
             autoModeError = true;
         } catch(const exception& e) {
-            getVariable("pc.execution.notification")->setValue("An unexpected error occured! " + string(e.what()));
+            setValue(Vars::pc_execution_notification, "An unexpected error occured! " + string(e.what()));
             autoModeError = true;
         }
 
@@ -225,21 +299,13 @@ void Navigation::serverTick()
         }
     }
 
+    recordTelemetry(activeAuto);
+    // the control variables of this tick are written with the trace context of their fix
+    if (traceVariable && isTraceNew()) {
+        traceVariable->setValue<string>(trace.toString());
+    }
+
     // TODO also add position data
     getStream().setRedisJsonValue("navigation.controller.info", position->toJson(platform.gps.utm_zone));
     setRedisJsonStatus(platform);  
 }
-
-int main() {
-    // First check if ILVO_PATH environment variable is set
-    if (getenv("ILVO_PATH") == NULL) { 
-        throw EnvVariableNotFoundException("$ILVO_PATH");
-    }
-
-    string procName = "ilvo-navigation";
-    LoggerStream::createInstance(procName);
-    LoggerStream::getInstance() << INFO << "Navigation Logger started";
-    Navigation navbase(procName);
-    navbase.run();
-    return 0;  
-}
@@ -1,4 +1,5 @@
 #include <Navigation/NavigationControl.h>
+#include <Utils/Redis/VariableSchemaGenerated.h>
 #include <Navigation/Navigation.h>
 #include <ThirdParty/bprinter/table_printer.h>
 #include <Exceptions/RobotExceptions.hpp>
@@ -12,6 +13,7 @@ using namespace Ilvo::Utils::Geometry;
 using namespace Ilvo::Utils::Settings;
 using namespace Ilvo::Utils::Redis;
 using namespace Ilvo::Utils::Logging;
+using namespace Ilvo::Utils::Pid;
 
 using bprinter::TablePrinter;
 using namespace std;
@@ -34,6 +36,7 @@ void NavigationControl::reset() {
     steadyStateLateralController.reset();  // reset the lateral controllers
     roughLateralController.reset();  // reset the lateral controllers
     purepursuitController.reset();  // reset the purepursuit controllers
+    if (mpc) mpc->reset();  // forget the solution of the previous path
 }
 
 bool NavigationControl::getActiveSideways() const {
@@ -42,8 +45,8 @@ bool NavigationControl::getActiveSideways() const {
 
 void NavigationControl::update(AlgorithmMode algorithmMode, bool firstTime) {
     // check if rtk fix
-    if (!manager->getVariable("pc.simulation.active")->getValue<bool>()) {
-        if (manager->getVariable("pc.gps.fix")->getValue<int>() != 4) {
+    if (!manager->getValue(Vars::pc_simulation_active)) {
+        if (manager->getValue(Vars::pc_gps_fix) != 4) {
             throw NoRtkFix();
         } 
     }
@@ -70,7 +73,7 @@ void NavigationControl::update(AlgorithmMode algorithmMode, bool firstTime) {
     // }
 
     // check robot orientation
-    double pathOrientation = manager->getVariable("pc.path.orientation")->getValue<double>();
+    double pathOrientation = manager->getValue(Vars::pc_path_orientation);
     double robotOrientation = position->robotRefState.getR().asVector()[2];
     double smallestAngle = calcSmallestAngleAbsolute(pathOrientation, robotOrientation);
     // check robot orientation to closest point
@@ -81,19 +84,19 @@ void NavigationControl::update(AlgorithmMode algorithmMode, bool firstTime) {
     }
 
     // stop 1m before the end of path is reached
-    int numStopPoints = (int)(1.0 / manager->getVariable("pc.purepursuit.inter_point_distance")->getValue<double>());
+    int numStopPoints = (int)(1.0 / manager->getValue(Vars::pc_purepursuit_inter_point_distance));
     if ((position->closestPoint.index+1+numStopPoints) >= traject->interpolationLength()) {
         throw EndOfTrajectIsReached();
     }
 
     // update velocities
-    if (manager->getVariable("pc.simulation.auto")->getValue<bool>() ||
-        manager->getVariable("plc.monitor.state.auto")->getValue<bool>() || 
-        manager->getVariable("plc.monitor.state.throttle")->getValue<bool>()) {  // set velocities
-        algorithm.velocity.longitudinal = manager->getVariable("pc.navigation.non_operational_velocity")->getValue<double>();
-        algorithm.longitudinalTaskVelocity = manager->getVariable("pc.navigation.operational_velocity")->getValue<double>();
-    } else if (manager->getVariable("plc.monitor.state.steer")->getValue<bool>()) {
-        algorithm.velocity.longitudinal = manager->getVariable("plc.monitor.navigation.velocity.longitudinal")->getValue<double>();  // TODO what will become the unit speed check this out
+    if (manager->getValue(Vars::pc_simulation_auto) ||
+        manager->getValue(Vars::plc_monitor_state_auto) || 
+        manager->getValue(Vars::plc_monitor_state_throttle)) {  // set velocities
+        algorithm.velocity.longitudinal = manager->getValue(Vars::pc_navigation_non_operational_velocity);
+        algorithm.longitudinalTaskVelocity = manager->getValue(Vars::pc_navigation_operational_velocity);
+    } else if (manager->getValue(Vars::plc_monitor_state_steer)) {
+        algorithm.velocity.longitudinal = manager->getValue(Vars::plc_monitor_navigation_velocity_longitudinal);  // TODO what will become the unit speed check this out
         algorithm.longitudinalTaskVelocity = algorithm.velocity.longitudinal;
     }
 
@@ -127,9 +130,9 @@ void NavigationControl::nextCorner() {
 void NavigationControl::purePursuit() {
     // update carrot point
     double linearVelocity = algorithm.velocity.longitudinal;
-    double carrotDistance = manager->getVariable("pc.purepursuit.carrot_distance")->getValue<double>();
+    double carrotDistance = manager->getValue(Vars::pc_purepursuit_carrot_distance);
     double minCarrotDistance = 1.5;
-    double interpolationDistance = manager->getVariable("pc.purepursuit.inter_point_distance")->getValue<double>();
+    double interpolationDistance = manager->getValue(Vars::pc_purepursuit_inter_point_distance);
 
     if (traject->getInterpolationType() == InterpolationType::CURVY) {
         Point* closestPointPtr = traject->getInterpolation().at(position->closestPoint.index).get();
@@ -157,7 +160,7 @@ void NavigationControl::purePursuit() {
     double alphaDegree = carrotLineOrientationDegree - position->heading;
     algorithm.alpha = DegToRad(alphaDegree);
     // calculate distance to path
-    double distanceToPath = manager->getVariable("pc.path.distance_error")->getValue<double>();
+    double distanceToPath = manager->getValue(Vars::pc_path_distance_error);
     // Steady state latch
     if (!algorithm.steadyState && abs(distanceToPath) < 0.2) {
         algorithm.steadyState = true;
@@ -172,15 +175,15 @@ void NavigationControl::purePursuit() {
         linearVelocity = algorithm.longitudinalTaskVelocity;
     }   
     // slow down mode
-    if (manager->getVariable("pc.implement.slow_down")->getValue<bool>()) {
+    if (manager->getValue(Vars::pc_implement_slow_down)) {
         linearVelocity = manager->getPlatform().auto_velocity.min;
     }
 
     // PID controller to remove steady state errors
     double kp, ki, kd = 0.0;
     double saturationMin, saturationMax = 0.0;
-    double currentVelocity = manager->getVariable("plc.monitor.navigation.velocity.longitudinal")->getValue<double>();
-    double purePursuitWeightFactor = manager->existsVariable("pc.purepursuit.weight_factor") ? manager->getVariable("pc.purepursuit.weight_factor")->getValue<double>() : 1.0;
+    double currentVelocity = manager->getValue(Vars::plc_monitor_navigation_velocity_longitudinal);
+    double purePursuitWeightFactor = manager->existsVariable("pc.purepursuit.weight_factor") ? manager->getValue(Vars::pc_purepursuit_weight_factor) : 1.0;
     double pidWeightFactor = 1.0 - purePursuitWeightFactor;
     
     double lateralPidOutput = 0.0;  
@@ -192,7 +195,11 @@ void NavigationControl::purePursuit() {
 
     double lateralVelocity, longitudinalVelocity, angularVelocity = 0.0;
 
-    bool enableLateralController = manager->existsVariable("pc.lateral_controller.enable") ? manager->getVariable("pc.lateral_controller.enable")->getValue<double>() : manager->getPlatform().navModesContainsId(AlgorithmMode::PP_SPINNING_180);
+    // model predictive line following, pure pursuit steers when the MPC exceeds its budget
+    double mpcAngularVelocity = 0.0;
+    bool mpcActive = modelPredictive(linearVelocity, mpcAngularVelocity);
+
+    bool enableLateralController = manager->existsVariable("pc.lateral_controller.enable") ? manager->getValue(Vars::pc_lateral_controller_enable) : manager->getPlatform().navModesContainsId(AlgorithmMode::PP_SPINNING_180);
     bool resetPid = currentVelocity <= 0.01;
 
     if (resetPid) {
@@ -208,7 +215,7 @@ void NavigationControl::purePursuit() {
     Line line = traject->pathLine(position->headClosestPoint.index);
     double pidErrorDistance = traject->isPointLeft(position->headClosestPoint.index, position->headCurrentPoint) * line.distance(position->headCurrentPoint);
 
-    double pidErrorOrientation = manager->existsVariable("pc.path.orientation_error") ? manager->getVariable("pc.path.orientation_error")->getValue<double>() : 0.0;  
+    double pidErrorOrientation = manager->existsVariable("pc.path.orientation_error") ? manager->getValue(Vars::pc_path_orientation_error) : 0.0;  
 
     if (enableLateralController) {
         if (!resetPid && pidWeightFactor > 0.0) {
@@ -217,64 +224,118 @@ void NavigationControl::purePursuit() {
             saturationMin = -linearVelocity * pidWeightFactor;
             saturationMax = linearVelocity * pidWeightFactor;
             if (algorithm.steadyState) {
-                kp = manager->existsVariable("pc.lateral_controller.steady_state.p") ? manager->getVariable("pc.lateral_controller.steady_state.p")->getValue<double>() : 0.0; 
-                ki = manager->existsVariable("pc.lateral_controller.steady_state.i") ? manager->getVariable("pc.lateral_controller.steady_state.i")->getValue<double>() : 0.0;
-                kd = manager->existsVariable("pc.lateral_controller.steady_state.d") ? manager->getVariable("pc.lateral_controller.steady_state.d")->getValue<double>() : 0.0;
+                kp = manager->existsVariable("pc.lateral_controller.steady_state.p") ? manager->getValue(Vars::pc_lateral_controller_steady_state_p) : 0.0; 
+                ki = manager->existsVariable("pc.lateral_controller.steady_state.i") ? manager->getValue(Vars::pc_lateral_controller_steady_state_i) : 0.0;
+                kd = manager->existsVariable("pc.lateral_controller.steady_state.d") ? manager->getValue(Vars::pc_lateral_controller_steady_state_d) : 0.0;
                 steadyStateLateralController.setSaturation(saturationMin, saturationMax);
                 steadyStateLateralController.setParameters(kp, ki, kd);
                 lateralPidOutput = steadyStateLateralController.update(pidErrorDistance);
 
-                manager->getVariable("pc.lateral_controller.steady_state.proportional")->setValue<double>(steadyStateLateralController.getProportional());
-                manager->getVariable("pc.lateral_controller.steady_state.integral")->setValue<double>(steadyStateLateralController.getIntegral());
-                manager->getVariable("pc.lateral_controller.steady_state.derivative")->setValue<double>(steadyStateLateralController.getDerivative());
-                manager->getVariable("pc.lateral_controller.steady_state.value")->setValue<double>(steadyStateLateralController.getOutput());
+                manager->setValue(Vars::pc_lateral_controller_steady_state_proportional, steadyStateLateralController.getProportional());
+                manager->setValue(Vars::pc_lateral_controller_steady_state_integral, steadyStateLateralController.getIntegral());
+                manager->setValue(Vars::pc_lateral_controller_steady_state_derivative, steadyStateLateralController.getDerivative());
+                manager->setValue(Vars::pc_lateral_controller_steady_state_value, steadyStateLateralController.getOutput());
             } else {
-                kp = manager->existsVariable("pc.lateral_controller.rough.p") ? manager->getVariable("pc.lateral_controller.rough.p")->getValue<double>() : 0.0;
+                kp = manager->existsVariable("pc.lateral_controller.rough.p") ? manager->getValue(Vars::pc_lateral_controller_rough_p) : 0.0;
                 roughLateralController.setSaturation(saturationMin, saturationMax);
                 roughLateralController.setParameters(kp, 0.0, 0.0);
                 lateralPidOutput = roughLateralController.update(pidErrorDistance);
 
-                manager->getVariable("pc.lateral_controller.rough.proportional")->setValue<double>(roughLateralController.getProportional());
-                manager->getVariable("pc.lateral_controller.rough.integral")->setValue<double>(roughLateralController.getIntegral());
-                manager->getVariable("pc.lateral_controller.rough.derivative")->setValue<double>(roughLateralController.getDerivative());
-                manager->getVariable("pc.lateral_controller.rough.value")->setValue<double>(roughLateralController.getOutput());
+                manager->setValue(Vars::pc_lateral_controller_rough_proportional, roughLateralController.getProportional());
+                manager->setValue(Vars::pc_lateral_controller_rough_integral, roughLateralController.getIntegral());
+                manager->setValue(Vars::pc_lateral_controller_rough_derivative, roughLateralController.getDerivative());
+                manager->setValue(Vars::pc_lateral_controller_rough_value, roughLateralController.getOutput());
             }
         } 
 
         lateralVelocity = -lateralPidOutput;
         longitudinalVelocity = sgn(linearVelocity) * sqrt(pow(linearVelocity, 2) - pow(lateralVelocity, 2)); // speed vactor may not go over the asked speed
-        angularVelocityPurePursuit = longitudinalVelocity * curvature;
+        angularVelocityPurePursuit = mpcActive ? mpcAngularVelocity : longitudinalVelocity * curvature;
         setVelocityOperation(longitudinalVelocity, lateralVelocity, angularVelocityPurePursuit);
     } else {        
         // PID for angular corrections
-        if (!resetPid && pidWeightFactor > 0.0) {
-            kp = manager->existsVariable("pc.purepursuit.pid.p") ? manager->getVariable("pc.purepursuit.pid.p")->getValue<double>() : 0.0; 
-            ki = manager->existsVariable("pc.purepursuit.pid.i") ? manager->getVariable("pc.purepursuit.pid.i")->getValue<double>() : 0.0;
-            kd = manager->existsVariable("pc.purepursuit.pid.d") ? manager->getVariable("pc.purepursuit.pid.d")->getValue<double>() : 0.0;
-            saturationMin = manager->existsVariable("pc.purepursuit.pid.saturation.min") ? manager->getVariable("pc.purepursuit.pid.saturation.min")->getValue<double>() : -1.0;
-            saturationMax = manager->existsVariable("pc.purepursuit.pid.saturation.max") ? manager->getVariable("pc.purepursuit.pid.saturation.max")->getValue<double>() : 1.0;
+        if (!resetPid && pidWeightFactor > 0.0 && !mpcActive) {
+            kp = manager->existsVariable("pc.purepursuit.pid.p") ? manager->getValue(Vars::pc_purepursuit_pid_p) : 0.0; 
+            ki = manager->existsVariable("pc.purepursuit.pid.i") ? manager->getValue(Vars::pc_purepursuit_pid_i) : 0.0;
+            kd = manager->existsVariable("pc.purepursuit.pid.d") ? manager->getValue(Vars::pc_purepursuit_pid_d) : 0.0;
+            saturationMin = manager->existsVariable("pc.purepursuit.pid.saturation.min") ? manager->getValue(Vars::pc_purepursuit_pid_saturation_min) : -1.0;
+            saturationMax = manager->existsVariable("pc.purepursuit.pid.saturation.max") ? manager->getValue(Vars::pc_purepursuit_pid_saturation_max) : 1.0;
             purepursuitController.setSaturation(saturationMin, saturationMax);
             purepursuitController.setParameters(kp, ki, kd);
             purePursuitPidOutput = purepursuitController.update(pidErrorDistance);
-            manager->getVariable("pc.purepursuit.pid.proportional")->setValue<double>(purepursuitController.getProportional());
-            manager->getVariable("pc.purepursuit.pid.integral")->setValue<double>(purepursuitController.getIntegral());
-            manager->getVariable("pc.purepursuit.pid.derivative")->setValue<double>(purepursuitController.getDerivative());
-            manager->getVariable("pc.purepursuit.pid.value")->setValue<double>(purepursuitController.getOutput());
+            manager->setValue(Vars::pc_purepursuit_pid_proportional, purepursuitController.getProportional());
+            manager->setValue(Vars::pc_purepursuit_pid_integral, purepursuitController.getIntegral());
+            manager->setValue(Vars::pc_purepursuit_pid_derivative, purepursuitController.getDerivative());
+            manager->setValue(Vars::pc_purepursuit_pid_value, purepursuitController.getOutput());
         }
 
         longitudinalVelocity = linearVelocity; 
         angularVelocityPurePursuit = longitudinalVelocity * curvature; 
         angularVelocity = purePursuitWeightFactor * angularVelocityPurePursuit + pidWeightFactor * purePursuitPidOutput; 
+        if (mpcActive) angularVelocity = mpcAngularVelocity;
         setVelocityOperation(longitudinalVelocity, 0.0, angularVelocity);
     }
+    if (lineFollowingMode == MPC && !mpcActive) {
+        mpc->applied(manager->getValue(Vars::plc_control_navigation_velocity_angular));
+    }
+
+    manager->setValue(Vars::pc_purepursuit_curvature_default, curvatureDefault);
+    manager->setValue(Vars::pc_purepursuit_curvature, curvature);
+
+}
+
+bool NavigationControl::modelPredictive(double velocity, double& angularVelocity) {
+    bool enable = manager->existsVariable("pc.mpc.enable") && manager->getValue(Vars::pc_mpc_enable);
+    lineFollowingMode = enable ? MPC : PUREPURSUIT;
+    if (lineFollowingMode != MPC) return false;
+
+    // the largest compiled horizon up to the configured horizon
+    int requestedHorizon = manager->existsVariable("pc.mpc.horizon") ? manager->getValue(Vars::pc_mpc_horizon) : 20;
+    int horizon = MPC_HORIZONS.front();
+    for (int h: MPC_HORIZONS) {
+        if (h <= requestedHorizon) horizon = h;
+    }
+    if (!mpc || mpc->getHorizon() != horizon) {
+        LoggerStream::getInstance() << INFO << "MPC line following with a horizon of " << horizon << " steps.";
+        mpc = MpcController::create(horizon);
+        mpcCurvature.assign(horizon, 0.0);
+    }
 
-    manager->getVariable("pc.purepursuit.curvature_default")->setValue<double>(curvatureDefault);
-    manager->getVariable("pc.purepursuit.curvature")->setValue<double>(curvature);
+    MpcSettings settings;
+    if (manager->existsVariable("pc.mpc.dt")) settings.dt = manager->getValue(Vars::pc_mpc_dt);
+    if (manager->existsVariable("pc.mpc.budget")) settings.budget = chrono::microseconds(int(manager->getValue(Vars::pc_mpc_budget) * 1000));
+    if (manager->existsVariable("pc.mpc.q_lateral")) settings.qLateral = manager->getValue(Vars::pc_mpc_q_lateral);
+    if (manager->existsVariable("pc.mpc.q_heading")) settings.qHeading = manager->getValue(Vars::pc_mpc_q_heading);
+    if (manager->existsVariable("pc.mpc.r_angular")) settings.rAngular = manager->getValue(Vars::pc_mpc_r_angular);
+    if (manager->existsVariable("pc.mpc.r_rate")) settings.rRate = manager->getValue(Vars::pc_mpc_r_rate);
+    if (manager->existsVariable("pc.mpc.max_angular")) settings.maxAngular = manager->getValue(Vars::pc_mpc_max_angular);
+    if (!(settings == mpc->getSettings())) mpc->setSettings(settings);
+
+    // errors to the path and the curvature of the path ahead, over the distance driven per step
+    int index = position->closestPoint.index;
+    Line line = traject->pathLine(index);
+    double lateral = -traject->isPointLeft(index, position->currentPoint) * line.distance(position->currentPoint);
+    double heading = DegToRad(calcSmallestAngle(position->heading, toRobotFrame(line.alpha())));
+    double interpolationDistance = manager->getValue(Vars::pc_purepursuit_inter_point_distance);
+    double stepDistance = abs(velocity) * settings.dt;
+    for (int k = 0; k < horizon; k++) {
+        mpcCurvature[k] = traject->pathCurvature(index + int(k * stepDistance / interpolationDistance), max(stepDistance, 0.5));
+    }
 
+    MpcResult result = mpc->solve(lateral, heading, velocity, mpcCurvature.data());
+    if (manager->existsVariable("pc.mpc.solve_time")) manager->setValue(Vars::pc_mpc_solve_time, result.solveTime);
+    if (manager->existsVariable("pc.mpc.iterations")) manager->setValue(Vars::pc_mpc_iterations, result.iterations);
+    if (manager->existsVariable("pc.mpc.fallback")) manager->setValue(Vars::pc_mpc_fallback, !result.valid);
+    if (mpcFallback != !result.valid) {
+        mpcFallback = !result.valid;
+        LoggerStream::getInstance() << DEBUG << (mpcFallback ? "MPC - Budget exceeded (" + to_string(result.solveTime) + " us), pure pursuit steers." : "MPC - Within budget again.");
+    }
+    angularVelocity = result.angular;
+    return result.valid;
 }
 
 bool NavigationControl::straightLine(double deaccelerationDistance) {
-    int pointsToIntersection = int((manager->getVariable("pc.navigation.turning_radius")->getValue<double>() + deaccelerationDistance) / manager->getVariable("pc.purepursuit.inter_point_distance")->getValue<double>());
+    int pointsToIntersection = int((manager->getValue(Vars::pc_navigation_turning_radius) + deaccelerationDistance) / manager->getValue(Vars::pc_purepursuit_inter_point_distance));
     
     purePursuit();
 
@@ -301,7 +362,7 @@ bool NavigationControl::creepToCorner() {
             longitudinalVelocity = creepVelocity.longitudinal * (lateralVelocity/creepVelocity.lateral);
         } else {
             // drive forward until the turning point
-            longitudinalVelocity = creepVelocity.longitudinal * (distanceToIntersection / manager->getVariable("pc.purepursuit.carrot_distance")->getValue<double>());   // speed is proportional with the distance to the intersec point
+            longitudinalVelocity = creepVelocity.longitudinal * (distanceToIntersection / manager->getValue(Vars::pc_purepursuit_carrot_distance));   // speed is proportional with the distance to the intersec point
             if (longitudinalVelocity < manager->getPlatform().auto_velocity.min) longitudinalVelocity = manager->getPlatform().auto_velocity.min; // saturation on manager->getPlatform().auto_velocity.min m/s
             lateralVelocity = 0.0;
         }
@@ -321,11 +382,11 @@ bool NavigationControl::creepToPosition()
 
     double distanceToNextCorner = position->corners.nextCorner.point.distance(position->currentPoint);
     double distanceToPreviousCorner = position->corners.previousCorner.point.distance(position->currentPoint);
-    bool condition1 = distanceToNextCorner >= manager->getVariable("pc.navigation.turning_radius")->getValue<double>();
+    bool condition1 = distanceToNextCorner >= manager->getValue(Vars::pc_navigation_turning_radius);
     bool condition2 = distanceToPreviousCorner < distanceToNextCorner;
 
     if (condition1 && condition2) {
-        LoggerStream::getInstance() << DEBUG << "distanceToNextCorner >= ppData.rotationRadius, distanceToNextCorner (m): " << distanceToNextCorner << ", rotationRadius (m): " << manager->getVariable("pc.navigation.turning_radius")->getValue<double>();
+        LoggerStream::getInstance() << DEBUG << "distanceToNextCorner >= ppData.rotationRadius, distanceToNextCorner (m): " << distanceToNextCorner << ", rotationRadius (m): " << manager->getValue(Vars::pc_navigation_turning_radius);
         LoggerStream::getInstance() << DEBUG << "distanceToPreviousCorner < distanceToNextCorner, distanceToPreviousCorner (m): " << distanceToPreviousCorner << ", distanceToNextCorner (m): " << distanceToNextCorner;
         setVelocityOperation();
         return false;
@@ -355,19 +416,19 @@ bool NavigationControl::spinning() {
     double smallestAngle;  // in degrees
     smallestAngle = calcSmallestAngle(position->heading, algorithm.headingGoal);
 
-    double stopTurnAngle = manager->existsVariable("pc.navigation.stop_turn_angle") ? manager->getVariable("pc.navigation.stop_turn_angle")->getValue<double>() : 0.0;
+    double stopTurnAngle = manager->existsVariable("pc.navigation.stop_turn_angle") ? manager->getValue(Vars::pc_navigation_stop_turn_angle) : 0.0;
     if (stopTurning(smallestAngle, stopTurnAngle)) {
         LoggerStream::getInstance() << DEBUG << "yaw: " << position->heading << "°, algorithm.headingGoal: " << algorithm.headingGoal << "°";
 
 	    return false;
     } else {
         // slow down when approaching proper corner
-	    double spinVel = manager->getVariable("pc.navigation.spinning_velocity")->getValue<double>();
+	    double spinVel = manager->getValue(Vars::pc_navigation_spinning_velocity);
         if (abs(smallestAngle) < 10 ) spinVel *= (1.0/3.0);
         else if (abs(smallestAngle) < 20 ) spinVel *= (1.0/2.0);
         else if (abs(smallestAngle) < 30 ) spinVel *= (2.0/3.0);
 
-        manager->getVariable("plc.control.navigation.velocity.angular")->setValue<double>(- sgn(smallestAngle) * spinVel);
+        manager->setValue(Vars::plc_control_navigation_velocity_angular, - sgn(smallestAngle) * spinVel);
 
         return true;
     }
@@ -412,7 +473,7 @@ void NavigationControl::stateMachineSpinning() {
             algorithm.turn180 = false;
             algorithm.fsmState = SPINNING;
             // When spinning state, disable implement operation when spinning
-            manager->getVariable("pc.implement.disable")->setValue(true);
+            manager->setValue(Vars::pc_implement_disable, true);
             // Update corner and set heading goal
             nextCorner();
             algorithm.headingGoal = toRobotFrame(traject->absPathOrientation(position->corners.previousCorner.index+3) );
@@ -428,7 +489,7 @@ void NavigationControl::stateMachineSpinning() {
             steadyStateLateralController.reset();
             roughLateralController.reset();
             // When going straightline state, enable implement operation again
-            manager->getVariable("pc.implement.disable")->setValue(false);
+            manager->setValue(Vars::pc_implement_disable, false);
         }
         break;}
     default:
@@ -474,7 +535,7 @@ void NavigationControl::stateMachineGTurn() {
             }
             algorithm.fsmState = SPINNING;
             // When going to spinning state, disable implement operation when spinning
-            manager->getVariable("pc.implement.disable")->setValue(true);
+            manager->setValue(Vars::pc_implement_disable, true);
         }
         break;}
     case SPINNING:{
@@ -500,7 +561,7 @@ void NavigationControl::stateMachineGTurn() {
                 steadyStateLateralController.reset();
                 roughLateralController.reset();
                 // When going straightline state, enable implement operation again
-                manager->getVariable("pc.implement.disable")->setValue(false);
+                manager->setValue(Vars::pc_implement_disable, false);
             }
 
         }
@@ -517,7 +578,7 @@ void NavigationControl::stateMachineGTurn() {
             steadyStateLateralController.reset();
             roughLateralController.reset();
             // When going straightline state, enable implement operation again
-            manager->getVariable("pc.implement.disable")->setValue(false);
+            manager->setValue(Vars::pc_implement_disable, false);
             nextCorner();
         }
         break;}
@@ -530,8 +591,8 @@ void NavigationControl::setTurningVelocity()
 {
     double longitudinalVelocity = manager->getPlatform().auto_velocity.min; // safety speed
     double signOmega = -traject->isPointLeft(position->corners.previousCorner.index-3, position->corners.nextCorner.point);
-    double turningRadius = manager->getVariable("pc.navigation.turning_radius")->getValue<double>();
-    double turningRadiusFactor = manager->existsVariable("pc.navigation.turning_radius_factor") ? manager->getVariable("pc.navigation.turning_radius_factor")->getValue<double>() : 1.0;
+    double turningRadius = manager->getValue(Vars::pc_navigation_turning_radius);
+    double turningRadiusFactor = manager->existsVariable("pc.navigation.turning_radius_factor") ? manager->getValue(Vars::pc_navigation_turning_radius_factor) : 1.0;
     turningRadiusFactor = turningRadiusFactor > 0.75 ? turningRadiusFactor : 1.0;
     double angularVelocity = signOmega * longitudinalVelocity / (turningRadius * turningRadiusFactor);
     creepVelocity.set(longitudinalVelocity, 0.0, angularVelocity);
@@ -547,7 +608,7 @@ void NavigationControl::stateMachineRollBack()
 
             algorithm.fsmState = TURN;
             // When turning state, disable implement operation when turning
-            manager->getVariable("pc.implement.disable")->setValue(true);
+            manager->setValue(Vars::pc_implement_disable, true);
 
             // update next corner
             nextCorner();
@@ -560,8 +621,8 @@ void NavigationControl::stateMachineRollBack()
         }
         break;}
     case TURN:{
-        bool turnNextCorner = position->corners.nextCorner.point.distance(position->currentPoint) <= (manager->getVariable("pc.navigation.turning_radius")->getValue<double>() + 1.5);
-        double stopTurnAngle = manager->existsVariable("pc.navigation.stop_turn_angle") ? manager->getVariable("pc.navigation.stop_turn_angle")->getValue<double>() : 0.0;
+        bool turnNextCorner = position->corners.nextCorner.point.distance(position->currentPoint) <= (manager->getValue(Vars::pc_navigation_turning_radius) + 1.5);
+        double stopTurnAngle = manager->existsVariable("pc.navigation.stop_turn_angle") ? manager->getValue(Vars::pc_navigation_stop_turn_angle) : 0.0;
         double earlyStoppingAngle = turnNextCorner ? 0.0 : stopTurnAngle;
         if (!turn(earlyStoppingAngle)) {
             // is there another corner nearby? Creep backwards to come in a good position to take this corner
@@ -573,7 +634,7 @@ void NavigationControl::stateMachineRollBack()
                 algorithm.fsmState = STRAIGHTLINE;
 
                 // When straightline state, enable implement operation when straightline
-                manager->getVariable("pc.implement.disable")->setValue(false);
+                manager->setValue(Vars::pc_implement_disable, false);
 
                 // reset the lateral controllers
                 algorithm.steadyState = false;
@@ -605,23 +666,23 @@ void NavigationControl::stateMachineRollBack()
 
 void NavigationControl::stopLinearOperation()
 {
-    manager->getVariable("plc.control.navigation.velocity.longitudinal")->setValue<double>(0);
-    manager->getVariable("plc.control.navigation.velocity.lateral")->setValue<double>(0);
+    manager->setValue(Vars::plc_control_navigation_velocity_longitudinal, 0);
+    manager->setValue(Vars::plc_control_navigation_velocity_lateral, 0);
 }
 
 void NavigationControl::setVelocityOperation(double longitudinalVelocity, double lateralVelocity, double omega)
 {
-    manager->getVariable("plc.control.navigation.velocity.lateral")->setValue<double>(0);
+    manager->setValue(Vars::plc_control_navigation_velocity_lateral, 0);
             
-    manager->getVariable("plc.control.navigation.velocity.longitudinal")->setValue<double>(longitudinalVelocity);
-    manager->getVariable("plc.control.navigation.velocity.angular")->setValue<double>(omega);
+    manager->setValue(Vars::plc_control_navigation_velocity_longitudinal, longitudinalVelocity);
+    manager->setValue(Vars::plc_control_navigation_velocity_angular, omega);
 
     if (manager->getPlatform().navModesContainsId(AlgorithmMode::PP_SPINNING_180)) {
-        manager->getVariable("plc.control.navigation.sideways")->setValue<bool>(getActiveSideways());
-        manager->getVariable("plc.control.navigation.velocity.lateral")->setValue<double>(lateralVelocity);
+        manager->setValue(Vars::plc_control_navigation_sideways, getActiveSideways());
+        manager->setValue(Vars::plc_control_navigation_velocity_lateral, lateralVelocity);
     } else {
-        manager->getVariable("plc.control.navigation.sideways")->setValue<bool>(false);
-        manager->getVariable("plc.control.navigation.velocity.lateral")->setValue<double>(0.0);
+        manager->setValue(Vars::plc_control_navigation_sideways, false);
+        manager->setValue(Vars::plc_control_navigation_velocity_lateral, 0.0);
     }
 }
 
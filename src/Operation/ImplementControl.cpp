@@ -1,4 +1,5 @@
 #include <Operation/ImplementControl.h>
+#include <Utils/Redis/VariableSchemaGenerated.h>
 #include <fstream>
 #include <algorithm>
 #include <vector>
@@ -8,6 +9,7 @@
 #include <Utils/Geometry/Angle.h>
 #include <Utils/Geometry/Point.h>
 #include <Utils/Logging/LoggerStream.h>
+#include <Utils/Timing/VirtualClock.h>
 
 using namespace Ilvo::Core;
 using namespace Ilvo::Exception;
@@ -15,6 +17,7 @@ using namespace Ilvo::Utils::Redis;
 using namespace Ilvo::Utils::Geometry;
 using namespace Ilvo::Utils::Settings;
 using namespace Ilvo::Utils::Logging;
+using namespace Ilvo::Utils::Timing;
 
 using namespace std;
 using namespace Eigen;
@@ -37,7 +40,8 @@ void ImplementControl::init(Utils::Redis::VariableManager* manager, shared_ptr<T
 
 void ImplementControl::update(bool autoMode) 
 {   
-    disableImplement = manager->getVariable("pc.implement.disable")->getValue<bool>();
+    disableImplement = manager->getValue(Vars::pc_implement_disable);
+    coverageResetEdge.detect(manager->getValue(Vars::pc_coverage_reset));
 
     // process
     for (Task& task: traject->getField().getTasks()) {  
@@ -55,6 +59,54 @@ void ImplementControl::update(bool autoMode)
             updateContinuous(task);
         }
     } 
+
+    if (coverageResetEdge.rising) {
+        LoggerStream::getInstance() << INFO << "Resetting the coverage of field " << traject->getField().getName();
+        for (Task& task: traject->getField().getTasks()) {
+            bool continuousTask = std::find(continuousOperationTypes.begin(), continuousOperationTypes.end(), task.getType()) != continuousOperationTypes.end();
+            CoverageMap* map = continuousTask ? coverage(task) : nullptr;
+            if (map) map->clear();
+        }
+        manager->setValue(Vars::pc_coverage_reset, false);
+    }
+}
+
+const map<string, unique_ptr<CoverageMap>>& ImplementControl::getCoverageMaps() const
+{
+    return coverageMaps;
+}
+
+CoverageMap* ImplementControl::coverage(Task& task)
+{
+    if (!manager->getValue(Vars::pc_coverage_enable)) {
+        return nullptr;
+    }
+
+    double resolution = manager->getValue(Vars::pc_coverage_resolution);
+    if (resolution <= 0.0) {
+        return nullptr;
+    }
+    if (coverageField != traject->getField().getName()) {
+        coverageMaps.clear();
+        coverageField = traject->getField().getName();
+    }
+    auto it = coverageMaps.find(task.getName());
+    if (it != coverageMaps.end() && it->second->getResolution() == resolution) {
+        return it->second.get();
+    }
+
+    string directory;
+    if (!isVirtualTime() && getenv("ILVO_PATH")) {
+        directory = (path(getenv("ILVO_PATH")) / "coverage" / traject->getField().getName() / task.getName()).string();
+    }
+    coverageMaps.erase(task.getName());
+    try {
+        coverageMaps[task.getName()] = make_unique<CoverageMap>(resolution, directory);
+    } catch (const std::exception& e) {
+        LoggerStream::getInstance() << ERROR << "Coverage of task " << task.getName() << " is kept in memory, " << e.what();
+        coverageMaps[task.getName()] = make_unique<CoverageMap>(resolution);
+    }
+    return coverageMaps[task.getName()].get();
 }
 
 void ImplementControl::reset()
@@ -95,7 +147,7 @@ void ImplementControl::reset()
 
     // Reset other parameters
     LoggerStream::getInstance() << INFO << " - Resetting other parameters.";
-    manager->getVariable("pc.implement.slow_down")->setValue(false);
+    manager->setValue(Vars::pc_implement_slow_down, false);
 }
 
 void ImplementControl::updateHitch(Task& task) {
@@ -133,7 +185,8 @@ void ImplementControl::updateContinuous(Task& task)
 {
     string activateName = "plc.control." + task.getHitch().getEntityName() + ".activate_continuous";
 
-    bool active = task.updateSections(manager, disableImplement);
+    double overlap = manager->getValue(Vars::pc_coverage_overlap);
+    bool active = task.updateSections(manager, disableImplement, coverage(task), overlap);
 
     manager->getVariable(activateName)->setValue(active);
 } 
@@ -150,8 +203,7 @@ void ImplementControl::updateCardan(Task& task)
 void ImplementControl::updateDiscrete(Task& task)
 {
     // first execute onDiscrPoint to set implPoint properly
-    double interpolationDistance = manager->getVariable("pc.purepursuit.inter_point_distance")->getValue<double>();
-    double pathDistanceToNextPoint = traject->distanceToNextDiscrPoint(task, interpolationDistance);
+    double pathDistanceToNextPoint = traject->distanceToNextDiscrPoint(task);
     task.activateSection("P", currentDiscrImplState == MEASURING);
 
     switch (currentDiscrImplState)
@@ -159,7 +211,7 @@ void ImplementControl::updateDiscrete(Task& task)
     case DRIVING:
         if (inRange(0.0, 1.5, pathDistanceToNextPoint)) {
             LoggerStream::getInstance() << DEBUG <<"pathDistanceToNextPoint: " << pathDistanceToNextPoint << " - DRIVING -> SLOW_DOWN";
-            manager->getVariable("pc.implement.slow_down")->setValue(true);
+            manager->setValue(Vars::pc_implement_slow_down, true);
             currentDiscrImplState = SLOW_DOWN;
         }
         break;
@@ -189,7 +241,7 @@ void ImplementControl::updateDiscrete(Task& task)
             busyDiscrImplEdge.detect(discreteImplementActive);
             if (busyDiscrImplEdge.falling) {
                 LoggerStream::getInstance() << DEBUG <<"MEASURING -> DRIVING";
-                manager->getVariable("pc.implement.slow_down")->setValue(false);
+                manager->setValue(Vars::pc_implement_slow_down, false);
                 manager->getVariable("plc.control." + task.getHitch().getEntityName() + ".activate")->setValue(false);
                 currentDiscrImplState = DRIVING;
             }
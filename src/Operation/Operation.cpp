@@ -1,8 +1,10 @@
 #include <Operation/Operation.h>
+#include <Utils/Redis/VariableSchemaGenerated.h>
 #include <boost/filesystem.hpp>
 #include <ThirdParty/json.hpp>
 #include <Utils/Settings/Field.h>
 #include <Utils/Timing/Timing.h>
+#include <Utils/Timing/VirtualClock.h>
 #include <Exceptions/FileExceptions.hpp>
 #include <Exceptions/RobotExceptions.hpp>
 
@@ -12,6 +14,7 @@ using namespace Ilvo::Utils::Redis;
 using namespace Ilvo::Utils::Geometry;
 using namespace Ilvo::Utils::Settings;
 using namespace Ilvo::Utils::Logging;
+using namespace Ilvo::Utils::Timing;
 
 using namespace std;
 using namespace chrono_literals;
@@ -21,7 +24,16 @@ using namespace boost::filesystem;
 
 
 Operation::Operation(const string ns) : 
-    VariableManager(ns)
+    VariableManager(ns),
+    fieldUpdated(false),
+    implStatesOutdated(true)
+{ 
+}
+
+Operation::Operation(const string ns, shared_ptr<LocalStore> store) : 
+    VariableManager(ns, store),
+    fieldUpdated(false),
+    implStatesOutdated(true)
 { 
 }
 
@@ -31,21 +43,93 @@ void Operation::init()
     traject = make_unique<Traject>();
     position = make_unique<PositionData>();
     implementControl.init(this, traject, position);
+    onVariableChanged(Vars::pc_field_updated, [this](VariablePtr var) {
+        edgeDetectorField.detect(var->getValue<bool>());
+        fieldUpdated |= edgeDetectorField.rising;
+    });
 }
 
 
 void Operation::setRedisJsonImplStates()
 {
+    double frequency = getValue(Vars::pc_implement_ui_frequency);
+    auto now = steadyNow();
+    if (frequency > 0.0 && now - implStatesTime < chrono::duration<double>(1.0 / frequency)) {
+        return;
+    }
+
+    auto visualized = [this](Task& task) {
+        return !task.isType("cardan") && find(implementTypes.begin(), implementTypes.end(), task.getType()) != implementTypes.end();
+    };
+    bool changed = implStatesOutdated;
+    for (Task& task: traject->getField().getTasks()) {
+        if (changed) break;
+        changed = visualized(task) && task.getImplement().visualizationChanged();
+    }
+    if (!changed) {
+        return;
+    }
+
     json jImplements = json();
     for (Task& task: traject->getField().getTasks()) {
-        if (!task.isType("cardan")) {
-            bool implementType = find(implementTypes.begin(), implementTypes.end(), task.getType()) != implementTypes.end();
-            if (implementType) {
-                jImplements[task.getImplement().getName()] = task.getImplement().visualizeJson(platform.gps.utm_zone);
-            }  
+        if (visualized(task)) {
+            jImplements[task.getImplement().getName()] = task.getImplement().visualize(platform.gps.utm_zone);
         }
     }
-    rs.setRedisJsonValue("implement.states", jImplements);   
+    rs.setRedisJsonValue("implement.states", jImplements);
+    implStatesOutdated = false;
+    implStatesTime = now;
+}
+
+
+void Operation::setRedisCoverage()
+{
+    double frequency = getValue(Vars::pc_coverage_ui_frequency);
+    auto now = steadyNow();
+    if (frequency > 0.0 && now - coverageTime < chrono::duration<double>(1.0 / frequency)) {
+        return;
+    }
+    coverageTime = now;
+
+    json jTiles = json::object();
+    size_t budget = COVERAGE_TILES_PER_EXPORT;
+    for (const auto& [taskName, coverage]: implementControl.getCoverageMaps()) {
+        // a tile is listed once it is written
+        set<string> written;
+        if (jCoverage.contains(taskName)) {
+            for (const auto& jTile: jCoverage[taskName]["tiles"]) {
+                written.insert(jTile.get<string>());
+            }
+        }
+        vector<uint64_t> changed = coverage->takeChangedTiles(budget);
+        budget -= changed.size();
+        for (uint64_t key: changed) {
+            rs.setRedisJsonValue("coverage." + taskName + "." + CoverageMap::tileName(key), coverage->exportTile(key));
+            written.insert(CoverageMap::tileName(key));
+        }
+        jTiles[taskName]["resolution"] = coverage->getResolution();
+        jTiles[taskName]["tiles"] = json::array();
+        for (uint64_t key: coverage->getTiles()) {
+            if (written.count(CoverageMap::tileName(key))) {
+                jTiles[taskName]["tiles"].push_back(CoverageMap::tileName(key));
+            }
+        }
+    }
+    if (jTiles == jCoverage) {
+        return;
+    }
+
+    // tiles that were cleared
+    for (const auto& [taskName, jTask]: jCoverage.items()) {
+        for (const auto& jTile: jTask["tiles"]) {
+            bool kept = jTiles.contains(taskName) && find(jTiles[taskName]["tiles"].begin(), jTiles[taskName]["tiles"].end(), jTile) != jTiles[taskName]["tiles"].end();
+            if (!kept) {
+                rs.delRedisValues("coverage." + taskName + "." + jTile.get<string>());
+            }
+        }
+    }
+    rs.setRedisJsonValue("coverage", jTiles);
+    jCoverage = jTiles;
 }
 
 
@@ -53,16 +137,18 @@ void Operation::serverTick()
 {
     updatePlatformState();
 
-    edgeDetectorField.detect( getVariable("pc.field.updated")->getValue<bool>());
-    bool activeAuto = getVariable("pc.simulation.auto")->getValue<bool>() || getVariable("plc.monitor.state.auto")->getValue<bool>();
+    bool fieldRising = fieldUpdated;
+    fieldUpdated = false;
+    bool activeAuto = getValue(Vars::pc_simulation_auto) || getValue(Vars::plc_monitor_state_auto);
     edgeDetectorAutomode.detect( activeAuto );
 
-    if (edgeDetectorField.rising || traject->empty()) {
-        traject->load(Field::checkFieldName(getVariable("pc.field.name")->getValue<string>()), 
+    if (fieldRising || traject->empty()) {
+        traject->load(Field::checkFieldName(getValue(Vars::pc_field_name)), 
                     getPlatform().gps.utm_zone, 
-                    getVariable("pc.navigation.spin_angle")->getValue<double>(),
-                    getVariable("pc.purepursuit.inter_point_distance")->getValue<double>(),
-                    getVariable("pc.navigation.turning_radius")->getValue<double>());
+                    getValue(Vars::pc_navigation_spin_angle),
+                    getValue(Vars::pc_purepursuit_inter_point_distance),
+                    getValue(Vars::pc_navigation_turning_radius));
+        implStatesOutdated = true;
 
         if (traject->empty()) {
             LoggerStream::getInstance() << DEBUG << "Traject loaded failed";
@@ -72,11 +158,11 @@ void Operation::serverTick()
     }
 
     // detect creation or loading of new field.
-    if (edgeDetectorAutomode.rising || edgeDetectorField.rising) {
+    if (edgeDetectorAutomode.rising || fieldRising) {
         LoggerStream::getInstance() << INFO <<"Resetting the field: ";
         if (edgeDetectorAutomode.rising) {
             LoggerStream::getInstance() << INFO <<"Auto mode is started.";
-        } else if (edgeDetectorField.rising) {
+        } else if (fieldRising) {
         }
         
         implementControl.reset();
@@ -87,19 +173,5 @@ void Operation::serverTick()
 
     // set redis states
     setRedisJsonImplStates();
-}
-
-
-int main() {
-    // First check if ILVO_PATH environment variable is set
-    if (getenv("ILVO_PATH") == NULL) { 
-        throw EnvVariableNotFoundException("$ILVO_PATH");
-    }
-
-    string procName = "ilvo-operation";
-    LoggerStream::createInstance(procName);
-    LoggerStream::getInstance() << INFO << "Operation Logger started";
-    Operation operation(procName);
-    operation.run();
-    return 0;  
+    setRedisCoverage();
 }
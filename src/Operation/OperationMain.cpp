@@ -0,0 +1,24 @@
+#include <Operation/Operation.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <Exceptions/FileExceptions.hpp>
+
+using namespace Ilvo::Exception;
+using namespace Ilvo::Core;
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+
+
+int main() {
+    // First check if ILVO_PATH environment variable is set
+    if (getenv("ILVO_PATH") == NULL) { 
+        throw EnvVariableNotFoundException("$ILVO_PATH");
+    }
+
+    string procName = "ilvo-operation";
+    LoggerStream::createInstance(procName);
+    LoggerStream::getInstance() << INFO << "Operation Logger started";
+    Operation operation(procName);
+    operation.run();
+    return 0;  
+}
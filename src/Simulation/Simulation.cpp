@@ -2,6 +2,7 @@
 #include <Utils/Geometry/Angle.h>
 #include <Utils/Logging/LoggerStream.h>
 #include <Simulation/Simulation.h>
+#include <Utils/Redis/VariableSchemaGenerated.h>
 #include <Exceptions/RobotExceptions.hpp>
 #include <Exceptions/FileExceptions.hpp>
 
@@ -9,6 +10,7 @@
 #include <chrono>
 
 using namespace Ilvo::Core;
+using namespace Ilvo::Utils::Redis;
 using namespace Ilvo::Utils::Geometry;
 using namespace Ilvo::Utils::Settings;
 using namespace Ilvo::Utils::Logging;
@@ -21,47 +23,61 @@ using namespace Eigen;
 
 
 Simulation::Simulation(const string ns) : 
-    VariableManager(ns), discreteImplementActive(false)
+    VariableManager(ns), discreteImplementActive(false),
+    plant(platform.plant, platform.navModesContainsId(AlgorithmMode::PP_SPINNING_180)), trueRobotRefValid(false)
+{}
+
+Simulation::Simulation(const string ns, shared_ptr<LocalStore> store) : 
+    VariableManager(ns, store), discreteImplementActive(false),
+    plant(platform.plant, platform.navModesContainsId(AlgorithmMode::PP_SPINNING_180)), trueRobotRefValid(false)
 {}
 
 void Simulation::init() {
-    field = std::make_shared<Field>(Field::checkFieldName(getVariable("pc.field.name")->getValue<string>()), platform.gps.utm_zone);
-}
+    field = std::make_shared<Field>(Field::checkFieldName(getValue(Vars::pc_field_name)), platform.gps.utm_zone);
 
-void Simulation::serverTick() {
     // Propagate simulation to programming mode
-    getVariable("plc.control.substate.programming")->setValue<bool>(getVariable("pc.simulation.active")->getValue<bool>());
+    onVariableChanged(Vars::pc_simulation_active, [this](VariablePtr var) {
+        setValue(Vars::plc_control_substate_programming, var->getValue<bool>());
+    });
+
+    // update field at the end of the pulse of the field update
+    onVariableChanged(Vars::pc_field_updated, [this](VariablePtr var) {
+        edgeDetectorField.detect(var->getValue<bool>());
+        if ( edgeDetectorField.falling ) {
+            field = std::make_shared<Field>(Field::checkFieldName(getValue(Vars::pc_field_name)), platform.gps.utm_zone);
+        }
+    });
+}
 
+void Simulation::serverTick() {
     // Check for end reached
-    if (getVariable("plc.control.navigation.end_reached")->getValue<bool>()) {
+    if (getValue(Vars::plc_control_navigation_end_reached)) {
         LoggerStream::getInstance() << DEBUG <<"set simulationAuto False";
-        getVariable("pc.simulation.auto")->setValue<bool>(false);
-    }
-
-    // update field
-    edgeDetectorField.detect( getVariable("pc.field.updated")->getValue<bool>());
-    if ( edgeDetectorField.falling ) {
-        field = std::make_shared<Field>(Field::checkFieldName(getVariable("pc.field.name")->getValue<string>()), platform.gps.utm_zone);
+        setValue(Vars::pc_simulation_auto, false);
     }
 
     // simulation
-    if ( getVariable("pc.simulation.active")->getValue<bool>() ) {
+    if ( getValue(Vars::pc_simulation_active) ) {
         // ** GET CURRENT STATE **
         // Robot local coordinate system
         //      y
         //      |
         //      |
         //    z .____ x
-        double yVelocity = getVariable("plc.control.navigation.velocity.longitudinal")->getValue<double>();
+        double yVelocity = getValue(Vars::plc_control_navigation_velocity_longitudinal);
         double xVelocity = 0;
         if (platform.navModesContainsId(AlgorithmMode::PP_SPINNING_180)) {
-            xVelocity = getVariable("plc.control.navigation.velocity.lateral")->getValue<double>();
+            xVelocity = getValue(Vars::plc_control_navigation_velocity_lateral);
         }
-        double zVelocity = getVariable("plc.control.navigation.velocity.angular")->getValue<double>();
+        double zVelocity = getValue(Vars::plc_control_navigation_velocity_angular);
 
-        getVariable("plc.monitor.navigation.velocity.longitudinal")->setValue<double>(yVelocity);
-        getVariable("plc.monitor.navigation.velocity.lateral")->setValue<double>(xVelocity);
-        getVariable("plc.monitor.navigation.velocity.angular")->setValue<double>(zVelocity);
+        double ts = clk.getIntervalMs()*1e-3 * getValue(Vars::pc_simulation_factor); // 50 ms
+
+        // the monitor velocities are the velocities realized by the actuators
+        PlantVelocity actuated = plant.actuate({yVelocity, xVelocity, zVelocity}, ts);
+        setValue(Vars::plc_monitor_navigation_velocity_longitudinal, actuated.longitudinal);
+        setValue(Vars::plc_monitor_navigation_velocity_lateral, actuated.lateral);
+        setValue(Vars::plc_monitor_navigation_velocity_angular, actuated.angular);
 
         // ** GET NEW STATE **
         // GET DISCR IMPL DURING PROGRAMMING MODE TEST WITH PLC
@@ -81,7 +97,7 @@ void Simulation::serverTick() {
             if (!discreteImplementActive && startDiscreteImplementEdge.rising) {
                 discreteImplementActive = true;
                 getVariable(busyName)->setValue<bool>(true);
-                if (!getVariable("plc.monitor.state.auto")->getValue<bool>()) {
+                if (!getValue(Vars::plc_monitor_state_auto)) {
                     // only when not attachted to actual robot, otherwise wait on robot change of busy variable
                     getVariable(notificationName)->setValue("Setting variable " + busyName + " to false to continue the simulation.");
                 }
@@ -92,7 +108,7 @@ void Simulation::serverTick() {
                 } 
                 
                 // turn of busy when user notification was acknowledged
-                if (!getVariable("plc.monitor.state.auto")->getValue<bool>()) {
+                if (!getValue(Vars::plc_monitor_state_auto)) {
                     // only when not attachted to actual robot, otherwise wait on robot change of busy variable
                     string notification = getVariable(notificationName)->getValue<string>();
                     notificationAcknowledgeEdge.detect(notification == "-");
@@ -108,29 +124,32 @@ void Simulation::serverTick() {
 
         // CREATE NEW STATE VARIABLES
         if (!(clk.checkTimerBusy() || discreteImplementActive)) {
-            platform.robot.updateState(getRedisState("robot.ref").asAffine());
+            if (plant.hasGnssModel() && trueRobotRefValid) {
+                platform.robot.updateState(trueRobotRef);
+            } else {
+                platform.robot.updateState(getRedisState("robot.ref").asAffine());
+            }
 
-            double ts = clk.getIntervalMs()*1e-3 * getVariable("pc.simulation.factor")->getValue<double>(); // 50 ms
-            
-            Affine3d velTransform = vectorToAffine(Vector3d(xVelocity * ts, yVelocity * ts, 0.0), Vector3d(0.0, 0.0, zVelocity * ts), false);
+            // velocities over the ground, with slip and creep
+            PlantVelocity v = plant.move(actuated, ts);
+            Affine3d velTransform = vectorToAffine(Vector3d(v.lateral * ts, v.longitudinal * ts, 0.0), Vector3d(0.0, 0.0, v.angular * ts), false);
             State newRawGpsState = platform.applyVelocityOnRobotRef(velTransform);
 
+            if (plant.hasGnssModel()) {
+                trueRobotRef = platform.robot.getState().asAffine();
+                trueRobotRefValid = true;
+                // publish the measured states
+                newRawGpsState = State(plant.measure(newRawGpsState.asAffine(), ts));
+                platform.updateState(newRawGpsState.asAffine());
+            }
+
             // ** SET NEW STATE **
+            startTrace(traceNow());
             setRedisJsonStates(platform, newRawGpsState);  
         } 
-    } 
-}
-
-int main() {
-    // First check if ILVO_PATH environment variable is set
-    if (getenv("ILVO_PATH") == NULL) { 
-        throw EnvVariableNotFoundException("$ILVO_PATH");
+    } else {
+        // restart from the published state when the simulation is activated again
+        trueRobotRefValid = false;
+        plant.resetGnss();
     }
-
-    string procName = "ilvo-simulation";
-    LoggerStream::createInstance(procName);
-    LoggerStream::getInstance() << INFO << "Simulation Logger started";
-    Simulation simulation(procName);
-    simulation.run();
-    return 0;    
-}
\ No newline at end of file
+}
@@ -0,0 +1,167 @@
+#include <Simulation/SimulationEngine.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <Exceptions/FileExceptions.hpp>
+
+#include <sys/wait.h>
+#include <unistd.h>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <map>
+
+using namespace Ilvo::Core;
+using namespace Ilvo::Exception;
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+using namespace nlohmann;
+
+
+namespace {
+
+    void usage()
+    {
+        cerr << "Usage: ilvo-simulation-batch <scenarios.json> [-j workers] [-o results.json]" << endl;
+        cerr << "  scenarios.json: {\"defaults\": {...}, \"scenarios\": [{\"name\": ..., \"variables\": {...}}, ...]}" << endl;
+    }
+
+    /** @brief Merge the defaults into every scenario, scenario values win */
+    vector<SimulationScenario> readScenarios(const string& path)
+    {
+        std::ifstream ifs(path);
+        if (!ifs.is_open()) {
+            throw PathNotFoundException(path);
+        }
+        json j = json::parse(ifs);
+        json defaults = j.is_object() && j.contains("defaults") ? j["defaults"] : json::object();
+        json jScenarios = j.is_array() ? j : j["scenarios"];
+
+        vector<SimulationScenario> scenarios;
+        for (size_t i = 0; i < jScenarios.size(); i++) {
+            json jScenario = defaults;
+            jScenario.merge_patch(jScenarios[i]);
+            if (!jScenario.contains("name")) jScenario["name"] = "scenario-" + to_string(i);
+            scenarios.push_back(SimulationScenario::fromJson(jScenario));
+        }
+        return scenarios;
+    }
+
+    /** @brief Simulate one scenario in a worker process and write the result to the pipe */
+    [[noreturn]] void runWorker(const SimulationScenario& scenario, int fd)
+    {
+        SimulationResult result;
+        result.name = scenario.name;
+        try {
+            LoggerStream::createInstance("ilvo-simulation-batch-" + scenario.name);
+            result = SimulationEngine(scenario).run();
+        } catch(const exception& e) {
+            result.error = e.what();
+        }
+
+        string message = result.toJson().dump();
+        size_t written = 0;
+        while (written < message.size()) {
+            ssize_t n = write(fd, message.data() + written, message.size() - written);
+            if (n <= 0) break;
+            written += n;
+        }
+        close(fd);
+        // skip the destructors of the singletons shared with the parent
+        _exit(0);
+    }
+
+    string readAll(int fd)
+    {
+        string message;
+        char buffer[4096];
+        ssize_t n;
+        while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+            message.append(buffer, n);
+        }
+        close(fd);
+        return message;
+    }
+}
+
+
+/**
+ * Runs the scenarios in parallel worker processes, each worker simulates one scenario with its own platform
+ * and logger singletons. The results are collected over pipes and written as a json array.
+ */
+int main(int argc, char** argv) {
+    if (getenv("ILVO_PATH") == NULL) {
+        throw EnvVariableNotFoundException("$ILVO_PATH");
+    }
+
+    string scenarioPath, outputPath;
+    size_t workers = max(1u, thread::hardware_concurrency());
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "-j" && i + 1 < argc) {
+            workers = max(1, stoi(argv[++i]));
+        } else if (arg == "-o" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else {
+            scenarioPath = arg;
+        }
+    }
+    if (scenarioPath.empty()) {
+        usage();
+        return 1;
+    }
+
+    vector<SimulationScenario> scenarios = readScenarios(scenarioPath);
+    vector<json> results(scenarios.size());
+    // running workers: pid -> (scenario index, read end of the pipe)
+    map<pid_t, pair<size_t, int>> running;
+    size_t next = 0;
+
+    auto collect = [&]() {
+        int status;
+        pid_t pid = wait(&status);
+        if (pid <= 0) return;
+        auto it = running.find(pid);
+        if (it == running.end()) return;
+        size_t index = it->second.first;
+        string message = readAll(it->second.second);
+        try {
+            results[index] = json::parse(message);
+        } catch(json::exception&) {
+            results[index] = {{"name", scenarios[index].name}, {"error", "worker exited with status " + to_string(status)}};
+        }
+        cerr << "[" << index + 1 << "/" << scenarios.size() << "] " << results[index].dump() << endl;
+        running.erase(it);
+    };
+
+    while (next < scenarios.size() || !running.empty()) {
+        if (next < scenarios.size() && running.size() < workers) {
+            int fds[2];
+            if (pipe(fds) != 0) {
+                throw runtime_error("Could not create a pipe for the simulation worker");
+            }
+            pid_t pid = fork();
+            if (pid == 0) {
+                close(fds[0]);
+                runWorker(scenarios[next], fds[1]);
+            } else if (pid < 0) {
+                throw runtime_error("Could not fork a simulation worker");
+            }
+            close(fds[1]);
+            running[pid] = make_pair(next, fds[0]);
+            next++;
+        } else {
+            collect();
+        }
+    }
+
+    json jResults = results;
+    if (outputPath.empty()) {
+        cout << jResults.dump(4) << endl;
+    } else {
+        std::ofstream(outputPath) << jResults.dump(4) << endl;
+    }
+    return 0;
+}
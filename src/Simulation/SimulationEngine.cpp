@@ -0,0 +1,305 @@
+#include <Simulation/SimulationEngine.h>
+#include <Simulation/Simulation.h>
+#include <Navigation/Navigation.h>
+#include <Operation/Operation.h>
+#include <Utils/Redis/LocalStore.h>
+#include <Utils/Redis/VariableSchemaGenerated.h>
+#include <Utils/Timing/VirtualClock.h>
+#include <Utils/Geometry/Transform.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <ThirdParty/UTM.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/geometry.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <algorithm>
+
+using namespace Ilvo::Core;
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Utils::Timing;
+using namespace Ilvo::Utils::Geometry;
+using namespace Ilvo::Utils::Settings;
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+using namespace nlohmann;
+using namespace Eigen;
+
+namespace {
+
+    /** @brief Running statistics of an error signal */
+    struct ErrorStatistics
+    {
+        size_t n = 0;
+        double sum = 0.0, sumSquared = 0.0, max = 0.0;
+
+        void add(double e) {
+            n++;
+            sum += abs(e);
+            sumSquared += e * e;
+            max = std::max(max, abs(e));
+        }
+        double mean() const { return n ? sum / n : 0.0; }
+        double rms() const { return n ? sqrt(sumSquared / n) : 0.0; }
+    };
+
+    /**
+     * @brief Raster of the geofence that keeps track of the covered cells
+     *
+     * @details Cells are covered when their center lies inside the polygon of an active section.
+     */
+    class CoverageRaster
+    {
+    private:
+        enum Cell : uint8_t { OUTSIDE, FREE, COVERED };
+
+        double resolution;
+        double xMin, yMin;
+        int nx, ny;
+        vector<uint8_t> cells;
+        size_t insideCount, coveredCount;
+
+        /** @brief Crossing number test of a point in a closed contour */
+        static bool inside(const vector<vector<double>>& contour, double x, double y) {
+            bool c = false;
+            for (size_t i = 0, j = contour.size() - 1; i < contour.size(); j = i++) {
+                double xi = contour[i][0], yi = contour[i][1];
+                double xj = contour[j][0], yj = contour[j][1];
+                if (((yi > y) != (yj > y)) && (x < (xj - xi) * (y - yi) / (yj - yi) + xi)) c = !c;
+            }
+            return c;
+        }
+    public:
+        CoverageRaster(const bgPolygon2D& geofence, double resolution) :
+            resolution(resolution), xMin(0.0), yMin(0.0), nx(0), ny(0), insideCount(0), coveredCount(0)
+        {
+            if (geofence.outer().empty()) return;
+
+            boost::geometry::model::box<bgPoint2D> box;
+            boost::geometry::envelope(geofence, box);
+            xMin = box.min_corner().x();
+            yMin = box.min_corner().y();
+            nx = ceil((box.max_corner().x() - xMin) / resolution);
+            ny = ceil((box.max_corner().y() - yMin) / resolution);
+            cells.assign(size_t(nx) * ny, OUTSIDE);
+            for (int j = 0; j < ny; j++) {
+                for (int i = 0; i < nx; i++) {
+                    bgPoint2D p(xMin + (i + 0.5) * resolution, yMin + (j + 0.5) * resolution);
+                    if (boost::geometry::within(p, geofence)) {
+                        cells[size_t(j) * nx + i] = FREE;
+                        insideCount++;
+                    }
+                }
+            }
+        }
+
+        void cover(const vector<vector<double>>& contour) {
+            if (contour.size() < 3 || cells.empty()) return;
+
+            double cxMin = contour[0][0], cxMax = contour[0][0], cyMin = contour[0][1], cyMax = contour[0][1];
+            for (const auto& p: contour) {
+                cxMin = min(cxMin, p[0]); cxMax = max(cxMax, p[0]);
+                cyMin = min(cyMin, p[1]); cyMax = max(cyMax, p[1]);
+            }
+            int iMin = max(0, int(floor((cxMin - xMin) / resolution)));
+            int iMax = min(nx - 1, int(ceil((cxMax - xMin) / resolution)));
+            int jMin = max(0, int(floor((cyMin - yMin) / resolution)));
+            int jMax = min(ny - 1, int(ceil((cyMax - yMin) / resolution)));
+            for (int j = jMin; j <= jMax; j++) {
+                for (int i = iMin; i <= iMax; i++) {
+                    uint8_t& cell = cells[size_t(j) * nx + i];
+                    if (cell == FREE && inside(contour, xMin + (i + 0.5) * resolution, yMin + (j + 0.5) * resolution)) {
+                        cell = COVERED;
+                        coveredCount++;
+                    }
+                }
+            }
+        }
+
+        double coverage() const {
+            return insideCount ? double(coveredCount) / insideCount : 0.0;
+        }
+    };
+
+    /** @brief Set the variables of a json object, in the same way as the system manager initializes redis */
+    void applyVariables(VariableManager& manager, const json& variables)
+    {
+        for (auto& el : variables.items()) {
+            if (!manager.existsVariable(el.key())) {
+                LoggerStream::getInstance() << WARN << "Simulation variable " << el.key() << " does not exist in the configuration, ignored.";
+                continue;
+            }
+            VariablePtr var = manager.getVariable(el.key());
+            if (var->getType() == "string") {
+                var->setValue(el.value().get<string>());
+            } else if (var->getType() == "bool") {
+                var->setValue(el.value().get<bool>());
+            } else {
+                var->setValue(el.value().get<double>());
+            }
+        }
+    }
+
+    json readInitVariables()
+    {
+        boost::filesystem::path p(string(getenv("ILVO_PATH")) + "/redis.init.json");
+        if (!boost::filesystem::exists(p)) return json::object();
+        try {
+            json j = json::parse(std::ifstream(p.string()));
+            return j.contains("variables") ? j["variables"] : json::object();
+        } catch(json::exception& e) {
+            LoggerStream::getInstance() << ERROR << "Redis init file parse error, file path: \"" << p << "\", " << e.what();
+            throw runtime_error("Redis init file parse error, " + std::string(e.what()));
+        }
+    }
+}
+
+
+SimulationScenario SimulationScenario::fromJson(const json& j)
+{
+    SimulationScenario scenario;
+    scenario.name = j.value("name", "scenario");
+    scenario.field = j.value("field", "");
+    scenario.navigationMode = j.value("mode", -1);
+    scenario.duration = j.value("duration", 600.0);
+    scenario.coverageResolution = j.value("coverage_resolution", 0.25);
+    scenario.ilvoPath = j.value("ilvo_path", "");
+    if (j.contains("variables")) scenario.variables = j["variables"];
+    return scenario;
+}
+
+json SimulationResult::toJson() const
+{
+    json j;
+    j["name"] = name;
+    if (!error.empty()) {
+        j["error"] = error;
+        return j;
+    }
+    j["end_reached"] = endReached;
+    j["notification"] = notification;
+    j["ticks"] = ticks;
+    j["simulated_time"] = simulatedTime;
+    j["wall_time"] = wallTime;
+    j["realtime_factor"] = wallTime > 0.0 ? simulatedTime / wallTime : 0.0;
+    j["distance_error"] = {{"rms", distanceErrorRms}, {"mean", distanceErrorMean}, {"max", distanceErrorMax}};
+    j["orientation_error"] = {{"rms", orientationErrorRms}, {"mean", orientationErrorMean}, {"max", orientationErrorMax}};
+    j["coverage"] = coverage;
+    return j;
+}
+
+
+SimulationEngine::SimulationEngine(SimulationScenario scenario) :
+    scenario(scenario)
+{}
+
+SimulationResult SimulationEngine::run()
+{
+    auto wallStart = chrono::steady_clock::now();
+    SimulationResult result;
+    result.name = scenario.name;
+
+    // the platform singleton is loaded from $ILVO_PATH on first use
+    if (!scenario.ilvoPath.empty()) {
+        setenv("ILVO_PATH", scenario.ilvoPath.c_str(), 1);
+    }
+
+    VirtualClock clock;
+    VirtualClockScope clockScope(clock);
+    auto store = make_shared<LocalStore>();
+
+    Simulation simulation("ilvo-simulation-" + scenario.name, store);
+    Navigation navigation("ilvo-navigation-" + scenario.name, store);
+    Operation operation("ilvo-operation-" + scenario.name, store);
+    Platform& platform = simulation.getPlatform();
+
+    // variables
+    applyVariables(simulation, readInitVariables());
+    applyVariables(simulation, scenario.variables);
+    if (!scenario.field.empty()) {
+        simulation.setValue(Vars::pc_field_name, scenario.field);
+    }
+    if (scenario.navigationMode >= 0) {
+        simulation.setValue(Vars::pc_navigation_mode, scenario.navigationMode);
+    }
+    simulation.setValue(Vars::pc_simulation_active, true);
+    simulation.setValue(Vars::pc_simulation_factor, 1.0);
+    simulation.setValue(Vars::pc_simulation_auto, false);
+    // the coverage is taken from the implement states of every tick, the coverage tiles keep 'pc.coverage.ui_frequency'
+    simulation.setValue(Vars::pc_implement_ui_frequency, 0.0);
+    simulation.writeRedisVariables();
+
+    string fieldName = Field::checkFieldName(simulation.getValue(Vars::pc_field_name));
+    Field field(fieldName, platform.gps.utm_zone);
+    const auto& trajectPoints = field.getTrajectPoints();
+    if (trajectPoints.size() < 2) {
+        throw runtime_error("Traject of field " + fieldName + " has less than 2 points");
+    }
+
+    // place the robot at the start of the traject, heading along the first segment
+    const Point& p0 = *trajectPoints[0];
+    const Point& p1 = *trajectPoints[1];
+    double heading = toRobotFrame(RadToDeg(std::atan2(p1.y() - p0.y(), p1.x() - p0.x())));
+    platform.robot.updateState(vectorToAffine(Vector3d(p0.x(), p0.y(), 0.0), Vector3d(0.0, 0.0, heading)));
+    State rawState(platform.applyVelocityOnRobotRef(Affine3d::Identity()));
+    simulation.setRedisJsonStates(platform, rawState);
+
+    vector<VariableManager*> managers = {&simulation, &navigation, &operation};
+    for (VariableManager* manager: managers) {
+        manager->readRedisVariables();
+        manager->init();
+    }
+
+    auto step = [&]() {
+        clock.advance(SIMULATION_TICK);
+        for (VariableManager* manager: managers) {
+            manager->tick();
+        }
+        result.ticks++;
+    };
+
+    // first tick loads the traject, then the automatic mode is started
+    step();
+    simulation.readRedisVariables();
+    simulation.setValue(Vars::pc_simulation_auto, true);
+    simulation.writeRedisVariables();
+
+    CoverageRaster coverage(field.getGeofence().geometry(), scenario.coverageResolution);
+    ErrorStatistics distanceError, orientationError;
+    VariablePtr autoVariable = navigation.getVariable(Vars::pc_simulation_auto);
+    VariablePtr distanceErrorVariable = navigation.getVariable(Vars::pc_path_distance_error);
+    VariablePtr orientationErrorVariable = navigation.getVariable(Vars::pc_path_orientation_error);
+
+    const double tickSeconds = chrono::duration<double>(SIMULATION_TICK).count();
+    while (result.ticks * tickSeconds < scenario.duration) {
+        step();
+        if (!autoVariable->getValue<bool>()) break;
+
+        distanceError.add(distanceErrorVariable->getValue<double>());
+        orientationError.add(orientationErrorVariable->getValue<double>());
+
+        json implementStates = store->getJson("implement.states");
+        for (auto& implement: implementStates) {
+            if (!implement.contains("sections")) continue;
+            for (auto& section: implement["sections"]) {
+                if (section.value("active", false)) {
+                    coverage.cover(section["xy"].get<vector<vector<double>>>());
+                }
+            }
+        }
+    }
+
+    result.notification = navigation.getValue(Vars::pc_execution_notification);
+    result.endReached = result.notification == SIMULATION_END_OF_TRAJECT;
+    result.simulatedTime = chrono::duration<double>(clock.getElapsed()).count();
+    result.wallTime = chrono::duration<double>(chrono::steady_clock::now() - wallStart).count();
+    result.distanceErrorRms = distanceError.rms();
+    result.distanceErrorMean = distanceError.mean();
+    result.distanceErrorMax = distanceError.max;
+    result.orientationErrorRms = orientationError.rms();
+    result.orientationErrorMean = orientationError.mean();
+    result.orientationErrorMax = orientationError.max;
+    result.coverage = coverage.coverage();
+    return result;
+}
@@ -0,0 +1,166 @@
+#include <Simulation/VehiclePlant.h>
+#include <Utils/Geometry/Transform.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Ilvo::Core;
+using namespace Ilvo::Utils::Settings;
+using namespace Ilvo::Utils::Geometry;
+
+using namespace std;
+using namespace Eigen;
+
+
+ActuatorDynamics::ActuatorDynamics(Actuator settings) :
+    settings(settings), velocity(0.0), acceleration(0.0)
+{}
+
+double ActuatorDynamics::update(double command, double ts)
+{
+    if (settings.isIdeal() || ts <= 0.0) {
+        velocity = command;
+        acceleration = 0.0;
+        return velocity;
+    }
+
+    // first order lag, discretized exactly so a step larger than the time constant stays stable
+    double target = command;
+    if (settings.time_constant > 0.0) {
+        target = command + (velocity - command) * exp(-ts / settings.time_constant);
+    }
+    double desired = (target - velocity) / ts;
+
+    if (settings.max_jerk > 0.0) {
+        // the acceleration must still be reducible to zero before the command is reached, avoids ringing
+        double jts = settings.max_jerk * ts;
+        double brake = sqrt(0.25 * jts * jts + 2.0 * settings.max_jerk * abs(command - velocity)) - 0.5 * jts;
+        desired = clamp(desired, -brake, brake);
+        desired = clamp(desired, acceleration - settings.max_jerk * ts, acceleration + settings.max_jerk * ts);
+    }
+    if (settings.max_acceleration > 0.0) {
+        desired = clamp(desired, -settings.max_acceleration, settings.max_acceleration);
+    }
+
+    acceleration = desired;
+    velocity += acceleration * ts;
+    return velocity;
+}
+
+
+ActuatorModel::ActuatorModel(const Plant& plant) :
+    longitudinal(plant.longitudinal), lateral(plant.lateral), angular(plant.angular)
+{}
+
+void ActuatorModel::apply(PlantVelocity& velocity, double ts)
+{
+    velocity.longitudinal = longitudinal.update(velocity.longitudinal, ts);
+    velocity.lateral = lateral.update(velocity.lateral, ts);
+    velocity.angular = angular.update(velocity.angular, ts);
+}
+
+
+SlipModel::SlipModel(const Plant& plant) :
+    longitudinalSlip(plant.longitudinal_slip), angularSlip(plant.angular_slip)
+{}
+
+void SlipModel::apply(PlantVelocity& velocity, double)
+{
+    velocity.longitudinal *= 1.0 - longitudinalSlip;
+    velocity.angular *= 1.0 - angularSlip;
+}
+
+
+CreepModel::CreepModel(const Plant& plant) :
+    creepVelocity(plant.creep_velocity), creepGain(plant.creep_gain)
+{}
+
+void CreepModel::apply(PlantVelocity& velocity, double)
+{
+    velocity.lateral += creepVelocity + creepGain * velocity.angular;
+}
+
+
+GnssModel::GnssModel(const Plant& plant) :
+    noise(plant.gnss_noise), headingNoise(degToRad(plant.gnss_heading_noise)), latency(plant.gnss_latency),
+    generator(plant.gnss_seed), distribution(0.0, 1.0)
+{}
+
+bool GnssModel::isIdeal() const
+{
+    return noise == 0.0 && headingNoise == 0.0 && latency == 0.0;
+}
+
+void GnssModel::reset()
+{
+    buffer.clear();
+}
+
+Affine3d GnssModel::measure(const Affine3d& raw, double ts)
+{
+    for (auto& sample: buffer) {
+        sample.first += ts;
+    }
+    buffer.emplace_back(0.0, raw);
+    // keep the newest sample that is at least latency old
+    while (buffer.size() > 1 && buffer[1].first >= latency) {
+        buffer.pop_front();
+    }
+
+    Affine3d measured = buffer.front().second;
+    if (noise > 0.0) {
+        measured = Translation3d(noise * distribution(generator), noise * distribution(generator), 0.0) * measured;
+    }
+    if (headingNoise > 0.0) {
+        measured = measured * AngleAxisd(headingNoise * distribution(generator), Vector3d::UnitZ());
+    }
+    return measured;
+}
+
+
+VehiclePlant::VehiclePlant(const Plant& plant, bool lateral) :
+    gnss(plant)
+{
+    if (!(plant.longitudinal.isIdeal() && plant.lateral.isIdeal() && plant.angular.isIdeal())) {
+        actuatorModels.push_back(make_unique<ActuatorModel>(plant));
+    }
+    if (plant.longitudinal_slip != 0.0 || plant.angular_slip != 0.0) {
+        groundModels.push_back(make_unique<SlipModel>(plant));
+    }
+    if (lateral && (plant.creep_velocity != 0.0 || plant.creep_gain != 0.0)) {
+        groundModels.push_back(make_unique<CreepModel>(plant));
+    }
+}
+
+PlantVelocity VehiclePlant::actuate(const PlantVelocity& command, double ts)
+{
+    PlantVelocity velocity = command;
+    for (auto& model: actuatorModels) {
+        model->apply(velocity, ts);
+    }
+    return velocity;
+}
+
+PlantVelocity VehiclePlant::move(const PlantVelocity& actuated, double ts)
+{
+    PlantVelocity velocity = actuated;
+    for (auto& model: groundModels) {
+        model->apply(velocity, ts);
+    }
+    return velocity;
+}
+
+Affine3d VehiclePlant::measure(const Affine3d& raw, double ts)
+{
+    return gnss.isIdeal() ? raw : gnss.measure(raw, ts);
+}
+
+bool VehiclePlant::hasGnssModel() const
+{
+    return !gnss.isIdeal();
+}
+
+void VehiclePlant::resetGnss()
+{
+    gnss.reset();
+}
@@ -1,6 +1,7 @@
 #include <System/IlvoAddon.h>
 #include <Utils/Logging/LoggerStream.h>
 #include <Utils/Timing/Timing.h>
+#include <algorithm>
 
 using namespace Ilvo::Core;
 using namespace Ilvo::Utils::Docker;
@@ -15,7 +16,8 @@ IlvoAddon::IlvoAddon(nlohmann::json ilvoAddon, DockerClient& dockerClient) :
     dockerClient(dockerClient),
     dockerConfig(ilvoAddon["DockerConfig"]),
     imageName(ilvoAddon["DockerConfig"]["Image"].get<string>()),
-    containerId("")
+    containerId(""),
+    eventDriven(false)
 {
     dockerRegistry.parse(ilvoAddon["DockerRegistry"]);
     if (ilvoAddon.contains("ContainerId")) {
@@ -41,7 +43,10 @@ json IlvoAddon::toJson() {
 }
 
 void IlvoAddon::pull() {
-    json docPull = dockerClient.pull_image(dockerRegistry.asHeader(), imageName);  
+    applyPull(dockerClient.pull_image(dockerRegistry.asHeader(), imageName));
+}
+
+void IlvoAddon::applyPull(const json& docPull) {
     if (docPull["code"] == 200) {
         LoggerStream::getInstance() << INFO <<"Pulled image: " << imageName << " successfully";
     } else {
@@ -70,13 +75,19 @@ void IlvoAddon::updateSoftware() {
 
 void IlvoAddon::createContainer(const std::string& imageName) {
     json docCreate = dockerClient.create_container(dockerConfig, data.getName()); 
+    if (applyCreation(docCreate, imageName, true)) {
+        pull();
+        createContainer(imageName);
+    }
+}
+
+bool IlvoAddon::applyCreation(const json& docCreate, const std::string& imageName, bool retry) {
     LoggerStream::getInstance() << DEBUG << "Create container code: " << docCreate["code"] ;
     if (docCreate["code"] == 201) {
         containerId = docCreate["data"]["Id"].get<string>();
         LoggerStream::getInstance() << INFO << "Created container \"" << data.getName() << "\" (" << containerId << ")";
-    } else if (docCreate["code"] == 404 || docCreate["code"] == 409) {
-        pull();
-        createContainer(imageName);
+    } else if (retry && (docCreate["code"] == 404 || docCreate["code"] == 409)) {
+        return true;
     } else {
         data.setErrorMessage("Container creation of image " + imageName + " failed. Does the image exist?");
         LoggerStream::getInstance() << WARN << data.getErrorMessage();
@@ -85,33 +96,33 @@ void IlvoAddon::createContainer(const std::string& imageName) {
         LoggerStream::getInstance() << WARN <<"Is the config correct?";
         LoggerStream::getInstance() << WARN << dockerConfig.dump();
     }
+    return false;
 }
 
-void IlvoAddon::start() {
-    // Search for containers of same image
-    json docList = dockerClient.list_containers();
-    if (docList["code"] == 200) {
-        for (auto& container : docList["data"]) {
-            bool equalImage = container["Image"] == imageName;
-            auto names = container["Names"];
-            bool equalName = std::find(names.begin(), names.end(), "/" + data.getName()) != names.end();
-            if (equalImage && equalName) {
-                containerId = container["Id"].get<string>();
-                break;
-            }
-        }
+void IlvoAddon::adoptContainer(const json& container) {
+    if (!container.is_null() && container["Image"] == imageName) {
+        containerId = container["Id"].get<string>();
     }
+    if (!containerId.empty()) {
+        LoggerStream::getInstance() << INFO << "Container \"" << data.getName() << "\" was found (" << containerId << ")";
+    }
+}
+
+void IlvoAddon::start() {
+    // Search for the container of the add-on with the same image
+    adoptContainer(dockerClient.find_container(data.getName()));
 
     // Create container when no containerId
     if (containerId.empty()) {
         string imageName = data.getName();
         createContainer(imageName);
-    } else {
-        LoggerStream::getInstance() << INFO << "Container \"" << data.getName() << "\" was found (" << containerId << ")";
     }
 
     // Start container
-    json docStart = dockerClient.start_container(containerId); 
+    applyStart(dockerClient.start_container(containerId));
+}
+
+void IlvoAddon::applyStart(const json& docStart) {
     LoggerStream::getInstance() << DEBUG << "Start container code: " << docStart["code"];
     if (docStart["code"] == 204) {
         LoggerStream::getInstance() << INFO << "Started container \"" << data.getName() << "\" (" << containerId << ")";
@@ -125,6 +136,64 @@ void IlvoAddon::start() {
     }
 }
 
+void IlvoAddon::startAll(const vector<IlvoAddon*>& addons, DockerClient& dockerClient) {
+    if (addons.empty()) return;
+
+    // One listing for all add-ons instead of a search per add-on
+    json docList = dockerClient.list_containers(true);
+    for (IlvoAddon* addon: addons) {
+        json found;
+        if (docList["success"]) {
+            for (auto& container : docList["data"]) {
+                auto names = container["Names"];
+                if (find(names.begin(), names.end(), "/" + addon->data.getName()) != names.end()) {
+                    found = container;
+                    break;
+                }
+            }
+        }
+        addon->adoptContainer(found);
+    }
+
+    // Create the missing containers in parallel, the images that are missing are pulled in parallel before one retry
+    vector<IlvoAddon*> creating;
+    for (IlvoAddon* addon: addons) {
+        if (addon->containerId.empty()) creating.push_back(addon);
+    }
+    for (int attempt = 0; attempt < 2 && !creating.empty(); attempt++) {
+        vector<future<json>> creations;
+        for (IlvoAddon* addon: creating) {
+            creations.push_back(dockerClient.create_container_async(addon->dockerConfig, addon->data.getName()));
+        }
+        vector<IlvoAddon*> pulling;
+        for (size_t i = 0; i < creating.size(); i++) {
+            if (creating[i]->applyCreation(creations[i].get(), creating[i]->data.getName(), attempt == 0)) {
+                pulling.push_back(creating[i]);
+            }
+        }
+        vector<future<json>> pulls;
+        for (IlvoAddon* addon: pulling) {
+            pulls.push_back(dockerClient.pull_image_async(addon->dockerRegistry.asHeader(), addon->imageName));
+        }
+        for (size_t i = 0; i < pulling.size(); i++) {
+            pulling[i]->applyPull(pulls[i].get());
+        }
+        creating = pulling;
+    }
+
+    // Start the containers in parallel
+    vector<IlvoAddon*> starting;
+    vector<future<json>> starts;
+    for (IlvoAddon* addon: addons) {
+        if (addon->containerId.empty()) continue;
+        starting.push_back(addon);
+        starts.push_back(dockerClient.start_container_async(addon->containerId));
+    }
+    for (size_t i = 0; i < starting.size(); i++) {
+        starting[i]->applyStart(starts[i].get());
+    }
+}
+
 void IlvoAddon::stop() {
     json docStop = dockerClient.stop_container(containerId);
     if (docStop["code"] == 204) {
@@ -136,18 +205,59 @@ void IlvoAddon::stop() {
 }
 
 bool IlvoAddon::runs() {
+    if (eventDriven) {
+        return data.getRunning();
+    }
+    return inspect();
+}
+
+bool IlvoAddon::inspect() {
     if (containerId == "") {
         data.setRunning(false);
+        return false;
+    }
+    return applyInspection(dockerClient.inspect_container(containerId));
+}
+
+bool IlvoAddon::applyInspection(const json& docInspect) {
+    if (containerId != "" && docInspect["success"] && docInspect["code"] == 200) {
+        data.setExitCode(docInspect["data"]["State"]["ExitCode"]);
+        data.setPid(docInspect["data"]["State"]["Pid"]);
+        data.setRunning(docInspect["data"]["State"]["Running"]);  
     } else {
-        json docInspect = dockerClient.inspect_container(containerId);
-        if (docInspect["success"] && docInspect["code"] == 200) {
-            data.setExitCode(docInspect["data"]["State"]["ExitCode"]);
-            data.setPid(docInspect["data"]["State"]["Pid"]);
-            data.setRunning(docInspect["data"]["State"]["Running"]);  
-        } else {
-            data.setRunning(false);
-        }
+        data.setRunning(false);
     }
     
     return data.getRunning();
 }
+
+const string& IlvoAddon::getContainerId() {
+    return containerId;
+}
+
+void IlvoAddon::setEventDriven(bool eventDriven) {
+    this->eventDriven = eventDriven;
+}
+
+bool IlvoAddon::applyEvent(const ContainerEvent& event) {
+    bool sameContainer = !containerId.empty() && event.id.rfind(containerId, 0) == 0;
+    if (!sameContainer && event.name != data.getName()) {
+        return false;
+    }
+
+    if (event.action == "start") {
+        containerId = event.id;
+        inspect();  // pid of the new container
+        return true;
+    } else if (event.action == "die") {
+        data.setRunning(false);
+        data.setExitCode(event.exitCode);
+        LoggerStream::getInstance() << INFO << "Container \"" << data.getName() << "\" stopped with exit code " << event.exitCode;
+        return true;
+    } else if (event.action == "destroy") {
+        if (sameContainer) containerId = "";
+        data.setRunning(false);
+        return true;
+    }
+    return false;
+}
@@ -2,6 +2,11 @@
 #include <Utils/Logging/LoggerStream.h>
 #include <Utils/Timing/Timing.h>
 #include <iostream>
+#include <fstream>
+#include <thread>
+#include <sys/syscall.h>
+#include <signal.h>
+#include <unistd.h>
 
 using namespace Ilvo::Core;
 using namespace Ilvo::Utils::Logging;
@@ -14,21 +19,26 @@ namespace bp = boost::process;
 namespace fs = boost::filesystem;
 
 IlvoProcess::IlvoProcess(json ilvoProcess) : 
-    IlvoJob(ilvoProcess), heartbeatHealthDetector(5s)
+    IlvoJob(ilvoProcess), pidfd(-1), heartbeatHealthDetector(5s)
 {
     if (ilvoProcess.contains("CheckHeartbeat")) checkHeartbeat = ilvoProcess["CheckHeartbeat"];
     else checkHeartbeat = false;
+    if (ilvoProcess.contains("DependsOn")) dependsOn = ilvoProcess["DependsOn"].get<vector<string>>();
+    if (ilvoProcess.contains("Hosts")) hosts = ilvoProcess["Hosts"].get<vector<string>>();
 }
 
 IlvoProcess::~IlvoProcess() {
     if (runs()) {
         stop();
     }
+    closePidFd();
 }
 
 json IlvoProcess::toJson() {
     json jsonData = data.toJson();
     jsonData["CheckHeartbeat"] = checkHeartbeat;
+    jsonData["DependsOn"] = dependsOn;
+    jsonData["Hosts"] = hosts;
     return jsonData;
 }
 
@@ -45,6 +55,7 @@ void IlvoProcess::start() {
             data.setRunning(false);
         }
         data.setPid(process.id());
+        openPidFd();
         startTime = chrono::system_clock::now();
         data.setStartTimeISO(toISO8601Format(startTime)); // ISO 8601 format
         LoggerStream::getInstance() << INFO << "Started process \"" << data.getName() << "\"";
@@ -58,6 +69,7 @@ void IlvoProcess::start() {
 void IlvoProcess::stop() {
     if (runs()) {
         process.terminate();
+        closePidFd();
         LoggerStream::getInstance() << INFO << "Stopped process \"" << data.getName() << "\"";
     } else {
         LoggerStream::getInstance() << INFO << "Process \"" << data.getName() << "\" was already stopped";
@@ -76,6 +88,7 @@ bool IlvoProcess::runs() {
         } else {
             data.setRunning(false);
             data.setExitCode(process.exit_code());
+            closePidFd();
             LoggerStream::getInstance() << ERROR << "Process \"" << data.getName() << "\" stopped with exit code " << process.exit_code();
         }
     }
@@ -98,36 +111,88 @@ bool IlvoProcess::heartbeatHealthy(bool heartbeatValue) {
     }
 }
 
+int IlvoProcess::getPidFd() {
+    return pidfd;
+}
+
+bool IlvoProcess::getCheckHeartbeat() {
+    return checkHeartbeat;
+}
+
+const vector<string>& IlvoProcess::getDependsOn() {
+    return dependsOn;
+}
+
+const vector<string>& IlvoProcess::getHosts() {
+    return hosts;
+}
+
+void IlvoProcess::openPidFd() {
+    closePidFd();
+#ifdef SYS_pidfd_open
+    pidfd = syscall(SYS_pidfd_open, process.id(), 0);
+#endif
+    if (pidfd < 0) {
+        pidfd = -1;
+        LoggerStream::getInstance() << DEBUG << "No pidfd for process \"" << data.getName() << "\", its state is polled.";
+    }
+}
+
+void IlvoProcess::closePidFd() {
+    if (pidfd >= 0) {
+        close(pidfd);
+        pidfd = -1;
+    }
+}
+
 void IlvoProcess::updateSoftware() {
     // Not necessary to implement
 }
 
 bool IlvoProcess::exists() {
-    FILE* cmd = popen(("pidof " + data.getName()).c_str(), "r");
-    if (!cmd) {
-        LoggerStream::getInstance() << ERROR << "Error: Unable to execute pidof command.";
-        return false;
-    }
+    return !findPids().empty();
+}
 
-    char buffer[128];
-    while (fgets(buffer, sizeof(buffer), cmd)) {
-        pclose(cmd);
-        return true; // Process with the given name exists
+vector<pid_t> IlvoProcess::findPids() {
+    vector<pid_t> pids;
+    boost::system::error_code ec;
+    for (fs::directory_iterator it("/proc", ec), end; !ec && it != end; it.increment(ec)) {
+        string pidStr = it->path().filename().string();
+        if (pidStr.find_first_not_of("0123456789") != string::npos) continue;
+        pid_t pid = stoi(pidStr);
+        if (pid == getpid()) continue;
+
+        // the name of the program is the first argument, zombies have no arguments
+        ifstream cmdline((it->path() / "cmdline").string());
+        string program;
+        if (getline(cmdline, program, '\0') && fs::path(program).filename().string() == data.getName()) {
+            pids.push_back(pid);
+        }
     }
-
-    pclose(cmd);
-    return false; // No process with the given name found
+    return pids;
 }
 
 void IlvoProcess::kill() {
-    if (exists()) {
-        int result = system(("killall " + data.getName()).c_str());
-        if (result == 0) {
-            LoggerStream::getInstance() << INFO << "Process " << data.getName() << " killed successfully.";
-        } else {
-            LoggerStream::getInstance() << ERROR << "Error: Unable to execute pidof command.";
-        }
-    } else {
+    vector<pid_t> pids = findPids();
+    if (pids.empty()) {
         LoggerStream::getInstance() << INFO << "No process with name " << data.getName() << " found.";
+        return;
     }
-}
\ No newline at end of file
+
+    for (pid_t pid: pids) {
+        ::kill(pid, SIGTERM);
+    }
+    // wait until they exited, an old instance may not write its heartbeat anymore when the new one is started
+    auto deadline = chrono::steady_clock::now() + 1s;
+    while (!(pids = findPids()).empty() && chrono::steady_clock::now() < deadline) {
+        this_thread::sleep_for(10ms);
+    }
+    if (pids.empty()) {
+        LoggerStream::getInstance() << INFO << "Process " << data.getName() << " killed successfully.";
+    } else {
+        for (pid_t pid: pids) {
+            ::kill(pid, SIGKILL);
+        }
+        LoggerStream::getInstance() << WARN << "Process " << data.getName() << " did not terminate, killed it.";
+    }
+}
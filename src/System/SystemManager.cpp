@@ -2,10 +2,14 @@
 #include <string>
 #include <chrono>
 #include <System/SystemManager.h>
+#include <Utils/Redis/VariableSchemaGenerated.h>
 #include <Utils/Logging/LoggerStream.h>
 #include <Utils/String/String.h>
 #include <Exceptions/FileExceptions.hpp>
 #include <boost/filesystem.hpp>
+#include <poll.h>
+#include <cstring>
+#include <set>
 
 using namespace Ilvo::Core;
 using namespace Ilvo::Exception;
@@ -23,7 +27,10 @@ SystemManager::SystemManager(const string ns) :
     VariableManager(ns, 400ms),  // Make sure this is smaller than the heartbeat period
     running(true),
     startTime(chrono::system_clock::now()),
-    dockerClient(Utils::Docker::DockerClient())
+    fieldPulseActive(false),
+    systemChanged(true),
+    dockerClient(Utils::Docker::DockerClient()),
+    readyTimeout(10s)
 {
     // format ISO string
     time_t timet = chrono::system_clock::to_time_t(startTime);
@@ -43,6 +50,7 @@ SystemManager::~SystemManager() {
 
     // set variables
     running = false;
+    dockerEvents.stop();
 
     // Update redis with final json
     rs.setRedisJsonValue("system", formatJson());  
@@ -55,13 +63,26 @@ void SystemManager::updateSoftware() {
 }
 
 void SystemManager::serverTick() {
-    // System
-    if (processJson(rs.getRedisJsonValue("system"))) {
-        rs.setRedisJsonValue("system", formatJson());   
+    // System, the configuration is only read when it was written and only processed when it was changed by a user
+    bool updated = false;
+    if (systemChanged) {
+        systemChanged = false;
+        json systemConfigJson = rs.getRedisJsonValue("system");
+        if (systemConfigJson != systemJson) {
+            updated = processJson(systemConfigJson);
+            systemJson = systemConfigJson;
+        }
+    }
+    updated = superviseProcesses() || updated;
+    updated = superviseAddons() || updated;
+    if (updated) {
+        systemJson = formatJson();
+        rs.setRedisJsonValue("system", systemJson);   
     }
     // Field
-    if (getVariable("pc.field.updated")->getValue<bool>()) {
-        getVariable("pc.field.updated")->setValue<bool>(fieldPulseGenerator.generatePulse(500ms));
+    if (fieldPulseActive) {
+        fieldPulseActive = fieldPulseGenerator.generatePulse(500ms);
+        setValue(Vars::pc_field_updated, fieldPulseActive);
     }
 }
 
@@ -79,20 +100,8 @@ bool SystemManager::processJson(json systemConfigJson) {
             string ilvoProcessName = ilvoProcessJson["Name"];
             if (!processes.count(ilvoProcessName)) {  // Necessary when new process is added
                 processes.insert({ilvoProcessName, std::make_unique<IlvoProcess>(ilvoProcessJson)});
+                updateHosts();
                 updated = true;
-            } else {
-                // Check if process is running
-                string heartbeatStr = rs.getRedisValue(getHeartbeatVariableName(ilvoProcessName));
-                bool heartbeat = (heartbeatStr == "true");
-                // cout << "Heartbeat: " << (heartbeat ? "true" : "false") << ", HeartbeatStr: " << heartbeatStr << endl;
-                if (!processes[ilvoProcessName]->runs() || !processes[ilvoProcessName]->heartbeatHealthy(heartbeat)) {
-                    // stop process
-                    processes[ilvoProcessName]->stop();
-                    // start process
-                    processes[ilvoProcessName]->start();
-                    // process is updated
-                    updated = true;
-                }
             }
             
             if (processes[ilvoProcessName]->update(ilvoProcessJson)) {
@@ -113,6 +122,229 @@ bool SystemManager::processJson(json systemConfigJson) {
     return updated;
 }
 
+bool SystemManager::superviseProcesses() {
+    bool updated = false;
+
+    // heartbeats of all processes in one request
+    vector<string> heartbeatNames;
+    for (auto& process: processes) {
+        if (process.second->getCheckHeartbeat()) {
+            heartbeatNames.push_back(getHeartbeatVariableName(process.first));
+        }
+    }
+    vector<string> heartbeats;
+    if (!heartbeatNames.empty()) {
+        heartbeats = rs.getRedisValues(heartbeatNames);
+    }
+
+    // exited processes, one poll on all pidfds
+    vector<pollfd> fds;
+    for (auto& process: processes) {
+        int pidfd = process.second->getPidFd();
+        if (pidfd >= 0) {
+            fds.push_back({pidfd, POLLIN, 0});
+        }
+    }
+    if (!fds.empty() && poll(fds.data(), fds.size(), 0) < 0) {
+        LoggerStream::getInstance() << WARN << "Polling the process file descriptors failed: " << strerror(errno);
+    }
+
+    size_t heartbeatIndex = 0, fdIndex = 0;
+    set<string> restarts;
+    for (auto& process: processes) {
+        IlvoProcess& ilvoProcess = *process.second;
+        bool heartbeat = false;
+        if (ilvoProcess.getCheckHeartbeat()) {
+            heartbeat = heartbeats[heartbeatIndex++] == "true";
+        }
+        bool exited = false;
+        if (ilvoProcess.getPidFd() >= 0) {
+            // the pidfd is readable when the process exited, runs() reaps it
+            exited = fds[fdIndex++].revents & (POLLIN | POLLERR | POLLHUP | POLLNVAL);
+        }
+
+        auto host = hostedBy.find(process.first);
+        if (host != hostedBy.end()) {
+            // a hosted process has no pid, its heartbeat stops when its host hangs
+            if (!ilvoProcess.heartbeatHealthy(heartbeat)) {
+                restarts.insert(host->second);
+            }
+            continue;
+        }
+        if (!ilvoProcess.getData().getAutoStart() && ilvoProcess.getData().getPid() == -1) {
+            // not started, e.g. ilvo-monolith while the core loops run as separate processes
+            continue;
+        }
+
+        bool running;
+        if (ilvoProcess.getPidFd() >= 0) {
+            running = !exited || ilvoProcess.runs();
+        } else {
+            running = ilvoProcess.runs();
+        }
+
+        if (!running || !ilvoProcess.heartbeatHealthy(heartbeat)) {
+            restarts.insert(process.first);
+        }
+    }
+
+    for (const string& name: restarts) {
+        // stop process
+        processes[name]->stop();
+        // start process
+        processes[name]->start();
+        // process is updated
+        updated = true;
+    }
+
+    return updated;
+}
+
+bool SystemManager::superviseAddons() {
+    bool updated = false;
+
+    bool eventDriven = dockerEvents.connected();
+    bool resync = dockerEvents.resyncRequired();
+    for (auto& addon: addons) {
+        addon.second->setEventDriven(eventDriven);
+    }
+    if (resync || !eventDriven) {
+        // no events (yet), inspect the containers in parallel
+        vector<IlvoAddon*> inspected;
+        vector<string> containerIds;
+        for (auto& addon: addons) {
+            bool wasRunning = addon.second->getData().getRunning();
+            if (addon.second->getContainerId().empty()) {
+                updated = (addon.second->applyInspection({{"success", false}, {"code", 404}}) != wasRunning) || updated;
+            } else {
+                inspected.push_back(addon.second.get());
+                containerIds.push_back(addon.second->getContainerId());
+            }
+        }
+        vector<json> docs = dockerClient.inspect_containers(containerIds);
+        for (size_t i = 0; i < inspected.size(); i++) {
+            bool wasRunning = inspected[i]->getData().getRunning();
+            updated = (inspected[i]->applyInspection(docs[i]) != wasRunning) || updated;
+        }
+    }
+
+    for (const ContainerEvent& event: dockerEvents.poll()) {
+        for (auto& addon: addons) {
+            updated = addon.second->applyEvent(event) || updated;
+        }
+    }
+
+    return updated;
+}
+
+void SystemManager::updateHosts() {
+    hostedBy.clear();
+    for (auto& process: processes) {
+        if (process.second->getData().getAutoStart()) {
+            for (const string& hosted: process.second->getHosts()) {
+                hostedBy[hosted] = process.first;
+            }
+        }
+    }
+}
+
+void SystemManager::startProcesses() {
+    set<string> launched;
+    vector<string> waiting;
+    for (auto& process: processes) {
+        if (process.second->getData().getAutoStart() && !hostedBy.count(process.first)) {
+            launched.insert(process.first);
+            waiting.push_back(process.first);
+        }
+    }
+    // a dependency on a hosted process is a dependency on its host
+    auto resolve = [&](const string& name) {
+        auto host = hostedBy.find(name);
+        return host != hostedBy.end() ? host->second : name;
+    };
+    for (const string& name: waiting) {
+        for (const string& dependency: processes[name]->getDependsOn()) {
+            if (!launched.count(resolve(dependency))) {
+                LoggerStream::getInstance() << WARN << "Process \"" << name << "\" depends on \"" << dependency << "\" which is not started, the dependency is ignored.";
+            }
+        }
+    }
+
+    set<string> ready;
+    map<string, chrono::steady_clock::time_point> starting;  // started and waiting for the first tick
+    set<string> ticked;
+    map<string, vector<int>> tickSubscriptions;
+    auto dependenciesReady = [&](const string& name) {
+        for (const string& dependency: processes[name]->getDependsOn()) {
+            if (launched.count(resolve(dependency)) && !ready.count(resolve(dependency))) return false;
+        }
+        return true;
+    };
+    // a host ticks when all its hosted processes ticked
+    auto tickers = [&](const string& name) {
+        const vector<string>& hosts = processes[name]->getHosts();
+        return hosts.empty() ? vector<string>{name} : hosts;
+    };
+    auto hasTicked = [&](const string& name) {
+        for (const string& ticker: tickers(name)) {
+            if (!ticked.count(ticker)) return false;
+        }
+        return true;
+    };
+
+    while (!waiting.empty() || !starting.empty()) {
+        vector<string> startable;
+        for (const string& name: waiting) {
+            if (dependenciesReady(name)) startable.push_back(name);
+        }
+        if (startable.empty() && starting.empty()) {
+            LoggerStream::getInstance() << WARN << "Circular process dependencies, the remaining processes are started together.";
+            startable = waiting;
+        }
+
+        for (const string& name: startable) {
+            // subscribed before the start, the first tick of the process cannot be missed
+            for (const string& ticker: tickers(name)) {
+                tickSubscriptions[name].push_back(getDispatcher().subscribe(ticker + "-tick", [&ticked, ticker](const RedisMessage& message) {
+                    // an empty message is the resync of the dispatcher, not a tick
+                    if (!message.message.empty()) ticked.insert(ticker);
+                }));
+            }
+            processes[name]->start();
+            starting[name] = chrono::steady_clock::now();
+            waiting.erase(find(waiting.begin(), waiting.end(), name));
+        }
+
+        this_thread::sleep_for(20ms);
+        getDispatcher().dispatch();
+
+        for (auto process = starting.begin(); process != starting.end();) {
+            const string& name = process->first;
+            auto waited = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - process->second);
+            bool done = true;
+            if (hasTicked(name)) {
+                LoggerStream::getInstance() << INFO << "Process \"" << name << "\" is ready after " << waited.count() << " ms.";
+            } else if (!processes[name]->runs()) {
+                LoggerStream::getInstance() << WARN << "Process \"" << name << "\" is not running, its dependents are started anyway.";
+            } else if (waited > readyTimeout) {
+                LoggerStream::getInstance() << WARN << "Process \"" << name << "\" is not ready after " << waited.count() << " ms, its dependents are started anyway.";
+            } else {
+                done = false;
+            }
+
+            if (done) {
+                for (int subscription: tickSubscriptions[name]) {
+                    getDispatcher().unsubscribe(subscription);
+                }
+                ready.insert(name);
+                process = starting.erase(process);
+            } else {
+                process++;
+            }
+        }
+    }
+}
+
 json SystemManager::formatJson() {
     json systemJson;
     for (auto process = processes.begin(); process != processes.end(); process++) {
@@ -183,22 +415,33 @@ void SystemManager::init() {
     for (auto ilvoProcessJson : systemConfigJson["ilvoProcesses"]) {
         std::unique_ptr<IlvoProcess> ilvoProcess = std::make_unique<IlvoProcess>(ilvoProcessJson);
         ilvoProcess->kill();
-        if (ilvoProcess->getData().getAutoStart()) {
-            ilvoProcess->start();
-        }
         processes.insert({ilvoProcessJson["Name"], std::move(ilvoProcess)});
-        this_thread::sleep_for(100ms);  // Sleep a bit to make sure the process is started
     }
+    updateHosts();
+    startProcesses();
+
+    vector<IlvoAddon*> autoStartAddons;
     for (auto ilvoAddonJson : systemConfigJson["ilvoAddons"]) {
         std::unique_ptr<IlvoAddon> ilvoAddon = std::make_unique<IlvoAddon>(ilvoAddonJson, dockerClient);
         if (ilvoAddon->getData().getAutoStart()) {
-            ilvoAddon->start();
+            autoStartAddons.push_back(ilvoAddon.get());
         }
         addons.insert({ilvoAddonJson["Name"], std::move(ilvoAddon)});
     }
+    IlvoAddon::startAll(autoStartAddons, dockerClient);
 
     // Save system to redis
-    rs.setRedisJsonValue("system", formatJson());   
+    systemJson = formatJson();
+    rs.setRedisJsonValue("system", systemJson);   
+
+    // Follow the container states of the add-ons
+    dockerEvents.start();
+
+    // Commands of the users
+    onKeyChanged("system", [this]() { systemChanged = true; });
+    onVariableChanged(Vars::pc_field_updated, [this](VariablePtr var) {
+        fieldPulseActive = fieldPulseActive || var->getValue<bool>();
+    });
 }
 
 int main() {
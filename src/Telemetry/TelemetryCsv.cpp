@@ -0,0 +1,32 @@
+#include <Utils/Logging/TelemetryStream.h>
+#include <fstream>
+#include <iostream>
+
+using namespace Ilvo::Utils::Logging;
+using namespace std;
+
+/**
+ * @brief Convert a binary telemetry file (.tlm) to csv
+ * 
+ * @details Usage: ilvo-telemetry-csv <file.tlm> [file.csv], without output file the csv is written to stdout.
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <file.tlm> [file.csv]" << endl;
+        return 1;
+    }
+
+    try {
+        TelemetryReader reader(argv[1]);
+        if (argc > 2) {
+            ofstream out(argv[2]);
+            reader.toCsv(out);
+        } else {
+            reader.toCsv(cout);
+        }
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,205 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_coverage_map
+#include <boost/test/included/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <string>
+#include <chrono>
+#include <cmath>
+
+#include <Utils/Geometry/CoverageMap.h>
+#include <ThirdParty/base64/base64.h>
+
+using namespace Ilvo::Utils::Geometry;
+
+using namespace std;
+using json = nlohmann::json;
+
+namespace {
+    /** @brief Footprint of width (across) x length (along x) with its rear center at (x, y), rotated over heading [rad] */
+    bgPolygon2D footprint(double x, double y, double width, double length, double heading=0.0)
+    {
+        double c = cos(heading), s = sin(heading);
+        auto corner = [&](double along, double across) {
+            return bgPoint2D(x + c * along - s * across, y + s * along + c * across);
+        };
+        bgPolygon2D p;
+        p.outer() = {corner(0.0, -width / 2), corner(0.0, width / 2), corner(length, width / 2),
+                     corner(length, -width / 2), corner(0.0, -width / 2)};
+        return p;
+    }
+
+    /** @brief Drive a footprint of 1 m wide and 0.2 m long along x, in steps of 0.05 m */
+    void drive(CoverageMap& map, int sweep, double x0, double x1, double y)
+    {
+        for (double x = x0; x <= x1 + 1e-9; x += 0.05) {
+            map.cover(sweep, footprint(x, y, 1.0, 0.2));
+        }
+        map.lift(sweep);
+    }
+
+    struct TemporaryDirectory
+    {
+        boost::filesystem::path path;
+        TemporaryDirectory() : path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()) {}
+        ~TemporaryDirectory() { boost::filesystem::remove_all(path); }
+    };
+}
+
+// Coverage map test bench suite
+BOOST_AUTO_TEST_SUITE(CoverageMapTest)
+
+BOOST_AUTO_TEST_CASE( single_pass )
+{
+    // Arrange
+    CoverageMap map(0.1);
+
+    // Act: a 10 m pass, 1 m wide, across a tile border (25.6 m)
+    drive(map, 0, 20.02, 29.82, 5.02);
+
+    // Assert: every cell of the 10 m x 1 m strip is counted exactly once
+    int once = 0, other = 0;
+    for (int i = 195; i < 305; i++) {
+        for (int j = 40; j < 60; j++) {
+            int c = map.count((i + 0.5) * 0.1, (j + 0.5) * 0.1);
+            if (c == 1) once++; else if (c != 0) other++;
+        }
+    }
+    BOOST_TEST(once == 100 * 10);
+    BOOST_TEST(other == 0);
+    BOOST_TEST(map.getTiles().size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE( overlap_of_passes )
+{
+    // Arrange
+    CoverageMap map(0.1);
+    drive(map, 0, 500000.02, 500010.02, 5650000.02);
+
+    // Act
+    map.cover(0, footprint(500002.02, 5650000.02, 1.0, 0.2));
+    double overlapSame = map.overlap(0, footprint(500002.17, 5650000.02, 1.0, 0.2));
+    double overlapHalf = map.overlap(1, footprint(500004.02, 5650000.52, 1.0, 0.2));
+    double overlapBeside = map.overlap(2, footprint(500004.02, 5650001.02, 1.0, 0.2));
+
+    // Assert
+    BOOST_TEST(overlapSame == 1.0);
+    BOOST_CHECK_CLOSE(overlapHalf, 0.5, 1e-9);
+    BOOST_TEST(overlapBeside == 0.0);
+    BOOST_TEST(map.count(500002.05, 5650000.05) == 2);
+    BOOST_TEST(map.count(500005.05, 5650000.05) == 1);
+}
+
+BOOST_AUTO_TEST_CASE( turning_and_jumping_footprint )
+{
+    // Arrange
+    CoverageMap map(0.05);
+
+    // Act: a quarter circle of radius 5 m, then a jump of 100 m
+    for (int k = 0; k <= 90; k++) {
+        double a = k * M_PI / 180.0;
+        map.cover(0, footprint(5.0 * sin(a), 5.0 - 5.0 * cos(a), 1.0, 0.2, a));
+    }
+    size_t jump = map.cover(0, footprint(100.0, 0.0, 1.0, 0.2));
+
+    // Assert: the arc is covered without gaps, the jump only covers the footprint
+    for (int k = 0; k <= 90; k++) {
+        double a = k * M_PI / 180.0;
+        for (double r: {4.6, 5.0, 5.4}) {
+            BOOST_TEST_REQUIRE(map.count(r * sin(a), 5.0 - r * cos(a)) >= 1);
+        }
+    }
+    BOOST_TEST(jump == 20 * 4);
+}
+
+BOOST_AUTO_TEST_CASE( persistent_tiles )
+{
+    // Arrange
+    TemporaryDirectory directory;
+    {
+        CoverageMap map(0.1, directory.path.string());
+        drive(map, 0, -2.98, 2.98, 0.02);
+    }
+
+    // Act
+    CoverageMap reopened(0.1, directory.path.string());
+    int count = reopened.count(-2.05, 0.05);
+    vector<uint64_t> tiles = reopened.getTiles();
+    json tile = reopened.exportTile(tiles[0]);
+    CoverageMap otherResolution(0.2, directory.path.string());
+
+    // Assert
+    BOOST_TEST(count == 1);
+    BOOST_TEST(tiles.size() == 4);
+    BOOST_TEST(CoverageMap::tileName(tiles[0]) == "0_0");
+    BOOST_TEST(tile["x"] == 0.0);
+    BOOST_TEST(tile["size"] == COVERAGE_TILE_SIZE);
+    string counts = base64_decode(tile["counts"].get<string>());
+    BOOST_TEST_REQUIRE(counts.size() == COVERAGE_TILE_SIZE * COVERAGE_TILE_SIZE);
+    BOOST_TEST(counts[0 * COVERAGE_TILE_SIZE + 20] == 1);
+    BOOST_TEST(counts[5 * COVERAGE_TILE_SIZE + 20] == 0);
+    BOOST_TEST(otherResolution.getTiles().empty());
+}
+
+BOOST_AUTO_TEST_CASE( changed_tiles )
+{
+    // Arrange
+    CoverageMap map(0.1);
+    drive(map, 0, 0.02, 30.02, 1.02);
+    map.takeChangedTiles();
+
+    // Act
+    map.cover(0, footprint(27.02, 1.02, 1.0, 0.2));
+    vector<uint64_t> changed = map.takeChangedTiles();
+
+    // Assert
+    BOOST_TEST_REQUIRE(changed.size() == 1);
+    BOOST_TEST(CoverageMap::tileName(changed[0]) == "1_0");
+    BOOST_TEST(map.takeChangedTiles().empty());
+}
+
+BOOST_AUTO_TEST_CASE( changed_tiles_count )
+{
+    // Arrange: a pass over two tiles
+    CoverageMap map(0.1);
+    drive(map, 0, 0.02, 30.02, 1.02);
+
+    // Act
+    vector<uint64_t> first = map.takeChangedTiles(1);
+    vector<uint64_t> second = map.takeChangedTiles(1);
+    vector<uint64_t> rest = map.takeChangedTiles(1);
+
+    // Assert: the tiles that were not taken stay changed
+    BOOST_TEST_REQUIRE(first.size() == 1);
+    BOOST_TEST_REQUIRE(second.size() == 1);
+    BOOST_TEST(CoverageMap::tileName(first[0]) == "0_0");
+    BOOST_TEST(CoverageMap::tileName(second[0]) == "1_0");
+    BOOST_TEST(rest.empty());
+}
+
+BOOST_AUTO_TEST_CASE( bounded_update_time )
+{
+    // Arrange: 200 passes of 100 m, 20 m wide, over 8 tiles
+    CoverageMap map(0.1);
+    for (int pass = 0; pass < 200; pass++) {
+        drive(map, 0, 0.0, 100.0, pass * 0.1);
+    }
+
+    // Act: a sweep of 24 sections of 0.5 m
+    const int ticks = 1000;
+    auto start = chrono::steady_clock::now();
+    for (int k = 0; k < ticks; k++) {
+        for (int s = 0; s < 24; s++) {
+            map.overlap(s, footprint(k * 0.05, s * 0.5, 0.5, 0.2));
+            map.cover(s, footprint(k * 0.05, s * 0.5, 0.5, 0.2));
+        }
+    }
+    double tickUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / ticks;
+
+    // Assert
+    BOOST_TEST_MESSAGE("Coverage update of 24 sections: " << tickUs << " us per tick");
+    BOOST_TEST(tickUs < 5000.0);
+    // 10 passes and section 10
+    BOOST_TEST(map.count(10.05, 5.05) == 11);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
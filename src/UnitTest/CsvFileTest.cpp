@@ -0,0 +1,185 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_csv_file
+#include <boost/test/included/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/algorithm/string.hpp>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include <Utils/File/CsvFile.h>
+#include <Utils/File/PointCsvFile.h>
+#include <Exceptions/FileExceptions.hpp>
+
+using namespace Ilvo::Utils::File;
+using namespace Ilvo::Exception;
+
+using namespace std;
+
+namespace {
+    struct TemporaryDirectory
+    {
+        boost::filesystem::path path;
+        TemporaryDirectory() : path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()) {
+            boost::filesystem::create_directories(path);
+        }
+        ~TemporaryDirectory() { boost::filesystem::remove_all(path); }
+    };
+
+    string writeFile(const boost::filesystem::path& file, const string& content)
+    {
+        std::ofstream(file.string()) << content;
+        return file.string();
+    }
+
+    /** @brief RTK survey of n rows, in series of 1000 rows */
+    string writeSurvey(const boost::filesystem::path& file, size_t n)
+    {
+        std::ofstream f(file.string());
+        f << "Id,Easting,Northing,Altitude,Fix,Series\r\n";
+        f.precision(12);
+        for (size_t r = 0; r < n; r++) {
+            f << r << "," << 500000.0 + 0.001 * r << "," << 5650000.0 + 0.002 * r << ",12.5,\"RTK, fixed\"," << r / 1000 << "\r\n";
+        }
+        return file.string();
+    }
+
+    /** @brief Reference of the loader: getline, stringstream and stod per row */
+    void readSurvey(const string& file, vector<double>& x, vector<double>& y)
+    {
+        std::ifstream f(file);
+        string line, value;
+        getline(f, line);
+        while (getline(f, line)) {
+            boost::algorithm::to_lower(line);
+            stringstream ss(line);
+            for (int c = 0; getline(ss, value, ','); c++) {
+                if (c == 1) x.push_back(stod(value));
+                if (c == 2) y.push_back(stod(value));
+            }
+        }
+    }
+}
+
+// Csv reader test bench suite
+BOOST_AUTO_TEST_SUITE(CsvFileTest)
+
+BOOST_AUTO_TEST_CASE( quoted_fields )
+{
+    // Arrange
+    TemporaryDirectory directory;
+    string file = writeFile(directory.path / "points.csv",
+        "\xEF\xBB\xBF" "Name,\"X\", Y ,Note\n"
+        "\"a, b\",1.5,+2.5,\"said \"\"hi\"\"\"\n"
+        "c,-3e2, 4 \n"
+        "d,,5,\n"
+        "\n"
+        "e,6,7,after the end\n");
+
+    // Act
+    CsvFile csv(file);
+    CsvColumns table = csv.readColumns({1, 2});
+    vector<vector<string>> rows = csv.readRows();
+
+    // Assert
+    BOOST_TEST(csv.getColumns() == vector<string>({"Name", "X", "Y", "Note"}));
+    BOOST_TEST(csv.findColumn({"Easting", "x"}) == 1);
+    BOOST_TEST(csv.findColumn({"Northing"}) == -1);
+    BOOST_TEST_REQUIRE(table.values[0].size() == 3);
+    BOOST_TEST(table.values[0][0] == 1.5);
+    BOOST_TEST(table.values[1][0] == 2.5);
+    BOOST_TEST(table.values[0][1] == -300.0);
+    BOOST_TEST(table.values[1][1] == 4.0);
+    BOOST_TEST(std::isnan(table.values[0][2]));
+    BOOST_TEST(table.seriesStart == vector<size_t>({0, 3}));
+    BOOST_TEST_REQUIRE(rows.size() == 3);
+    BOOST_TEST(rows[0][0] == "a, b");
+    BOOST_TEST(rows[0][3] == "said \"hi\"");
+    BOOST_TEST(rows[2].size() == 4);
+}
+
+BOOST_AUTO_TEST_CASE( invalid_number )
+{
+    // Arrange
+    TemporaryDirectory directory;
+    string file = writeFile(directory.path / "points.csv", "X,Y\n1,2\n3,four\n");
+
+    // Act & Assert
+    CsvFile csv(file);
+    BOOST_CHECK_THROW(csv.readColumns({0, 1}), FileFormatException);
+    BOOST_CHECK_THROW(CsvFile((directory.path / "missing.csv").string()), PathNotFoundException);
+}
+
+BOOST_AUTO_TEST_CASE( series_across_chunks )
+{
+    // Arrange: series of 1000 rows over several chunks
+    TemporaryDirectory directory;
+    string file = writeSurvey(directory.path / "survey.csv", 100000);
+    CsvFile csv(file);
+
+    // Act
+    CsvColumns table = csv.readColumns({1, 2}, csv.findColumn({"Series"}));
+
+    // Assert
+    BOOST_TEST_REQUIRE(table.values[0].size() == 100000);
+    BOOST_TEST(table.values[0][99999] == 500000.0 + 0.001 * 99999, boost::test_tools::tolerance(1e-12));
+    BOOST_TEST_REQUIRE(table.seriesStart.size() == 101);
+    for (size_t s = 0; s < table.seriesStart.size(); s++) {
+        BOOST_TEST_REQUIRE(table.seriesStart[s] == s * 1000);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( point_csv_file_series )
+{
+    // Arrange
+    TemporaryDirectory directory;
+    string file = writeFile(directory.path / "task.csv",
+        "Series,Easting,Northing,Rate\n"
+        "1,0,0,10\n1,1,0,10\n1,1,1,10\n"
+        "2,5,5,20\n2,6,5,20\n2,6,6,20\n");
+    vector<string> xFields{"Easting", "X"};
+    vector<string> yFields{"Northing", "Y"};
+    PointCsvFile f(true);
+    PointCsvFile single(false);
+
+    // Act
+    f.init(file, xFields, yFields, {"Series"});
+    single.init(file, xFields, yFields);
+
+    // Assert
+    BOOST_TEST_REQUIRE(f.getNumSeries() == 2);
+    BOOST_TEST(f.getNumPoints(1) == 4);
+    BOOST_TEST(f.isPolygon(1));
+    BOOST_TEST(f.getPoints(1)[0]->x() == 5.0);
+    BOOST_TEST(single.getNumSeries() == 1);
+    BOOST_TEST(single.getNumPoints(0) == 6);
+    BOOST_TEST(single.getColumnNames().at("Rate") == 3);
+    BOOST_TEST_REQUIRE(single.getDataLines().size() == 6);
+    BOOST_TEST(single.getDataLines()[5][3] == "20");
+}
+
+BOOST_AUTO_TEST_CASE( load_time )
+{
+    // Arrange: 500000 surveyed points, about 30 MB
+    TemporaryDirectory directory;
+    string file = writeSurvey(directory.path / "survey.csv", 500000);
+
+    // Act
+    auto start = chrono::steady_clock::now();
+    vector<double> xLines, yLines;
+    readSurvey(file, xLines, yLines);
+    double linesMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    CsvColumns table = CsvFile(file).readColumns({1, 2});
+    double mappedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    // Assert
+    BOOST_TEST_MESSAGE("500000 rows, getline: " << linesMs << " ms, mapped chunks: " << mappedMs << " ms");
+    BOOST_TEST(table.values[0] == xLines);
+    BOOST_TEST(table.values[1] == yLines);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
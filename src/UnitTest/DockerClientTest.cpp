@@ -0,0 +1,95 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_docker_client
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+#include <future>
+#include <chrono>
+
+#include <Utils/Docker/DockerClient.h>
+#include <Utils/Logging/LoggerStream.h>
+#include "FakeDockerServer.h"
+
+using namespace Ilvo::Utils::Docker;
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+using namespace std::chrono_literals;
+using namespace nlohmann;
+
+// Docker client test bench suite
+BOOST_AUTO_TEST_SUITE(DockerClientTest)
+
+BOOST_AUTO_TEST_CASE( persistent_connection )
+{
+    // Arrange
+    LoggerStream::createInstance("test-docker-client");
+    FakeDockerServer daemon("/tmp/test-docker-client-" + to_string(getpid()) + ".sock");
+    string other = daemon.addContainer("ilvo-other", "ilvo/other", true);
+    setenv("ILVO_DOCKER_SOCKET", daemon.getSocketPath().c_str(), 1);
+    DockerClient client;
+    json config = {{"Image", "ilvo/addon"}};
+
+    // Act
+    json docCreate = client.create_container(config, "ilvo-addon");
+    string id = docCreate["data"]["Id"];
+    json docStart = client.start_container(id);
+    json docFound = client.find_container("ilvo-addon");
+    json docMissing = client.find_container("ilvo-missing");
+    for (int i = 0; i < 20; i++) {
+        client.inspect_container(id);
+    }
+    json docInspect = client.inspect_container(id);
+    future<json> stopped = client.stop_container_async(id);
+    json docStop = stopped.get();
+
+    // Assert: all requests on one kept-alive connection
+    BOOST_TEST(docCreate["code"] == 201);
+    BOOST_TEST(docStart["code"] == 204);
+    BOOST_TEST(docFound["Id"] == id);
+    BOOST_TEST(docFound["Image"] == "ilvo/addon");
+    BOOST_TEST(docMissing.is_null());
+    BOOST_TEST(docInspect["data"]["State"]["Running"] == true);
+    BOOST_TEST(docStop["code"] == 204);
+    BOOST_TEST(client.exists_container(other));
+    BOOST_TEST(!client.exists_container("0123"));
+    BOOST_TEST(daemon.getConnections() == 1);
+    BOOST_TEST(client.get_last_command().find("--unix-socket " + daemon.getSocketPath()) != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE( parallel_inspect )
+{
+    // Arrange: a daemon that needs 20 ms per request
+    FakeDockerServer daemon("/tmp/test-docker-client-" + to_string(getpid()) + ".sock", 20ms);
+    vector<string> ids;
+    for (int i = 0; i < 8; i++) {
+        ids.push_back(daemon.addContainer("ilvo-addon-" + to_string(i), "ilvo/addon", i % 2 == 0));
+    }
+    setenv("ILVO_DOCKER_SOCKET", daemon.getSocketPath().c_str(), 1);
+    DockerClient client;
+    client.inspect_container(ids[0]);  // warm up
+
+    // Act
+    auto start = chrono::steady_clock::now();
+    for (const string& id: ids) {
+        client.inspect_container(id);
+    }
+    double sequential = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    size_t sequentialPeak = daemon.getPeakRequests();
+    start = chrono::steady_clock::now();
+    vector<json> docs = client.inspect_containers(ids);
+    double batched = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    BOOST_TEST_MESSAGE("8 inspects: sequential " << sequential * 1e3 << " ms, batched " << batched * 1e3 << " ms");
+
+    // Assert
+    BOOST_TEST(docs.size() == ids.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+        BOOST_TEST(docs[i]["data"]["Id"] == ids[i]);
+        BOOST_TEST(docs[i]["data"]["State"]["Running"] == (i % 2 == 0));
+    }
+    // the inspects of the batch overlapped on the daemon, the times are only reported
+    BOOST_TEST(sequentialPeak == 1);
+    BOOST_TEST(daemon.getPeakRequests() > 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,84 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_docker_events
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+#include <Utils/Docker/DockerClient.h>
+#include <Utils/Docker/DockerEventStream.h>
+#include <Utils/Logging/LoggerStream.h>
+#include "FakeDockerServer.h"
+
+using namespace Ilvo::Utils::Docker;
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+using namespace std::chrono_literals;
+
+namespace {
+    template<typename Predicate>
+    bool waitFor(Predicate predicate)
+    {
+        for (int i = 0; i < 200 && !predicate(); i++) this_thread::sleep_for(10ms);
+        return predicate();
+    }
+}
+
+// Docker events test bench suite
+BOOST_AUTO_TEST_SUITE(DockerEventsTest)
+
+BOOST_AUTO_TEST_CASE( event_stream )
+{
+    // Arrange
+    LoggerStream::createInstance("test-docker-events");
+    FakeDockerServer daemon("/tmp/test-docker-events-" + to_string(getpid()) + ".sock");
+    string id = daemon.addContainer("ilvo-addon", "ilvo/addon", false);
+    setenv("ILVO_DOCKER_SOCKET", daemon.getSocketPath().c_str(), 1);
+    DockerClient client;
+    DockerEventStream stream(daemon.getSocketPath(), "v1.44", 20ms);
+    vector<ContainerEvent> events;
+    auto received = [&](size_t n) {
+        return waitFor([&]() {
+            for (auto& e: stream.poll()) events.push_back(e);
+            return events.size() >= n;
+        });
+    };
+
+    // Act
+    stream.start();
+    BOOST_REQUIRE(waitFor([&]() { return stream.connected(); }));
+    bool resync = stream.resyncRequired();
+    client.start_container(id);
+    daemon.killContainer(id, 137);
+    bool first = received(2);
+    // the connection drops while the container is started again
+    daemon.closeEvents();
+    client.start_container(id);
+    bool second = received(3);
+    stream.stop();
+
+    // Assert
+    BOOST_TEST(resync);
+    BOOST_REQUIRE(first);
+    BOOST_REQUIRE(second);
+    BOOST_TEST(events[0].action == "start");
+    BOOST_TEST(events[0].name == "ilvo-addon");
+    BOOST_TEST(events[1].action == "die");
+    BOOST_TEST(events[1].id == id);
+    BOOST_TEST(events[1].exitCode == 137);
+    BOOST_TEST(events.back().action == "start");
+    // the reconnection replays the events since the last received event
+    vector<string> requests = daemon.getRequestLines();
+    vector<string> eventRequests;
+    for (const string& r: requests) {
+        if (r.find("/events?filters=") != string::npos) eventRequests.push_back(r);
+    }
+    BOOST_REQUIRE(eventRequests.size() >= 2);
+    BOOST_TEST(eventRequests[0].find("since=") == string::npos);
+    BOOST_TEST(eventRequests[1].find("since=") != string::npos);
+    BOOST_TEST(!stream.connected());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
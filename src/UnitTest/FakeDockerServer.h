@@ -0,0 +1,350 @@
+/**
+ * @file FakeDockerServer.h
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Fake docker engine API on a unix socket for the docker tests
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ */
+#pragma once
+
+#include <ThirdParty/json.hpp>
+
+#include <string>
+#include <vector>
+#include <map>
+#include <list>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <algorithm>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * @brief Fake docker daemon
+ *
+ * @details Serves the container endpoints used by the DockerClient and the /events stream with HTTP/1.1 keep-alive,
+ * one thread per connection. Every response is delayed with the latency to emulate a loaded daemon.
+ */
+class FakeDockerServer
+{
+private:
+    struct Container
+    {
+        std::string id, name, image;
+        bool running = false;
+        int pid = 0;
+        int exitCode = 0;
+    };
+
+    std::string socketPath;
+    std::chrono::milliseconds latency;
+    int server;
+    std::atomic<bool> running;
+    std::thread acceptor;
+    std::list<std::thread> handlers;
+    std::vector<int> clients;
+    std::atomic<size_t> connections, requests;
+    /** @brief Requests in progress and their maximum since the start */
+    std::atomic<size_t> activeRequests, peakRequests;
+
+    std::mutex mutex;
+    std::condition_variable eventCondition;
+    std::map<std::string, Container> containers;
+    std::vector<std::string> requestLines;
+    /** @brief Time and json line of the container events */
+    std::vector<std::pair<long, std::string>> events;
+    long eventTime = 1700000000;
+    int nextId = 1;
+
+    static std::string urlDecode(const std::string& s) {
+        std::string decoded;
+        for (size_t i = 0; i < s.size(); i++) {
+            if (s[i] == '%' && i + 2 < s.size()) {
+                decoded += char(std::stoi(s.substr(i + 1, 2), nullptr, 16));
+                i += 2;
+            } else {
+                decoded += s[i];
+            }
+        }
+        return decoded;
+    }
+
+    static std::string response(int code, const std::string& body = "") {
+        static std::map<int, std::string> reasons = {
+            {200, "OK"}, {201, "Created"}, {204, "No Content"}, {304, "Not Modified"}, {404, "Not Found"}, {409, "Conflict"}};
+        return "HTTP/1.1 " + std::to_string(code) + " " + reasons[code] + "\r\nContent-Type: application/json\r\n"
+            + "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+    }
+
+    /** @brief Container with this id (prefix) or name, must be called with the lock */
+    Container* lookup(const std::string& idOrName) {
+        for (auto& c: containers) {
+            if (c.first.rfind(idOrName, 0) == 0 || c.second.name == idOrName) return &c.second;
+        }
+        return nullptr;
+    }
+
+    /** @brief Queue a container event, must be called with the lock */
+    void event(const Container& c, const std::string& action) {
+        nlohmann::json attributes = {{"name", c.name}, {"image", c.image}};
+        if (action == "die") attributes["exitCode"] = std::to_string(c.exitCode);
+        nlohmann::json e = {{"Type", "container"}, {"Action", action}, {"time", ++eventTime},
+            {"Actor", {{"ID", c.id}, {"Attributes", attributes}}}};
+        events.emplace_back(eventTime, e.dump());
+        eventCondition.notify_all();
+    }
+
+    std::string route(const std::string& method, std::string path, const std::string& body) {
+        std::string query;
+        size_t q = path.find('?');
+        if (q != std::string::npos) {
+            query = path.substr(q + 1);
+            path = path.substr(0, q);
+        }
+        // the api version is optional
+        if (path.rfind("/v1.", 0) == 0) path = path.substr(path.find('/', 1));
+        std::vector<std::string> parts;
+        for (size_t i = 1, j; i <= path.size(); i = j + 1) {
+            j = path.find('/', i);
+            if (j == std::string::npos) j = path.size();
+            parts.push_back(path.substr(i, j - i));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (method == "GET" && path == "/containers/json") {
+            std::string nameFilter;
+            size_t f = query.find("filters=");
+            if (f != std::string::npos) {
+                nlohmann::json filters = nlohmann::json::parse(urlDecode(query.substr(f + 8, query.find('&', f) - f - 8)));
+                std::string pattern = filters["name"][0];
+                nameFilter = pattern.substr(2, pattern.size() - 3);  // ^/name$
+            }
+            nlohmann::json list = nlohmann::json::array();
+            for (auto& c: containers) {
+                if (!nameFilter.empty() && c.second.name != nameFilter) continue;
+                list.push_back({{"Id", c.second.id}, {"Names", {"/" + c.second.name}}, {"Image", c.second.image},
+                    {"State", c.second.running ? "running" : "exited"}});
+            }
+            return response(200, list.dump());
+        }
+        if (method == "POST" && path == "/containers/create") {
+            std::string name = query.rfind("name=", 0) == 0 ? query.substr(5) : "";
+            if (!name.empty() && lookup(name)) return response(409, R"({"message":"Conflict"})");
+            Container c;
+            c.id = std::to_string(nextId++);
+            c.id = std::string(64 - c.id.size(), 'f') + c.id;
+            c.name = name;
+            c.image = nlohmann::json::parse(body.empty() ? "{}" : body).value("Image", "");
+            containers[c.id] = c;
+            event(c, "create");
+            return response(201, nlohmann::json({{"Id", c.id}, {"Warnings", nlohmann::json::array()}}).dump());
+        }
+        if (method == "POST" && path == "/images/create") {
+            return response(200, R"({"status":"Downloaded newer image"})");
+        }
+        if (parts.size() >= 2 && parts[0] == "containers") {
+            Container* c = lookup(parts[1]);
+            if (!c) return response(404, R"({"message":"No such container"})");
+            if (method == "GET" && parts.size() == 3 && parts[2] == "json") {
+                nlohmann::json state = {{"Running", c->running}, {"Pid", c->pid}, {"ExitCode", c->exitCode}};
+                return response(200, nlohmann::json({{"Id", c->id}, {"Name", "/" + c->name}, {"State", state}}).dump());
+            }
+            if (method == "POST" && parts.size() == 3 && parts[2] == "start") {
+                if (c->running) return response(304);
+                c->running = true;
+                c->pid = 1000 + nextId++;
+                event(*c, "start");
+                return response(204);
+            }
+            if (method == "POST" && parts.size() == 3 && parts[2] == "stop") {
+                if (!c->running) return response(304);
+                c->running = false;
+                c->pid = 0;
+                c->exitCode = 0;
+                event(*c, "die");
+                return response(204);
+            }
+            if (method == "DELETE" && parts.size() == 2) {
+                Container removed = *c;
+                containers.erase(removed.id);
+                event(removed, "destroy");
+                return response(204);
+            }
+        }
+        return response(404, R"({"message":"page not found"})");
+    }
+
+    /** @brief Stream the events until the server stops or closeEvents() is called */
+    void streamEvents(int client, const std::string& path) {
+        std::string header = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nConnection: close\r\n\r\n";
+        if (write(client, header.data(), header.size()) < 0) return;
+        std::unique_lock<std::mutex> lock(mutex);
+        // replay the events since the requested time
+        size_t sent = events.size();
+        size_t s = path.find("since=");
+        if (s != std::string::npos) {
+            long since = std::stol(path.substr(s + 6));
+            sent = 0;
+            while (sent < events.size() && events[sent].first < since) sent++;
+        }
+        while (running) {
+            eventCondition.wait(lock, [&]() { return !running || events.size() > sent || eventsClosed; });
+            if (eventsClosed) break;
+            for (; sent < events.size(); sent++) {
+                std::string line = events[sent].second + "\n";
+                if (write(client, line.data(), line.size()) < 0) return;
+            }
+        }
+    }
+
+    void handle(int client) {
+        std::string buffer;
+        char chunk[4096];
+        while (running) {
+            size_t end;
+            while ((end = buffer.find("\r\n\r\n")) == std::string::npos) {
+                ssize_t n = read(client, chunk, sizeof(chunk));
+                if (n <= 0) { disconnect(client); return; }
+                buffer.append(chunk, n);
+            }
+            std::string head = buffer.substr(0, end);
+            size_t contentLength = 0;
+            size_t cl = head.find("Content-Length: ");
+            if (cl != std::string::npos) contentLength = std::stoul(head.substr(cl + 16));
+            while (buffer.size() < end + 4 + contentLength) {
+                ssize_t n = read(client, chunk, sizeof(chunk));
+                if (n <= 0) { disconnect(client); return; }
+                buffer.append(chunk, n);
+            }
+            std::string body = buffer.substr(end + 4, contentLength);
+            buffer.erase(0, end + 4 + contentLength);
+
+            std::string requestLine = head.substr(0, head.find("\r\n"));
+            std::string method = requestLine.substr(0, requestLine.find(' '));
+            std::string path = requestLine.substr(method.size() + 1, requestLine.rfind(' ') - method.size() - 1);
+            requests++;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                requestLines.push_back(requestLine);
+            }
+
+            if (path.find("/events") != std::string::npos) {
+                std::this_thread::sleep_for(latency);
+                streamEvents(client, path);
+                disconnect(client);
+                return;
+            }
+            size_t active = ++activeRequests;
+            size_t peak = peakRequests;
+            while (active > peak && !peakRequests.compare_exchange_weak(peak, active)) {}
+            std::this_thread::sleep_for(latency);
+            std::string answer = route(method, path, body);
+            activeRequests--;
+            if (write(client, answer.data(), answer.size()) < 0) break;
+        }
+        disconnect(client);
+    }
+
+    void disconnect(int client) {
+        std::lock_guard<std::mutex> lock(mutex);
+        clients.erase(std::find(clients.begin(), clients.end(), client));
+        close(client);
+    }
+
+    bool eventsClosed = false;
+
+public:
+    FakeDockerServer(std::string socketPath, std::chrono::milliseconds latency = std::chrono::milliseconds(0)) :
+        socketPath(socketPath), latency(latency), running(true), connections(0), requests(0), activeRequests(0), peakRequests(0)
+    {
+        unlink(socketPath.c_str());
+        server = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+        if (::bind(server, (sockaddr*) &address, sizeof(address)) != 0 || listen(server, 16) != 0) {
+            throw std::runtime_error("Fake docker server cannot listen on " + socketPath);
+        }
+        acceptor = std::thread([this]() {
+            while (running) {
+                int client = accept(server, nullptr, nullptr);
+                if (client < 0) break;
+                connections++;
+                std::lock_guard<std::mutex> lock(mutex);
+                clients.push_back(client);
+                handlers.emplace_back(&FakeDockerServer::handle, this, client);
+            }
+        });
+    }
+
+    ~FakeDockerServer() {
+        running = false;
+        shutdown(server, SHUT_RDWR);
+        close(server);
+        acceptor.join();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (int client: clients) shutdown(client, SHUT_RDWR);
+            eventCondition.notify_all();
+        }
+        for (auto& handler: handlers) handler.join();
+        unlink(socketPath.c_str());
+    }
+
+    const std::string& getSocketPath() const { return socketPath; }
+    size_t getConnections() const { return connections; }
+    size_t getRequests() const { return requests; }
+    /** @brief Maximum number of requests the server handled at the same time */
+    size_t getPeakRequests() const { return peakRequests; }
+
+    std::vector<std::string> getRequestLines() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return requestLines;
+    }
+
+    /** @brief Add an existing container, returns its id */
+    std::string addContainer(const std::string& name, const std::string& image, bool isRunning) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Container c;
+        c.id = std::to_string(nextId++);
+        c.id = std::string(64 - c.id.size(), 'a') + c.id;
+        c.name = name;
+        c.image = image;
+        c.running = isRunning;
+        c.pid = isRunning ? 1000 + nextId : 0;
+        containers[c.id] = c;
+        return c.id;
+    }
+
+    /** @brief The container exits, e.g. it crashed */
+    void killContainer(const std::string& id, int exitCode) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Container* c = lookup(id);
+        if (!c) return;
+        c->running = false;
+        c->pid = 0;
+        c->exitCode = exitCode;
+        event(*c, "die");
+    }
+
+    /** @brief Drop the open event streams, the clients have to reconnect */
+    void closeEvents() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            eventsClosed = true;
+            eventCondition.notify_all();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::lock_guard<std::mutex> lock(mutex);
+        eventsClosed = false;
+    }
+};
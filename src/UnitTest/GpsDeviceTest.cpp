@@ -0,0 +1,103 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_gps_device
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+
+#include <Gps/GpsDevice.h>
+#include <Utils/Nmea/Nmea.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <Utils/Redis/LocalStore.h>
+#include <Utils/Settings/Platform.h>
+
+using namespace Ilvo::Core;
+using namespace Ilvo::Utils::Nmea;
+using namespace Ilvo::Utils::Peripheral;
+using namespace Ilvo::Utils::Logging;
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Utils::Settings;
+
+using namespace std;
+using namespace std::chrono_literals;
+
+namespace {
+    /** @brief NMEA line of the sentence with its checksum */
+    vector<char> nmea(const string& sentence)
+    {
+        int sum = 0;
+        for (char c: sentence) sum ^= c;
+        char checksum[4];
+        snprintf(checksum, sizeof(checksum), "%02X", sum);
+        string line = "$" + sentence + "*" + checksum;
+        return vector<char>(line.begin(), line.end());
+    }
+
+    /** @brief Peripheral that delivers the same lines of a fix, at a given receive time */
+    class ReplayPeripheral: public Peripheral
+    {
+    public:
+        ReplayPeripheral() { loaded = true; }
+        bool openFd() override { return true; }
+        bool closeFd() override { return true; }
+        bool readNmeaLine() override { return true; }
+        void init() override {}
+        void run() override {}
+
+        void deliver(chrono::steady_clock::time_point received)
+        {
+            lock_guard<mutex> lock(m);
+            for (string sentence: {"GPGGA,084310.70,5058.9727940,N,00346.7146948,E,4,06,9.9,80.300,M,0.00,M,06,2069",
+                                   "GPVTG,45.0,T,45.0,M,1.0,N,1.85,K,A",
+                                   "PSSN,HRP,084310.70,010124,90.0,0.5,1.0,0.1,0.1,0.1,12,4,0,1",
+                                   "GPHDT,123.456,T"}) {
+                vector<char> chars = nmea(sentence);
+                nmeaMessagePack.addNmeaLine(make_shared<NmeaLine>(chars));
+            }
+            nmeaMessagePack.received = received;
+        }
+    };
+
+    class TestGpsDevice: public GpsDevice
+    {
+    public:
+        TestGpsDevice(shared_ptr<LocalStore> store, unique_ptr<Peripheral> peripheral) :
+            GpsDevice("ilvo-gps", store, std::move(peripheral)) {}
+        const TraceContext& getTrace() const { return trace; }
+    };
+}
+
+// Gps device test bench suite
+BOOST_AUTO_TEST_SUITE(GpsDeviceTest)
+
+BOOST_AUTO_TEST_CASE( trace_per_fix )
+{
+    // Arrange
+    LoggerStream::createInstance("test-gps-device");
+    Platform::getInstance();
+    auto store = make_shared<LocalStore>();
+    auto peripheral = make_unique<ReplayPeripheral>();
+    ReplayPeripheral& replay = *peripheral;
+    TestGpsDevice gps(store, std::move(peripheral));
+    auto received = chrono::steady_clock::now();
+
+    // Act: the lines of the first fix are delivered twice
+    replay.deliver(received);
+    gps.tick();
+    int64_t first = gps.getTrace().seq;
+    replay.deliver(received);
+    gps.tick();
+    int64_t again = gps.getTrace().seq;
+    replay.deliver(received + 100ms);
+    gps.tick();
+    int64_t next = gps.getTrace().seq;
+
+    // Assert: one trace per fix, not per tick
+    BOOST_TEST(first == 1);
+    BOOST_TEST(again == first);
+    BOOST_TEST(next == first + 1);
+    BOOST_TEST(store->getJson("gps.raw.state")["trace"]["seq"] == next);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,75 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_ilvo_addon
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+
+#include <System/IlvoAddon.h>
+#include <Utils/Docker/DockerClient.h>
+#include <Utils/Logging/LoggerStream.h>
+#include "FakeDockerServer.h"
+
+using namespace Ilvo::Core;
+using namespace Ilvo::Utils::Docker;
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+using namespace std::chrono_literals;
+using namespace nlohmann;
+
+namespace {
+    json addonJson(const string& name, const string& image)
+    {
+        return {
+            {"Name", name},
+            {"DockerRegistry", {{"serveraddress", "https://registry.hub.docker.com/v2/"}}},
+            {"DockerConfig", {{"Image", image}}}
+        };
+    }
+}
+
+// Ilvo add-on test bench suite
+BOOST_AUTO_TEST_SUITE(IlvoAddonTest)
+
+BOOST_AUTO_TEST_CASE( start_all )
+{
+    // Arrange
+    LoggerStream::createInstance("test-ilvo-addon");
+    FakeDockerServer daemon("/tmp/test-ilvo-addon-" + to_string(getpid()) + ".sock", 50ms);
+    string existing = daemon.addContainer("system", "ilvo/system", false);
+    setenv("ILVO_DOCKER_SOCKET", daemon.getSocketPath().c_str(), 1);
+    DockerClient client;
+    vector<unique_ptr<IlvoAddon>> addons;
+    addons.push_back(make_unique<IlvoAddon>(addonJson("system", "ilvo/system"), client));
+    addons.push_back(make_unique<IlvoAddon>(addonJson("node-red", "nodered/node-red"), client));
+    addons.push_back(make_unique<IlvoAddon>(addonJson("dashboard", "ilvo/dashboard"), client));
+    vector<IlvoAddon*> autoStart;
+    for (auto& addon: addons) autoStart.push_back(addon.get());
+
+    // Act
+    auto start = chrono::steady_clock::now();
+    IlvoAddon::startAll(autoStart, client);
+    auto elapsed = chrono::steady_clock::now() - start;
+
+    // Assert
+    BOOST_TEST(addons[0]->getContainerId() == existing);
+    for (auto& addon: addons) {
+        BOOST_TEST(!addon->getContainerId().empty());
+        BOOST_TEST(addon->getData().getRunning());
+        BOOST_TEST(addon->inspect());
+    }
+    // one listing, the creations and the starts are sent together: three round trips instead of nine
+    size_t listings = 0;
+    for (const string& r: daemon.getRequestLines()) {
+        if (r.find("/containers/json") != string::npos) listings++;
+    }
+    BOOST_TEST(listings == 1);
+    BOOST_TEST(daemon.getPeakRequests() > 1);
+    BOOST_TEST_MESSAGE("3 add-ons started in " << chrono::duration_cast<chrono::milliseconds>(elapsed).count() << " ms");
+
+    addons.clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
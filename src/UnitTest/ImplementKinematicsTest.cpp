@@ -0,0 +1,176 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_implement_kinematics
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <chrono>
+#include <cmath>
+
+#include <Utils/Settings/ImplementKinematics.h>
+#include <Utils/Settings/Implement.h>
+#include <Utils/Geometry/Transform.h>
+
+using namespace Ilvo::Utils::Settings;
+using namespace Ilvo::Utils::Geometry;
+
+using namespace std;
+using namespace Eigen;
+using json = nlohmann::json;
+
+namespace {
+    /** @brief Three point hitch at the rear of the robot */
+    json hitchJson()
+    {
+        return json::parse(R"({
+            "id": 2, "name": "FB", "min": 10, "max": 65, "types": ["continuous"], "link_length": 0.601,
+            "transform": {"T": [0.0, 0.3314, -1.3831], "R": [0.0, 0.0, 0.0]}
+        })");
+    }
+
+    /** @brief Sprayer boom of 48 sections of 0.5 m, the outer ones on a parallel linkage */
+    json boomJson()
+    {
+        return json::parse(R"({
+            "name": "boom",
+            "types": ["continuous"],
+            "sections": [{
+                "id": "L", "width": 0.5, "up": 0.05, "down": 0.05, "repeats": 12, "offset": 0.5, "link_length": 0.4,
+                "transform": {"T": [-12.0, -0.98, -0.4], "R": [0.0, 0.0, 0.0]}
+            }, {
+                "id": "C", "width": 0.5, "up": 0.05, "down": 0.05, "repeats": 24, "offset": 0.5,
+                "transform": {"T": [-5.75, -0.98, -0.4], "R": [0.0, 0.0, 0.0]}
+            }, {
+                "id": "R", "width": 0.5, "up": 0.05, "down": 0.05, "repeats": 12, "offset": 0.5, "link_length": 0.4,
+                "transform": {"T": [6.25, -0.98, -0.4], "R": [0.0, 0.0, 0.0]}
+            }]
+        })");
+    }
+
+    /** @brief Place the hitch at a robot pose */
+    void place(Hitch& hitch, double x, double y, double heading)
+    {
+        hitch.updateState(vectorToAffine(Vector3d(x, y, 0.0), Vector3d(0.0, 0.0, heading)) * hitch.getRefTransform());
+    }
+
+    /** @brief Section states and polygons the way Task::updateState calculated them before */
+    void updateChain(Hitch& hitch, double hitchAngle, vector<SectionPtr>& sections)
+    {
+        for (auto section: sections) {
+            section->updateState(hitch.getBallState(hitchAngle) * section->getParallelTransform());
+            section->updatePolygon();
+        }
+    }
+
+    void updateKinematics(ImplementKinematics& kinematics, Hitch& hitch, double hitchAngle, vector<SectionPtr>& sections)
+    {
+        kinematics.update(hitch, hitchAngle, sections);
+        for (size_t i = 0; i < sections.size(); i++) {
+            sections[i]->updateState(kinematics.getTransform(i));
+            sections[i]->setFootprint(kinematics.getCorners(i));
+        }
+    }
+}
+
+// Implement kinematics test bench suite
+BOOST_AUTO_TEST_SUITE(ImplementKinematicsTest)
+
+BOOST_AUTO_TEST_CASE( same_footprints_as_chain )
+{
+    // Arrange
+    Hitch hitch(hitchJson());
+    Implement chainBoom(boomJson()), kinematicsBoom(boomJson());
+    ImplementKinematics kinematics;
+    BOOST_TEST_REQUIRE(chainBoom.getSections().size() == 48);
+
+    for (int k = 0; k < 20; k++) {
+        // Act: a moving robot, hitch and outer sections
+        place(hitch, 500000.0 + k, 5650000.0 + 0.5 * k, 10.0 * k);
+        double hitchAngle = 20.0 + k;
+        for (size_t i = 0; i < 48; i++) {
+            double parallelAngle = (i < 12 || i >= 36) ? 2.0 * k : 0.0;
+            chainBoom.getSections()[i]->setParallelAngle(parallelAngle);
+            kinematicsBoom.getSections()[i]->setParallelAngle(parallelAngle);
+        }
+        updateChain(hitch, hitchAngle, chainBoom.getSections());
+        updateKinematics(kinematics, hitch, hitchAngle, kinematicsBoom.getSections());
+
+        // Assert
+        for (size_t i = 0; i < 48; i++) {
+            const auto& expected = chainBoom.getSections()[i]->getPolygon().geometry().outer();
+            const auto& actual = kinematicsBoom.getSections()[i]->getPolygon().geometry().outer();
+            BOOST_TEST_REQUIRE(actual.size() == expected.size());
+            for (size_t c = 0; c < expected.size(); c++) {
+                BOOST_TEST_REQUIRE(actual[c].x() == expected[c].x(), boost::test_tools::tolerance(1e-12));
+                BOOST_TEST_REQUIRE(actual[c].y() == expected[c].y(), boost::test_tools::tolerance(1e-12));
+            }
+            State& expectedState = chainBoom.getSections()[i]->getState();
+            State& actualState = kinematicsBoom.getSections()[i]->getState();
+            BOOST_TEST_REQUIRE(actualState.getT().asVector().isApprox(expectedState.getT().asVector(), 1e-12));
+            BOOST_TEST_REQUIRE((actualState.getR().asVector() - expectedState.getR().asVector()).norm() < 1e-9);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( chain_recalculated_on_changed_angles )
+{
+    // Arrange
+    Hitch hitch(hitchJson());
+    Implement boom(boomJson());
+    ImplementKinematics kinematics;
+    vector<SectionPtr>& sections = boom.getSections();
+    place(hitch, 500000.0, 5650000.0, 30.0);
+
+    // Act
+    size_t first = kinematics.update(hitch, 20.0, sections);
+    place(hitch, 500001.0, 5650000.0, 31.0);
+    size_t moved = kinematics.update(hitch, 20.0, sections);
+    sections[3]->setParallelAngle(5.0);
+    size_t parallel = kinematics.update(hitch, 20.0, sections);
+    size_t lifted = kinematics.update(hitch, 40.0, sections);
+    sections.pop_back();
+    size_t removed = kinematics.update(hitch, 40.0, sections);
+
+    // Assert
+    BOOST_TEST(first == 48);
+    BOOST_TEST(moved == 0);
+    BOOST_TEST(parallel == 1);
+    BOOST_TEST(lifted == 48);
+    BOOST_TEST(removed == 47);
+    BOOST_TEST(kinematics.getNumSections() == 47);
+}
+
+BOOST_AUTO_TEST_CASE( sprayer_boom_update_time )
+{
+    // Arrange
+    Hitch hitch(hitchJson());
+    Implement chainBoom(boomJson()), kinematicsBoom(boomJson());
+    ImplementKinematics kinematics;
+    const int ticks = 2000;
+
+    // Act: the robot drives with a fixed hitch angle, the state of all sections is updated every tick
+    auto start = chrono::steady_clock::now();
+    for (int k = 0; k < ticks; k++) {
+        place(hitch, 500000.0 + 0.01 * k, 5650000.0, 30.0);
+        updateChain(hitch, 20.0, chainBoom.getSections());
+    }
+    double chainUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / ticks;
+
+    start = chrono::steady_clock::now();
+    for (int k = 0; k < ticks; k++) {
+        place(hitch, 500000.0 + 0.01 * k, 5650000.0, 30.0);
+        updateKinematics(kinematics, hitch, 20.0, kinematicsBoom.getSections());
+    }
+    double kinematicsUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / ticks;
+
+    start = chrono::steady_clock::now();
+    for (int k = 0; k < ticks; k++) {
+        place(hitch, 500000.0 + 0.01 * k, 5650000.0, 30.0);
+        kinematics.update(hitch, 20.0, kinematicsBoom.getSections());
+    }
+    double footprintsUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / ticks;
+
+    // Report: the times depend on the machine and its load, they are not asserted
+    BOOST_TEST_MESSAGE("48 sections, chain: " << chainUs << " us, kinematics with section states: " << kinematicsUs
+                       << " us, footprints only: " << footprintsUs << " us per tick");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,93 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_implement_visualization
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+
+#include <Utils/Settings/Implement.h>
+#include <Utils/Geometry/Transform.h>
+
+using namespace Ilvo::Utils::Settings;
+using namespace Ilvo::Utils::Geometry;
+
+using namespace std;
+using namespace Eigen;
+using json = nlohmann::json;
+
+namespace {
+    const int zone = 31;
+
+    /** @brief Implement of 6 sections, visualized in a local tangent plane */
+    json implementJson()
+    {
+        return json::parse(R"({
+            "name": "boom",
+            "types": ["continuous"],
+            "sections": [{
+                "id": "S", "width": 0.5, "up": 0.05, "down": 0.05, "repeats": 6, "offset": 0.5,
+                "transform": {"T": [-1.25, -1.0, 0.0], "R": [0.0, 0.0, 0.0]}
+            }]
+        })");
+    }
+
+    /** @brief Place the implement at a robot pose */
+    void place(Implement& implement, double x, double y, double heading)
+    {
+        Affine3d robot = vectorToAffine(Vector3d(x, y, 0.0), Vector3d(0.0, 0.0, heading));
+        for (auto section: implement.getSections()) {
+            section->updateState(robot * section->getRefTransform());
+            section->updatePolygon();
+        }
+    }
+}
+
+// Implement visualization test bench suite
+BOOST_AUTO_TEST_SUITE(ImplementVisualizationTest)
+
+BOOST_AUTO_TEST_CASE( unchanged_implement )
+{
+    // Arrange
+    Implement implement(implementJson());
+    place(implement, 500000.0, 5650000.0, 30.0);
+
+    // Act
+    bool changedBefore = implement.visualizationChanged();
+    json visualization = implement.visualize(zone);
+    json expected = implement.visualizeJson(zone);
+    bool changedAfter = implement.visualizationChanged();
+    place(implement, 500000.004, 5650000.003, 30.0);
+
+    // Assert
+    BOOST_TEST(changedBefore);
+    BOOST_TEST(visualization == expected);
+    BOOST_TEST(!changedAfter);
+    BOOST_TEST(!implement.visualizationChanged());
+    BOOST_TEST(implement.visualize(zone) == visualization);
+}
+
+BOOST_AUTO_TEST_CASE( moved_or_activated_sections )
+{
+    // Arrange
+    Implement implement(implementJson());
+    place(implement, 500000.0, 5650000.0, 30.0);
+    json initial = implement.visualize(zone);
+
+    // Act
+    place(implement, 500000.0, 5650000.0, 31.0);
+    bool changedRotation = implement.visualizationChanged();
+    json rotated = implement.visualize(zone);
+    json expectedRotated = implement.visualizeJson(zone);
+    implement.getSections()[2]->setActive(true);
+    bool changedActivation = implement.visualizationChanged();
+    json activated = implement.visualize(zone);
+
+    // Assert
+    BOOST_TEST(changedRotation);
+    BOOST_TEST(rotated != initial);
+    BOOST_TEST(rotated == expectedRotated);
+    BOOST_TEST(changedActivation);
+    BOOST_TEST(activated["sections"][2]["active"] == true);
+    BOOST_TEST(activated == implement.visualizeJson(zone));
+    BOOST_TEST(!implement.visualizationChanged());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
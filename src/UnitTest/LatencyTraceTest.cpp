@@ -0,0 +1,187 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_latency_trace
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <chrono>
+
+#include <Utils/Logging/LatencyTrace.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <Utils/Redis/LocalStore.h>
+#include <Utils/Redis/VariableManager.h>
+#include <Utils/Settings/Platform.h>
+
+using namespace Ilvo::Utils::Logging;
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Utils::Settings;
+
+using namespace std;
+using namespace nlohmann;
+
+namespace {
+    /** @brief Source of the fixes, like the GPS device */
+    class TestSource: public VariableManager
+    {
+    public:
+        TestSource(shared_ptr<LocalStore> store) : VariableManager("ilvo-test-source", store) {}
+        void serverTick() override
+        {
+            State rawState;
+            startTrace(traceNow() - 5000);  // received 5 ms ago
+            setRedisJsonStates(platform, rawState);
+        }
+        const TraceContext& getTrace() const { return trace; }
+    };
+
+    /** @brief Consumer of the fixes, like the navigation */
+    class TestConsumer: public VariableManager
+    {
+    public:
+        TestConsumer(shared_ptr<LocalStore> store) : VariableManager("ilvo-test-consumer", store) {}
+        void serverTick() override { updatePlatformState(); }
+        const TraceContext& getTrace() const { return trace; }
+        LatencyTracer& getTracer() { return tracer; }
+    };
+}
+
+// Latency trace test bench suite
+BOOST_AUTO_TEST_SUITE(LatencyTraceTest)
+
+BOOST_AUTO_TEST_CASE( trace_context )
+{
+    // Arrange
+    TraceContext trace{42, 123456789012345};
+
+    // Act
+    TraceContext fromString = TraceContext::fromString(trace.toString());
+    TraceContext fromJson = TraceContext::fromJson(trace.toJson());
+
+    // Assert
+    BOOST_TEST(trace.toString() == "42:123456789012345");
+    BOOST_TEST((fromString == trace));
+    BOOST_TEST((fromJson == trace));
+    BOOST_TEST(!TraceContext::fromString("-").valid());
+    BOOST_TEST(!TraceContext::fromString("a:b").valid());
+    BOOST_TEST(!TraceContext::fromJson(json()).valid());
+}
+
+BOOST_AUTO_TEST_CASE( rolling_histogram )
+{
+    // Arrange: a window of 100 fixes
+    LatencyTracer tracer("test-latency-trace", 16, 100);
+
+    // Act: 200 fixes, the first 100 of 1 s are rolled out of the window by 100 fixes of 1 to 100 ms
+    for (int i = 0; i < 100; i++) {
+        tracer.record("test", TraceContext{i + 1, 0}, 0, 1000000);
+    }
+    for (int i = 0; i < 100; i++) {
+        tracer.record("test", TraceContext{i + 101, 0}, 0, (i + 1) * 1000);
+    }
+    json histogram = tracer.histogram();
+
+    // Assert
+    BOOST_TEST(tracer.samples() == 100);
+    BOOST_TEST(histogram["count"] == 100);
+    BOOST_TEST(histogram["p50"].get<double>() == 51.0);
+    BOOST_TEST(histogram["p99"].get<double>() == 100.0);
+    BOOST_TEST(histogram["max"].get<double>() == 100.0);
+    json buckets = histogram["buckets"];
+    BOOST_TEST(buckets.size() == TRACE_LATENCY_BUCKETS.size() + 1);
+    BOOST_TEST(buckets[0]["count"] == 1);   // <= 1 ms
+    BOOST_TEST(buckets[4]["count"] == 10);  // 10 < age <= 20 ms
+    BOOST_TEST(buckets[6]["count"] == 50);  // 50 < age <= 100 ms
+    BOOST_TEST(buckets.back()["count"] == 0);
+}
+
+BOOST_AUTO_TEST_CASE( chrome_trace )
+{
+    // Arrange: a ring buffer of 4 spans
+    LatencyTracer tracer("test-latency-trace", 4);
+
+    // Act
+    for (int i = 1; i <= 6; i++) {
+        tracer.record("test", TraceContext{i, 1000 * i}, 1000 * i + 100, 1000 * i + 300, TraceFlow::END);
+    }
+    BOOST_TEST(tracer.flush());
+    json trace = json::parse(ifstream(tracer.getFilePath().string()));
+    boost::filesystem::remove(tracer.getFilePath());
+
+    // Assert: a name event and a span and flow event per span of the buffer
+    json events = trace["traceEvents"];
+    BOOST_TEST(events.size() == 9);
+    BOOST_TEST(events[0]["ph"] == "M");
+    BOOST_TEST(events[1]["ph"] == "X");
+    BOOST_TEST(events[1]["args"]["seq"] == 3);
+    BOOST_TEST(events[1]["ts"] == 3100);
+    BOOST_TEST(events[1]["dur"] == 200);
+    BOOST_TEST(events[1]["args"]["age_ms"].get<double>() == 0.3);
+    BOOST_TEST(events[2]["ph"] == "f");
+    BOOST_TEST(events[2]["id"] == 3);
+    BOOST_TEST(events.back()["id"] == 6);
+}
+
+BOOST_AUTO_TEST_CASE( export_thread )
+{
+    // Arrange
+    boost::filesystem::path filePath;
+    {
+        LatencyTracer tracer("test-latency-export");
+        filePath = tracer.getFilePath();
+        tracer.record("test", TraceContext{1, 1000}, 1100, 1300, TraceFlow::BEGIN);
+
+        // Act: the thread writes the spans recorded before the stop
+        tracer.startExport(chrono::milliseconds(50));
+        this_thread::sleep_for(chrono::milliseconds(20));
+        tracer.record("test", TraceContext{2, 2000}, 2100, 2300, TraceFlow::END);
+        tracer.stopExport();
+
+        // Assert
+        BOOST_TEST(tracer.takeExportError().empty());
+    }
+    json trace = json::parse(ifstream(filePath.string()));
+    BOOST_TEST(trace["traceEvents"].size() == 5);
+    boost::filesystem::remove(filePath);
+}
+
+BOOST_AUTO_TEST_CASE( export_opt_in )
+{
+    // Arrange
+    boost::filesystem::path filePath;
+
+    // Act: a tracer without export writes no file, also not at its destruction
+    {
+        LatencyTracer tracer("test-latency-no-export");
+        filePath = tracer.getFilePath();
+        tracer.record("test", TraceContext{1, 1000}, 1100, 1300, TraceFlow::BEGIN);
+    }
+
+    // Assert
+    BOOST_TEST(!boost::filesystem::exists(filePath));
+}
+
+BOOST_AUTO_TEST_CASE( propagation )
+{
+    // Arrange
+    LoggerStream::createInstance("test-latency-trace");
+    Platform::getInstance();
+    auto store = make_shared<LocalStore>();
+    TestSource source(store);
+    TestConsumer consumer(store);
+
+    // Act
+    source.tick();
+    consumer.tick();
+    consumer.tick();  // the same fix, no second span
+
+    // Assert: the trace context is carried by the raw state and the consumer records the age of the fix
+    BOOST_TEST(source.getTrace().seq == 1);
+    BOOST_TEST((consumer.getTrace() == source.getTrace()));
+    BOOST_TEST(consumer.getTracer().samples() == 1);
+    BOOST_TEST(consumer.getTracer().histogram()["p50"].get<double>() >= 5.0);
+    BOOST_TEST(store->getJson("ilvo-test-consumer.latency")["count"] == 1);
+    BOOST_TEST(store->getJson("ilvo-test-source.latency")["count"] == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
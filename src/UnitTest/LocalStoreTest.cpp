@@ -0,0 +1,206 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_local_store
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <boost/filesystem.hpp>
+
+#include <Utils/Redis/RedisStream.h>
+#include <Utils/Redis/LocalStore.h>
+#include <Utils/Redis/VariableManager.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <Utils/Settings/Platform.h>
+#include <Utils/Timing/Clk.h>
+#include <Utils/Timing/Logic.h>
+#include <Utils/Timing/VirtualClock.h>
+
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Utils::Timing;
+using namespace Ilvo::Utils::Logging;
+using namespace Ilvo::Utils::Settings;
+
+using namespace std;
+using namespace std::chrono_literals;
+
+namespace {
+    class TestVariableManager: public VariableManager
+    {
+    public:
+        TestVariableManager(shared_ptr<LocalStore> store) : VariableManager("ilvo-test", store) {}
+        void serverTick() override {}
+    };
+}
+
+// Local store test bench suite
+BOOST_AUTO_TEST_SUITE(LocalStoreTest)
+
+BOOST_AUTO_TEST_CASE( redis_stream_on_local_store )
+{
+    // Arrange
+    auto store = make_shared<LocalStore>();
+    RedisStream rs(store);
+
+    // Act
+    rs.setRedisValue(string("pc.navigation.mode"), 2);
+    rs.setRedisValues({"pc.field.name", "example", "pc.simulation.auto", "true"});
+    rs.setRedisJsonValue("robot.status", {{"fix", "RTK"}});
+    int received = 0;
+    string channel = "ilvo-navigation-tick";
+    store->subscribe(channel, [&received](const string_view& message) { received += message == "1.500000"; });
+    int subscribers = rs.publishRedisValue(channel, 1.5);
+
+    // Assert
+    BOOST_TEST(rs.getRedisValue(string("pc.navigation.mode")) == "2");
+    vector<string> values = rs.getRedisValues({"pc.field.name", "pc.unknown", "pc.simulation.auto"});
+    BOOST_TEST(values.size() == 3);
+    BOOST_TEST(values[0] == "example");
+    BOOST_TEST(values[1].empty());
+    BOOST_TEST(values[2] == "true");
+    BOOST_TEST(rs.isRedisValueNil("pc.unknown"));
+    BOOST_TEST(rs.getRedisJsonValue("robot.status")["fix"] == "RTK");
+    BOOST_TEST(rs.getRedisJsonValue("robot.contour").is_null());
+    BOOST_TEST(subscribers == 1);
+    BOOST_TEST(received == 1);
+    BOOST_TEST(rs.delRedisValues(string("pc.field.name"), string("robot.status")) == 2);
+    BOOST_TEST(!store->exists("pc.field.name"));
+}
+
+BOOST_AUTO_TEST_CASE( key_inspection )
+{
+    // Arrange
+    auto store = make_shared<LocalStore>();
+    RedisStream rs(store);
+
+    // Act
+    rs.setRedisValue(string("pc.navigation.mode"), 2);
+    store->hset("pc.field", {"updated", "true", "name", "example"});
+    rs.setRedisJsonValue("robot.status", {{"fix", "RTK"}});
+
+    // Assert
+    BOOST_TEST(rs.getRedisType("pc.navigation.mode") == "string");
+    BOOST_TEST(rs.getRedisType("pc.field") == "hash");
+    BOOST_TEST(rs.getRedisType("robot.status") == "ReJSON-RL");
+    BOOST_TEST(rs.getRedisType("pc.unknown") == "none");
+    vector<string> keys = rs.getRedisKeys("pc.*");
+    sort(keys.begin(), keys.end());
+    BOOST_TEST(keys == vector<string>({"pc.field", "pc.navigation.mode"}));
+    BOOST_TEST(rs.getRedisKeys().size() == 3);
+    BOOST_TEST(rs.getRedisHashAll("pc.field") == vector<string>({"name", "example", "updated", "true"}));
+    BOOST_TEST(rs.getRedisHashAll("pc.unknown").empty());
+}
+
+BOOST_AUTO_TEST_CASE( variable_defaults )
+{
+    // Arrange
+    LoggerStream::createInstance("test-local-store");
+    auto store = make_shared<LocalStore>();
+    store->set("pc.field.name", "example");
+    store->set("pc.execution.notification", "");
+
+    // Act
+    TestVariableManager variableManager(store);
+
+    // Assert: the nil variables are initialized, the existing values are kept, also the empty ones
+    BOOST_TEST(store->get("pc.field.name") == "example");
+    BOOST_TEST(store->exists("pc.execution.notification"));
+    BOOST_TEST(store->get("pc.execution.notification") == "");
+    BOOST_TEST(store->get("pc.navigation.mode") == "0");
+    BOOST_TEST(store->get("pc.test.heartbeat") == "false");
+}
+
+BOOST_AUTO_TEST_CASE( hash_layout )
+{
+    // Arrange: the configuration of $ILVO_PATH with the hash layout
+    LoggerStream::createInstance("test-local-store");
+    Platform::getInstance();
+    string ilvoPath = getenv("ILVO_PATH");
+    boost::filesystem::path hashPath = boost::filesystem::temp_directory_path() / "ilvo-hash-layout";
+    boost::filesystem::create_directories(hashPath);
+    boost::filesystem::copy_file(ilvoPath + "/types.json", hashPath / "types.json", boost::filesystem::copy_options::overwrite_existing);
+    nlohmann::ordered_json config = nlohmann::ordered_json::parse(ifstream(ilvoPath + "/config.json"));
+    config["protocols"]["redis"]["layout"] = "hash";
+    config["protocols"]["redis"]["flat_mirror"] = true;
+    ofstream((hashPath / "config.json").string()) << config.dump();
+    setenv("ILVO_PATH", hashPath.c_str(), 1);
+    auto store = make_shared<LocalStore>();
+    store->hset("pc.field", {"name", "example"});
+    store->hset("pc.execution", {"notification", ""});
+
+    // Act
+    TestVariableManager variableManager(store);
+    variableManager.getVariable("pc.navigation.mode")->setValue<int>(2);
+    variableManager.writeRedisVariables();
+    store->hset("plc.monitor.hitch_fb", {"feedback_sections.1", "12"});
+    variableManager.readRedisVariables();
+    setenv("ILVO_PATH", ilvoPath.c_str(), 1);
+
+    // Assert: the variables are grouped per entity, the flat keys are mirrored and the heartbeat remains flat
+    BOOST_TEST(store->hmget("pc.field", {"name"})[0] == "example");
+    BOOST_TEST(store->hmget("pc.navigation", {"mode"})[0] == "2");
+    BOOST_TEST(store->get("pc.navigation.mode") == "2");
+    BOOST_TEST(store->get("pc.test.heartbeat") == "false");
+    BOOST_TEST(store->hmget("pc.execution", {"heartbeat"})[0].empty());
+    BOOST_TEST(store->hmget("pc.execution", {"notification"})[0] == "");
+    BOOST_TEST(variableManager.getVariable("pc.execution.notification")->getValue<string>() == "");
+    BOOST_TEST(variableManager.getVariable("pc.field.name")->getValue<string>() == "example");
+    BOOST_TEST(variableManager.getVariable("plc.monitor.hitch_fb.feedback_sections.1")->getValue<int>() == 12);
+}
+
+BOOST_AUTO_TEST_CASE( virtual_clock )
+{
+    // Arrange
+    VirtualClock clock;
+    VirtualClockScope scope(clock);
+    Clk clk(20ms);
+    PulseGenerator pulse(500ms);
+    auto wallStart = chrono::steady_clock::now();
+
+    // Act: 10 simulated seconds
+    int toggles = 0;
+    bool previous = pulse.generatePulse();
+    for (int i = 0; i < 500; i++) {
+        clk.start();
+        clock.advance(20ms);
+        bool p = pulse.generatePulse();
+        toggles += p != previous;
+        previous = p;
+        clk.stop();
+    }
+    double wallTime = chrono::duration<double>(chrono::steady_clock::now() - wallStart).count();
+
+    // Assert
+    BOOST_TEST(clock.getElapsed() == chrono::nanoseconds(10s));
+    BOOST_TEST(toggles == 20);
+    BOOST_TEST(wallTime < 1.0);
+    BOOST_TEST(isVirtualTime());
+}
+
+BOOST_AUTO_TEST_CASE( tick_time_on_virtual_clock )
+{
+    // Arrange
+    LoggerStream::createInstance("test-local-store");
+    VirtualClock clock;
+    VirtualClockScope scope(clock);
+    auto store = make_shared<LocalStore>();
+    TestVariableManager variableManager(store);
+    vector<double> published;
+    auto callback = [&published](const string_view& message) { published.push_back(stod(string(message))); };
+    store->subscribe("ilvo-test-tick", callback);
+
+    // Act
+    for (int i = 0; i < 3; i++) {
+        variableManager.tick();
+        clock.advance(20ms);
+    }
+
+    // Assert: the published tick time advances with the virtual time
+    BOOST_TEST_REQUIRE(published.size() == 3);
+    BOOST_TEST(published[1] - published[0] == 20.0, boost::test_tools::tolerance(1e-3));
+    BOOST_TEST(published[2] - published[1] == 20.0, boost::test_tools::tolerance(1e-3));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
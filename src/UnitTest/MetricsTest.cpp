@@ -0,0 +1,140 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_metrics
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <Utils/Logging/Metrics.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <Utils/Nmea/Nmea.h>
+#include <Utils/Redis/LocalStore.h>
+#include <Utils/Redis/VariableManager.h>
+#include <Utils/Settings/Platform.h>
+
+using namespace Ilvo::Utils::Logging;
+using namespace Ilvo::Utils::Nmea;
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Utils::Settings;
+
+using namespace std;
+
+namespace {
+    /** @brief HTTP GET of the path on the local port, the response with its header */
+    string scrape(int port, const string& path)
+    {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = inet_addr("127.0.0.1");
+        if (connect(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+            close(fd);
+            return "";
+        }
+        string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        send(fd, request.data(), request.size(), 0);
+        string response;
+        char buffer[4096];
+        ssize_t n;
+        while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+            response.append(buffer, n);
+        }
+        close(fd);
+        return response;
+    }
+
+    /** @brief NMEA line of the sentence with its checksum */
+    vector<char> nmea(const string& sentence, bool validChecksum = true)
+    {
+        int sum = 0;
+        for (char c: sentence) sum ^= c;
+        char checksum[4];
+        snprintf(checksum, sizeof(checksum), "%02X", validChecksum ? sum : sum ^ 0xFF);
+        string line = "$" + sentence + "*" + checksum;
+        return vector<char>(line.begin(), line.end());
+    }
+
+    class TestManager: public VariableManager
+    {
+    public:
+        TestManager(shared_ptr<LocalStore> store) : VariableManager("ilvo-test-metrics", store) {}
+        void serverTick() override {}
+    };
+}
+
+// Metrics test bench suite
+BOOST_AUTO_TEST_SUITE(MetricsTest)
+
+BOOST_AUTO_TEST_CASE( registry )
+{
+    // Arrange
+    MetricsRegistry registry;
+    MetricCounter& counter = registry.counter("test_events_total", "Events.", {{"kind", "a\"b"}});
+    MetricGauge& gauge = registry.gauge("test_level", "Level.");
+    MetricHistogram& histogram = registry.histogram("test_duration_seconds", "Duration.", {}, {0.1, 1.0});
+
+    // Act
+    counter.inc();
+    registry.counter("test_events_total", "Events.", {{"kind", "a\"b"}}).inc(2);  // the same counter
+    gauge.set(-1.5);
+    histogram.observe(0.05);
+    histogram.observe(0.5);
+    histogram.observe(0.5);
+    histogram.observe(5.0);
+    string text = registry.render();
+
+    // Assert
+    BOOST_TEST(counter.get() == 3);
+    BOOST_TEST(text.find("# TYPE test_events_total counter\n") != string::npos);
+    BOOST_TEST(text.find("test_events_total{kind=\"a\\\"b\"} 3\n") != string::npos);
+    BOOST_TEST(text.find("# HELP test_level Level.\n# TYPE test_level gauge\ntest_level -1.5\n") != string::npos);
+    BOOST_TEST(text.find("test_duration_seconds_bucket{le=\"0.1\"} 1\n") != string::npos);
+    BOOST_TEST(text.find("test_duration_seconds_bucket{le=\"1\"} 3\n") != string::npos);
+    BOOST_TEST(text.find("test_duration_seconds_bucket{le=\"+Inf\"} 4\n") != string::npos);
+    BOOST_TEST(text.find("test_duration_seconds_sum 6.05\n") != string::npos);
+    BOOST_TEST(text.find("test_duration_seconds_count 4\n") != string::npos);
+    BOOST_CHECK_THROW(registry.gauge("test_events_total", "Events."), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( scrape_endpoint )
+{
+    // Arrange: the metrics of a tick and of the received NMEA lines
+    LoggerStream::createInstance("test-metrics");
+    Platform::getInstance();
+    auto store = make_shared<LocalStore>();
+    TestManager manager(store);
+    MetricsServer server(0);
+
+    // Act
+    manager.tick();
+    manager.tick();
+    auto gga = nmea("GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,");
+    auto wrong = nmea("GPHDT,274.07,T", false);
+    NmeaLine ggaLine(gga);
+    NmeaLine wrongLine(wrong);
+    string response = scrape(server.getPort(), "/metrics");
+    string query = scrape(server.getPort(), "/metrics?name[]=ilvo_tick_duration_seconds");
+    string notFound = scrape(server.getPort(), "/");
+    string prefix = scrape(server.getPort(), "/metricsx");
+
+    // Assert
+    BOOST_TEST(response.find("HTTP/1.1 200 OK\r\n") == 0);
+    BOOST_TEST(response.find("Content-Type: text/plain; version=0.0.4") != string::npos);
+    BOOST_TEST(response.find("ilvo_tick_duration_seconds_count{process=\"ilvo-test-metrics\"} 2\n") != string::npos);
+    BOOST_TEST(response.find("ilvo_tick_overruns_total{process=\"ilvo-test-metrics\"}") != string::npos);
+    BOOST_TEST(response.find("ilvo_redis_roundtrip_seconds_count{process=\"ilvo-test-metrics\",op=\"write\"} 2\n") != string::npos);
+    BOOST_TEST(response.find("ilvo_nmea_sentences_total{type=\"GGA\"} 1\n") != string::npos);
+    BOOST_TEST(response.find("ilvo_nmea_sentences_total{type=\"HDT\"} 0\n") != string::npos);
+    BOOST_TEST(response.find("ilvo_nmea_checksum_failures_total 1\n") != string::npos);
+    BOOST_TEST(response.find("ilvo_log_messages_total{level=\"INFO\"}") != string::npos);
+    BOOST_TEST(query.find("HTTP/1.1 200 OK\r\n") == 0);
+    BOOST_TEST(notFound.find("HTTP/1.1 404 Not Found\r\n") == 0);
+    BOOST_TEST(prefix.find("HTTP/1.1 404 Not Found\r\n") == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
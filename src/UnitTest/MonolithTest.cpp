@@ -0,0 +1,61 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_monolith
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Monolith/Monolith.h>
+#include <Utils/Redis/LocalStore.h>
+#include <Utils/Redis/VariableManager.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <Utils/Settings/Platform.h>
+
+using namespace Ilvo::Core;
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Utils::Logging;
+using namespace Ilvo::Utils::Settings;
+
+using namespace std;
+
+// Monolith test bench suite
+BOOST_AUTO_TEST_SUITE(MonolithTest)
+
+BOOST_AUTO_TEST_CASE( create_core_loops )
+{
+    // Arrange
+    LoggerStream::createInstance("test-monolith");
+    Platform::getInstance();
+    auto store = make_shared<LocalStore>();
+
+    for (const string& name: {"ilvo-robot-plc", "ilvo-gps", "ilvo-navigation", "ilvo-operation", "ilvo-simulation"}) {
+        // Act
+        unique_ptr<VariableManager> manager = Monolith::createManager(name, store);
+
+        // Assert
+        BOOST_TEST(manager != nullptr, name);
+    }
+    BOOST_TEST(Monolith::createManager("ilvo-system-manager", store) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE( platform_thread_instance )
+{
+    // Arrange
+    LoggerStream::createInstance("test-monolith");
+    Platform* processPlatform = &Platform::getInstance();
+    bool sharedInThread = false, sharedInLoop = true;
+
+    // Act
+    std::thread([&]() { sharedInThread = &Platform::getInstance() == processPlatform; }).join();
+    std::thread([&]() {
+        Platform::createThreadInstance();
+        sharedInLoop = &Platform::getInstance() == processPlatform;
+    }).join();
+
+    // Assert
+    BOOST_TEST(sharedInThread);
+    BOOST_TEST(!sharedInLoop);
+    BOOST_TEST(&Platform::getInstance() == processPlatform);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
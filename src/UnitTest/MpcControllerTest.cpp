@@ -0,0 +1,274 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_mpc_controller
+#include <boost/test/included/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <Simulation/VehiclePlant.h>
+#include <Simulation/SimulationEngine.h>
+#include <Utils/Pid/MpcController.h>
+#include <Utils/Settings/Traject.h>
+#include <Utils/Geometry/Angle.h>
+#include <Utils/Geometry/Transform.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <boost/filesystem.hpp>
+
+using namespace Ilvo::Core;
+using namespace Ilvo::Utils::Pid;
+using namespace Ilvo::Utils::Settings;
+using namespace Ilvo::Utils::Geometry;
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+using namespace nlohmann;
+
+namespace {
+    const double ts = 0.02;
+
+    /** @brief Curvature of a circle to the left with the radius over the horizon */
+    vector<double> circle(int horizon, double radius)
+    {
+        return vector<double>(horizon, radius > 0 ? 1.0 / radius : 0.0);
+    }
+
+    /** @brief MPC with a budget that is not exceeded, the tests of the solution do not depend on the build */
+    unique_ptr<MpcController> createMpc(int horizon)
+    {
+        unique_ptr<MpcController> mpc = MpcController::create(horizon);
+        MpcSettings settings;
+        settings.budget = chrono::seconds(1);
+        mpc->setSettings(settings);
+        return mpc;
+    }
+
+    /**
+     * @brief Iterations of the closed loop from a large error to the path, the errors follow the model of the MPC
+     *
+     * @param warmStart keep the previous solution or reset the MPC before every solve
+     */
+    int closedLoopIterations(bool warmStart)
+    {
+        unique_ptr<MpcController> mpc = createMpc(30);
+        vector<double> straight = circle(30, 0.0);
+        const double v = 1.0, dt = mpc->getSettings().dt;
+        double lateral = 2.0, heading = 0.2;
+        int iterations = 0;
+        for (int i = 0; i < 30; i++) {
+            if (!warmStart) mpc->reset();
+            MpcResult result = mpc->solve(lateral, heading, v, straight.data());
+            BOOST_TEST(result.valid);
+            iterations += result.iterations;
+            lateral += v * dt * heading + v * dt * dt / 2 * result.angular;
+            heading += dt * result.angular;
+        }
+        return iterations;
+    }
+
+    /** @brief Line following controller of the tracking simulation */
+    enum class Tracker {PUREPURSUIT, MPC};
+
+    /**
+     * @brief Drive the example field with the tracker and return the RMS lateral error [m]
+     *
+     * @details The platform starts 0.5 m left of the path, its angular velocity passes through an actuator lag.
+     * Pure pursuit is the carrot law of NavigationControl::purePursuit without the PID corrections.
+     */
+    double track(Traject& traject, Tracker tracker, double velocity, double duration)
+    {
+        const double interpolationDistance = 0.1;
+        const double carrotDistance = 3.5;
+        const double maxAngular = 1.0;
+        VehiclePlant plant(Plant(json::parse(R"({"actuators": {"angular": {"time_constant": 0.15}}})")), false);
+
+        unique_ptr<MpcController> mpc = MpcController::create(20);
+        MpcSettings settings;
+        settings.maxAngular = maxAngular;
+        mpc->setSettings(settings);
+        vector<double> curvature(mpc->getHorizon());
+
+        // start pose: 0.5 m left of the first line of the path
+        Line first = traject.pathLine(0);
+        double pathAngle = DegToRad(first.alpha());
+        double x = first.p1().x() - 0.5 * sin(pathAngle);
+        double y = first.p1().y() + 0.5 * cos(pathAngle);
+        double psi = pathAngle;
+        int closest = 0;
+
+        double sumSquared = 0.0;
+        int samples = 0;
+        for (double t = 0.0; t < duration && closest < traject.interpolationLength() - 50; t += ts) {
+            Point current(x, y);
+            closest = traject.closestPoint(current, closest, closest + 30).index;
+            Line line = traject.pathLine(closest);
+            double lateral = -traject.isPointLeft(closest, current) * line.distance(current);
+            sumSquared += lateral * lateral;
+            samples++;
+
+            double angular = 0.0;
+            if (tracker == Tracker::MPC) {
+                double heading = DegToRad(calcSmallestAngle(RadToDeg(psi), line.alpha()));
+                for (int k = 0; k < mpc->getHorizon(); k++) {
+                    int index = closest + int(k * velocity * settings.dt / interpolationDistance);
+                    curvature[k] = traject.pathCurvature(index, max(velocity * settings.dt, 0.5));
+                }
+                angular = mpc->solve(lateral, heading, velocity, curvature.data()).angular;
+            } else {
+                IndexPoint carrot = traject.closestPoint(current, closest, closest + int(carrotDistance / interpolationDistance) + 10, carrotDistance);
+                double alpha = std::atan2(carrot.y() - y, carrot.x() - x) - psi;
+                angular = velocity * 2 * sin(alpha) / current.distance(carrot);
+                angular = clamp(angular, -maxAngular, maxAngular);
+            }
+
+            PlantVelocity moved = plant.move(plant.actuate({velocity, 0.0, angular}, ts), ts);
+            x += moved.longitudinal * cos(psi) * ts;
+            y += moved.longitudinal * sin(psi) * ts;
+            psi += moved.angular * ts;
+        }
+        return sqrt(sumSquared / max(samples, 1));
+    }
+}
+
+// MPC controller test bench suite
+BOOST_AUTO_TEST_SUITE(MpcControllerTest)
+
+BOOST_AUTO_TEST_CASE( steering_direction )
+{
+    for (int horizon: MPC_HORIZONS) {
+        // Arrange
+        unique_ptr<MpcController> mpc = createMpc(horizon);
+        vector<double> straight = circle(horizon, 0.0);
+        vector<double> left = circle(horizon, 5.0);
+
+        // Act
+        MpcResult onPath = mpc->solve(0.0, 0.0, 1.0, straight.data());
+        mpc->reset();
+        MpcResult leftOfPath = mpc->solve(0.3, 0.0, 1.0, straight.data());
+        mpc->reset();
+        MpcResult curve = mpc->solve(0.0, 0.0, 1.0, left.data());
+
+        // Assert: on the path no steering, left of the path to the right, a left curve to the left
+        BOOST_TEST(mpc->getHorizon() == horizon);
+        BOOST_TEST(onPath.valid);
+        BOOST_TEST(abs(onPath.angular) < 1e-9);
+        BOOST_TEST(leftOfPath.angular < 0.0);
+        BOOST_TEST(curve.angular > 0.0);
+        BOOST_TEST(curve.angular <= mpc->getSettings().maxAngular + 1e-9);
+    }
+    BOOST_CHECK_THROW(MpcController::create(15), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( constrained_warm_start )
+{
+    // Arrange: a large error saturates the angular velocity
+    unique_ptr<MpcController> mpc = createMpc(30);
+    vector<double> straight = circle(30, 0.0);
+
+    // Act
+    MpcResult saturated = mpc->solve(2.0, 0.2, 1.0, straight.data());
+    int coldIterations = closedLoopIterations(false);
+    int warmIterations = closedLoopIterations(true);
+
+    // Assert
+    BOOST_TEST(saturated.valid);
+    BOOST_TEST(saturated.iterations > 0);
+    BOOST_TEST(saturated.angular == -mpc->getSettings().maxAngular);
+    BOOST_TEST_MESSAGE("Closed loop iterations: cold " << coldIterations << ", warm " << warmIterations);
+    BOOST_TEST(warmIterations < coldIterations);
+}
+
+BOOST_AUTO_TEST_CASE( budget_exceeded )
+{
+    // Arrange: no compute budget
+    unique_ptr<MpcController> mpc = MpcController::create(40);
+    MpcSettings settings;
+    settings.budget = chrono::microseconds(0);
+    mpc->setSettings(settings);
+    vector<double> straight = circle(40, 0.0);
+
+    // Act
+    MpcResult result = mpc->solve(2.0, 0.2, 1.0, straight.data());
+
+    // Assert: the caller falls back on pure pursuit
+    BOOST_TEST(!result.valid);
+}
+
+BOOST_AUTO_TEST_CASE( benchmark )
+{
+    // solve time per horizon for a path with an offset, the constrained solves warm start from the previous tick
+    for (int horizon: MPC_HORIZONS) {
+        unique_ptr<MpcController> mpc = MpcController::create(horizon);
+        vector<double> curve = circle(horizon, 8.0);
+        const int solves = 1000;
+        double total = 0.0, maxTime = 0.0, iterations = 0.0;
+        int valid = 0;
+        for (int i = 0; i < solves; i++) {
+            double lateral = 1.5 * sin(i * 0.05);
+            MpcResult result = mpc->solve(lateral, 0.1 * cos(i * 0.05), 1.0, curve.data());
+            total += result.solveTime;
+            maxTime = max(maxTime, result.solveTime);
+            iterations += result.iterations;
+            valid += result.valid;
+        }
+        BOOST_TEST_MESSAGE("MPC horizon " << horizon << ": mean " << total / solves << " us, max " << maxTime
+                           << " us, mean iterations " << iterations / solves << ", valid " << valid << "/" << solves);
+        BOOST_TEST(valid > 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( tracking_example_field )
+{
+    // Arrange
+    LoggerStream::createInstance("test-mpc-controller");
+    Traject traject;
+    traject.load("example", 31, 15.0, 0.1, 2.0, InterpolationType::CURVY);
+
+    // Act
+    double purePursuitError = track(traject, Tracker::PUREPURSUIT, 1.0, 300.0);
+    double mpcError = track(traject, Tracker::MPC, 1.0, 300.0);
+
+    // Assert
+    BOOST_TEST_MESSAGE("RMS lateral error on the example field: pure pursuit " << purePursuitError << " m, MPC " << mpcError << " m");
+    BOOST_TEST(mpcError < purePursuitError);
+}
+
+BOOST_AUTO_TEST_CASE( navigation_control )
+{
+    // Arrange: the navigation steers the simulated robot with 'pc.mpc.enable', the MPC gets its path from the traject
+    LoggerStream::createInstance("test-mpc-controller");
+    string ilvoPath = getenv("ILVO_PATH");
+    // the configuration of the robot without its logs, the logs and telemetry of the engine are written in a temp dir
+    boost::filesystem::path robotPath = boost::filesystem::temp_directory_path() / "ilvo-mpc-navigation";
+    boost::filesystem::remove_all(robotPath);
+    boost::filesystem::create_directories(robotPath / "logs");
+    for (const boost::filesystem::directory_entry& entry: boost::filesystem::directory_iterator(ILVO_SCHEMA_PATH)) {
+        if (entry.path().filename() != "logs") {
+            boost::filesystem::create_symlink(entry.path(), robotPath / entry.path().filename());
+        }
+    }
+    SimulationScenario purePursuit;
+    purePursuit.name = "purepursuit";
+    purePursuit.field = "example";
+    purePursuit.duration = 30.0;
+    purePursuit.ilvoPath = robotPath.string();
+    SimulationScenario mpc = purePursuit;
+    mpc.name = "mpc";
+    mpc.variables = {{"pc.mpc.enable", true}, {"pc.mpc.budget", 1000.0}};
+
+    // Act
+    SimulationResult purePursuitResult = SimulationEngine(purePursuit).run();
+    SimulationResult mpcResult = SimulationEngine(mpc).run();
+    setenv("ILVO_PATH", ilvoPath.c_str(), 1);
+    boost::filesystem::remove_all(robotPath);
+
+    // Assert: the MPC steers instead of pure pursuit and keeps the robot on the path
+    BOOST_TEST_MESSAGE("RMS lateral error of the navigation: pure pursuit " << purePursuitResult.distanceErrorRms << " m, MPC " << mpcResult.distanceErrorRms << " m");
+    BOOST_TEST(mpcResult.error.empty());
+    BOOST_TEST(mpcResult.simulatedTime >= 29.0);
+    BOOST_TEST(mpcResult.distanceErrorRms < 0.01);
+    BOOST_TEST(mpcResult.distanceErrorMax < 0.5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,74 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_path_matcher
+#include <boost/test/included/unit_test.hpp>
+#include <cmath>
+#include <vector>
+
+#include <Utils/Geometry/PathMatcher.h>
+
+using namespace std;
+using namespace Ilvo::Utils::Geometry;
+
+// Path matcher test bench suite
+BOOST_AUTO_TEST_SUITE(PathMatcherTest)
+
+BOOST_AUTO_TEST_CASE( Projection )
+{
+    // Arrange: L-shaped path of 20 m
+    PathMatcher matcher({make_shared<Point>(0.0, 0.0), make_shared<Point>(10.0, 0.0), make_shared<Point>(10.0, 10.0)});
+
+    // Act
+    PathMatch left = matcher.match(Point(3.25, 0.5));
+    PathMatch right = matcher.match(Point(12.0, 7.125));
+    PathMatch before = matcher.match(Point(-1.0, -1.0));
+
+    // Assert: the along-track distance is not limited to the vertices
+    BOOST_CHECK_CLOSE(matcher.length(), 20.0, 1e-9);
+    BOOST_TEST(left.index == 0);
+    BOOST_CHECK_CLOSE(left.along, 3.25, 1e-9);
+    BOOST_CHECK_CLOSE(left.offset, 0.5, 1e-9);
+    BOOST_CHECK_CLOSE(left.point.x(), 3.25, 1e-9);
+    BOOST_TEST(right.index == 1);
+    BOOST_CHECK_CLOSE(right.along, 17.125, 1e-9);
+    BOOST_CHECK_CLOSE(right.offset, -2.0, 1e-9);
+    BOOST_TEST(before.along == 0.0);
+    BOOST_CHECK_CLOSE(before.offset, -sqrt(2.0), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE( BatchMatchesBruteForce )
+{
+    // Arrange: swaths back and forth, interpolated every 0.5 m
+    vector<PointPtr> path;
+    for (int swath = 0; swath < 20; swath++) {
+        for (int i = 0; i <= 200; i++) {
+            double x = (swath % 2 == 0) ? i * 0.5 : 100.0 - i * 0.5;
+            path.push_back(make_shared<Point>(x, swath * 3.0));
+        }
+    }
+    PathMatcher matcher(path);
+    vector<PointPtr> points;
+    for (int i = 0; i < 5000; i++) {
+        points.push_back(make_shared<Point>(fmod(i * 7.31, 110.0) - 5.0, fmod(i * 3.17, 62.0) - 2.0));
+    }
+
+    // Act
+    vector<PathMatch> matches = matcher.match(points);
+
+    // Assert: same distance as the projection on every segment
+    BOOST_TEST_REQUIRE(matches.size() == points.size());
+    for (int i = 0; i < points.size(); i++) {
+        double best = INFINITY;
+        for (int j = 0; j < path.size()-1; j++) {
+            Point a = *path[j], b = *path[j+1];
+            double dx = b.x() - a.x(), dy = b.y() - a.y();
+            double length2 = dx*dx + dy*dy;
+            double t = (length2 > 0.0) ? ((points[i]->x() - a.x())*dx + (points[i]->y() - a.y())*dy) / length2 : 0.0;
+            t = max(0.0, min(1.0, t));
+            best = min(best, points[i]->distance(Point(a.x() + t*dx, a.y() + t*dy)));
+        }
+        BOOST_TEST_REQUIRE(abs(abs(matches[i].offset) - best) < 1e-9);
+        BOOST_TEST_REQUIRE(abs(matches[i].point.distance(*points[i]) - best) < 1e-9);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
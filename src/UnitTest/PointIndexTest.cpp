@@ -0,0 +1,134 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_point_index
+#include <boost/test/included/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <Utils/Geometry/PointIndex.h>
+
+using namespace std;
+using namespace Ilvo::Utils::Geometry;
+
+namespace {
+    /** @brief Seeding map of rows of plants every 0.75 m, a plant every 0.2 m with some jitter */
+    vector<PointPtr> seedingMap(int plants)
+    {
+        mt19937 generator(42);
+        normal_distribution<double> jitter(0.0, 0.02);
+        vector<PointPtr> points;
+        for (int i = 0; i < plants; i++) {
+            int row = i / 500;
+            points.push_back(make_shared<Point>(500000.0 + (i % 500) * 0.2 + jitter(generator), 5600000.0 + row * 0.75 + jitter(generator)));
+        }
+        return points;
+    }
+
+    vector<int> bruteRadius(const vector<PointPtr>& points, const Point& center, double radius)
+    {
+        vector<int> result;
+        for (int i = 0; i < points.size(); i++) {
+            double dx = points[i]->x() - center.x(), dy = points[i]->y() - center.y();
+            if (dx * dx + dy * dy <= radius * radius) result.push_back(i);
+        }
+        return result;
+    }
+
+    vector<int> bruteNearest(const vector<PointPtr>& points, const Point& point, int k)
+    {
+        vector<pair<double, int>> distances;
+        for (int i = 0; i < points.size(); i++) {
+            double dx = points[i]->x() - point.x(), dy = points[i]->y() - point.y();
+            distances.emplace_back(dx * dx + dy * dy, i);
+        }
+        sort(distances.begin(), distances.end());
+        vector<int> result;
+        for (int i = 0; i < k && i < distances.size(); i++) result.push_back(distances[i].second);
+        return result;
+    }
+}
+
+// Point index test bench suite
+BOOST_AUTO_TEST_SUITE(PointIndexTest)
+
+BOOST_AUTO_TEST_CASE( Queries )
+{
+    // Arrange
+    vector<PointPtr> points = seedingMap(20000);
+    PointIndex index(points);
+    mt19937 generator(7);
+    uniform_real_distribution<double> x(499990.0, 500110.0), y(5599990.0, 5600040.0);
+    vector<int> result;
+
+    // Act / Assert: same points as a search over all points, also for points outside the map
+    BOOST_TEST(index.size() == points.size());
+    for (int i = 0; i < 200; i++) {
+        Point p(x(generator), y(generator));
+        index.inRadius(p, 0.5, result);
+        BOOST_TEST_REQUIRE(result == bruteRadius(points, p, 0.5));
+        BOOST_TEST_REQUIRE(index.nearest(p, 5) == bruteNearest(points, p, 5));
+
+        index.inBox(p.x() - 1.5, p.y() - 0.25, p.x() + 1.5, p.y() + 0.25, result);
+        for (int j: result) {
+            BOOST_TEST_REQUIRE(abs(points[j]->x() - p.x()) <= 1.5);
+            BOOST_TEST_REQUIRE(abs(points[j]->y() - p.y()) <= 0.25);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( DegenerateMaps )
+{
+    // Arrange: no points, one point and a line of points
+    PointIndex none(vector<PointPtr>{});
+    PointIndex one({make_shared<Point>(1.0, 1.0)});
+    vector<PointPtr> line;
+    for (int i = 0; i < 100; i++) line.push_back(make_shared<Point>(i * 1.0, 2.0));
+    PointIndex row(line);
+    vector<int> result;
+
+    // Act / Assert
+    none.inRadius(Point(0.0, 0.0), 10.0, result);
+    BOOST_TEST(result.empty());
+    BOOST_TEST(none.nearest(Point(0.0, 0.0), 3).empty());
+    BOOST_TEST(one.nearest(Point(100.0, -50.0), 3) == vector<int>{0});
+    row.inRadius(Point(50.2, 2.0), 1.0, result);
+    BOOST_TEST(result == (vector<int>{50, 51}));
+    BOOST_TEST(row.nearest(Point(-10.0, 5.0), 2) == (vector<int>{0, 1}));
+}
+
+BOOST_AUTO_TEST_CASE( Benchmark100kPlants )
+{
+    // Arrange: section footprints of 3 x 0.5 m driving along the rows
+    vector<PointPtr> points = seedingMap(100000);
+    auto start = chrono::steady_clock::now();
+    PointIndex index(points);
+    double buildTime = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    vector<int> result;
+    size_t found = 0;
+
+    // Act
+    const int queries = 100000;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < queries; i++) {
+        double x = 500000.0 + fmod(i * 0.01, 100.0), y = 5600000.0 + (i % 200) * 0.75;
+        index.inBox(x - 1.5, y - 0.25, x + 1.5, y + 0.25, result);
+        found += result.size();
+    }
+    double queryTime = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / queries;
+
+    // a scan over all points, as the search of the old nearby window did
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < 100; i++) {
+        double x = 500000.0 + fmod(i * 1.01, 100.0), y = 5600000.0 + (i % 200) * 0.75;
+        found += bruteRadius(points, Point(x, y), 1.5).size();
+    }
+    double scanTime = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / 100;
+
+    // Assert: a footprint holds the plants of one row
+    BOOST_TEST_MESSAGE("build " << buildTime << " ms, footprint query " << queryTime << " us, full scan " << scanTime << " us");
+    BOOST_TEST(found > queries * 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,199 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_redis_dispatcher
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <Utils/Redis/RedisDispatcher.h>
+#include <Utils/Redis/LocalStore.h>
+#include <Utils/Redis/VariableManager.h>
+#include <Utils/Redis/VariableSchemaGenerated.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <Utils/Settings/Platform.h>
+
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Utils::Logging;
+using namespace Ilvo::Utils::Settings;
+
+using namespace std;
+using namespace std::chrono_literals;
+
+namespace {
+    class TestVariableManager: public VariableManager
+    {
+    public:
+        TestVariableManager(shared_ptr<LocalStore> store) : VariableManager("ilvo-test", store) {}
+        void serverTick() override {}
+    };
+}
+
+// Redis dispatcher test bench suite
+BOOST_AUTO_TEST_SUITE(RedisDispatcherTest)
+
+BOOST_AUTO_TEST_CASE( message_queue )
+{
+    // Arrange
+    RedisMessageQueue queue(3);  // rounded up to 4
+    RedisMessage message;
+
+    // Act
+    for (int i = 0; i < 4; i++) {
+        BOOST_TEST(queue.push("", "channel", to_string(i)));
+    }
+    bool full = !queue.push("", "channel", "4");
+    size_t until = queue.position() - 2;
+
+    // Assert
+    BOOST_TEST(full);
+    BOOST_TEST(queue.pop(message, until));
+    BOOST_TEST(message.message == "0");
+    BOOST_TEST(queue.pop(message, until));
+    BOOST_TEST(message.message == "1");
+    BOOST_TEST(!queue.pop(message, until));
+    BOOST_TEST(queue.pop(message));
+    BOOST_TEST(message.message == "2");
+    BOOST_TEST(queue.push("pattern", "channel", "5"));
+    BOOST_TEST(queue.pop(message));
+    BOOST_TEST(queue.pop(message));
+    BOOST_TEST(message.pattern == "pattern");
+    BOOST_TEST(message.message == "5");
+    BOOST_TEST(!queue.pop(message));
+}
+
+BOOST_AUTO_TEST_CASE( keyspace_pattern )
+{
+    BOOST_TEST(RedisDispatcher::keyspacePattern("pc.field.updated") == "__keyspace@*__:pc.field.updated");
+    BOOST_TEST(RedisDispatcher::keyspacePattern("a*b[1]") == "__keyspace@*__:a\\*b\\[1\\]");
+}
+
+BOOST_AUTO_TEST_CASE( local_store_dispatch )
+{
+    // Arrange
+    auto store = make_shared<LocalStore>();
+    RedisDispatcher dispatcher(store);
+    vector<string> channels;
+    vector<string> keyspace;
+    dispatcher.subscribe("pc.events", [&](const RedisMessage& m) { channels.push_back(m.message); });
+    int id = dispatcher.psubscribe(RedisDispatcher::keyspacePattern("pc.field.updated"), [&](const RedisMessage& m) { keyspace.push_back(m.message); });
+    dispatcher.dispatch();  // initial resync
+    channels.clear();
+    keyspace.clear();
+
+    // Act
+    store->publish("pc.events", "started");
+    store->set("pc.field.updated", "true");
+    store->set("pc.field.name", "example");
+    size_t beforeDispatch = channels.size() + keyspace.size();
+    size_t count = dispatcher.dispatch();
+    dispatcher.unsubscribe(id);
+    store->set("pc.field.updated", "false");
+    dispatcher.dispatch();
+
+    // Assert: the callbacks are only called by dispatch, for the subscribed keys
+    BOOST_TEST(beforeDispatch == 0);
+    BOOST_TEST(count == 2);
+    BOOST_TEST(channels == vector<string>{"started"});
+    BOOST_TEST(keyspace == vector<string>{"set"});
+}
+
+BOOST_AUTO_TEST_CASE( queue_overflow )
+{
+    // Arrange
+    LoggerStream::createInstance("test-redis-dispatcher");
+    auto store = make_shared<LocalStore>();
+    RedisDispatcher dispatcher(store);
+    int events = 0, eventResyncs = 0, fieldResyncs = 0;
+    dispatcher.subscribe("pc.events", [&](const RedisMessage& m) { m.channel.empty() ? eventResyncs++ : events++; });
+    dispatcher.psubscribe(RedisDispatcher::keyspacePattern("pc.field.updated"), [&](const RedisMessage& m) { fieldResyncs += m.channel.empty(); });
+    dispatcher.dispatch();  // initial resync
+    eventResyncs = fieldResyncs = 0;
+
+    // Act: more messages than the queue holds, the field update is dropped
+    for (int i = 0; i < 2000; i++) {
+        store->publish("pc.events", to_string(i));
+    }
+    store->set("pc.field.updated", "true");
+    size_t count = dispatcher.dispatch();
+    size_t countAfter = dispatcher.dispatch();
+
+    // Assert: every callback is resynced once, the queued messages follow
+    BOOST_TEST(eventResyncs == 1);
+    BOOST_TEST(fieldResyncs == 1);
+    BOOST_TEST(events == int(count));
+    BOOST_TEST(count < 2000);
+    BOOST_TEST(countAfter == 0);
+}
+
+BOOST_AUTO_TEST_CASE( variable_change_events )
+{
+    // Arrange
+    LoggerStream::createInstance("test-redis-dispatcher");
+    Platform::getInstance();
+    auto store = make_shared<LocalStore>();
+    TestVariableManager vm(store);
+    TestVariableManager writer(store);
+    vector<bool> values;
+    vm.onVariableChanged(Vars::pc_field_updated, [&](VariablePtr var) { values.push_back(var->getValue<bool>()); });
+
+    // Act
+    vm.tick();  // resync after subscribing
+    vm.tick();  // no change
+    writer.setValue(Vars::pc_field_updated, true);
+    writer.writeRedisVariables();
+    vm.tick();
+
+    // Assert
+    BOOST_TEST(values == vector<bool>({false, true}));
+}
+
+BOOST_AUTO_TEST_CASE( network_subscription )
+{
+    // Arrange: a server that accepts the subscription and sends a message in two parts
+    int server = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    BOOST_REQUIRE(bind(server, (sockaddr*)&address, sizeof(address)) == 0);
+    BOOST_REQUIRE(listen(server, 1) == 0);
+    socklen_t length = sizeof(address);
+    getsockname(server, (sockaddr*)&address, &length);
+    int port = ntohs(address.sin_port);
+
+    string command;
+    thread serverThread([&]() {
+        int client = accept(server, nullptr, nullptr);
+        char buffer[256];
+        ssize_t n = recv(client, buffer, sizeof(buffer), 0);
+        if (n > 0) command.assign(buffer, n);
+        string reply = "*3\r\n$9\r\nsubscribe\r\n$9\r\npc.events\r\n:1\r\n*3\r\n$7\r\nmessage\r\n$9\r\npc.events\r\n$7\r\nstarted\r\n";
+        send(client, reply.data(), 40, 0);
+        this_thread::sleep_for(50ms);
+        send(client, reply.data() + 40, reply.size() - 40, 0);
+        this_thread::sleep_for(200ms);
+        close(client);
+    });
+
+    RedisDispatcher dispatcher("127.0.0.1", port, 10s);
+    vector<string> messages;
+    dispatcher.subscribe("pc.events", [&](const RedisMessage& m) { messages.push_back(m.message); });
+
+    // Act
+    for (int i = 0; i < 100 && messages.size() < 3; i++) {
+        this_thread::sleep_for(10ms);
+        dispatcher.dispatch();
+    }
+    serverThread.join();
+    close(server);
+
+    // Assert: resync after subscribing and after connecting, then the message
+    BOOST_TEST(command == "*2\r\n$9\r\nSUBSCRIBE\r\n$9\r\npc.events\r\n");
+    BOOST_TEST(messages == vector<string>({"", "", "started"}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
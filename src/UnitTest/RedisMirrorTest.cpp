@@ -0,0 +1,163 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_redis_mirror
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include <Utils/Redis/RedisMirror.h>
+#include <Utils/Redis/LocalStore.h>
+#include <Utils/Logging/LoggerStream.h>
+
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+using namespace std::chrono_literals;
+
+namespace {
+    /** @brief Mirror of a store on a second store in place of the Redis server */
+    class TestRedisMirror: public RedisMirror
+    {
+    public:
+        TestRedisMirror(shared_ptr<LocalStore> store, shared_ptr<LocalStore> server) : RedisMirror(store, server, 20ms) {}
+        using RedisMirror::reconnect;
+        /** @brief The server lost a mirrored key without a notification, e.g. it expired */
+        void forget(const string& key, const string& value) { mirrored[key] = value; }
+        int pendingEchoes(const string& key) { return echoes.count(key) ? echoes[key] : 0; }
+    };
+
+    /** @brief Number of keyspace notifications of a store */
+    int countWrites(shared_ptr<LocalStore> store, int& writes)
+    {
+        return store->psubscribe("__keyspace@0__:*", [&writes](const string& channel, const string_view& message) { writes++; });
+    }
+}
+
+// Redis mirror test bench suite
+BOOST_AUTO_TEST_SUITE(RedisMirrorTest)
+
+BOOST_AUTO_TEST_CASE( push_without_echo )
+{
+    // Arrange
+    LoggerStream::createInstance("test-redis-mirror");
+    auto store = make_shared<LocalStore>();
+    auto server = make_shared<LocalStore>();
+    TestRedisMirror mirror(store, server);
+    int storeWrites = 0, serverWrites = 0;
+    string message;
+    countWrites(store, storeWrites);
+    countWrites(server, serverWrites);
+    server->subscribe("robot.event", [&message](const string_view& m) { message = m; });
+
+    // Act
+    store->set("pc.field.name", "example");
+    store->hset("plc.monitor", {"state.auto", "1", "state.steer", "0"});
+    store->setJson("implement.states", {{"active", true}});
+    store->publish("robot.event", "started");
+    mirror.sync();
+    int writesAfterPush = serverWrites;
+    int storeWritesAfterPush = storeWrites;
+    mirror.sync();
+
+    // Assert: the notifications of the writes of the mirror are not copied back
+    BOOST_TEST(server->get("pc.field.name") == "example");
+    BOOST_TEST(server->hgetall("plc.monitor") == vector<string>({"state.auto", "1", "state.steer", "0"}));
+    BOOST_TEST(server->getJson("implement.states")["active"] == true);
+    BOOST_TEST(message == "started");
+    BOOST_TEST(writesAfterPush == 3);
+    BOOST_TEST(serverWrites == writesAfterPush);
+    BOOST_TEST(storeWrites == storeWritesAfterPush);
+    BOOST_TEST(mirror.pendingEchoes("pc.field.name") == 0);
+    BOOST_TEST(mirror.pendingEchoes("plc.monitor") == 0);
+}
+
+BOOST_AUTO_TEST_CASE( pull_and_sync )
+{
+    // Arrange
+    auto store = make_shared<LocalStore>();
+    auto server = make_shared<LocalStore>();
+    server->set("pc.navigation.mode", "2");
+    server->hset("plc.monitor", {"state.auto", "0"});
+    TestRedisMirror mirror(store, server);
+
+    // Act
+    mirror.pull();
+    mirror.sync();
+    string pulled = store->get("pc.navigation.mode");
+    server->set("pc.navigation.mode", "3");  // written by another client
+    server->hset("plc.monitor", {"state.auto", "1"});
+    mirror.sync();
+
+    // Assert
+    BOOST_TEST(pulled == "2");
+    BOOST_TEST(store->get("pc.navigation.mode") == "3");
+    BOOST_TEST(store->hgetall("plc.monitor") == vector<string>({"state.auto", "1"}));
+    BOOST_TEST(server->get("pc.navigation.mode") == "3");
+}
+
+BOOST_AUTO_TEST_CASE( removed_hash_fields )
+{
+    // Arrange
+    auto store = make_shared<LocalStore>();
+    auto server = make_shared<LocalStore>();
+    TestRedisMirror mirror(store, server);
+    store->hset("plc.monitor", {"state.auto", "1", "state.steer", "0"});
+    mirror.sync();
+
+    // Act
+    store->hdel("plc.monitor", {"state.steer"});
+    mirror.sync();
+    vector<string> serverFields = server->hgetall("plc.monitor");
+    server->hset("plc.monitor", {"state.throttle", "1"});  // written by another client
+    server->hdel("plc.monitor", {"state.auto"});
+    mirror.sync();
+
+    // Assert
+    BOOST_TEST(serverFields == vector<string>({"state.auto", "1"}));
+    BOOST_TEST(store->hgetall("plc.monitor") == vector<string>({"state.throttle", "1"}));
+    BOOST_TEST(mirror.pendingEchoes("plc.monitor") == 0);
+}
+
+BOOST_AUTO_TEST_CASE( delete_of_key_missing_on_server )
+{
+    // Arrange: the server lost a mirrored key without a notification
+    auto store = make_shared<LocalStore>();
+    auto server = make_shared<LocalStore>();
+    TestRedisMirror mirror(store, server);
+    mirror.forget("pc.field.name", "sexample");
+    store->set("pc.field.name", "example");
+    store->del({"pc.field.name"});
+
+    // Act
+    mirror.sync();
+    server->set("pc.field.name", "blok3");  // written by another client
+    mirror.sync();
+
+    // Assert: the deletion on the server has no notification to wait for
+    BOOST_TEST(mirror.pendingEchoes("pc.field.name") == 0);
+    BOOST_TEST(store->get("pc.field.name") == "blok3");
+}
+
+BOOST_AUTO_TEST_CASE( reconnect_overwrites_server )
+{
+    // Arrange
+    auto store = make_shared<LocalStore>();
+    auto server = make_shared<LocalStore>();
+    TestRedisMirror mirror(store, server);
+    store->set("pc.field.name", "example");
+    mirror.sync();
+
+    // Act: the server changed while the mirror was disconnected
+    server->set("pc.field.name", "blok3");
+    mirror.reconnect();
+    mirror.sync();
+    mirror.sync();
+
+    // Assert
+    BOOST_TEST(server->get("pc.field.name") == "example");
+    BOOST_TEST(store->get("pc.field.name") == "example");
+    BOOST_TEST(mirror.pendingEchoes("pc.field.name") == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,112 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_resp_reader
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+#include <sstream>
+
+#include <Utils/Redis/RespReader.h>
+#include <Utils/Redis/Variable.h>
+#include <Exceptions/RedisExceptions.hpp>
+
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Exception;
+
+using namespace std;
+
+// RESP reader test bench suite
+BOOST_AUTO_TEST_SUITE(RespReaderTest)
+
+BOOST_AUTO_TEST_CASE( append_command )
+{
+    // Arrange
+    string request;
+
+    // Act
+    RespReader::appendCommand(request, "MGET", {"pc.gps.fix", "pc.field.name"});
+    RespReader::appendCommand(request, "HMGET", "pc.gps", {"fix"});
+
+    // Assert
+    BOOST_TEST(request == "*3\r\n$4\r\nMGET\r\n$10\r\npc.gps.fix\r\n$13\r\npc.field.name\r\n"
+                          "*3\r\n$5\r\nHMGET\r\n$6\r\npc.gps\r\n$3\r\nfix\r\n");
+}
+
+BOOST_AUTO_TEST_CASE( read_arrays )
+{
+    // Arrange: a MGET reply and a pipelined HMGET reply, with nil and empty elements
+    stringstream ss("*3\r\n$1\r\n4\r\n$-1\r\n$11\r\nexample\r\nab\r\n*2\r\n$0\r\n\r\n:7\r\n");
+    RespReader reader;
+
+    // Act
+    reader.begin();
+    size_t first = reader.readArray(ss);
+    size_t second = reader.readArray(ss);
+    const vector<string_view>& values = reader.values();
+
+    // Assert
+    BOOST_TEST(first == 3);
+    BOOST_TEST(second == 2);
+    BOOST_TEST(values.size() == 5);
+    BOOST_TEST(values[0] == "4");
+    BOOST_TEST(values[1].empty());
+    BOOST_TEST(values[1].data() == nullptr);  // nil
+    BOOST_TEST(values[2] == "example\r\nab");
+    BOOST_TEST(values[3].empty());
+    BOOST_TEST(values[3].data() != nullptr);  // empty string
+    BOOST_TEST(values[4] == "7");
+}
+
+BOOST_AUTO_TEST_CASE( read_error )
+{
+    // Arrange
+    stringstream error("-WRONGTYPE Operation against a key holding the wrong kind of value\r\n");
+    stringstream truncated("*2\r\n$5\r\nab");
+    RespReader reader;
+
+    // Assert
+    BOOST_CHECK_THROW(reader.readArray(error), RedisErrorReplyException);
+    BOOST_CHECK_THROW(reader.readArray(truncated), RedisCommandExectionException);
+}
+
+BOOST_AUTO_TEST_CASE( read_pipeline_error )
+{
+    // Arrange: three pipelined HMGET replies, the second one an error, and the reply of the next command
+    stringstream ss("*1\r\n$1\r\na\r\n-WRONGTYPE Operation against a key holding the wrong kind of value\r\n"
+                    "*1\r\n$1\r\nb\r\n*1\r\n$4\r\nnext\r\n");
+    RespReader reader;
+
+    // Act
+    reader.begin();
+    BOOST_CHECK_THROW(reader.readArrays(ss, 3), RedisErrorReplyException);
+    reader.begin();
+    size_t next = reader.readArray(ss);
+
+    // Assert: the replies after the error were read, the next command reads its own reply
+    BOOST_TEST(next == 1);
+    BOOST_TEST(reader.values()[0] == "next");
+}
+
+BOOST_AUTO_TEST_CASE( parse_views )
+{
+    // Arrange
+    Variable integer("pc.navigation.mode", "pc", "navigation", "int8", PlcType::NONE);
+    Variable number("pc.purepursuit.carrot_distance", "pc", "purepursuit", "float", PlcType::NONE);
+    Variable flag("pc.simulation.active", "pc", "simulation", "bool", PlcType::NONE);
+    Variable text("pc.field.name", "pc", "field", "string", PlcType::NONE);
+    string buffer = " +12|2.5e-1|TRUE|example";
+    string_view view(buffer);
+
+    // Act
+    integer.setValueString(view.substr(0, 4));
+    number.setValueString(view.substr(5, 6));
+    flag.setValueString(view.substr(12, 4));
+    text.setValueString(view.substr(17));
+
+    // Assert
+    BOOST_TEST(integer.getValue<int>() == 12);
+    BOOST_TEST(number.getValue<double>() == 0.25);
+    BOOST_TEST(flag.getValue<bool>());
+    BOOST_TEST(text.getValue<string>() == "example");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,232 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_shape_file
+#include <boost/test/included/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+
+#include <Utils/File/ShapeFile.h>
+#include <Utils/File/PointShapeFile.h>
+#include <Exceptions/FileExceptions.hpp>
+#include <ThirdParty/shapefil.h>
+
+using namespace Ilvo::Utils::File;
+using namespace Ilvo::Exception;
+
+using namespace std;
+
+namespace {
+    struct TemporaryDirectory
+    {
+        boost::filesystem::path path;
+        TemporaryDirectory() : path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()) {
+            boost::filesystem::create_directories(path);
+        }
+        ~TemporaryDirectory() { boost::filesystem::remove_all(path); }
+    };
+
+    /** @brief Prescription map of n x n square cells of 2 m with a rate, a product and a flag */
+    string writePrescriptionMap(const boost::filesystem::path& directory, int n)
+    {
+        string file = (directory / "prescription.shp").string();
+        SHPHandle shp = SHPCreate(file.c_str(), SHPT_POLYGON);
+        DBFHandle dbf = DBFCreate(file.c_str());
+        DBFAddField(dbf, "ZONE", FTInteger, 8, 0);
+        DBFAddField(dbf, "RATE", FTDouble, 12, 3);
+        DBFAddField(dbf, "PRODUCT", FTString, 16, 0);
+        DBFAddField(dbf, "APPLY", FTLogical, 1, 0);
+        for (int k = 0; k < n * n; k++) {
+            double x0 = 500000.0 + 2.0 * (k % n), y0 = 5650000.0 + 2.0 * (k / n);
+            double x[5] = {x0, x0, x0 + 2.0, x0 + 2.0, x0};
+            double y[5] = {y0, y0 + 2.0, y0 + 2.0, y0, y0};
+            SHPObject* object = SHPCreateSimpleObject(SHPT_POLYGON, 5, x, y, nullptr);
+            SHPWriteObject(shp, -1, object);
+            SHPDestroyObject(object);
+            DBFWriteIntegerAttribute(dbf, k, 0, k % 7);
+            DBFWriteDoubleAttribute(dbf, k, 1, 100.0 + 0.125 * (k % 400));
+            DBFWriteStringAttribute(dbf, k, 2, (k % 2) ? "urea" : "ammonium nitrate");
+            DBFWriteLogicalAttribute(dbf, k, 3, (k % 3) ? 'T' : 'F');
+        }
+        SHPClose(shp);
+        DBFClose(dbf);
+        return file;
+    }
+
+    /** @brief Check the vertices and attributes of the reader against shapelib */
+    void compareWithShapelib(const string& file)
+    {
+        ShapeFile shapes(file);
+        SHPHandle shp = SHPOpen(file.c_str(), "rb");
+        DBFHandle dbf = DBFOpen(file.c_str(), "rb");
+        BOOST_TEST_REQUIRE(shp != nullptr);
+
+        int numShapes, shapeType;
+        SHPGetInfo(shp, &numShapes, &shapeType, nullptr, nullptr);
+        BOOST_TEST(shapes.getShapeType() == shapeType);
+        BOOST_TEST_REQUIRE(shapes.getNumShapes() == size_t(numShapes));
+        for (int s = 0; s < numShapes; s++) {
+            SHPObject* object = SHPReadObject(shp, s);
+            size_t parts = (object->nSHPType == SHPT_NULL) ? 0 : max(object->nParts, 1);
+            BOOST_TEST_REQUIRE(shapes.getNumParts(s) == parts);
+            if (parts > 0) {
+                size_t begin = shapes.partBegin(s, 0);
+                BOOST_TEST_REQUIRE(shapes.partEnd(s, parts - 1) - begin == size_t(object->nVertices));
+                for (int v = 0; v < object->nVertices; v++) {
+                    BOOST_TEST_REQUIRE(shapes.getX()[begin + v] == object->padfX[v]);
+                    BOOST_TEST_REQUIRE(shapes.getY()[begin + v] == object->padfY[v]);
+                }
+            }
+            SHPDestroyObject(object);
+        }
+
+        if (dbf) {
+            BOOST_TEST_REQUIRE(shapes.getNumRecords() == size_t(DBFGetRecordCount(dbf)));
+            BOOST_TEST_REQUIRE(shapes.getFields().size() == size_t(DBFGetFieldCount(dbf)));
+            for (size_t r = 0; r < shapes.getNumRecords(); r++) {
+                vector<ShapeFieldDataPtr> data = shapes.getFieldData(r);
+                for (size_t f = 0; f < data.size(); f++) {
+                    switch (DBFGetFieldInfo(dbf, f, nullptr, nullptr, nullptr)) {
+                        case FTInteger:
+                            BOOST_TEST_REQUIRE(data[f]->i == DBFReadIntegerAttribute(dbf, r, f));
+                            break;
+                        case FTDouble:
+                            BOOST_TEST_REQUIRE(data[f]->d == DBFReadDoubleAttribute(dbf, r, f));
+                            break;
+                        case FTLogical:
+                            BOOST_TEST_REQUIRE(data[f]->b == (DBFReadLogicalAttribute(dbf, r, f)[0] == 'T'));
+                            break;
+                        default:
+                            BOOST_TEST_REQUIRE(data[f]->s == string(DBFReadStringAttribute(dbf, r, f)));
+                    }
+                }
+            }
+            DBFClose(dbf);
+        }
+        SHPClose(shp);
+    }
+}
+
+// Shapefile reader test bench suite
+BOOST_AUTO_TEST_SUITE(ShapeFileTest)
+
+BOOST_AUTO_TEST_CASE( field_files_as_shapelib )
+{
+    // Arrange
+    string fieldPath = string(getenv("ILVO_PATH")) + "/field";
+
+    // Act & Assert: every shapefile of the test fields
+    int files = 0;
+    for (const auto& entry: boost::filesystem::recursive_directory_iterator(fieldPath)) {
+        if (entry.path().extension() == ".shp") {
+            BOOST_TEST_CONTEXT(entry.path().string()) {
+                compareWithShapelib(entry.path().string());
+            }
+            files++;
+        }
+    }
+    BOOST_TEST(files > 0);
+}
+
+BOOST_AUTO_TEST_CASE( prescription_map )
+{
+    // Arrange
+    TemporaryDirectory directory;
+    string file = writePrescriptionMap(directory.path, 20);
+
+    // Act
+    ShapeFile shapes(file);
+    vector<double> rates = shapes.getDoubleColumn(shapes.findField("RATE"));
+
+    // Assert
+    BOOST_TEST(shapes.getNumShapes() == 400);
+    BOOST_TEST(shapes.getNumVertices() == 400 * 5);
+    BOOST_TEST(shapes.findField("MISSING") == -1);
+    BOOST_TEST_REQUIRE(rates.size() == 400);
+    BOOST_TEST(rates[9] == 101.125);
+    BOOST_TEST(shapes.getString(1, shapes.findField("PRODUCT")) == "urea");
+    BOOST_TEST(shapes.getFields()[shapes.findField("ZONE")].type == INT);
+    BOOST_TEST(shapes.getBool(1, shapes.findField("APPLY")));
+    BOOST_TEST(!shapes.isDeleted(0));
+    compareWithShapelib(file);
+}
+
+BOOST_AUTO_TEST_CASE( point_shape_file_fields )
+{
+    // Arrange
+    TemporaryDirectory directory;
+    string file = writePrescriptionMap(directory.path, 3);
+    PointShapeFile f(true, 31);
+
+    // Act
+    f.init(file);
+
+    // Assert: one serie per cell with the attributes of its own record
+    BOOST_TEST_REQUIRE(f.getNumSeries() == 9);
+    BOOST_TEST(f.getNumPoints(4) == 5);
+    BOOST_TEST(f.isPolygon(4));
+    BOOST_TEST_REQUIRE(f.getNumFields(4) == 4);
+    BOOST_TEST(f.getFields(4)[0]->name == "ZONE");
+    BOOST_TEST(f.getFields(4)[0]->i == 4);
+    BOOST_TEST(f.getFields(5)[2]->s == "urea");
+}
+
+BOOST_AUTO_TEST_CASE( truncated_file )
+{
+    // Arrange
+    TemporaryDirectory directory;
+    string file = writePrescriptionMap(directory.path, 3);
+    boost::filesystem::resize_file(file, boost::filesystem::file_size(file) - 8);
+
+    // Act & Assert
+    BOOST_CHECK_THROW(ShapeFile shapes(file), FileFormatException);
+    BOOST_CHECK_THROW(ShapeFile shapes((directory.path / "missing.shp").string()), PathNotFoundException);
+}
+
+BOOST_AUTO_TEST_CASE( faster_than_shapelib )
+{
+    // Arrange: 250 x 250 cells
+    TemporaryDirectory directory;
+    string file = writePrescriptionMap(directory.path, 250);
+
+    // Act: all vertices and the rate of every cell
+    auto start = chrono::steady_clock::now();
+    double sumShapelib = 0.0;
+    {
+        SHPHandle shp = SHPOpen(file.c_str(), "rb");
+        DBFHandle dbf = DBFOpen(file.c_str(), "rb");
+        int numShapes;
+        SHPGetInfo(shp, &numShapes, nullptr, nullptr, nullptr);
+        for (int s = 0; s < numShapes; s++) {
+            SHPObject* object = SHPReadObject(shp, s);
+            for (int v = 0; v < object->nVertices; v++) {
+                sumShapelib += object->padfX[v] + object->padfY[v];
+            }
+            SHPDestroyObject(object);
+            sumShapelib += DBFReadDoubleAttribute(dbf, s, 1);
+        }
+        SHPClose(shp);
+        DBFClose(dbf);
+    }
+    double shapelibMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    double sum = 0.0;
+    {
+        ShapeFile shapes(file);
+        for (size_t v = 0; v < shapes.getNumVertices(); v++) {
+            sum += shapes.getX()[v] + shapes.getY()[v];
+        }
+        for (double rate: shapes.getDoubleColumn(1)) {
+            sum += rate;
+        }
+    }
+    double mappedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    // Assert
+    BOOST_TEST_MESSAGE("62500 polygons, shapelib: " << shapelibMs << " ms, mapped: " << mappedMs << " ms");
+    BOOST_CHECK_CLOSE(sum, sumShapelib, 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
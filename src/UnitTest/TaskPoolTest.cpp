@@ -0,0 +1,67 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_task_pool
+#include <boost/test/included/unit_test.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <Utils/Settings/TaskPool.h>
+
+using namespace Ilvo::Utils::Settings;
+
+using namespace std;
+
+// Task pool test bench suite
+BOOST_AUTO_TEST_SUITE(TaskPoolTest)
+
+BOOST_AUTO_TEST_CASE( every_index_once )
+{
+    // Arrange
+    TaskPool pool(3);
+    vector<int> visits(10007, 0);
+
+    // Act: the chunks write to their own indices
+    for (int run = 0; run < 20; run++) {
+        pool.parallelFor(visits.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) visits[i]++;
+        }, 64);
+    }
+
+    // Assert
+    BOOST_TEST(pool.getConcurrency() == 4);
+    for (int v: visits) BOOST_TEST_REQUIRE(v == 20);
+}
+
+BOOST_AUTO_TEST_CASE( nested_loop )
+{
+    // Arrange
+    TaskPool pool(2);
+    atomic<int> total(0);
+
+    // Act: the inner loops run on the thread of their chunk
+    pool.parallelFor(8, [&](size_t, size_t) {
+        pool.parallelFor(100, [&](size_t begin, size_t end) { total += end - begin; }, 10);
+    });
+
+    // Assert
+    BOOST_TEST(total == 800);
+}
+
+BOOST_AUTO_TEST_CASE( exception )
+{
+    // Arrange
+    TaskPool pool(2);
+    atomic<int> chunks(0);
+
+    // Act / Assert: the pool can run another loop after the failed one
+    BOOST_CHECK_THROW(pool.parallelFor(100, [&](size_t begin, size_t) {
+        chunks++;
+        if (begin == 50) throw runtime_error("chunk 50");
+    }), runtime_error);
+    BOOST_TEST(chunks == 100);
+    chunks = 0;
+    pool.parallelFor(100, [&](size_t, size_t) { chunks++; });
+    BOOST_TEST(chunks == 100);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
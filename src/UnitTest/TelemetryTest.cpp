@@ -0,0 +1,62 @@
+#define BOOST_TEST_DYN_LINK 
+#define BOOST_TEST_MODULE boost_test_telemetry
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include <Utils/Logging/TelemetryStream.h>
+
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+
+// Telemetry test bench suite
+BOOST_AUTO_TEST_SUITE(TelemetryTest)
+
+BOOST_AUTO_TEST_CASE( roundtrip )
+{
+    // Arrange
+    vector<TelemetryChannel> channels = {{"x", FLOAT64}, {"index", INT32}, {"auto", BOOL}};
+    boost::filesystem::path filePath;
+    {
+        TelemetryStream telemetry("test-telemetry", channels, 4);
+        filePath = telemetry.getFilePath();
+        size_t x = telemetry.channel("x");
+        size_t index = telemetry.channel("index");
+        size_t active = telemetry.channel("auto");
+
+        // Act: 10 rows, written in blocks of 4 and a last block on destruction
+        for (int i = 0; i < 10; i++) {
+            telemetry.set(x, 0.5 * i);
+            telemetry.set(index, i);
+            telemetry.set(active, i % 2 == 0);
+            telemetry.commit();
+        }
+    }
+
+    // Assert
+    TelemetryReader reader(filePath);
+    BOOST_TEST(reader.getChannels().size() == 3);
+    BOOST_TEST(reader.getChannels()[1].name == "index");
+
+    vector<int64_t> timestamps;
+    vector<vector<double>> columns;
+    int rows = 0;
+    while (reader.readBlock(timestamps, columns)) {
+        for (size_t j = 0; j < timestamps.size(); j++, rows++) {
+            BOOST_TEST(columns[0][j] == 0.5 * rows);
+            BOOST_TEST(columns[1][j] == rows);
+            BOOST_TEST(columns[2][j] == (rows % 2 == 0));
+        }
+    }
+    BOOST_TEST(rows == 10);
+
+    stringstream csv;
+    TelemetryReader(filePath).toCsv(csv);
+    string header;
+    getline(csv, header);
+    BOOST_TEST(header == "timestamp,x,index,auto");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
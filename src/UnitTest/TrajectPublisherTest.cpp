@@ -0,0 +1,125 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_traject_publisher
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+
+#include <Utils/Redis/TrajectPublisher.h>
+#include <Utils/Redis/LocalStore.h>
+#include <Utils/Geometry/PathEncoding.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <Utils/Settings/Traject.h>
+
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Utils::Geometry;
+using namespace Ilvo::Utils::Logging;
+using namespace Ilvo::Utils::Settings;
+
+using namespace std;
+using namespace std::chrono_literals;
+using json = nlohmann::json;
+
+// Traject publisher test bench suite
+BOOST_AUTO_TEST_SUITE(TrajectPublisherTest)
+
+BOOST_AUTO_TEST_CASE( encoded_polyline )
+{
+    // Arrange: the example of the encoded polyline algorithm, (x, y) in the place of (lat, lon)
+    vector<PointPtr> points = {make_shared<Point>(38.5, -120.2), make_shared<Point>(40.7, -120.95), make_shared<Point>(43.252, -126.453)};
+
+    // Act
+    string encoded = encodePath(points, Point(0.0, 0.0), 5);
+    vector<Point> decoded = decodePath(encoded, Point(0.0, 0.0), 5);
+    vector<Point> utm = decodePath(encodePath({make_shared<Point>(512345.6789, 5654321.1234)}, Point(512000.0, 5654000.0)), Point(512000.0, 5654000.0));
+
+    // Assert
+    BOOST_TEST(encoded == "_p~iF~ps|U_ulLnnqC_mqNvxq`@");
+    BOOST_TEST_REQUIRE(decoded.size() == 3);
+    BOOST_CHECK_CLOSE(decoded[2].x(), 43.252, 1e-9);
+    BOOST_CHECK_CLOSE(decoded[2].y(), -126.453, 1e-9);
+    BOOST_TEST(abs(utm[0].x() - 512345.679) < 1e-6);
+    BOOST_TEST(abs(utm[0].y() - 5654321.123) < 1e-6);
+    BOOST_CHECK_THROW(decodePath(encoded.substr(0, encoded.size()-1), Point(0.0, 0.0), 5), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( publish_traject )
+{
+    // Arrange
+    LoggerStream::createInstance("traject-publisher-test", true);
+    auto store = make_shared<LocalStore>();
+    int versions = 0;
+    store->subscribe("traject", [&versions](const string_view&) { versions++; });
+    Traject traject;
+    traject.load("blok3", 31, 15.0, 0.1, 6.0, InterpolationType::CURVY);
+    TrajectPublisher publisher(store, 1000);
+
+    // Act
+    publisher.publish(traject);
+    BOOST_TEST_REQUIRE(publisher.waitIdle(10s));
+    json header = store->getJson("traject");
+    publisher.setInterpolation(InterpolationType::LINEAR);
+    BOOST_TEST_REQUIRE(publisher.waitIdle(10s));
+
+    // Assert: the chunks decode to the interpolation within the precision
+    BOOST_TEST(header["name"] == "blok3");
+    BOOST_TEST(header["interpolation"] == "curvy");
+    BOOST_TEST(store->getJson("traject")["interpolation"] == "linear");
+    BOOST_TEST(versions == 2);
+    Point origin(header["origin"]["x"].get<double>(), header["origin"]["y"].get<double>());
+    for (InterpolationType type: {InterpolationType::LINEAR, InterpolationType::CURVY}) {
+        const vector<PointPtr>& interpolation = traject.getInterpolation(type);
+        json jInterpolation = header[type == InterpolationType::LINEAR ? "linear" : "curvy"];
+        BOOST_TEST(jInterpolation["points"] == interpolation.size());
+
+        vector<Point> decoded;
+        for (int c = 0; c < jInterpolation["chunks"].get<int>(); c++) {
+            string key = string("traject.") + (type == InterpolationType::LINEAR ? "linear." : "curvy.") + to_string(header["version"].get<int>()) + "." + to_string(c);
+            vector<Point> chunk = decodePath(store->get(key), origin);
+            decoded.insert(decoded.end(), chunk.begin(), chunk.end());
+        }
+        BOOST_TEST_REQUIRE(decoded.size() == interpolation.size());
+        for (int i = 0; i < decoded.size(); i++) {
+            BOOST_TEST_REQUIRE(decoded[i].distance(*interpolation[i]) < 1e-3);
+        }
+        BOOST_TEST(decodePath(jInterpolation["skeleton"], origin).size() == traject.getSkeleton(type).size());
+    }
+    BOOST_TEST(decodePath(header["corners"], origin).size() == traject.getCorners().size());
+    BOOST_TEST(decodePath(header["raw"], origin).size() == traject.getRawPoints().size());
+}
+
+BOOST_AUTO_TEST_CASE( versioned_chunks )
+{
+    // Arrange: the json and a chunk of an older version of a previous run
+    LoggerStream::createInstance("traject-publisher-test", true);
+    auto store = make_shared<LocalStore>();
+    store->setJson("traject", {{"name", "blok3"}, {"version", 7}, {"linear", {{"chunks", 1}}}, {"curvy", {{"chunks", 1}}}});
+    store->set("traject.linear.7.0", "kept");
+    store->set("traject.linear.6.0", "stale");
+    Traject traject;
+    traject.load("blok3", 31, 15.0, 0.1, 6.0, InterpolationType::CURVY);
+    TrajectPublisher publisher(store, 1000);
+
+    // Act
+    vector<int> versions;
+    for (int i = 0; i < 3; i++) {
+        publisher.publish(traject);
+        BOOST_TEST_REQUIRE(publisher.waitIdle(10s));
+        versions.push_back(store->getJson("traject")["version"].get<int>());
+        if (i == 0) {
+            // Assert: the versions continue, the previous version is kept for the clients that read its json
+            BOOST_TEST(!store->exists("traject.linear.6.0"));
+            BOOST_TEST(store->get("traject.linear.7.0") == "kept");
+        }
+    }
+
+    // Assert: only the chunks of the last two versions remain
+    BOOST_TEST(versions == (vector<int>{8, 9, 10}));
+    BOOST_TEST(!store->exists("traject.linear.7.0"));
+    BOOST_TEST(!store->exists("traject.linear.8.0"));
+    BOOST_TEST(store->exists("traject.linear.9.0"));
+    BOOST_TEST(store->exists("traject.curvy.10.0"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -7,6 +7,7 @@
 
 #include <math.h>
 #include <Utils/Settings/Traject.h>
+#include <Utils/Settings/TaskPool.h>
 #include <Utils/Geometry/Point.h>
 
 using namespace Ilvo::Utils::Settings;
@@ -90,4 +91,79 @@ BOOST_AUTO_TEST_CASE( TrajectPenetrometerBlok3 )
 }
 
 
+BOOST_AUTO_TEST_CASE( TrajectStagedLoad )
+{
+    // Arrange
+    LoggerStream::createInstance("traject-test", true);
+    Traject t, reference;
+
+    // Act: a loop started from a loop of the pool runs on the calling thread, the reference is loaded sequentially
+    t.load("blok3", 31, 15.0, 0.1, 6.0);
+    TaskPool::getInstance().parallelFor(1, [&reference](size_t begin, size_t end) {
+        reference.load("blok3", 31, 15.0, 0.1, 6.0);
+    });
+
+    // Assert: the linear interpolation is the one of the raw segments in order
+    const vector<PointPtr>& raw = t.getRawPoints();
+    vector<PointPtr> expected;
+    for (int i = 0; i < raw.size()-1; i++) {
+        auto segment = Line(*raw[i], *raw[i+1]).interpolate(0.1);
+        expected.insert(expected.end(), segment.begin(), segment.end());
+    }
+    const vector<PointPtr>& linear = t.getInterpolation(InterpolationType::LINEAR);
+    BOOST_TEST_REQUIRE(linear.size() == expected.size());
+    for (int i = 0; i < linear.size(); i++) {
+        BOOST_TEST((linear[i]->x() == expected[i]->x() && linear[i]->y() == expected[i]->y()));
+    }
+    BOOST_TEST(t.getCorners().back()->index == int(linear.size()) - 1);
+
+    // the corners and the curvy interpolation are the ones of the sequential load
+    const vector<CornerPointPtr>& corners = t.getCorners();
+    const vector<CornerPointPtr>& referenceCorners = reference.getCorners();
+    BOOST_TEST_REQUIRE(corners.size() == referenceCorners.size());
+    for (int i = 0; i < corners.size(); i++) {
+        BOOST_TEST(corners[i]->index == referenceCorners[i]->index);
+    }
+    const vector<PointPtr>& curvy = t.getInterpolation(InterpolationType::CURVY);
+    const vector<PointPtr>& referenceCurvy = reference.getInterpolation(InterpolationType::CURVY);
+    BOOST_TEST_REQUIRE(curvy.size() == referenceCurvy.size());
+    for (int i = 0; i < curvy.size(); i++) {
+        CurvyPoint* p = dynamic_cast<CurvyPoint*>(curvy[i].get());
+        CurvyPoint* q = dynamic_cast<CurvyPoint*>(referenceCurvy[i].get());
+        BOOST_TEST_REQUIRE((p != nullptr && q != nullptr));
+        BOOST_TEST((p->x() == q->x() && p->y() == q->y() && p->radius == q->radius));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( TrajectDiscretePoints )
+{
+    // Arrange
+    LoggerStream::createInstance("traject-test", true);
+    Traject t;
+    t.load("example_discrete", 31, 15.0, 0.1, 2.0);
+    Task& task = t.getField().getTasks().at(0);
+
+    // Act: reset just past the second discrete point, the implement is there
+    t.onDiscrReset(*t.getRawPoints().front());
+    const vector<PathMatch>& points = task.getPathPointsDiscr();
+    BOOST_TEST_REQUIRE(points.size() >= 3);
+    Point current = *t.getInterpolation().at(points[1].index + 1);
+    PathMatch currentMatch = t.getPathMatcher().match(current);
+    BOOST_TEST_REQUIRE((currentMatch.along > points[1].along && currentMatch.along < points[2].along));
+    t.onDiscrReset(current);
+    int next = task.nextDiscreteImplementIndex;
+    Eigen::Affine3d position = Eigen::Affine3d::Identity();
+    position.translation() << current.x(), current.y(), 0.0;
+    task.getHitch().updateState(position);
+    for (auto& section: task.getImplement().getSections()) {
+        section->updateState(position);
+    }
+    double distance = t.distanceToNextDiscrPoint(task);
+
+    // Assert: the next point is the first one ahead of the position, along the matched path
+    BOOST_TEST(next == 2);
+    BOOST_TEST(distance == points[2].along - currentMatch.along, boost::test_tools::tolerance(1e-6));
+    BOOST_TEST(distance > 0.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+#define BOOST_TEST_DYN_LINK 
+#define BOOST_TEST_MODULE boost_test_utm
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <math.h>
+
+#include <ThirdParty/UTM.hpp>
+#include <Utils/Geometry/UtmProjection.h>
+
+using namespace std;
+using namespace Ilvo::Utils::Geometry;
+
+// Field around Merelbeke (Belgium), UTM zone 31
+const int zone = 31;
+const double originX = 557000.0;
+const double originY = 5647000.0;
+const size_t n = 100000;
+
+void grid(vector<double>& x, vector<double>& y, double size)
+{
+    x.resize(n);
+    y.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        x[i] = originX + size * ((i % 317) / 317.0 - 0.5);
+        y[i] = originY + size * ((i / 317) / 317.0 - 0.5);
+    }
+}
+
+// UTM test bench suite
+BOOST_AUTO_TEST_SUITE(UtmTest)
+
+BOOST_AUTO_TEST_CASE( batch_to_latlon )
+{
+    // Arrange
+    vector<double> x, y;
+    grid(x, y, 2000.0);
+    vector<double> lat(n), lon(n), latScalar(n), lonScalar(n);
+
+    // Act
+    auto t0 = chrono::steady_clock::now();
+    for (size_t i = 0; i < n; i++) {
+        UTMXYToLatLon(x[i], y[i], zone, false, latScalar[i], lonScalar[i]);
+        latScalar[i] = RadToDeg(latScalar[i]);
+        lonScalar[i] = RadToDeg(lonScalar[i]);
+    }
+    auto t1 = chrono::steady_clock::now();
+    UtmProjection::get(zone).toLatLon(x.data(), y.data(), lat.data(), lon.data(), n);
+    auto t2 = chrono::steady_clock::now();
+
+    // Assert
+    double maxDiff = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        maxDiff = max(maxDiff, max(abs(lat[i] - latScalar[i]), abs(lon[i] - lonScalar[i])));
+    }
+    cout << "toLatLon " << n << " points: scalar " << chrono::duration<double, milli>(t1 - t0).count() << " ms, batch " 
+         << chrono::duration<double, milli>(t2 - t1).count() << " ms, max difference " << maxDiff << " deg" << endl;
+    BOOST_TEST(maxDiff < 1e-10);
+}
+
+BOOST_AUTO_TEST_CASE( batch_to_utm )
+{
+    // Arrange
+    vector<double> x, y;
+    grid(x, y, 2000.0);
+    vector<double> lat(n), lon(n), xUtm(n), yUtm(n), xScalar(n), yScalar(n);
+    UtmProjection::get(zone).toLatLon(x.data(), y.data(), lat.data(), lon.data(), n);
+
+    // Act
+    auto t0 = chrono::steady_clock::now();
+    for (size_t i = 0; i < n; i++) {
+        LatLonToUTMXY(lat[i], lon[i], zone, xScalar[i], yScalar[i]);
+    }
+    auto t1 = chrono::steady_clock::now();
+    UtmProjection::get(zone).toUtm(lat.data(), lon.data(), xUtm.data(), yUtm.data(), n);
+    auto t2 = chrono::steady_clock::now();
+
+    // Assert
+    double maxDiff = 0.0;
+    double maxRoundTrip = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        maxDiff = max(maxDiff, max(abs(xUtm[i] - xScalar[i]), abs(yUtm[i] - yScalar[i])));
+        maxRoundTrip = max(maxRoundTrip, max(abs(xUtm[i] - x[i]), abs(yUtm[i] - y[i])));
+    }
+    cout << "toUtm " << n << " points: scalar " << chrono::duration<double, milli>(t1 - t0).count() << " ms, batch " 
+         << chrono::duration<double, milli>(t2 - t1).count() << " ms, max difference " << maxDiff << " m" << endl;
+    BOOST_TEST(maxDiff < 1e-6);
+    BOOST_TEST(maxRoundTrip < 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE( local_tangent_plane )
+{
+    // Arrange
+    vector<double> x, y;
+    grid(x, y, 100.0);
+    vector<double> lat(n), lon(n), latExact(n), lonExact(n);
+
+    // Act
+    auto t0 = chrono::steady_clock::now();
+    LocalTangentPlane plane(UtmProjection::get(zone), originX, originY, 100.0);
+    plane.toLatLon(x.data(), y.data(), lat.data(), lon.data(), n);
+    auto t1 = chrono::steady_clock::now();
+    UtmProjection::get(zone).toLatLon(x.data(), y.data(), latExact.data(), lonExact.data(), n);
+
+    // Assert
+    double maxDiff = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        maxDiff = max(maxDiff, max(abs(lat[i] - latExact[i]), abs(lon[i] - lonExact[i])));
+    }
+    cout << "LocalTangentPlane " << n << " points: " << chrono::duration<double, milli>(t1 - t0).count() << " ms, max difference " 
+         << maxDiff * 111320.0 << " m, error bound " << plane.getMaxError() << " m" << endl;
+    BOOST_TEST(plane.isValid());
+    BOOST_TEST(maxDiff * 111320.0 < 1e-3);
+
+    // a plane that is too large for the tolerance falls back on the exact projection
+    LocalTangentPlane largePlane(UtmProjection::get(zone), originX, originY, 200000.0);
+    BOOST_TEST(!largePlane.isValid());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_variable_schema
+#include <boost/test/included/unit_test.hpp>
+#include <string>
+#include <vector>
+
+#include <Utils/Redis/VariableSchema.h>
+#include <Utils/Redis/VariableSchemaGenerated.h>
+
+using namespace Ilvo::Utils::Redis;
+
+using namespace std;
+using namespace nlohmann;
+
+namespace {
+    const ordered_json types = ordered_json::parse(R"({
+        "drive": {"velocity": "float", "enable": "bool", "error": "bool"},
+        "state": {"auto": "bool", "manual": "bool"},
+        "wheels": {"angle": "array[2] of int16"}
+    })");
+    const ordered_json variables = ordered_json::parse(R"({
+        "plc": {
+            "monitor": {"drive": "drive", "state": "state", "wheels": "wheels"},
+            "control": {"state": "state"}
+        },
+        "pc": {"field": {"name": "string", "updated": "bool"}}
+    })");
+
+    const VariableSpec& find(const vector<VariableSpec>& specs, const string& name)
+    {
+        for (const VariableSpec& spec: specs) {
+            if (spec.name == name) return spec;
+        }
+        throw runtime_error("No such variable " + name);
+    }
+}
+
+// Variable schema test bench suite
+BOOST_AUTO_TEST_SUITE(VariableSchemaTest)
+
+BOOST_AUTO_TEST_CASE( expand_variables )
+{
+    // Act
+    vector<VariableSpec> specs = expandVariables(variables, types);
+
+    // Assert
+    BOOST_TEST(specs.size() == 11);
+    BOOST_TEST(specs.front().name == "plc.monitor.drive.velocity");
+    BOOST_TEST(specs.back().name == "pc.field.updated");
+    BOOST_TEST(find(specs, "plc.monitor.drive.enable").group == "plc.monitor");
+    BOOST_TEST(find(specs, "plc.monitor.drive.enable").entity == "drive");
+    BOOST_TEST(find(specs, "plc.monitor.wheels.angle.1").type == "int16");
+    BOOST_TEST(find(specs, "pc.field.name").plcType == PlcType::NONE);
+    BOOST_TEST(find(specs, "pc.field.name").byteOffset == -1);
+}
+
+BOOST_AUTO_TEST_CASE( plc_offsets )
+{
+    // Act
+    vector<VariableSpec> specs = expandVariables(variables, types);
+
+    // Assert: bools of one entity share a byte, a new entity starts a new word
+    BOOST_TEST(find(specs, "plc.monitor.drive.velocity").byteOffset == 0);
+    BOOST_TEST(find(specs, "plc.monitor.drive.enable").byteOffset == 4);
+    BOOST_TEST(find(specs, "plc.monitor.drive.error").byteOffset == 4);
+    BOOST_TEST(find(specs, "plc.monitor.drive.error").bitOffset == 1);
+    BOOST_TEST(find(specs, "plc.monitor.state.auto").byteOffset == 6);
+    BOOST_TEST(find(specs, "plc.monitor.state.auto").bitOffset == 0);
+    BOOST_TEST(find(specs, "plc.monitor.wheels.angle.0").byteOffset == 8);
+    BOOST_TEST(find(specs, "plc.monitor.wheels.angle.1").byteOffset == 10);
+    BOOST_TEST(plcDataSize(specs, PlcType::MONITOR) == 12);
+    BOOST_TEST(find(specs, "plc.control.state.manual").byteOffset == 0);
+    BOOST_TEST(find(specs, "plc.control.state.manual").bitOffset == 1);
+    BOOST_TEST(plcDataSize(specs, PlcType::CONTROL) == 1);
+}
+
+BOOST_AUTO_TEST_CASE( compiled_schema )
+{
+    // Arrange
+    ordered_json changed = variables;
+    changed["pc"]["field"]["updated"] = "int16";
+
+    // Assert
+    BOOST_TEST(schemaFingerprint(variables, types) == schemaFingerprint(variables, types));
+    BOOST_TEST(schemaFingerprint(variables, types) != schemaFingerprint(changed, types));
+    BOOST_TEST(Schema::variables[Vars::pc_field_updated.index].name == string(Vars::pc_field_updated.name));
+    BOOST_TEST(string(Schema::variables[Vars::pc_field_updated.index].type) == "bool");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE boost_test_vehicle_plant
+#include <boost/test/included/unit_test.hpp>
+#include <cmath>
+
+#include <Simulation/VehiclePlant.h>
+#include <Utils/Settings/Plant.h>
+
+using namespace Ilvo::Core;
+using namespace Ilvo::Utils::Settings;
+
+using namespace std;
+using namespace nlohmann;
+using namespace Eigen;
+
+const double ts = 0.02;
+
+// Vehicle plant test bench suite
+BOOST_AUTO_TEST_SUITE(VehiclePlantTest)
+
+BOOST_AUTO_TEST_CASE( ideal_plant )
+{
+    // Arrange
+    Plant settings;
+    VehiclePlant plant(settings, true);
+    Affine3d raw = Affine3d(Translation3d(1.0, 2.0, 0.0));
+
+    // Act
+    PlantVelocity actuated = plant.actuate({1.2, 0.3, -0.4}, ts);
+    PlantVelocity moved = plant.move(actuated, ts);
+
+    // Assert
+    BOOST_TEST(settings.isIdeal());
+    BOOST_TEST(!plant.hasGnssModel());
+    BOOST_TEST(moved.longitudinal == 1.2);
+    BOOST_TEST(moved.lateral == 0.3);
+    BOOST_TEST(moved.angular == -0.4);
+    BOOST_TEST(plant.measure(raw, ts).isApprox(raw));
+}
+
+BOOST_AUTO_TEST_CASE( actuator_lag_and_limits )
+{
+    // Arrange
+    ActuatorDynamics lag(Actuator(json::parse(R"({"time_constant": 0.5})")));
+    ActuatorDynamics limited(Actuator(json::parse(R"({"max_acceleration": 0.5, "max_jerk": 1.0})")));
+
+    // Act: step of 1 m/s during one time constant and during 10 s
+    double vLag = 0.0;
+    for (int i = 0; i < 25; i++) vLag = lag.update(1.0, ts);
+    double vLimited = 0.0, vMax = 0.0, aMax = 0.0;
+    for (int i = 0; i < 500; i++) {
+        double v = limited.update(1.0, ts);
+        aMax = max(aMax, abs(v - vLimited) / ts);
+        vLimited = v;
+        vMax = max(vMax, v);
+    }
+
+    // Assert
+    BOOST_TEST(abs(vLag - (1.0 - exp(-1.0))) < 1e-9);
+    BOOST_TEST(aMax <= 0.5 + 1e-9);
+    BOOST_TEST(vMax <= 1.0 + 1e-3);
+    BOOST_TEST(abs(vLimited - 1.0) < 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE( slip_and_creep )
+{
+    // Arrange
+    Plant settings(json::parse(R"({"slip": {"longitudinal": 0.1, "angular": 0.2}, "creep": {"velocity": 0.01, "gain": 0.05}})"));
+    VehiclePlant lateralPlant(settings, true);
+    VehiclePlant plant(settings, false);
+
+    // Act
+    PlantVelocity v = lateralPlant.move({1.0, 0.0, 0.5}, ts);
+    PlantVelocity w = plant.move({1.0, 0.0, 0.5}, ts);
+
+    // Assert
+    BOOST_TEST(abs(v.longitudinal - 0.9) < 1e-12);
+    BOOST_TEST(abs(v.angular - 0.4) < 1e-12);
+    BOOST_TEST(abs(v.lateral - (0.01 + 0.05 * 0.4)) < 1e-12);
+    BOOST_TEST(w.lateral == 0.0);
+}
+
+BOOST_AUTO_TEST_CASE( gnss_latency_and_noise )
+{
+    // Arrange
+    Plant delayed(json::parse(R"({"gnss": {"latency": 0.1}})"));
+    Plant noisy(json::parse(R"({"gnss": {"noise": 0.02, "seed": 7}})"));
+    VehiclePlant delayedPlant(delayed, false);
+    VehiclePlant noisyPlant(noisy, false), noisyPlant2(noisy, false);
+
+    // Act: the robot drives 1 cm each step along x
+    vector<double> measuredX;
+    double sumSquared = 0.0;
+    int n = 2000;
+    for (int i = 0; i < n; i++) {
+        Affine3d raw = Affine3d(Translation3d(0.01 * i, 0.0, 0.0));
+        measuredX.push_back(delayedPlant.measure(raw, ts).translation().x());
+        Affine3d m = noisyPlant.measure(raw, ts);
+        BOOST_TEST(m.isApprox(noisyPlant2.measure(raw, ts)));
+        sumSquared += (m.translation() - raw.translation()).squaredNorm();
+    }
+
+    // Assert: 0.1 s latency is 5 steps, noise of 0.02 m per axis
+    BOOST_TEST(delayedPlant.hasGnssModel());
+    BOOST_TEST(abs(measuredX[100] - 0.01 * 95) < 1e-9);
+    double rms = sqrt(sumSquared / n / 2);
+    BOOST_TEST(abs(rms - 0.02) < 0.002);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,144 @@
+/**
+ * @file VariableSchemaGenerator.cpp
+ * @author Axel Willekens (axel.willekens@ilvo.vlaanderen.be)
+ * @brief Build step generating the compiled variable schema of a config.json and types.json
+ * @version 0.1
+ * @date 2024-03-20
+ *
+ * @copyright Copyright (c) 2024 Flanders Research Institute for Agriculture, Fisheries and Food (ILVO)
+ *
+ * Usage: ilvo-variable-schema-generator <config.json> <types.json> <output header>
+ */
+#include <Utils/Redis/VariableSchema.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <set>
+#include <cctype>
+
+using namespace Ilvo::Utils::Redis;
+
+using namespace std;
+using namespace nlohmann;
+
+namespace {
+    string cppType(const string& type)
+    {
+        if (type == "bool") return "bool";
+        if (type == "string") return "std::string";
+        if (type.find("float") != string::npos || type == "double") return "double";
+        return "int";
+    }
+
+    string identifier(const string& name)
+    {
+        string id;
+        for (char c: name) {
+            id += isalnum(static_cast<unsigned char>(c)) ? c : '_';
+        }
+        if (id.empty() || isdigit(static_cast<unsigned char>(id[0]))) id = "_" + id;
+        return id;
+    }
+
+    string plcTypeName(PlcType plcType)
+    {
+        switch (plcType) {
+            case PlcType::MONITOR: return "PlcType::MONITOR";
+            case PlcType::CONTROL: return "PlcType::CONTROL";
+            default: return "PlcType::NONE";
+        }
+    }
+
+    ordered_json parse(const string& path)
+    {
+        ifstream ifs(path);
+        if (!ifs) throw runtime_error("File not found: " + path);
+        return ordered_json::parse(ifs);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 4) {
+        cerr << "Usage: " << argv[0] << " <config.json> <types.json> <output header>" << endl;
+        return 1;
+    }
+
+    vector<VariableSpec> specs;
+    uint64_t fingerprint;
+    try {
+        ordered_json config = parse(argv[1]);
+        ordered_json types = parse(argv[2]);
+        specs = expandVariables(config["variables"], types);
+        fingerprint = schemaFingerprint(config["variables"], types);
+    } catch (const exception& e) {
+        cerr << "Variable schema generation failed: " << e.what() << endl;
+        return 1;
+    }
+
+    set<string> identifiers;
+    for (const VariableSpec& spec: specs) {
+        if (!typeSizeMap.count(spec.type)) {
+            cerr << "Variable schema generation failed: unknown type \"" << spec.type << "\" of " << spec.name << endl;
+            return 1;
+        }
+        if (!identifiers.insert(identifier(spec.name)).second) {
+            cerr << "Variable schema generation failed: " << spec.name << " has the same identifier as another variable" << endl;
+            return 1;
+        }
+    }
+
+    stringstream out;
+    out << "/**\n"
+        << " * @file VariableSchemaGenerated.h\n"
+        << " * @brief Compiled variable schema, generated by ilvo-variable-schema-generator from\n"
+        << " * " << argv[1] << " and " << argv[2] << "\n"
+        << " *\n"
+        << " * Do not edit, the header is generated at build time.\n"
+        << " */\n"
+        << "#pragma once\n\n"
+        << "#include <Utils/Redis/VariableSchema.h>\n"
+        << "#include <string>\n\n"
+        << "namespace Ilvo {\n"
+        << "namespace Utils {\n"
+        << "namespace Redis {\n"
+        << "namespace Schema {\n\n"
+        << "    inline constexpr uint64_t fingerprint = " << fingerprint << "ULL;\n"
+        << "    inline constexpr size_t variableCount = " << specs.size() << ";\n"
+        << "    /** @brief Size of the PLC data blocks [bytes] */\n"
+        << "    inline constexpr int monitorSize = " << plcDataSize(specs, PlcType::MONITOR) << ";\n"
+        << "    inline constexpr int controlSize = " << plcDataSize(specs, PlcType::CONTROL) << ";\n\n"
+        << "    inline constexpr VariableDescriptor variables[variableCount] = {\n";
+    for (const VariableSpec& spec: specs) {
+        out << "        {\"" << spec.name << "\", \"" << spec.group << "\", \"" << spec.entity << "\", \"" << spec.type << "\", "
+            << plcTypeName(spec.plcType) << ", " << spec.byteOffset << ", " << spec.bitOffset << "},\n";
+    }
+    out << "    };\n\n"
+        << "} // Schema\n\n"
+        << "namespace Vars {\n\n";
+    for (size_t i = 0; i < specs.size(); i++) {
+        out << "    inline constexpr VariableKey<" << cppType(specs[i].type) << ", " << i << "> " << identifier(specs[i].name)
+            << "{\"" << specs[i].name << "\"};\n";
+    }
+    out << "\n} // Vars\n"
+        << "} // Redis\n"
+        << "} // Utils\n"
+        << "} // Ilvo\n";
+
+    // only touch the header when the schema changed, avoids rebuilding every process
+    string header = out.str();
+    {
+        ifstream previous(argv[3]);
+        stringstream previousHeader;
+        previousHeader << previous.rdbuf();
+        if (previous && previousHeader.str() == header) return 0;
+    }
+    ofstream ofs(argv[3]);
+    ofs << header;
+    if (!ofs) {
+        cerr << "Variable schema generation failed: cannot write " << argv[3] << endl;
+        return 1;
+    }
+    return 0;
+}
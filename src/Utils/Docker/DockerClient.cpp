@@ -2,11 +2,46 @@
 #include <Utils/Logging/LoggerStream.h>
 #include <utility>
 #include <sstream>
+#include <iomanip>
+#include <algorithm>
 
 using namespace Ilvo::Utils::Docker;
 using namespace Ilvo::Utils::Logging;
 using namespace nlohmann;
 
+namespace {
+    /** @brief Maximal number of idle easy handles kept for reuse */
+    const size_t MAX_IDLE_HANDLES = 8;
+
+    std::string urlEncode(const std::string& value) {
+        std::ostringstream encoded;
+        encoded << std::hex << std::uppercase;
+        for (unsigned char c : value) {
+            if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+                encoded << c;
+            } else {
+                encoded << '%' << std::setw(2) << std::setfill('0') << int(c);
+            }
+        }
+        return encoded.str();
+    }
+}
+
+/** @brief Request in the queue or in progress on the multi handle */
+struct DockerClient::Request {
+    Method method;
+    std::string url;
+    std::string body;
+    curl_slist* headers = nullptr;
+    unsigned success_code;
+    std::string response;
+    std::promise<json> promise;
+
+    ~Request() {
+        curl_slist_free_all(headers);
+    }
+};
+
 /*
 *  
 * START DockerClient Implementation
@@ -18,26 +53,50 @@ DockerClient::DockerClient() {
         api_version = std::string(getenv("ILVO_DOCKER_API_VERSION"));
     }
     host_uri = "http:/" + api_version;
-    curl_global_init(CURL_GLOBAL_ALL);
     is_remote = false;
+    init();
 }
 
 DockerClient::DockerClient(std::string api_version) {
     host_uri = "http:/" + api_version;
-    curl_global_init(CURL_GLOBAL_ALL);
     is_remote = false;
+    init();
 }
 
 DockerClient::DockerClient(std::string host, std::string api_version) : host_uri(){
     host_uri = std::move(host) + "/" + api_version;
-    curl_global_init(CURL_GLOBAL_ALL);
     is_remote = true;
+    init();
 }
 
 DockerClient::~DockerClient(){
+    running = false;
+    curl_multi_wakeup(multi);
+    if (worker.joinable()) {
+        worker.join();
+    }
+    for (CURL* easy : idle) {
+        curl_easy_cleanup(easy);
+    }
+    curl_multi_cleanup(multi);
     curl_global_cleanup();
 }
 
+void DockerClient::init(){
+    if (getenv("ILVO_DOCKER_SOCKET")) {
+        socket_path = std::string(getenv("ILVO_DOCKER_SOCKET"));
+    }
+    curl_global_init(CURL_GLOBAL_ALL);
+    multi = curl_multi_init();
+    if(!multi){
+        LoggerStream::getInstance() << WARN << "error while initiating curl";
+        curl_global_cleanup();
+        exit(1);
+    }
+    running = true;
+    worker = std::thread(&DockerClient::run, this);
+}
+
 
 /*
 *  
@@ -66,11 +125,7 @@ json DockerClient::list_images(){
 }
 
 json DockerClient::pull_image(json& headers, const std::string& image_name){
-    std::string path = "/images/create?";
-    headers["Content-Type"] = "application/tar";
-    path += Ilvo::Utils::Docker::param("fromImage", image_name);
-    path += Ilvo::Utils::Docker::param("tag", "latest");
-    return requestAndParseJson(POST,path,200,json(),headers);
+    return pull_image_async(headers, image_name).get();
 }
 
 /*
@@ -85,8 +140,7 @@ json DockerClient::list_containers(bool all, int limit, int size, json filters){
     return requestAndParseJson(GET,path);
 }
 json DockerClient::inspect_container(const std::string& container_id){
-    std::string path = "/containers/" + container_id + "/json";
-    return requestAndParseJson(GET,path);
+    return inspect_container_async(container_id).get();
 }
 json DockerClient::top_container(const std::string& container_id){
     std::string path = "/containers/" + container_id + "/top";
@@ -102,21 +156,17 @@ json DockerClient::logs_container(const std::string& container_id, bool follow,
     return requestAndParse(GET,path,101);
 }
 json DockerClient::create_container(json& body, const std::string& name){
-    std::string path = "/containers/create";
-    path += not name.empty() ? "?name=" + name : "";
-    return requestAndParseJson(POST,path,201,body);
+    return create_container_async(body, name).get();
 }
 json DockerClient::start_container(const std::string& container_id){
-    std::string path = "/containers/" + container_id + "/start";
-    return requestAndParse(POST,path,204);
+    return start_container_async(container_id).get();
 }
 json DockerClient::get_container_changes(const std::string& container_id){
     std::string path = "/containers/" + container_id + "/changes";
     return requestAndParseJson(GET,path);
 }
 json DockerClient::stop_container(const std::string& container_id){
-    std::string path = "/containers/" + container_id + "/stop";
-    return requestAndParse(POST,path,204);
+    return stop_container_async(container_id).get();
 }
 json DockerClient::kill_container(const std::string& container_id, int signal){
     std::string path = "/containers/" + container_id + "/kill?";
@@ -159,13 +209,65 @@ json DockerClient::attach_to_container(const std::string& container_id, bool log
 //void DockerClient::copy_from_container(const std::string& container_id, const std::string& file_path, const std::string& dest_tar_file){}
 
 bool DockerClient::exists_container(const std::string& container_id){
-    json docList = list_containers(); 
-    for (auto& container : docList["data"]) {
-        if(container["Id"].get<std::string>().find(container_id) != std::string::npos) {
-            return true;
+    if (container_id.empty()) return false;
+    json docInspect = inspect_container(container_id);
+    return docInspect["success"] && docInspect["code"] == 200;
+}
+
+json DockerClient::find_container(const std::string& name){
+    std::string path = "/containers/json?";
+    path += Ilvo::Utils::Docker::param("all", true);
+    path += "&filters=" + urlEncode(json({{"name", {"^/" + name + "$"}}}).dump());
+    json docList = requestAndParseJson(GET,path);
+    if (docList["success"]) {
+        for (auto& container : docList["data"]) {
+            auto names = container["Names"];
+            if (std::find(names.begin(), names.end(), "/" + name) != names.end()) {
+                return container;
+            }
         }
     }
-    return false;
+    return json();
+}
+
+/*
+* Async
+*/
+std::future<json> DockerClient::pull_image_async(json& headers, const std::string& image_name){
+    std::string path = "/images/create?";
+    headers["Content-Type"] = "application/tar";
+    path += Ilvo::Utils::Docker::param("fromImage", image_name);
+    path += Ilvo::Utils::Docker::param("tag", "latest");
+    return requestJson(POST,path,200,json(),headers);
+}
+std::future<json> DockerClient::inspect_container_async(const std::string& container_id){
+    std::string path = "/containers/" + container_id + "/json";
+    return requestJson(GET,path);
+}
+std::future<json> DockerClient::create_container_async(json& body, const std::string& name){
+    std::string path = "/containers/create";
+    path += not name.empty() ? "?name=" + name : "";
+    return requestJson(POST,path,201,body);
+}
+std::future<json> DockerClient::start_container_async(const std::string& container_id){
+    std::string path = "/containers/" + container_id + "/start";
+    return request(POST,path,204);
+}
+std::future<json> DockerClient::stop_container_async(const std::string& container_id){
+    std::string path = "/containers/" + container_id + "/stop";
+    return request(POST,path,204);
+}
+
+std::vector<json> DockerClient::inspect_containers(const std::vector<std::string>& container_ids){
+    std::vector<std::future<json>> futures;
+    for (const std::string& id : container_ids) {
+        futures.push_back(inspect_container_async(id));
+    }
+    std::vector<json> docs;
+    for (auto& future : futures) {
+        docs.push_back(future.get());
+    }
+    return docs;
 }
 
 /*
@@ -174,14 +276,111 @@ bool DockerClient::exists_container(const std::string& container_id){
 * 
 */
 
+std::future<json> DockerClient::request(Method method, const std::string& path, unsigned success_code, json add_body, json add_headers){
+    auto request = std::make_shared<Request>();
+    request->method = method;
+    request->url = host_uri + path;
+    request->body = add_body.empty() ? "" : add_body.dump();
+    request->success_code = success_code;
+
+    if(!add_headers.empty()) {
+        for (auto& h : add_headers.items()) {
+            request->headers = curl_slist_append(request->headers, (h.key() + ": " + h.value().get<std::string>()).c_str());
+        }
+    } else {
+        request->headers = curl_slist_append(request->headers, "Content-Type: application/json");
+    }
+
+    std::future<json> future = request->promise.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!is_remote) {
+            last_command = "curl -s --unix-socket " + socket_path + " " + request->url;
+        } else {
+            last_command = "curl " + request->url;
+        }
+        queue.push_back(request);
+    }
+    curl_multi_wakeup(multi);
+    return future;
+}
+
+std::future<json> DockerClient::requestJson(Method method, const std::string& path, unsigned success_code, json add_body, json add_headers){
+    if (add_headers.empty()) {
+        add_headers["Accept"] = "application/json";
+        add_headers["Content-Type"] = "application/json";
+    }
+    return request(method,path,success_code,add_body,add_headers);
+}
+
 json DockerClient::requestAndParse(Method method, const std::string& path, unsigned success_code, json add_body, json add_headers){
-    std::string readBuffer;
-    std::string method_str;
+    json doc = request(method,path,success_code,add_body,add_headers).get();
+    if (doc.contains("error")) {
+        LoggerStream::getInstance() << WARN << "curl_easy_perform() failed: " << doc["error"].get<std::string>();
+    }
+    return doc;
+}
 
-    struct curl_slist *headers = nullptr;
-    std::string body_str = std::string(add_body.empty() ? "" : add_body.dump());
+json DockerClient::requestAndParseJson(Method method, const std::string& path, unsigned success_code, json add_body, json add_headers){
+    if (add_headers.empty()) {
+        add_headers["Accept"] = "application/json";
+        add_headers["Content-Type"] = "application/json";
+    }
+    return requestAndParse(method,path,success_code,add_body,add_headers);
+}
 
-    switch(method){
+void DockerClient::run(){
+    while (running) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            while (!queue.empty()) {
+                perform(queue.front());
+                queue.pop_front();
+            }
+        }
+
+        int still_running = 0;
+        curl_multi_perform(multi, &still_running);
+        int queued;
+        CURLMsg* msg;
+        while ((msg = curl_multi_info_read(multi, &queued))) {
+            if (msg->msg == CURLMSG_DONE) {
+                finish(msg->easy_handle, msg->data.result);
+            }
+        }
+
+        // sleep until a socket is ready or a new request is queued
+        curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+    }
+
+    // abort the requests that did not finish
+    for (auto it = active.begin(); it != active.end(); it = active.begin()) {
+        finish(it->first, CURLE_ABORTED_BY_CALLBACK);
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& request : queue) {
+        request->promise.set_value({{"success", false}, {"code", 0}, {"data", json()}, {"error", "client stopped"}});
+    }
+    queue.clear();
+}
+
+void DockerClient::perform(std::shared_ptr<Request> request){
+    CURL* easy;
+    if (idle.empty()) {
+        easy = curl_easy_init();
+    } else {
+        // the connections live in the multi handle, a reset easy handle reuses them
+        easy = idle.back();
+        idle.pop_back();
+        curl_easy_reset(easy);
+    }
+    if(!easy){
+        request->promise.set_value({{"success", false}, {"code", 0}, {"data", json()}, {"error", "error while initiating curl"}});
+        return;
+    }
+
+    std::string method_str;
+    switch(request->method){
         case GET:
             method_str = "GET";
             break;
@@ -198,52 +397,43 @@ json DockerClient::requestAndParse(Method method, const std::string& path, unsig
             method_str = "GET";
     }
 
-    curl = curl_easy_init();
-    if(!curl){
-        LoggerStream::getInstance() << WARN << "error while initiating curl";
-        curl_global_cleanup();
-        exit(1);
+    if(!is_remote) {
+        curl_easy_setopt(easy, CURLOPT_UNIX_SOCKET_PATH, socket_path.c_str());
     }
-
-    if(!add_headers.empty()) {
-        for (auto& h : add_headers.items()) {
-            headers = curl_slist_append(headers, (h.key() + ": " + h.value().get<std::string>()).c_str());
-        }
-    } else {
-        headers = curl_slist_append(headers, "Content-Type: application/json");
+    curl_easy_setopt(easy, CURLOPT_URL, request->url.c_str());
+    curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, method_str.c_str());
+    curl_easy_setopt(easy, CURLOPT_HTTPHEADER, request->headers);
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, &request->response);
+    if(request->method == POST){
+        curl_easy_setopt(easy, CURLOPT_POSTFIELDS, request->body.c_str());
+        curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, request->body.length());
     }
 
-    if(!is_remote) {
-        curl_easy_setopt(curl, CURLOPT_UNIX_SOCKET_PATH, "/var/run/docker.sock");
-        last_command = "curl -s --unix-socket /var/run/docker.sock " + host_uri + path;
+    active[easy] = request;
+    curl_multi_add_handle(multi, easy);
+}
+
+void DockerClient::finish(CURL* easy, CURLcode result){
+    std::shared_ptr<Request> request = active[easy];
+    active.erase(easy);
+
+    long status = 0;
+    curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &status);
+    curl_multi_remove_handle(multi, easy);
+    if (idle.size() < MAX_IDLE_HANDLES) {
+        idle.push_back(easy);
     } else {
-        last_command = "curl " + host_uri + path;
-    }
-    
-    curl_easy_setopt(curl, CURLOPT_URL, (host_uri + path).c_str());
-    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, method_str.c_str());
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-    if(method == POST){
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body_str.c_str());
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, body_str.length());
-    }
-
-    res = curl_easy_perform(curl);
-    if(res != CURLE_OK)
-        LoggerStream::getInstance() << WARN << "curl_easy_perform() failed: " << curl_easy_strerror(res);
-    unsigned status = 0;
-    curl_easy_getinfo (curl, CURLINFO_RESPONSE_CODE, &status);
-    curl_easy_cleanup(curl);
+        curl_easy_cleanup(easy);
+    }
 
     json doc;
-    if(status == success_code || status == 200){
+    if(status == request->success_code || status == 200){
         doc["success"] = true;
         try {
-            doc["data"] = json::parse(readBuffer.length() ? readBuffer : "{}");
+            doc["data"] = json::parse(request->response.length() ? request->response : "{}");
         } catch (json::parse_error& e) {
-            doc["data"] = readBuffer;
+            doc["data"] = request->response;
         }
         doc["code"] = status;
     }else{
@@ -252,16 +442,10 @@ json DockerClient::requestAndParse(Method method, const std::string& path, unsig
         doc["code"] = status;
         doc["data"] = resp;
     }
-    curl_slist_free_all(headers);
-    return doc;
-}
-
-json DockerClient::requestAndParseJson(Method method, const std::string& path, unsigned success_code, json add_body, json add_headers){
-    if (add_headers.empty()) {
-        add_headers["Accept"] = "application/json";
-        add_headers["Content-Type"] = "application/json";
+    if(result != CURLE_OK){
+        doc["error"] = curl_easy_strerror(result);
     }
-    return requestAndParse(method,path,success_code,add_body,add_headers);
+    request->promise.set_value(doc);
 }
 
 const std::string& DockerClient::get_last_command() const {
@@ -0,0 +1,181 @@
+#include <Utils/Docker/DockerEventStream.h>
+#include <Utils/Logging/LoggerStream.h>
+
+using namespace Ilvo::Utils::Docker;
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+using namespace nlohmann;
+
+
+bool ContainerEvent::parse(const json& j, ContainerEvent& event)
+{
+    if (j.value("Type", "") != "container" || !j.contains("Actor")) return false;
+
+    const json& actor = j["Actor"];
+    event.id = actor.value("ID", "");
+    event.action = j.value("Action", "");
+    event.time = j.value("time", 0L);
+    event.exitCode = 0;
+    event.name = "";
+    if (actor.contains("Attributes")) {
+        const json& attributes = actor["Attributes"];
+        event.name = attributes.value("name", "");
+        if (attributes.contains("exitCode")) {
+            try {
+                event.exitCode = stoi(attributes["exitCode"].get<string>());
+            } catch (const exception&) {}
+        }
+    }
+    return !event.id.empty();
+}
+
+
+DockerEventStream::DockerEventStream() :
+    DockerEventStream(getenv("ILVO_DOCKER_SOCKET") ? getenv("ILVO_DOCKER_SOCKET") : "/var/run/docker.sock",
+        getenv("ILVO_DOCKER_API_VERSION") ? getenv("ILVO_DOCKER_API_VERSION") : "v1.44")
+{}
+
+DockerEventStream::DockerEventStream(string socket_path, string api_version, chrono::milliseconds reconnectPeriod) :
+    host_uri("http:/" + api_version), socket_path(socket_path),
+    running(false), isConnected(false), resync(false), reconnectPeriod(reconnectPeriod),
+    lastEventTime(0)
+{
+    curl_global_init(CURL_GLOBAL_ALL);
+}
+
+DockerEventStream::~DockerEventStream()
+{
+    stop();
+    curl_global_cleanup();
+}
+
+void DockerEventStream::start()
+{
+    if (running) return;
+    running = true;
+    thread = std::thread(&DockerEventStream::run, this);
+}
+
+void DockerEventStream::stop()
+{
+    {
+        lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    stopCondition.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+    isConnected = false;
+}
+
+bool DockerEventStream::connected() const
+{
+    return isConnected;
+}
+
+bool DockerEventStream::resyncRequired()
+{
+    return resync.exchange(false);
+}
+
+vector<ContainerEvent> DockerEventStream::poll()
+{
+    lock_guard<std::mutex> lock(mutex);
+    vector<ContainerEvent> taken;
+    taken.swap(events);
+    return taken;
+}
+
+void DockerEventStream::run()
+{
+    while (running) {
+        CURL* curl = curl_easy_init();
+        if (!curl) {
+            LoggerStream::getInstance() << WARN << "error while initiating curl for the docker events";
+            break;
+        }
+
+        string filters = "{\"type\":[\"container\"]}";
+        char* escaped = curl_easy_escape(curl, filters.c_str(), filters.length());
+        string path = "/events?filters=" + string(escaped);
+        curl_free(escaped);
+        if (lastEventTime > 0) {
+            // replay the events that happened while disconnected
+            path += "&since=" + to_string(lastEventTime);
+        }
+        lineBuffer.clear();
+
+        curl_easy_setopt(curl, CURLOPT_UNIX_SOCKET_PATH, socket_path.c_str());
+        curl_easy_setopt(curl, CURLOPT_URL, (host_uri + path).c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, this);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderCallback);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, this);
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, ProgressCallback);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, this);
+
+        CURLcode res = curl_easy_perform(curl);
+        curl_easy_cleanup(curl);
+        isConnected = false;
+
+        if (running) {
+            LoggerStream::getInstance() << WARN << "Docker events stream closed: " << curl_easy_strerror(res) << ", reconnecting.";
+            unique_lock<std::mutex> lock(mutex);
+            stopCondition.wait_for(lock, reconnectPeriod, [this]() { return !running; });
+        }
+    }
+}
+
+void DockerEventStream::processLine(const string& line)
+{
+    ContainerEvent event;
+    try {
+        if (!ContainerEvent::parse(json::parse(line), event)) return;
+    } catch (json::parse_error& e) {
+        LoggerStream::getInstance() << DEBUG << "Docker event parse error: " << e.what();
+        return;
+    }
+    lastEventTime = max(lastEventTime, event.time);
+    lock_guard<std::mutex> lock(mutex);
+    events.push_back(event);
+}
+
+size_t DockerEventStream::WriteCallback(void *contents, size_t size, size_t nmemb, void *userp)
+{
+    DockerEventStream* stream = static_cast<DockerEventStream*>(userp);
+    stream->lineBuffer.append(static_cast<char*>(contents), size * nmemb);
+    // the events are newline delimited json objects
+    size_t start = 0, end;
+    while ((end = stream->lineBuffer.find('\n', start)) != string::npos) {
+        if (end > start) {
+            stream->processLine(stream->lineBuffer.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    stream->lineBuffer.erase(0, start);
+    return size * nmemb;
+}
+
+size_t DockerEventStream::HeaderCallback(char *buffer, size_t size, size_t nitems, void *userp)
+{
+    DockerEventStream* stream = static_cast<DockerEventStream*>(userp);
+    string header(buffer, size * nitems);
+    if (header.rfind("HTTP/", 0) == 0) {
+        bool ok = header.find(" 200") != string::npos;
+        if (ok && !stream->isConnected) {
+            LoggerStream::getInstance() << INFO << "Docker events stream connected.";
+            stream->resync = true;
+        }
+        stream->isConnected = ok;
+    }
+    return size * nitems;
+}
+
+int DockerEventStream::ProgressCallback(void *clientp, curl_off_t, curl_off_t, curl_off_t, curl_off_t)
+{
+    // a non-zero return aborts the transfer when the stream is stopped
+    return static_cast<DockerEventStream*>(clientp)->running ? 0 : 1;
+}
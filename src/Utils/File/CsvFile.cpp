@@ -0,0 +1,263 @@
+#include <Utils/File/CsvFile.h>
+#include <Utils/Settings/TaskPool.h>
+#include <Exceptions/FileExceptions.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+using namespace Ilvo::Utils::File;
+using namespace Ilvo::Utils::Settings;
+using namespace Ilvo::Exception;
+
+using namespace std;
+
+namespace {
+    /** @brief Rows of a chunk and the series that start in it */
+    struct Chunk
+    {
+        size_t rows = 0;
+        /** @brief The chunk holds the empty line that ends the rows */
+        bool stop = false;
+        size_t firstRow = 0;
+        std::vector<size_t> seriesStart;
+        std::string firstKey, lastKey;
+    };
+
+    string_view trim(string_view s)
+    {
+        size_t b = s.find_first_not_of(" \t");
+        if (b == string_view::npos) return string_view();
+        size_t e = s.find_last_not_of(" \t");
+        return s.substr(b, e - b + 1);
+    }
+
+    /** @brief Call f(line) for the lines of [begin, end), without the line break, until f returns false */
+    template<typename F>
+    void forEachLine(const char* begin, const char* end, F f)
+    {
+        const char* p = begin;
+        while (p < end) {
+            const char* n = static_cast<const char*>(memchr(p, '\n', end - p));
+            const char* e = n ? n : end;
+            string_view line(p, e - p);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (!f(line)) return;
+            p = e + 1;
+        }
+    }
+
+    bool isEmpty(string_view line)
+    {
+        return line.find_first_not_of(" \t") == string_view::npos;
+    }
+
+    /**
+     * @brief Field at p of the line, p moves to the next field
+     *
+     * @details A quoted field is returned without its quotes, with the doubled quotes inside. last is set for the
+     * last field of the line.
+     */
+    string_view nextField(const char*& p, const char* end, char delimiter, bool& last)
+    {
+        string_view field;
+        const char* s = p;
+        while (s < end && (*s == ' ' || *s == '\t')) s++;
+        if (s < end && *s == '"') {
+            const char* b = ++s;
+            while (s < end && !(*s == '"' && (s + 1 == end || s[1] != '"'))) {
+                s += (*s == '"') ? 2 : 1;
+            }
+            field = string_view(b, min(s, end) - b);
+        }
+        const char* d = static_cast<const char*>(memchr(s, delimiter, max(s, end) - s));
+        if (field.data() == nullptr) field = trim(string_view(p, (d ? d : end) - p));
+        last = (d == nullptr);
+        p = d ? d + 1 : end;
+        return field;
+    }
+
+    string unquote(string_view field)
+    {
+        string s(field);
+        for (size_t q = s.find("\"\""); q != string::npos; q = s.find("\"\"", q + 1)) {
+            s.erase(q, 1);
+        }
+        return s;
+    }
+
+    bool parseNumber(string_view s, double& v)
+    {
+        s = trim(s);
+        if (s.empty()) {
+            v = NAN;
+            return true;
+        }
+        if (s.front() == '+') s.remove_prefix(1);
+        auto [ptr, ec] = from_chars(s.data(), s.data() + s.size(), v);
+        return ec == errc() && ptr == s.data() + s.size();
+    }
+}
+
+
+CsvFile::CsvFile(const string& filename, char delimiter) :
+    file(filename),
+    delimiter(delimiter),
+    body(0)
+{
+    const char* begin = file.data();
+    const char* end = begin + file.size();
+    // UTF-8 byte order mark
+    if (file.size() >= 3 && memcmp(begin, "\xEF\xBB\xBF", 3) == 0) {
+        body = 3;
+    }
+    forEachLine(begin + body, end, [&](string_view line) {
+        body = line.data() + line.size() - begin;
+        if (body < file.size() && begin[body] == '\r') body++;
+        if (body < file.size()) body++;
+        bool last = line.empty();
+        const char* p = line.data();
+        while (!last) {
+            columns.push_back(unquote(nextField(p, line.data() + line.size(), this->delimiter, last)));
+        }
+        return false;
+    });
+}
+
+const vector<string>& CsvFile::getColumns() const
+{
+    return columns;
+}
+
+int CsvFile::findColumn(const vector<string>& names) const
+{
+    auto same = [](const string& a, const string& b) {
+        return a.size() == b.size() && equal(a.begin(), a.end(), b.begin(), [](char x, char y) { return tolower(x) == tolower(y); });
+    };
+    for (size_t c = 0; c < columns.size(); c++) {
+        for (const string& name: names) {
+            if (same(columns[c], name)) return c;
+        }
+    }
+    return -1;
+}
+
+vector<size_t> CsvFile::chunks() const
+{
+    vector<size_t> offsets{body};
+    const char* data = file.data();
+    while (offsets.back() + CSV_CHUNK_SIZE < file.size()) {
+        size_t from = offsets.back() + CSV_CHUNK_SIZE;
+        const char* n = static_cast<const char*>(memchr(data + from, '\n', file.size() - from));
+        if (!n) break;
+        offsets.push_back(n + 1 - data);
+    }
+    if (offsets.back() < file.size()) offsets.push_back(file.size());
+    return offsets;
+}
+
+CsvColumns CsvFile::readColumns(const vector<size_t>& columns, int seriesColumn) const
+{
+    vector<size_t> offsets = chunks();
+    size_t numChunks = offsets.size() - 1;
+    const char* data = file.data();
+    vector<Chunk> chunk(numChunks);
+    TaskPool& pool = TaskPool::getInstance();
+
+    // count the rows of every chunk
+    pool.parallelFor(numChunks, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; k++) {
+            forEachLine(data + offsets[k], data + offsets[k + 1], [&](string_view line) {
+                if (isEmpty(line)) {
+                    chunk[k].stop = true;
+                    return false;
+                }
+                chunk[k].rows++;
+                return true;
+            });
+        }
+    });
+    size_t numRows = 0;
+    bool stopped = false;
+    for (Chunk& c: chunk) {
+        if (stopped) c.rows = 0;
+        c.firstRow = numRows;
+        numRows += c.rows;
+        stopped = stopped || c.stop;
+    }
+
+    CsvColumns result;
+    result.values.assign(columns.size(), vector<double>(numRows));
+    size_t lastColumn = columns.empty() ? 0 : *max_element(columns.begin(), columns.end());
+    if (seriesColumn >= 0) lastColumn = max<size_t>(lastColumn, seriesColumn);
+    vector<int> slot(lastColumn + 1, -1);
+    for (size_t c = 0; c < columns.size(); c++) {
+        slot[columns[c]] = c;
+    }
+
+    // parse the rows of every chunk into their place of the arrays
+    pool.parallelFor(numChunks, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; k++) {
+            size_t row = chunk[k].firstRow;
+            size_t endRow = row + chunk[k].rows;
+            forEachLine(data + offsets[k], data + offsets[k + 1], [&](string_view line) {
+                if (row == endRow) return false;
+                for (auto& values: result.values) {
+                    values[row] = NAN;
+                }
+                const char* p = line.data();
+                bool last = false;
+                string_view key;
+                for (size_t c = 0; c <= lastColumn && !last; c++) {
+                    string_view field = nextField(p, line.data() + line.size(), delimiter, last);
+                    if (int(c) == seriesColumn) key = field;
+                    if (slot[c] >= 0 && !parseNumber(field, result.values[slot[c]][row])) {
+                        throw FileFormatException(file.getFilename(), "no number at line " + to_string(row + 2) +
+                                                  ", column " + to_string(c + 1));
+                    }
+                }
+                if (seriesColumn >= 0) {
+                    if (row == chunk[k].firstRow) {
+                        chunk[k].firstKey = key;
+                    } else if (key != chunk[k].lastKey) {
+                        chunk[k].seriesStart.push_back(row);
+                    }
+                    chunk[k].lastKey = key;
+                }
+                row++;
+                return true;
+            });
+        }
+    });
+
+    result.seriesStart.push_back(0);
+    const Chunk* previous = nullptr;
+    for (const Chunk& c: chunk) {
+        if (c.rows == 0) continue;
+        if (previous && seriesColumn >= 0 && c.firstKey != previous->lastKey) {
+            result.seriesStart.push_back(c.firstRow);
+        }
+        result.seriesStart.insert(result.seriesStart.end(), c.seriesStart.begin(), c.seriesStart.end());
+        previous = &c;
+    }
+    if (numRows > 0) result.seriesStart.push_back(numRows);
+    return result;
+}
+
+vector<vector<string>> CsvFile::readRows() const
+{
+    vector<vector<string>> rows;
+    const char* data = file.data();
+    forEachLine(data + body, data + file.size(), [&](string_view line) {
+        if (isEmpty(line)) return false;
+        vector<string> row;
+        const char* p = line.data();
+        bool last = false;
+        while (!last) {
+            row.push_back(unquote(nextField(p, line.data() + line.size(), delimiter, last)));
+        }
+        rows.push_back(std::move(row));
+        return true;
+    });
+    return rows;
+}
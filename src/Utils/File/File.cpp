@@ -1,10 +1,19 @@
 #include <Utils/File/File.h>
+#include <Exceptions/FileExceptions.hpp>
 #include <filesystem>
 #include <iostream>
 #include <sstream>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include <boost/algorithm/string.hpp>
 
+using namespace Ilvo::Utils::File;
+using namespace Ilvo::Exception;
+
 using namespace std;
 using namespace std::filesystem;
 using namespace boost::algorithm;
@@ -35,4 +44,79 @@ void Ilvo::Utils::File::removeCharacters(string& s, const vector<char>& removeCh
     for (char c: removeChars) {
         s.erase(remove(s.begin(), s.end(), c), s.end());
     }
-}
\ No newline at end of file
+}
+
+MappedFile::MappedFile() :
+    begin(nullptr),
+    length(0)
+{
+}
+
+MappedFile::MappedFile(const string& filename) :
+    filename(filename),
+    begin(nullptr),
+    length(0)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw PathNotFoundException(filename);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw FileFormatException(filename, "no file status");
+    }
+    length = st.st_size;
+    if (length > 0) {
+        void* p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            close(fd);
+            throw FileFormatException(filename, "the file can not be mapped");
+        }
+        begin = static_cast<const char*>(p);
+    }
+    close(fd);
+}
+
+MappedFile::MappedFile(MappedFile&& other) :
+    filename(std::move(other.filename)),
+    begin(std::exchange(other.begin, nullptr)),
+    length(std::exchange(other.length, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other)
+{
+    if (this != &other) {
+        if (begin) munmap(const_cast<char*>(begin), length);
+        filename = std::move(other.filename);
+        begin = std::exchange(other.begin, nullptr);
+        length = std::exchange(other.length, 0);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    if (begin) munmap(const_cast<char*>(begin), length);
+}
+
+const string& MappedFile::getFilename() const
+{
+    return filename;
+}
+
+const char* MappedFile::data() const
+{
+    return begin;
+}
+
+size_t MappedFile::size() const
+{
+    return length;
+}
+
+bool MappedFile::empty() const
+{
+    return length == 0;
+}
@@ -1,11 +1,8 @@
 #include <Utils/File/PointCsvFile.h>
 #include <Utils/File/File.h>
 #include <Exceptions/FileExceptions.hpp>
-#include <boost/algorithm/string.hpp>
 
 #include <filesystem>
-#include <sstream>
-#include <fstream>
 
 using namespace Ilvo::Utils::File;
 using namespace Ilvo::Utils::Geometry;
@@ -13,7 +10,6 @@ using namespace Ilvo::Exception;
 
 using namespace std;
 using namespace chrono_literals;
-using namespace boost::algorithm;
 using namespace std::filesystem;
 
 using chrono::duration_cast;
@@ -22,7 +18,7 @@ PointCsvFile::PointCsvFile(bool polygon) : PointData(polygon)
 {
 }
 
-void PointCsvFile::init(const string& filename, vector<string>& xFields, vector<string>& yFields)
+void PointCsvFile::init(const string& filename, vector<string>& xFields, vector<string>& yFields, const vector<string>& seriesFields)
 {
     csv_file = filename;
     // Check if filename is of .csv format
@@ -49,103 +45,51 @@ void PointCsvFile::init(const string& filename, vector<string>& xFields, vector<
     series.clear(); 
 
     // Read series
-    this->readPointFile(xFields, yFields);
+    this->readPointFile(xFields, yFields, seriesFields);
 
 }
 
-void PointCsvFile::readPointFile(vector<string>& xFields, vector<string>& yFields) {
-    // Create an input filestream
-    ifstream myFile( csv_file );
-    // Make xFields and yFields lower case
-    for (string& xf : xFields) {
-        to_lower(xf);
-    }
-    for (string& yf : yFields) {
-        to_lower(yf);
-    }
-
-    // Make sure the file is open
-    if(!myFile.is_open()) {
-        throw PathNotFoundException( csv_file );
-    }
-
-    // Helper vars
-    string line, colname;
-    int xColIdx = -1;
-    int yColIdx = -1;
-    int colIdx;
+void PointCsvFile::readPointFile(vector<string>& xFields, vector<string>& yFields, const vector<string>& seriesFields) {
+    csv = make_unique<CsvFile>(csv_file);
+    column_names.clear();
+    data_lines.clear();
 
     // Read the column names
-    if(myFile.good())
-    {
-        // Extract the first line in the file
-        getline(myFile, line);
-        removeCharacters(line, CHARS_END_OF_LINE);
-
-        // Create a stringstream from line
-        stringstream ss(line);
-
-        // Extract each column name
-        colIdx = 0;
-        while(getline(ss, colname, ',')){
-            string colname_orig = colname;
-            to_lower(colname);
-            if (count(xFields.begin(), xFields.end(), colname)) {
-                xColIdx = colIdx;
-            } else if (count(yFields.begin(), yFields.end(), colname)) {
-                yColIdx = colIdx;
-            } 
-            column_names.insert(make_pair(colname_orig, colIdx));
-            colIdx++;
-        }
+    const vector<string>& columns = csv->getColumns();
+    for (size_t c = 0; c < columns.size(); c++) {
+        column_names.insert(make_pair(columns[c], int(c)));
     }
+    int xColIdx = csv->findColumn(xFields);
+    int yColIdx = csv->findColumn(yFields);
 
     // check if columns occured
     if (! (xColIdx >= 0 && yColIdx >= 0)) {
         throw CsvColumnsNotFoundException(xFields, yFields);
     }
-
-    // Read data, line by line
-    this->series.push_back(vector<PointPtr>()); // add new pointvector
-    while(getline(myFile, line))
-    {
-        removeCharacters(line, CHARS_END_OF_LINE);
-        // don't process when no data
-        if (line.empty()) break;
-
-        // helper var -> keeps the point
-        vector<double> point;
-        // Create a stringstream of the current line
-        stringstream ss(line);
-             
-        // Extract each integer
-        double x = -1.0;
-        double y = -1.0;
-        colIdx = 0;
-        string colVal;
-        vector<string> data_line = {};
-        while(getline(ss, colVal, ',')){
-            removeCharacters(colVal, CHARS_BRACKETS);
-
-            if (xColIdx == colIdx) {
-                x = stod(colVal);
-            } else if (yColIdx == colIdx) {
-                y = stod(colVal);
-            }
-            data_line.push_back(colVal);
-            colIdx++;
+    int seriesColIdx = seriesFields.empty() ? -1 : csv->findColumn(seriesFields);
+
+    // Read data, in parallel chunks
+    CsvColumns table = csv->readColumns({size_t(xColIdx), size_t(yColIdx)}, seriesColIdx);
+    const vector<double>& x = table.values[0];
+    const vector<double>& y = table.values[1];
+
+    for (size_t s = 0; s + 1 < table.seriesStart.size(); s++) {
+        size_t begin = table.seriesStart[s];
+        size_t end = table.seriesStart[s + 1];
+        vector<PointPtr> points;
+        points.reserve(end - begin + 1);
+        for (size_t r = begin; r < end; r++) {
+            points.push_back(make_shared<Point>(x[r], y[r]));
+        }
+        // if polygon push first point to the end of the array
+        if (polygon) {
+            points.push_back(make_shared<Point>(x[begin], y[begin]));
         }
-        
-        data_lines.push_back(data_line);
-        series[0].push_back(make_shared<Point>(x, y));
+        this->series.push_back(std::move(points));
     }
-    // if polygon push last point to the array
-    if (polygon && this->getPoints(0).size() > 0) {
-        vector<PointPtr> p_first_series = this->getPoints(0);
-        this->series[0].push_back(make_shared<Point>(p_first_series[0]->x(), p_first_series[0]->y()));
+    if (this->series.empty()) {
+        this->series.push_back(vector<PointPtr>());
     }
-    // Close file
-    myFile.close();
 }
 
 const map<string, int>& PointCsvFile::getColumnNames() const
@@ -154,5 +98,8 @@ const map<string, int>& PointCsvFile::getColumnNames() const
 }
 const vector<vector<string>>& PointCsvFile::getDataLines() const
 {
+    if (data_lines.empty() && csv) {
+        data_lines = csv->readRows();
+    }
     return data_lines;
 }
@@ -41,7 +41,7 @@ int PointData::getNumPoints(uint serie)
 
 int PointData::getNumFields(uint i)
 {
-    return int(this->metadata[i].size());
+    return int(this->getFields(i).size());
 }
 
 bool PointData::isPolygon(uint i)
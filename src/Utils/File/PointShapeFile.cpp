@@ -55,138 +55,65 @@ void PointShapeFile::init(const std::string& filename)
     this->readShapefile();
 }
 
-void PointShapeFile::loadDbfFields(DBFHandle dbfHandle, int i)
+vector<ShapeFieldDataPtr>& PointShapeFile::getFields(uint i)
 {
-    // read in the attributes      
-    for (int f = 0; f < DBFGetFieldCount(dbfHandle); f++)
-    {
-        char fieldNameChar[12];
-        DBFFieldType fieldType = DBFGetFieldInfo(dbfHandle, f, fieldNameChar, NULL, NULL);
-        string fieldName = string(fieldNameChar);
-        switch(fieldType) {
-            case FTString:
-            {
-                this->metadata[i].push_back(make_shared<ShapeFieldData>(fieldName, DBFReadStringAttribute(dbfHandle, i, f)));
-                break; 
-            }
-            case FTInteger:
-            {
-                this->metadata[i].push_back(make_shared<ShapeFieldData>(fieldName, DBFReadIntegerAttribute(dbfHandle, i, f)));
-                break; 
-            }
-            case FTDouble:
-            {
-                this->metadata[i].push_back(make_shared<ShapeFieldData>(fieldName, DBFReadDoubleAttribute(dbfHandle, i, f)));
-                break; 
-            }
-            case FTLogical:
-            {
-                this->metadata[i].push_back(make_shared<ShapeFieldData>(fieldName, DBFReadLogicalAttribute(dbfHandle, i, f)));
-                break; 
-            }
-        }
+    if (!decoded[i]) {
+        this->metadata[i] = shapes->getFieldData(records[i]);
+        decoded[i] = true;
     }
-
+    return this->metadata[i];
 }
 
-
 void PointShapeFile::readShapefile()
 {
-    try
+    shapes = make_unique<ShapeFile>(shp_file);
+    records.clear();
+
+    // if x y values are in xE[-180,+180] and yE[-90,+90]
+    // x => longitude and y => latitude
+    // so convert all vertices to UTM in one batch
+    shapes->toUtm(utmZone);
+    const vector<double>& x = shapes->getX();
+    const vector<double>& y = shapes->getY();
+
+    int shapeType = shapes->getShapeType();
+    if (shapeType == POINT || shapeType == POINTZ || shapeType == POINTM
+        || shapeType == MULTIPOINT || shapeType == MULTIPOINTZ || shapeType == MULTIPOINTM)
     {
-        SHPHandle shpHandle = SHPOpen(shp_file.c_str(), "rb");
-        DBFHandle dbfHandle = DBFOpen(shp_file.c_str(), "rb");
-        // if (shpHandle <= 0)
-        // {
-        //     throw std::string("File " + filename + " not found");
-        // }
-
-        int nShapeType, nEntities;
-        double adfMinBound[4], adfMaxBound[4];
-        SHPGetInfo(shpHandle, &nEntities, &nShapeType, adfMinBound, adfMaxBound );
-
-        for (int i = 0; i < nEntities; i++)
-        {
-            SHPObject* psShape = SHPReadObject(shpHandle, i );
-
-            // For Point and MultiPoint files
-            if (psShape->nSHPType == SHPT_POINTZ || psShape->nSHPType == SHPT_POINT
-                || psShape->nSHPType == SHPT_MULTIPOINT || psShape->nSHPType == SHPT_MULTIPOINTZ)
-            {
-                // only push one point vector
-                if (i == 0) {
-                    this->series.push_back(vector<PointPtr>());
-                    this->metadata.push_back(vector<ShapeFieldDataPtr>());
-                }
-
-                double x = (psShape->padfX)[0];
-                double y = (psShape->padfY)[0];
-                // if x y values are in xE[-180,+180] and yE[-90,+90]
-                // x => longitude and y => latitude
-                // so convert to UTM
-                if (x <= 180.0 || y <= 90.0) {
-                    double lon = x;
-                    double lat = y;
-                    LatLonToUTMXY(lat, lon, utmZone, x, y);
-                }
-                this->series[0].push_back(make_shared<Point>(x, y));
-                // if polygon push last point to the array
-                if (polygon) {
-                    if (i == nEntities-1) {
-                        vector<PointPtr> p_first_series = this->getPoints(0);
-                        this->series[0].push_back(make_shared<Point>(p_first_series[0]->x(), p_first_series[0]->y()));
-                    }
-                }
-
-                loadDbfFields(dbfHandle, 0);
-            } // For Polygon and linestring files
-            else if (
-                ((psShape->nSHPType == SHPT_POLYGON || psShape->nSHPType == SHPT_POLYGONZ))
-                || (psShape->nSHPType == SHPT_ARC || psShape->nSHPType == SHPT_ARCZ)
-            )
-            {
-                if (psShape->nParts != 1) {
-                    // only polygons in once piece (whitout holes)
-                    LoggerStream::getInstance() << ERROR << "A polygon with zero or more then one parts detected! Polygons with holes are not permitted!";
-                    throw PolygonWithHoleException(); // TODO problems with string conversion
-                }
-                // only push one point vector
-                this->series.push_back(vector<PointPtr>()); // add new pointvector
-                this->metadata.push_back(vector<ShapeFieldDataPtr>());
-
-                double* x = psShape->padfX;
-                double* y = psShape->padfY;
-                
-                // read in the shape vertices
-                for (int v = 0; v < psShape->nVertices; v++)
-                {
-                    double x = (psShape->padfX)[v];
-                    double y = (psShape->padfY)[v];
-                    // if x y values are in xE[-180,+180] and yE[-90,+90]
-                    // x => longitude and y => latitude
-                    // so convert to UTM
-                    if (x <= 180.0 || y <= 90.0) {
-                        double lon = x;
-                        double lat = y;
-                        LatLonToUTMXY(lat, lon, utmZone, x, y);
-                    }
-                    this->series[i].push_back(make_shared<Point>(x, y));
-                }
-
-                loadDbfFields(dbfHandle, i);
-            } 
-
-            SHPDestroyObject(psShape);
+        // For Point and MultiPoint files, all points in one vector
+        this->series.push_back(vector<PointPtr>());
+        this->series[0].reserve(shapes->getNumVertices() + 1);
+        for (size_t v = 0; v < shapes->getNumVertices(); v++) {
+            this->series[0].push_back(make_shared<Point>(x[v], y[v]));
         }
-        SHPClose(shpHandle);
-        DBFClose(dbfHandle);
-    }
-    catch(const std::string& s)
-    {
-        throw s;
+        // if polygon push first point to the end of the array
+        if (polygon && !this->series[0].empty()) {
+            this->series[0].push_back(make_shared<Point>(x[0], y[0]));
+        }
+        records.push_back(0);
     }
-    catch(...)
+    else if (shapeType == POLYGON || shapeType == POLYGONZ || shapeType == POLYGONM
+             || shapeType == POLYLINE || shapeType == POLYLINEZ || shapeType == POLYLINEM)
     {
-        throw std::string("Other exception");
+        // For Polygon and linestring files, one vector per shape
+        for (size_t s = 0; s < shapes->getNumShapes(); s++) {
+            // null shapes have no vertices
+            if (shapes->getNumParts(s) == 0) continue;
+            if (shapes->getNumParts(s) != 1) {
+                // only polygons in once piece (whitout holes)
+                LoggerStream::getInstance() << ERROR << "A polygon with more then one part detected! Polygons with holes are not permitted!";
+                throw PolygonWithHoleException();
+            }
+            vector<PointPtr> points;
+            points.reserve(shapes->partEnd(s, 0) - shapes->partBegin(s, 0));
+            for (size_t v = shapes->partBegin(s, 0); v < shapes->partEnd(s, 0); v++) {
+                points.push_back(make_shared<Point>(x[v], y[v]));
+            }
+            this->series.push_back(std::move(points));
+            records.push_back(s);
+        }
     }
+
+    this->metadata.assign(this->series.size(), vector<ShapeFieldDataPtr>());
+    decoded.assign(this->series.size(), false);
 }
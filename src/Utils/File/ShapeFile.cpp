@@ -0,0 +1,336 @@
+#include <Utils/File/ShapeFile.h>
+#include <Utils/Geometry/UtmProjection.h>
+#include <Exceptions/FileExceptions.hpp>
+#include <charconv>
+#include <cstring>
+
+using namespace Ilvo::Utils::File;
+using namespace Ilvo::Utils::Geometry;
+using namespace Ilvo::Exception;
+
+using namespace std;
+
+namespace {
+    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "the .shp and .dbf values are read in little endian");
+
+    const size_t SHP_HEADER_LENGTH = 100;
+    const int SHP_FILE_CODE = 9994;
+
+    template<typename T>
+    T readLE(const char* p)
+    {
+        T v;
+        memcpy(&v, p, sizeof(T));
+        return v;
+    }
+
+    int32_t readBE(const char* p)
+    {
+        return int32_t(__builtin_bswap32(readLE<uint32_t>(p)));
+    }
+
+    string_view trim(string_view s)
+    {
+        size_t b = s.find_first_not_of(" \t\r\n\0"sv);
+        if (b == string_view::npos) return string_view();
+        size_t e = s.find_last_not_of(" \t\r\n\0"sv);
+        return s.substr(b, e - b + 1);
+    }
+
+    double parseDouble(string_view s)
+    {
+        double v = 0.0;
+        if (!s.empty() && s.front() == '+') s.remove_prefix(1);
+        from_chars(s.data(), s.data() + s.size(), v);
+        return v;
+    }
+}
+
+
+ShapeFile::ShapeFile(const string& shpFile) :
+    shp(shpFile),
+    shapeType(NULL_SHAPE),
+    numRecords(0),
+    headerLength(0),
+    recordLength(0)
+{
+    readShp();
+
+    string dbfFile = shpFile.substr(0, shpFile.size() - 4) + ".dbf";
+    try {
+        dbf = MappedFile(dbfFile);
+    } catch (const PathNotFoundException&) {
+        return;
+    }
+    readDbfHeader();
+}
+
+void ShapeFile::readShp()
+{
+    const char* data = shp.data();
+    const size_t size = shp.size();
+    if (size < SHP_HEADER_LENGTH || readBE(data) != SHP_FILE_CODE) {
+        throw FileFormatException(shp.getFilename(), "no shapefile header");
+    }
+    shapeType = readLE<int32_t>(data + 32);
+
+    // every vertex takes at least 16 bytes
+    xs.reserve((size - SHP_HEADER_LENGTH) / 16);
+    ys.reserve((size - SHP_HEADER_LENGTH) / 16);
+
+    auto addVertices = [this](const char* p, size_t n) {
+        size_t base = xs.size();
+        xs.resize(base + n);
+        ys.resize(base + n);
+        for (size_t k = 0; k < n; k++) {
+            memcpy(&xs[base + k], p + 16 * k, sizeof(double));
+            memcpy(&ys[base + k], p + 16 * k + 8, sizeof(double));
+        }
+    };
+
+    size_t offset = SHP_HEADER_LENGTH;
+    while (offset + 8 <= size) {
+        size_t length = size_t(readBE(data + offset + 4)) * 2;
+        const char* content = data + offset + 8;
+        offset += 8 + length;
+        if (offset > size || length < 4) {
+            throw FileFormatException(shp.getFilename(), "truncated record " + to_string(shapeStart.size()));
+        }
+
+        shapeStart.push_back(partStart.size());
+        int type = readLE<int32_t>(content);
+        switch (type) {
+            case NULL_SHAPE:
+                break;
+            case POINT: case POINTZ: case POINTM:
+                if (length < 20) throw FileFormatException(shp.getFilename(), "truncated point");
+                partStart.push_back(xs.size());
+                addVertices(content + 4, 1);
+                break;
+            case MULTIPOINT: case MULTIPOINTZ: case MULTIPOINTM: {
+                if (length < 40) throw FileFormatException(shp.getFilename(), "truncated multipoint");
+                int32_t numPoints = readLE<int32_t>(content + 36);
+                if (numPoints < 0 || 40 + 16 * size_t(numPoints) > length) {
+                    throw FileFormatException(shp.getFilename(), "truncated multipoint");
+                }
+                partStart.push_back(xs.size());
+                addVertices(content + 40, numPoints);
+                break;
+            }
+            case POLYLINE: case POLYLINEZ: case POLYLINEM:
+            case POLYGON: case POLYGONZ: case POLYGONM: {
+                if (length < 44) throw FileFormatException(shp.getFilename(), "truncated shape");
+                int32_t numParts = readLE<int32_t>(content + 36);
+                int32_t numPoints = readLE<int32_t>(content + 40);
+                if (numParts < 0 || numPoints < 0 || 44 + 4 * size_t(numParts) + 16 * size_t(numPoints) > length) {
+                    throw FileFormatException(shp.getFilename(), "truncated shape");
+                }
+                size_t base = xs.size();
+                int32_t previous = 0;
+                for (int32_t p = 0; p < numParts; p++) {
+                    int32_t start = readLE<int32_t>(content + 44 + 4 * p);
+                    if (start < previous || start > numPoints || (p == 0 && start != 0)) {
+                        throw FileFormatException(shp.getFilename(), "invalid part of shape " + to_string(shapeStart.size() - 1));
+                    }
+                    partStart.push_back(base + start);
+                    previous = start;
+                }
+                addVertices(content + 44 + 4 * numParts, numPoints);
+                break;
+            }
+            default:
+                throw FileFormatException(shp.getFilename(), "unsupported shape type " + to_string(type));
+        }
+    }
+    partStart.push_back(xs.size());
+    shapeStart.push_back(partStart.size() - 1);
+}
+
+void ShapeFile::readDbfHeader()
+{
+    const char* data = dbf.data();
+    const size_t size = dbf.size();
+    if (size < 32) {
+        throw FileFormatException(dbf.getFilename(), "no dBase header");
+    }
+    numRecords = readLE<uint32_t>(data + 4);
+    headerLength = readLE<uint16_t>(data + 8);
+    recordLength = readLE<uint16_t>(data + 10);
+    if (headerLength > size || headerLength + numRecords * recordLength > size) {
+        throw FileFormatException(dbf.getFilename(), "truncated records");
+    }
+
+    size_t offset = 1;  // deletion flag
+    for (size_t d = 32; d + 32 <= headerLength && data[d] != 0x0D; d += 32) {
+        ShapeField field;
+        field.name = string(data + d, strnlen(data + d, 11));
+        field.dbfType = data[d + 11];
+        field.width = uint8_t(data[d + 16]);
+        field.decimals = uint8_t(data[d + 17]);
+        field.offset = offset;
+        offset += field.width;
+        switch (field.dbfType) {
+            case 'N': case 'F':
+                field.type = (field.decimals == 0 && field.width < 10) ? INT : DOUBLE;
+                break;
+            case 'L':
+                field.type = BOOL;
+                break;
+            default:
+                field.type = STRING;
+        }
+        fields.push_back(field);
+    }
+    if (offset > recordLength) {
+        throw FileFormatException(dbf.getFilename(), "fields are wider than the records");
+    }
+}
+
+int ShapeFile::getShapeType() const
+{
+    return shapeType;
+}
+
+size_t ShapeFile::getNumShapes() const
+{
+    return shapeStart.size() - 1;
+}
+
+size_t ShapeFile::getNumParts(size_t shape) const
+{
+    return shapeStart[shape + 1] - shapeStart[shape];
+}
+
+size_t ShapeFile::getNumVertices() const
+{
+    return xs.size();
+}
+
+size_t ShapeFile::partBegin(size_t shape, size_t p) const
+{
+    return partStart[shapeStart[shape] + p];
+}
+
+size_t ShapeFile::partEnd(size_t shape, size_t p) const
+{
+    return partStart[shapeStart[shape] + p + 1];
+}
+
+const vector<double>& ShapeFile::getX() const
+{
+    return xs;
+}
+
+const vector<double>& ShapeFile::getY() const
+{
+    return ys;
+}
+
+bool ShapeFile::toUtm(int utmZone)
+{
+    auto geographic = [this](size_t v) { return xs[v] <= 180.0 || ys[v] <= 90.0; };
+    size_t first = 0;
+    while (first < xs.size() && !geographic(first)) first++;
+    if (first == xs.size()) return false;
+
+    int zone = UtmProjection::isValidZone(utmZone) ? utmZone : UtmProjection::zoneOf(xs[first]);
+    vector<double> xUtm(xs.size()), yUtm(ys.size());
+    UtmProjection::get(zone).toUtm(ys.data(), xs.data(), xUtm.data(), yUtm.data(), xs.size());
+    for (size_t v = first; v < xs.size(); v++) {
+        if (geographic(v)) {
+            xs[v] = xUtm[v];
+            ys[v] = yUtm[v];
+        }
+    }
+    return true;
+}
+
+size_t ShapeFile::getNumRecords() const
+{
+    return numRecords;
+}
+
+const vector<ShapeField>& ShapeFile::getFields() const
+{
+    return fields;
+}
+
+int ShapeFile::findField(const string& name) const
+{
+    for (size_t f = 0; f < fields.size(); f++) {
+        if (fields[f].name == name) return f;
+    }
+    return -1;
+}
+
+const char* ShapeFile::record(size_t r) const
+{
+    return dbf.data() + headerLength + r * recordLength;
+}
+
+bool ShapeFile::isDeleted(size_t r) const
+{
+    return record(r)[0] == '*';
+}
+
+string_view ShapeFile::getRaw(size_t r, size_t f) const
+{
+    return trim(string_view(record(r) + fields[f].offset, fields[f].width));
+}
+
+string ShapeFile::getString(size_t r, size_t f) const
+{
+    return string(getRaw(r, f));
+}
+
+int ShapeFile::getInt(size_t r, size_t f) const
+{
+    return int(parseDouble(getRaw(r, f)));
+}
+
+double ShapeFile::getDouble(size_t r, size_t f) const
+{
+    return parseDouble(getRaw(r, f));
+}
+
+bool ShapeFile::getBool(size_t r, size_t f) const
+{
+    string_view s = getRaw(r, f);
+    return !s.empty() && (s[0] == 'T' || s[0] == 't' || s[0] == 'Y' || s[0] == 'y');
+}
+
+vector<double> ShapeFile::getDoubleColumn(size_t f) const
+{
+    vector<double> column(numRecords);
+    for (size_t r = 0; r < numRecords; r++) {
+        column[r] = parseDouble(getRaw(r, f));
+    }
+    return column;
+}
+
+vector<ShapeFieldDataPtr> ShapeFile::getFieldData(size_t r) const
+{
+    vector<ShapeFieldDataPtr> data;
+    if (r >= numRecords) return data;
+
+    data.reserve(fields.size());
+    for (size_t f = 0; f < fields.size(); f++) {
+        // shapelib reads dates as FTDate, the fields of the series never had them
+        if (fields[f].dbfType == 'D') continue;
+        switch (fields[f].type) {
+            case INT:
+                data.push_back(make_shared<ShapeFieldData>(fields[f].name, getInt(r, f)));
+                break;
+            case DOUBLE:
+                data.push_back(make_shared<ShapeFieldData>(fields[f].name, getDouble(r, f)));
+                break;
+            case BOOL:
+                data.push_back(make_shared<ShapeFieldData>(fields[f].name, getBool(r, f)));
+                break;
+            case STRING:
+                data.push_back(make_shared<ShapeFieldData>(fields[f].name, getString(r, f)));
+                break;
+        }
+    }
+    return data;
+}
@@ -0,0 +1,314 @@
+#include <Utils/Geometry/CoverageMap.h>
+#include <ThirdParty/base64/base64.h>
+#include <boost/geometry.hpp>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace Ilvo::Utils::Geometry;
+using namespace boost::filesystem;
+
+using namespace std;
+using json = nlohmann::json;
+
+namespace {
+    const size_t TILE_BYTES = size_t(COVERAGE_TILE_SIZE) * COVERAGE_TILE_SIZE;
+    const int TILE_SHIFT = 8;
+    static_assert((1 << TILE_SHIFT) == COVERAGE_TILE_SIZE, "tile size is a power of two");
+
+    /** @brief Interval [x0, x1) of the scanline y inside a convex ring */
+    bool span(const bgPolygon2D& area, double y, double& x0, double& x1)
+    {
+        x0 = INFINITY;
+        x1 = -INFINITY;
+        const auto& ring = area.outer();
+        for (size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+            double yi = ring[i].y(), yj = ring[j].y();
+            if ((yi <= y) != (yj <= y)) {
+                double x = ring[i].x() + (y - yi) * (ring[j].x() - ring[i].x()) / (yj - yi);
+                x0 = min(x0, x);
+                x1 = max(x1, x);
+            }
+        }
+        return x0 < x1;
+    }
+
+    bool isTileFile(const path& file, int64_t& tx, int64_t& ty)
+    {
+        long long x, y;
+        char end;
+        return file.extension() == ".tile" &&
+               sscanf(file.stem().string().c_str(), "%lld_%lld%c", &x, &y, &end) == 2 &&
+               (tx = x, ty = y, true);
+    }
+}
+
+
+CoverageMap::CoverageMap(double resolution, const string& directory) :
+    resolution(resolution),
+    directory(directory)
+{
+    if (resolution <= 0.0) throw invalid_argument("Coverage resolution must be positive");
+    if (directory.empty()) return;
+
+    try {
+        create_directories(directory);
+        // tiles of another resolution are of no use
+        path meta = path(directory) / "coverage.json";
+        json jMeta;
+        if (exists(meta)) {
+            jMeta = json::parse(std::ifstream(meta.string()), nullptr, false);
+        }
+        if (!jMeta.is_object() || jMeta.value("resolution", 0.0) != resolution || jMeta.value("size", 0) != COVERAGE_TILE_SIZE) {
+            clear();
+            std::ofstream(meta.string()) << json({{"resolution", resolution}, {"size", COVERAGE_TILE_SIZE}}).dump();
+        }
+        for (const directory_entry& entry: directory_iterator(directory)) {
+            int64_t tx, ty;
+            if (isTileFile(entry.path(), tx, ty)) {
+                mapTile(tx, ty);
+                changedTiles.insert(tileKey(tx, ty));
+            }
+        }
+    } catch (const filesystem_error& e) {
+        unmapTiles();
+        throw runtime_error(string("Coverage directory ") + directory + ", " + e.what());
+    } catch (...) {
+        unmapTiles();
+        throw;
+    }
+}
+
+CoverageMap::~CoverageMap()
+{
+    unmapTiles();
+}
+
+double CoverageMap::getResolution() const
+{
+    return resolution;
+}
+
+const string& CoverageMap::getDirectory() const
+{
+    return directory;
+}
+
+uint64_t CoverageMap::tileKey(int64_t tx, int64_t ty)
+{
+    return (uint64_t(uint32_t(tx)) << 32) | uint32_t(ty);
+}
+
+string CoverageMap::tileName(uint64_t key)
+{
+    return to_string(int32_t(key >> 32)) + "_" + to_string(int32_t(key & 0xffffffff));
+}
+
+void CoverageMap::mapTile(int64_t tx, int64_t ty)
+{
+    void* cells;
+    if (directory.empty()) {
+        cells = mmap(nullptr, TILE_BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    } else {
+        string file = (path(directory) / (tileName(tileKey(tx, ty)) + ".tile")).string();
+        int fd = open(file.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) throw runtime_error("Can not open coverage tile " + file);
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t(st.st_size) != TILE_BYTES && ftruncate(fd, TILE_BYTES) != 0)) {
+            close(fd);
+            throw runtime_error("Can not size coverage tile " + file);
+        }
+        cells = mmap(nullptr, TILE_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+    }
+    if (cells == MAP_FAILED) throw runtime_error("Can not map coverage tile " + tileName(tileKey(tx, ty)));
+    tiles[tileKey(tx, ty)] = Tile{static_cast<uint8_t*>(cells), tx, ty};
+}
+
+void CoverageMap::unmapTiles()
+{
+    for (auto& [key, t]: tiles) {
+        munmap(t.cells, TILE_BYTES);
+    }
+    tiles.clear();
+}
+
+CoverageMap::Tile& CoverageMap::tile(int64_t tx, int64_t ty)
+{
+    auto it = tiles.find(tileKey(tx, ty));
+    if (it != tiles.end()) return it->second;
+    mapTile(tx, ty);
+    return tiles[tileKey(tx, ty)];
+}
+
+const CoverageMap::Tile* CoverageMap::findTile(int64_t tx, int64_t ty) const
+{
+    auto it = tiles.find(tileKey(tx, ty));
+    return it == tiles.end() ? nullptr : &it->second;
+}
+
+int CoverageMap::count(double x, double y) const
+{
+    int64_t i = floor(x / resolution);
+    int64_t j = floor(y / resolution);
+    const Tile* t = findTile(i >> TILE_SHIFT, j >> TILE_SHIFT);
+    if (!t) return 0;
+    return t->cells[(j & (COVERAGE_TILE_SIZE - 1)) * COVERAGE_TILE_SIZE + (i & (COVERAGE_TILE_SIZE - 1))];
+}
+
+template<typename F>
+void CoverageMap::forEachCell(const bgPolygon2D& area, const bgPolygon2D* exclude, F f) const
+{
+    if (area.outer().size() < 3) return;
+
+    boost::geometry::model::box<bgPoint2D> box;
+    boost::geometry::envelope(area, box);
+    // cell (i, j) has its center at ((i + 0.5) * resolution, (j + 0.5) * resolution)
+    int64_t jMin = ceil(box.min_corner().y() / resolution - 0.5);
+    int64_t jMax = int64_t(ceil(box.max_corner().y() / resolution - 0.5)) - 1;
+    for (int64_t j = jMin; j <= jMax; j++) {
+        double y = (j + 0.5) * resolution;
+        double x0, x1;
+        if (!span(area, y, x0, x1)) continue;
+        int64_t iMin = ceil(x0 / resolution - 0.5);
+        int64_t iMax = int64_t(ceil(x1 / resolution - 0.5)) - 1;
+
+        int64_t eMin = 1, eMax = 0;
+        double e0, e1;
+        if (exclude && span(*exclude, y, e0, e1)) {
+            eMin = ceil(e0 / resolution - 0.5);
+            eMax = int64_t(ceil(e1 / resolution - 0.5)) - 1;
+        }
+        for (int64_t i = iMin; i <= iMax; i++) {
+            if (i >= eMin && i <= eMax) {
+                i = eMax;
+                continue;
+            }
+            f(i, j);
+        }
+    }
+}
+
+bgPolygon2D CoverageMap::sweptArea(int sweep, const bgPolygon2D& footprint, const bgPolygon2D*& previous) const
+{
+    previous = nullptr;
+    auto it = sweeps.find(sweep);
+    if (it == sweeps.end()) return footprint;
+
+    boost::geometry::model::multi_point<bgPoint2D> points;
+    points.insert(points.end(), it->second.outer().begin(), it->second.outer().end());
+    points.insert(points.end(), footprint.outer().begin(), footprint.outer().end());
+    bgPolygon2D hull;
+    boost::geometry::convex_hull(points, hull);
+
+    boost::geometry::model::box<bgPoint2D> box;
+    boost::geometry::envelope(hull, box);
+    double cells = ((box.max_corner().x() - box.min_corner().x()) / resolution + 1.0) *
+                   ((box.max_corner().y() - box.min_corner().y()) / resolution + 1.0);
+    if (cells > COVERAGE_MAX_SWEEP_CELLS) return footprint;
+
+    previous = &it->second;
+    return hull;
+}
+
+double CoverageMap::overlap(int sweep, const bgPolygon2D& footprint) const
+{
+    const bgPolygon2D* previous;
+    bgPolygon2D area = sweptArea(sweep, footprint, previous);
+
+    size_t cells = 0, covered = 0;
+    forEachCell(area, previous, [&](int64_t i, int64_t j) {
+        cells++;
+        const Tile* t = findTile(i >> TILE_SHIFT, j >> TILE_SHIFT);
+        if (t && t->cells[(j & (COVERAGE_TILE_SIZE - 1)) * COVERAGE_TILE_SIZE + (i & (COVERAGE_TILE_SIZE - 1))] > 0) {
+            covered++;
+        }
+    });
+    return cells ? double(covered) / cells : 0.0;
+}
+
+size_t CoverageMap::cover(int sweep, const bgPolygon2D& footprint)
+{
+    const bgPolygon2D* previous;
+    bgPolygon2D area = sweptArea(sweep, footprint, previous);
+
+    size_t cells = 0;
+    Tile* t = nullptr;
+    forEachCell(area, previous, [&](int64_t i, int64_t j) {
+        int64_t tx = i >> TILE_SHIFT, ty = j >> TILE_SHIFT;
+        if (!t || t->tx != tx || t->ty != ty) {
+            t = &tile(tx, ty);
+            changedTiles.insert(tileKey(tx, ty));
+        }
+        uint8_t& cell = t->cells[(j & (COVERAGE_TILE_SIZE - 1)) * COVERAGE_TILE_SIZE + (i & (COVERAGE_TILE_SIZE - 1))];
+        if (cell < UINT8_MAX) cell++;
+        cells++;
+    });
+    sweeps[sweep] = footprint;
+    return cells;
+}
+
+void CoverageMap::lift(int sweep)
+{
+    sweeps.erase(sweep);
+}
+
+void CoverageMap::clear()
+{
+    unmapTiles();
+    changedTiles.clear();
+    sweeps.clear();
+    if (directory.empty()) return;
+
+    vector<path> files;
+    for (const directory_entry& entry: directory_iterator(directory)) {
+        int64_t tx, ty;
+        if (isTileFile(entry.path(), tx, ty)) {
+            files.push_back(entry.path());
+        }
+    }
+    for (const path& file: files) {
+        boost::filesystem::remove(file);
+    }
+}
+
+vector<uint64_t> CoverageMap::getTiles() const
+{
+    vector<uint64_t> keys;
+    for (const auto& [key, t]: tiles) {
+        keys.push_back(key);
+    }
+    sort(keys.begin(), keys.end());
+    return keys;
+}
+
+vector<uint64_t> CoverageMap::takeChangedTiles(size_t count)
+{
+    auto last = changedTiles.begin();
+    std::advance(last, min(count, changedTiles.size()));
+    vector<uint64_t> keys(changedTiles.begin(), last);
+    changedTiles.erase(changedTiles.begin(), last);
+    return keys;
+}
+
+json CoverageMap::exportTile(uint64_t key) const
+{
+    auto it = tiles.find(key);
+    if (it == tiles.end()) return json();
+
+    const Tile& t = it->second;
+    json j;
+    j["x"] = t.tx * COVERAGE_TILE_SIZE * resolution;
+    j["y"] = t.ty * COVERAGE_TILE_SIZE * resolution;
+    j["resolution"] = resolution;
+    j["size"] = COVERAGE_TILE_SIZE;
+    j["counts"] = base64_encode(t.cells, TILE_BYTES);
+    return j;
+}
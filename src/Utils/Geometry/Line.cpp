@@ -266,10 +266,19 @@ Point Line::intersection(Line line)
 
 vector<PointPtr> Line::interpolate(double interpolationDistance, bool curvy) const
 {
-    vector<PointPtr> interpolation;
+    vector<PointPtr> interpolation(interpolationLength(interpolationDistance));
+    interpolate(interpolationDistance, interpolation.begin(), curvy);
+    return interpolation;
+}
+
+int Line::interpolationLength(double interpolationDistance) const
+{
+    return int(pointStart.distance(pointStop)/interpolationDistance);
+}
 
-    double d = pointStart.distance(pointStop);
-    int num = int(d/interpolationDistance);
+void Line::interpolate(double interpolationDistance, vector<PointPtr>::iterator output, bool curvy, double radius) const
+{
+    int num = interpolationLength(interpolationDistance);
     double dx = (pointStop.x() - pointStart.x()) / num;
     double dy = (pointStop.y() - pointStart.y()) / num;
 
@@ -277,13 +286,11 @@ vector<PointPtr> Line::interpolate(double interpolationDistance, bool curvy) con
         double x = pointStart.x() + j * dx;
         double y = pointStart.y() + j * dy;
         if (curvy) {
-            interpolation.push_back(make_shared<CurvyPoint>(x, y));
+            *output++ = make_shared<CurvyPoint>(x, y, radius);
         } else {
-            interpolation.push_back(make_shared<Point>(x,y));
+            *output++ = make_shared<Point>(x,y);
         }
     }
-
-    return interpolation;
 }
 
 double Line::length() const
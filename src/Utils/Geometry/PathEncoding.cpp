@@ -0,0 +1,86 @@
+#include <Utils/Geometry/PathEncoding.h>
+#include <cmath>
+#include <stdexcept>
+
+using namespace Ilvo::Utils::Geometry;
+
+using namespace std;
+
+
+PathEncoder::PathEncoder(const Point& origin, int precision) :
+    origin(origin),
+    factor(pow(10.0, precision)),
+    previousX(0),
+    previousY(0)
+{
+}
+
+void PathEncoder::addValue(long long value)
+{
+    // zigzag, the sign in the lowest bit
+    unsigned long long v = (value < 0) ? ~((unsigned long long)value << 1) : ((unsigned long long)value << 1);
+    while (v >= 0x20) {
+        encoded.push_back(char((0x20 | (v & 0x1f)) + 63));
+        v >>= 5;
+    }
+    encoded.push_back(char(v + 63));
+}
+
+void PathEncoder::add(double x, double y)
+{
+    long long qx = llround((x - origin.x()) * factor);
+    long long qy = llround((y - origin.y()) * factor);
+    addValue(qx - previousX);
+    addValue(qy - previousY);
+    previousX = qx;
+    previousY = qy;
+}
+
+void PathEncoder::add(const Point& point)
+{
+    add(point.x(), point.y());
+}
+
+size_t PathEncoder::size() const
+{
+    return encoded.size();
+}
+
+const string& PathEncoder::str() const
+{
+    return encoded;
+}
+
+string Ilvo::Utils::Geometry::encodePath(const vector<PointPtr>& points, const Point& origin, int precision)
+{
+    PathEncoder encoder(origin, precision);
+    for (const PointPtr& p: points) {
+        encoder.add(*p);
+    }
+    return encoder.str();
+}
+
+vector<Point> Ilvo::Utils::Geometry::decodePath(const string& encoded, const Point& origin, int precision)
+{
+    const double factor = pow(10.0, precision);
+    vector<Point> points;
+    long long value[2] = {0, 0};
+    size_t i = 0;
+    while (i < encoded.size()) {
+        for (int c = 0; c < 2; c++) {
+            unsigned long long v = 0;
+            int shift = 0;
+            int chunk;
+            do {
+                if (i >= encoded.size()) throw invalid_argument("Encoded path ends in the middle of a point");
+                chunk = encoded[i++] - 63;
+                if (chunk < 0 || chunk > 63 || shift > 60) throw invalid_argument("Invalid character in encoded path");
+                v |= (unsigned long long)(chunk & 0x1f) << shift;
+                shift += 5;
+            } while (chunk >= 0x20);
+            value[c] += (v & 1) ? ~(long long)(v >> 1) : (long long)(v >> 1);
+        }
+        points.emplace_back(origin.x() + value[0] / factor, origin.y() + value[1] / factor);
+    }
+    return points;
+}
@@ -0,0 +1,103 @@
+#include <Utils/Geometry/PathMatcher.h>
+#include <Utils/Settings/TaskPool.h>
+#include <boost/geometry/algorithms/distance.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace Ilvo::Utils::Geometry;
+using namespace Ilvo::Utils::Settings;
+
+using namespace std;
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+
+PathMatcher::PathMatcher() {}
+
+PathMatcher::PathMatcher(const vector<PointPtr>& path)
+{
+    vertices.reserve(path.size());
+    cumulative.reserve(path.size());
+    for (const PointPtr& p: path) {
+        double along = vertices.empty() ? 0.0 : cumulative.back() + bg::distance(vertices.back(), p->geometry());
+        vertices.push_back(p->geometry());
+        cumulative.push_back(along);
+    }
+
+    // pack the boxes of the segments at once
+    vector<SegmentBox> boxes;
+    boxes.reserve(vertices.size());
+    for (int i = 0; i < int(vertices.size())-1; i++) {
+        bgBox box(bgPoint2D(min(vertices[i].x(), vertices[i+1].x()), min(vertices[i].y(), vertices[i+1].y())),
+                  bgPoint2D(max(vertices[i].x(), vertices[i+1].x()), max(vertices[i].y(), vertices[i+1].y())));
+        boxes.emplace_back(box, i);
+    }
+    segments = decltype(segments)(boxes);
+}
+
+bool PathMatcher::empty() const
+{
+    return vertices.empty();
+}
+
+double PathMatcher::length() const
+{
+    return cumulative.empty() ? 0.0 : cumulative.back();
+}
+
+PathMatch PathMatcher::project(const bgPoint2D& point, int index) const
+{
+    const bgPoint2D& a = vertices[index];
+    const bgPoint2D& b = vertices[index+1];
+    double dx = b.x() - a.x();
+    double dy = b.y() - a.y();
+    double length2 = dx*dx + dy*dy;
+    double t = (length2 > 0.0) ? ((point.x() - a.x())*dx + (point.y() - a.y())*dy) / length2 : 0.0;
+    t = clamp(t, 0.0, 1.0);
+
+    PathMatch m;
+    m.index = index;
+    m.point = Point(a.x() + t*dx, a.y() + t*dy);
+    m.along = cumulative[index] + t * (cumulative[index+1] - cumulative[index]);
+    double distance = bg::distance(point, m.point.geometry());
+    // left of the segment when the cross product is positive
+    m.offset = (dx * (point.y() - a.y()) - dy * (point.x() - a.x()) > 0) ? distance : -distance;
+    return m;
+}
+
+PathMatch PathMatcher::match(const Point& point) const
+{
+    PathMatch best;
+    if (vertices.size() == 1) {
+        best.point = Point(vertices[0].x(), vertices[0].y());
+        best.offset = point.distance(best.point);
+    }
+    if (vertices.size() < 2) return best;
+
+    // the boxes come closest first, their distance is a lower bound of the distance to the segment
+    const bgPoint2D& p = point.geometry();
+    double bestDistance = INFINITY;
+    for (auto it = segments.qbegin(bgi::nearest(p, segments.size())); it != segments.qend(); ++it) {
+        if (bg::distance(p, it->first) > bestDistance) break;
+        PathMatch m = project(p, it->second);
+        double distance = abs(m.offset);
+        if (distance < bestDistance || (distance == bestDistance && m.index < best.index)) {
+            best = m;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+vector<PathMatch> PathMatcher::match(const vector<PointPtr>& points) const
+{
+    vector<PathMatch> matches(points.size());
+    TaskPool::getInstance().parallelFor(points.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            matches[i] = match(*points[i]);
+        }
+    }, 256);
+    return matches;
+}
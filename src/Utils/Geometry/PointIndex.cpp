@@ -0,0 +1,178 @@
+#include <Utils/Geometry/PointIndex.h>
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+
+using namespace Ilvo::Utils::Geometry;
+
+using namespace std;
+
+
+PointIndex::PointIndex() :
+    x0(0.0),
+    y0(0.0),
+    cellSize(1.0),
+    nx(0),
+    ny(0),
+    cellStart(1, 0)
+{
+}
+
+PointIndex::PointIndex(const vector<PointPtr>& points) :
+    PointIndex()
+{
+    const int n = points.size();
+    if (n == 0) return;
+
+    double x1 = -INFINITY, y1 = -INFINITY;
+    x0 = INFINITY;
+    y0 = INFINITY;
+    for (const PointPtr& p: points) {
+        x0 = min(x0, p->x());
+        y0 = min(y0, p->y());
+        x1 = max(x1, p->x());
+        y1 = max(y1, p->y());
+    }
+
+    // about two points per cell, a line of points gets cells along its length
+    double width = x1 - x0, height = y1 - y0;
+    if (width > 0.0 && height > 0.0) {
+        cellSize = sqrt(2.0 * width * height / n);
+    } else if (max(width, height) > 0.0) {
+        cellSize = 2.0 * max(width, height) / n;
+    }
+    // at most four cells per point
+    const long long maxCells = 4LL * n + 16;
+    auto cells = [&]() { return (long long)(width / cellSize + 1) * (long long)(height / cellSize + 1); };
+    while (cells() > maxCells) cellSize *= 1.5;
+    nx = int(width / cellSize) + 1;
+    ny = int(height / cellSize) + 1;
+
+    // counting sort of the points on their cell
+    vector<int> cell(n);
+    cellStart.assign(nx * ny + 1, 0);
+    for (int i = 0; i < n; i++) {
+        cell[i] = cellY(points[i]->y()) * nx + cellX(points[i]->x());
+        cellStart[cell[i] + 1]++;
+    }
+    for (int c = 0; c < nx * ny; c++) {
+        cellStart[c + 1] += cellStart[c];
+    }
+    xs.resize(n);
+    ys.resize(n);
+    ids.resize(n);
+    vector<int> fill(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < n; i++) {
+        int j = fill[cell[i]]++;
+        xs[j] = points[i]->x();
+        ys[j] = points[i]->y();
+        ids[j] = i;
+    }
+}
+
+int PointIndex::cellX(double x) const
+{
+    return int(clamp(floor((x - x0) / cellSize), 0.0, double(nx - 1)));
+}
+
+int PointIndex::cellY(double y) const
+{
+    return int(clamp(floor((y - y0) / cellSize), 0.0, double(ny - 1)));
+}
+
+size_t PointIndex::size() const
+{
+    return ids.size();
+}
+
+bool PointIndex::empty() const
+{
+    return ids.empty();
+}
+
+void PointIndex::inBox(double minX, double minY, double maxX, double maxY, vector<int>& result) const
+{
+    result.clear();
+    if (empty() || minX > maxX || minY > maxY) return;
+
+    const int cx0 = cellX(minX), cx1 = cellX(maxX);
+    for (int cy = cellY(minY); cy <= cellY(maxY); cy++) {
+        // the cells of a row are contiguous
+        for (int j = cellStart[cy * nx + cx0]; j < cellStart[cy * nx + cx1 + 1]; j++) {
+            if (xs[j] >= minX && xs[j] <= maxX && ys[j] >= minY && ys[j] <= maxY) {
+                result.push_back(ids[j]);
+            }
+        }
+    }
+    sort(result.begin(), result.end());
+}
+
+void PointIndex::inRadius(const Point& center, double radius, vector<int>& result) const
+{
+    result.clear();
+    if (empty() || radius < 0.0) return;
+
+    const double r2 = radius * radius;
+    const int cx0 = cellX(center.x() - radius), cx1 = cellX(center.x() + radius);
+    for (int cy = cellY(center.y() - radius); cy <= cellY(center.y() + radius); cy++) {
+        for (int j = cellStart[cy * nx + cx0]; j < cellStart[cy * nx + cx1 + 1]; j++) {
+            double dx = xs[j] - center.x(), dy = ys[j] - center.y();
+            if (dx * dx + dy * dy <= r2) {
+                result.push_back(ids[j]);
+            }
+        }
+    }
+    sort(result.begin(), result.end());
+}
+
+vector<int> PointIndex::nearest(const Point& point, int k) const
+{
+    k = min<int>(k, size());
+    if (k <= 0) return {};
+
+    // max-heap of the k closest points so far on (squared distance, index)
+    priority_queue<pair<double, int>> closest;
+    auto visit = [&](int c) {
+        for (int j = cellStart[c]; j < cellStart[c + 1]; j++) {
+            double dx = xs[j] - point.x(), dy = ys[j] - point.y();
+            pair<double, int> candidate(dx * dx + dy * dy, ids[j]);
+            if (int(closest.size()) < k) {
+                closest.push(candidate);
+            } else if (candidate < closest.top()) {
+                closest.pop();
+                closest.push(candidate);
+            }
+        }
+    };
+
+    // rings of cells around the cell of the point, until the unvisited cells are further than the k-th point
+    const int cx = cellX(point.x()), cy = cellY(point.y());
+    for (int r = 0; ; r++) {
+        int left = cx - r, right = cx + r, bottom = cy - r, top = cy + r;
+        for (int y = max(bottom, 0); y <= min(top, ny - 1); y++) {
+            if (y == bottom || y == top) {
+                for (int x = max(left, 0); x <= min(right, nx - 1); x++) visit(y * nx + x);
+            } else {
+                if (left >= 0) visit(y * nx + left);
+                if (right < nx) visit(y * nx + right);
+            }
+        }
+
+        // distance from the point to the cells outside the ring, the sides on the border of the grid have none
+        double bound = INFINITY;
+        if (left > 0) bound = min(bound, point.x() - (x0 + left * cellSize));
+        if (right < nx - 1) bound = min(bound, x0 + (right + 1) * cellSize - point.x());
+        if (bottom > 0) bound = min(bound, point.y() - (y0 + bottom * cellSize));
+        if (top < ny - 1) bound = min(bound, y0 + (top + 1) * cellSize - point.y());
+        if (bound == INFINITY) break;
+        if (int(closest.size()) == k && bound > 0.0 && closest.top().first < bound * bound) break;
+    }
+
+    vector<int> result(k);
+    for (int i = k - 1; i >= 0; i--) {
+        result[i] = closest.top().second;
+        closest.pop();
+    }
+    return result;
+}
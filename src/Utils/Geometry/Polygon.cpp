@@ -1,5 +1,6 @@
 #include <Utils/Geometry/Polygon.h>
 #include <Utils/Geometry/Point.h>
+#include <Utils/Geometry/UtmProjection.h>
 #include <boost/geometry/algorithms/centroid.hpp>
 #include <vector>
 #include <ThirdParty/Eigen/Dense>
@@ -61,7 +62,7 @@ json Polygon::toJson() const
     return j;
 }
 
-void Polygon::update(TransformMatrix transform, double width, double height)
+void Polygon::update(const TransformMatrix& transform, double width, double height)
 {
     // Check the input validity
     if (width <= 0) {
@@ -72,14 +73,14 @@ void Polygon::update(TransformMatrix transform, double width, double height)
     }
 
     // Define the points of the polygon
-    MatrixXd points(5, 4);
+    Matrix<double, 5, 4> points;
     points << -width / 2, -height / 2, 0, 1.0,
               width / 2, -height / 2, 0, 1.0,
               width / 2, height / 2, 0, 1.0,
               -width / 2, height / 2, 0, 1.0,
               -width / 2, -height / 2, 0, 1.0;  // Closing the polygon by repeating the first point
 
-    MatrixXd transformed_points = points * transform.matrix().transpose();
+    Matrix<double, 5, 4> transformed_points = points * transform.matrix().transpose();
 
     // Create the polygon
     p.outer().clear();
@@ -88,7 +89,7 @@ void Polygon::update(TransformMatrix transform, double width, double height)
     }
 }
 
-void Polygon::update(TransformMatrix transform, double width, double up, double down)
+void Polygon::update(const TransformMatrix& transform, double width, double up, double down)
 {
     // Check the input validity
     if (width <= 0) {
@@ -96,14 +97,14 @@ void Polygon::update(TransformMatrix transform, double width, double up, double
     }
 
     // Define the points of the polygon
-    MatrixXd points(5, 4);
+    Matrix<double, 5, 4> points;
     points << -width / 2, down, 0, 1.0,
               width / 2, down, 0, 1.0,
               width / 2, up, 0, 1.0,
               -width / 2, up, 0, 1.0,
               -width / 2, down, 0, 1.0;  // Closing the polygon by repeating the first point
 
-    MatrixXd transformed_points = points * transform.matrix().transpose();
+    Matrix<double, 5, 4> transformed_points = points * transform.matrix().transpose();
 
     // Create the polygon
     p.outer().clear();
@@ -112,13 +113,43 @@ void Polygon::update(TransformMatrix transform, double width, double up, double
     }
 }
 
+void Polygon::update(const Matrix<double, 2, 4>& corners)
+{
+    auto& ring = p.outer();
+    ring.resize(5);
+    for (int i = 0; i < 4; i++) {
+        ring[i] = bgPoint2D(corners(0, i), corners(1, i));
+    }
+    ring[4] = ring[0];
+}
+
 void Polygon::contour(vector<vector<double>>& robotLatLng, vector<vector<double>>& robotXY, int zone) const {
-    for (auto point: geometry().outer()) {
-        robotXY.push_back({point.x(), point.y()});
-        double lat, lng;
-        if ((1 <= zone) && (zone <= 60)) {
-            UTMXYToLatLon(point.x(), point.y(), zone, false, lat, lng);
-            robotLatLng.push_back({RadToDeg(lat), RadToDeg(lng)});
+    size_t n = geometry().outer().size();
+    vector<double> x(n), y(n);
+    for (size_t i = 0; i < n; i++) {
+        x[i] = geometry().outer()[i].x();
+        y[i] = geometry().outer()[i].y();
+        robotXY.push_back({x[i], y[i]});
+    }
+    if (UtmProjection::isValidZone(zone)) {
+        vector<double> lat(n), lng(n);
+        UtmProjection::get(zone).toLatLon(x.data(), y.data(), lat.data(), lng.data(), n);
+        for (size_t i = 0; i < n; i++) {
+            robotLatLng.push_back({lat[i], lng[i]});
         }
     }
+}
+
+void Polygon::contour(vector<vector<double>>& robotLatLng, vector<vector<double>>& robotXY, const LocalTangentPlane& plane) const {
+    size_t n = geometry().outer().size();
+    vector<double> x(n), y(n), lat(n), lng(n);
+    for (size_t i = 0; i < n; i++) {
+        x[i] = geometry().outer()[i].x();
+        y[i] = geometry().outer()[i].y();
+        robotXY.push_back({x[i], y[i]});
+    }
+    plane.toLatLon(x.data(), y.data(), lat.data(), lng.data(), n);
+    for (size_t i = 0; i < n; i++) {
+        robotLatLng.push_back({lat[i], lng[i]});
+    }
 }
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include <Utils/Geometry/UtmProjection.h>
+#include <ThirdParty/UTM.hpp>
+#include <stdexcept>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+using namespace Ilvo::Utils::Geometry;
+using namespace std;
+
+namespace {
+    const double degPerRad = 180.0 / pi;
+    const double radPerDeg = pi / 180.0;
+    /** @brief Meters per degree latitude, used to express the tangent plane error in meters */
+    const double metersPerDeg = 111320.0;
+
+    /** @brief sin(2a), sin(4a), sin(6a) and sin(8a) from one sin/cos evaluation */
+    inline void multipleAngleSines(double a, double& s2, double& s4, double& s6, double& s8)
+    {
+        s2 = sin(2.0 * a);
+        double c2 = cos(2.0 * a);
+        s4 = 2.0 * s2 * c2;
+        double c4 = 1.0 - 2.0 * s2 * s2;
+        s6 = s4 * c2 + c4 * s2;
+        s8 = 2.0 * s4 * c4;
+    }
+}
+
+
+UtmProjection::UtmProjection(int zone, bool southhemi) :
+    zone(zone),
+    southhemi(southhemi)
+{
+    if (!isValidZone(zone)) {
+        throw invalid_argument("UTM zone must be in [1, 60], but was " + to_string(zone));
+    }
+    lambda0 = UTMCentralMeridian(zone);
+    ep2 = (sm_a * sm_a - sm_b * sm_b) / (sm_b * sm_b);
+
+    double n = (sm_a - sm_b) / (sm_a + sm_b);
+    double n2 = n * n, n3 = n2 * n, n4 = n3 * n, n5 = n4 * n;
+
+    // ArcLengthOfMeridian
+    alpha = ((sm_a + sm_b) / 2.0) * (1.0 + n2 / 4.0 + n4 / 64.0);
+    beta = (-3.0 * n / 2.0) + (9.0 * n3 / 16.0) + (-3.0 * n5 / 32.0);
+    gamma = (15.0 * n2 / 16.0) + (-15.0 * n4 / 32.0);
+    delta = (-35.0 * n3 / 48.0) + (105.0 * n5 / 256.0);
+    epsilon = (315.0 * n4 / 512.0);
+
+    // FootpointLatitude
+    alpha_ = alpha;
+    beta_ = (3.0 * n / 2.0) + (-27.0 * n3 / 32.0) + (269.0 * n5 / 512.0);
+    gamma_ = (21.0 * n2 / 16.0) + (-55.0 * n4 / 32.0);
+    delta_ = (151.0 * n3 / 96.0) + (-417.0 * n5 / 128.0);
+    epsilon_ = (1097.0 * n4 / 512.0);
+}
+
+const UtmProjection& UtmProjection::get(int zone)
+{
+    static const vector<UtmProjection> projections = [] {
+        vector<UtmProjection> v;
+        v.reserve(60);
+        for (int z = 1; z <= 60; z++) v.emplace_back(z);
+        return v;
+    }();
+
+    if (!isValidZone(zone)) {
+        throw invalid_argument("UTM zone must be in [1, 60], but was " + to_string(zone));
+    }
+    return projections[zone - 1];
+}
+
+int UtmProjection::zoneOf(double lon)
+{
+    return floor((lon + 180.0) / 6) + 1;
+}
+
+bool UtmProjection::isValidZone(int zone)
+{
+    return (1 <= zone) && (zone <= 60);
+}
+
+int UtmProjection::getZone() const
+{
+    return zone;
+}
+
+void UtmProjection::toLatLon(const double* x, const double* y, double* lat, double* lon, size_t n) const
+{
+    const double falseNorthing = southhemi ? 10000000.0 : 0.0;
+    const double a2b = (sm_a * sm_a) / sm_b;
+
+    for (size_t i = 0; i < n; i++) {
+        double xi = (x[i] - 500000.0) / UTMScaleFactor;
+        double yi = (y[i] - falseNorthing) / UTMScaleFactor;
+
+        // footpoint latitude
+        double y_ = yi / alpha_;
+        double s2, s4, s6, s8;
+        multipleAngleSines(y_, s2, s4, s6, s8);
+        double phif = y_ + beta_ * s2 + gamma_ * s4 + delta_ * s6 + epsilon_ * s8;
+
+        double cf = cos(phif);
+        double tf = tan(phif);
+        double nuf2 = ep2 * cf * cf;
+        double Nf = a2b / sqrt(1.0 + nuf2);
+        double tf2 = tf * tf;
+        double tf4 = tf2 * tf2;
+        double nuf4 = nuf2 * nuf2;
+
+        // powers of x / Nf
+        double u = xi / Nf;
+        double u2 = u * u, u3 = u2 * u, u4 = u3 * u, u5 = u4 * u, u6 = u5 * u, u7 = u6 * u, u8 = u7 * u;
+
+        double x2poly = -1.0 - nuf2;
+        double x3poly = -1.0 - 2.0 * tf2 - nuf2;
+        double x4poly = 5.0 + 3.0 * tf2 + 6.0 * nuf2 - 6.0 * tf2 * nuf2 - 3.0 * nuf4 - 9.0 * tf2 * nuf4;
+        double x5poly = 5.0 + 28.0 * tf2 + 24.0 * tf4 + 6.0 * nuf2 + 8.0 * tf2 * nuf2;
+        double x6poly = -61.0 - 90.0 * tf2 - 45.0 * tf4 - 107.0 * nuf2 + 162.0 * tf2 * nuf2;
+        double x7poly = -61.0 - 662.0 * tf2 - 1320.0 * tf4 - 720.0 * (tf4 * tf2);
+        double x8poly = 1385.0 + 3633.0 * tf2 + 4095.0 * tf4 + 1575.0 * (tf4 * tf2);
+
+        double phi = phif + tf * (x2poly * u2 / 2.0 + x4poly * u4 / 24.0 + x6poly * u6 / 720.0 + x8poly * u8 / 40320.0);
+        double lambda = lambda0 + (u + x3poly * u3 / 6.0 + x5poly * u5 / 120.0 + x7poly * u7 / 5040.0) / cf;
+
+        lat[i] = phi * degPerRad;
+        lon[i] = lambda * degPerRad;
+    }
+}
+
+void UtmProjection::toUtm(const double* lat, const double* lon, double* x, double* y, size_t n) const
+{
+    const double a2b = (sm_a * sm_a) / sm_b;
+
+    for (size_t i = 0; i < n; i++) {
+        double phi = lat[i] * radPerDeg;
+        double l = lon[i] * radPerDeg - lambda0;
+
+        double c = cos(phi);
+        double t = tan(phi);
+        double nu2 = ep2 * c * c;
+        double N = a2b / sqrt(1.0 + nu2);
+        double t2 = t * t;
+
+        double l3coef = 1.0 - t2 + nu2;
+        double l4coef = 5.0 - t2 + 9.0 * nu2 + 4.0 * (nu2 * nu2);
+        double l5coef = 5.0 - 18.0 * t2 + (t2 * t2) + 14.0 * nu2 - 58.0 * t2 * nu2;
+        double l6coef = 61.0 - 58.0 * t2 + (t2 * t2) + 270.0 * nu2 - 330.0 * t2 * nu2;
+        double l7coef = 61.0 - 479.0 * t2 + 179.0 * (t2 * t2) - (t2 * t2 * t2);
+        double l8coef = 1385.0 - 3111.0 * t2 + 543.0 * (t2 * t2) - (t2 * t2 * t2);
+
+        // powers of l * cos(phi)
+        double v = l * c;
+        double v2 = v * v, v3 = v2 * v, v4 = v3 * v, v5 = v4 * v, v6 = v5 * v, v7 = v6 * v, v8 = v7 * v;
+
+        double s2, s4, s6, s8;
+        multipleAngleSines(phi, s2, s4, s6, s8);
+        double arcLength = alpha * (phi + beta * s2 + gamma * s4 + delta * s6 + epsilon * s8);
+
+        double xi = N * (v + l3coef * v3 / 6.0 + l5coef * v5 / 120.0 + l7coef * v7 / 5040.0);
+        double yi = arcLength + t * N * (v2 / 2.0 + l4coef * v4 / 24.0 + l6coef * v6 / 720.0 + l8coef * v8 / 40320.0);
+
+        x[i] = xi * UTMScaleFactor + 500000.0;
+        yi = yi * UTMScaleFactor;
+        y[i] = yi + (yi < 0.0) * 10000000.0;
+    }
+}
+
+void UtmProjection::toLatLon(double x, double y, double& lat, double& lon) const
+{
+    toLatLon(&x, &y, &lat, &lon, 1);
+}
+
+void UtmProjection::toUtm(double lat, double lon, double& x, double& y) const
+{
+    toUtm(&lat, &lon, &x, &y, 1);
+}
+
+
+LocalTangentPlane::LocalTangentPlane(const UtmProjection& projection, double x0, double y0, double radius, double tolerance) :
+    projection(projection),
+    x0(x0),
+    y0(y0),
+    radius(radius)
+{
+    // central differences of the exact projection on a 3x3 stencil
+    const double h = min(radius, 10.0);
+    double xs[9], ys[9], lats[9], lons[9];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            xs[3 * i + j] = x0 + (i - 1) * h;
+            ys[3 * i + j] = y0 + (j - 1) * h;
+        }
+    }
+    projection.toLatLon(xs, ys, lats, lons, 9);
+    lat0 = lats[4];
+    lon0 = lons[4];
+
+    auto fit = [h](const double* f, double* c) {
+        // f[3*i+j] = f(x0 + (i-1)h, y0 + (j-1)h)
+        c[0] = (f[7] - f[1]) / (2.0 * h);
+        c[1] = (f[5] - f[3]) / (2.0 * h);
+        c[2] = (f[7] - 2.0 * f[4] + f[1]) / (2.0 * h * h);
+        c[3] = (f[8] - f[6] - f[2] + f[0]) / (4.0 * h * h);
+        c[4] = (f[5] - 2.0 * f[4] + f[3]) / (2.0 * h * h);
+    };
+    fit(lats, cLat);
+    fit(lons, cLon);
+
+    // measure the error on the boundary of the radius, where the approximation is worst
+    const int nCheck = 8;
+    double xc[nCheck], yc[nCheck], latExact[nCheck], lonExact[nCheck], latApprox[nCheck], lonApprox[nCheck];
+    for (int k = 0; k < nCheck; k++) {
+        double angle = 2.0 * pi * k / nCheck;
+        xc[k] = x0 + radius * cos(angle);
+        yc[k] = y0 + radius * sin(angle);
+    }
+    projection.toLatLon(xc, yc, latExact, lonExact, nCheck);
+    valid = true;  // evaluate the approximation itself
+    toLatLon(xc, yc, latApprox, lonApprox, nCheck);
+
+    maxError = 0.0;
+    double cosLat0 = cos(lat0 * radPerDeg);
+    for (int k = 0; k < nCheck; k++) {
+        double dLat = (latApprox[k] - latExact[k]) * metersPerDeg;
+        double dLon = (lonApprox[k] - lonExact[k]) * metersPerDeg * cosLat0;
+        maxError = max(maxError, sqrt(dLat * dLat + dLon * dLon));
+    }
+    valid = maxError <= tolerance;
+}
+
+bool LocalTangentPlane::isValid() const
+{
+    return valid;
+}
+
+double LocalTangentPlane::getMaxError() const
+{
+    return maxError;
+}
+
+void LocalTangentPlane::toLatLon(const double* x, const double* y, double* lat, double* lon, size_t n) const
+{
+    if (!valid) {
+        projection.toLatLon(x, y, lat, lon, n);
+        return;
+    }
+
+    // the tolerance of the boundary check has a small margin for points on the radius
+    const double radius2 = radius * radius * (1.0 + 1e-9);
+    bool outside = false;
+    for (size_t i = 0; i < n; i++) {
+        double dx = x[i] - x0;
+        double dy = y[i] - y0;
+        double dx2 = dx * dx, dxy = dx * dy, dy2 = dy * dy;
+        lat[i] = lat0 + cLat[0] * dx + cLat[1] * dy + cLat[2] * dx2 + cLat[3] * dxy + cLat[4] * dy2;
+        lon[i] = lon0 + cLon[0] * dx + cLon[1] * dy + cLon[2] * dx2 + cLon[3] * dxy + cLon[4] * dy2;
+        outside |= (dx2 + dy2) > radius2;
+    }
+
+    // points outside the radius use the exact projection
+    if (outside) {
+        for (size_t i = 0; i < n; i++) {
+            double dx = x[i] - x0;
+            double dy = y[i] - y0;
+            if (dx * dx + dy * dy > radius2) {
+                projection.toLatLon(x[i], y[i], lat[i], lon[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,255 @@
+#include <Utils/Logging/LatencyTrace.h>
+#include <algorithm>
+#include <fstream>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+using namespace nlohmann;
+
+namespace fs = boost::filesystem;
+
+
+int64_t Ilvo::Utils::Logging::traceNow()
+{
+    return traceTime(chrono::steady_clock::now());
+}
+
+int64_t Ilvo::Utils::Logging::traceTime(chrono::steady_clock::time_point t)
+{
+    return chrono::duration_cast<chrono::microseconds>(t.time_since_epoch()).count();
+}
+
+
+json TraceContext::toJson() const
+{
+    return {{"seq", seq}, {"stamp", stamp}};
+}
+
+TraceContext TraceContext::fromJson(const json& j)
+{
+    TraceContext trace;
+    if (j.is_object() && j.contains("seq") && j.contains("stamp")) {
+        trace.seq = j["seq"].get<int64_t>();
+        trace.stamp = j["stamp"].get<int64_t>();
+    }
+    return trace;
+}
+
+string TraceContext::toString() const
+{
+    return to_string(seq) + ":" + to_string(stamp);
+}
+
+TraceContext TraceContext::fromString(const string& s)
+{
+    TraceContext trace;
+    size_t colon = s.find(':');
+    if (colon == string::npos) return trace;
+    try {
+        trace.seq = stoll(s.substr(0, colon));
+        trace.stamp = stoll(s.substr(colon + 1));
+    } catch (logic_error&) {
+        trace = TraceContext();
+    }
+    return trace;
+}
+
+
+LatencyTracer::LatencyTracer(string name, size_t capacity, size_t window) :
+    name(name),
+    traceDir(fs::path(getenv("ILVO_PATH")) / "logs"),
+    pid(getpid()),
+    tid(syscall(SYS_gettid)),
+    spans(capacity),
+    next(0),
+    count(0),
+    unwritten(false),
+    ages(window),
+    nextAge(0),
+    countAge(0),
+    exporting(false)
+{
+}
+
+LatencyTracer::~LatencyTracer()
+{
+    stopExport();
+}
+
+void LatencyTracer::record(const string& spanName, const TraceContext& trace, int64_t start, int64_t end, TraceFlow flow)
+{
+    lock_guard<mutex> lock(spanMutex);
+    Span& span = spans[next];
+    span.name = spanName;  // reuses the capacity of the previous name
+    span.trace = trace;
+    span.start = start;
+    span.end = end;
+    span.flow = flow;
+    next = (next + 1) % spans.size();
+    count = min(count + 1, spans.size());
+    unwritten = true;
+
+    ages[nextAge] = end - trace.stamp;
+    nextAge = (nextAge + 1) % ages.size();
+    countAge = min(countAge + 1, ages.size());
+}
+
+size_t LatencyTracer::samples() const
+{
+    lock_guard<mutex> lock(spanMutex);
+    return countAge;
+}
+
+json LatencyTracer::histogram() const
+{
+    vector<int64_t> sorted;
+    {
+        lock_guard<mutex> lock(spanMutex);
+        sorted.assign(ages.begin(), ages.begin() + countAge);
+    }
+    sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](double p) {
+        if (sorted.empty()) return 0.0;
+        size_t i = min(sorted.size() - 1, size_t(p * sorted.size()));
+        return sorted[i] / 1000.0;
+    };
+
+    json buckets = json::array();
+    auto begin = sorted.begin();
+    for (double bound: TRACE_LATENCY_BUCKETS) {
+        auto end = upper_bound(begin, sorted.end(), int64_t(bound * 1000));
+        buckets.push_back({{"le", bound}, {"count", end - begin}});
+        begin = end;
+    }
+    buckets.push_back({{"le", "inf"}, {"count", sorted.end() - begin}});
+
+    return {
+        {"count", sorted.size()},
+        {"p50", percentile(0.5)},
+        {"p90", percentile(0.9)},
+        {"p99", percentile(0.99)},
+        {"max", sorted.empty() ? 0.0 : sorted.back() / 1000.0},
+        {"buckets", buckets}
+    };
+}
+
+vector<LatencyTracer::Span> LatencyTracer::orderedSpans() const
+{
+    vector<Span> ordered;
+    ordered.reserve(count);
+    size_t first = (next + spans.size() - count) % spans.size();
+    for (size_t i = 0; i < count; i++) {
+        ordered.push_back(spans[(first + i) % spans.size()]);
+    }
+    return ordered;
+}
+
+json LatencyTracer::toChromeTrace() const
+{
+    vector<Span> ordered;
+    {
+        lock_guard<mutex> lock(spanMutex);
+        ordered = orderedSpans();
+    }
+    return toChromeTrace(ordered);
+}
+
+json LatencyTracer::toChromeTrace(const vector<Span>& ordered) const
+{
+    json events = json::array();
+    events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", pid}, {"tid", tid}, {"args", {{"name", name}}}});
+
+    for (const Span& span: ordered) {
+        events.push_back({
+            {"name", span.name}, {"cat", "latency"}, {"ph", "X"},
+            {"ts", span.start}, {"dur", max<int64_t>(span.end - span.start, 0)},
+            {"pid", pid}, {"tid", tid},
+            {"args", {{"seq", span.trace.seq}, {"age_ms", (span.end - span.trace.stamp) / 1000.0}}}
+        });
+        // flow events bind to the enclosing span, the id links the spans of a fix over the processes
+        const char* phase = span.flow == TraceFlow::BEGIN ? "s" : (span.flow == TraceFlow::END ? "f" : "t");
+        json flow = {
+            {"name", "fix"}, {"cat", "fix"}, {"ph", phase}, {"id", span.trace.seq},
+            {"ts", span.start}, {"pid", pid}, {"tid", tid}
+        };
+        if (span.flow == TraceFlow::END) flow["bp"] = "e";
+        events.push_back(flow);
+    }
+    return {{"traceEvents", events}, {"displayTimeUnit", "ms"}};
+}
+
+fs::path LatencyTracer::getFilePath() const
+{
+    return traceDir / (name + ".trace.json");
+}
+
+bool LatencyTracer::flush()
+{
+    // the spans are copied under the lock, the serialisation and the write do not block record
+    vector<Span> ordered;
+    {
+        lock_guard<mutex> lock(spanMutex);
+        if (!unwritten) return true;
+        unwritten = false;
+        ordered = orderedSpans();
+    }
+
+    // write a temporary file and rename, a viewer never reads a partial trace
+    try {
+        fs::create_directories(traceDir);
+        fs::path tmpPath = traceDir / (name + ".trace.json.tmp");
+        {
+            ofstream out(tmpPath.string(), ofstream::out | ofstream::trunc);
+            out << toChromeTrace(ordered).dump();
+            if (!out) {
+                throw runtime_error("Could not write " + tmpPath.string());
+            }
+        }
+        fs::rename(tmpPath, getFilePath());
+    } catch (exception& e) {
+        // the trace is diagnostic, the owner reports the error
+        lock_guard<mutex> lock(spanMutex);
+        exportError = e.what();
+        return false;
+    }
+    return true;
+}
+
+void LatencyTracer::startExport(chrono::milliseconds period)
+{
+    if (exporter.joinable()) return;
+    exporting = true;
+    exporter = thread([this, period]() {
+        unique_lock<mutex> lock(spanMutex);
+        while (exporting) {
+            exportWake.wait_for(lock, period, [this]() { return !exporting; });
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    });
+}
+
+void LatencyTracer::stopExport()
+{
+    {
+        lock_guard<mutex> lock(spanMutex);
+        exporting = false;
+    }
+    exportWake.notify_all();
+    if (exporter.joinable()) {
+        // the last spans are written before the thread ends
+        exporter.join();
+    }
+}
+
+string LatencyTracer::takeExportError()
+{
+    lock_guard<mutex> lock(spanMutex);
+    string error;
+    swap(error, exportError);
+    return error;
+}
@@ -1,4 +1,5 @@
 #include <Utils/Logging/LoggerStream.h>
+#include <Utils/Logging/Metrics.h>
 
 using namespace Ilvo::Utils::Logging;
 
@@ -8,6 +9,7 @@ namespace fs = boost::filesystem;
 
 // initializing instancePtr with NULL
 std::shared_ptr<LoggerStream> LoggerStream::instancePtr = NULL; 
+thread_local std::shared_ptr<LoggerStream> LoggerStream::threadInstancePtr = NULL;
 
 LoggerStream::LoggerStream(string name, bool terminalOutput) :
     name(name),
@@ -44,7 +46,14 @@ void LoggerStream::createInstance(string name, bool terminalOutput) {
     instancePtr = std::make_shared<LoggerStream>(name, terminalOutput);
 }
 
+void LoggerStream::createThreadInstance(string name, bool terminalOutput) {
+    threadInstancePtr = std::make_shared<LoggerStream>(name, terminalOutput);
+}
+
 LoggerStream& LoggerStream::getInstance() {
+    if (threadInstancePtr != NULL) {
+        return *threadInstancePtr;
+    }
     if (instancePtr == NULL) {  
         throw runtime_error("Logger not initialized");
         // returning the instance pointer
@@ -55,6 +64,18 @@ LoggerStream& LoggerStream::getInstance() {
 }
 
 LoggerStream& LoggerStream::operator<< (LogLevel level) {
+    // the messages are written synchronously, the rate per level replaces a queue depth
+    static MetricCounter* messages[] = {
+        &MetricsRegistry::getInstance().counter("ilvo_log_messages_total", "Logged messages per level.", {{"level", "DEBUG"}}),
+        &MetricsRegistry::getInstance().counter("ilvo_log_messages_total", "Logged messages per level.", {{"level", "INFO"}}),
+        &MetricsRegistry::getInstance().counter("ilvo_log_messages_total", "Logged messages per level.", {{"level", "WARN"}}),
+        &MetricsRegistry::getInstance().counter("ilvo_log_messages_total", "Logged messages per level.", {{"level", "ERROR"}})
+    };
+    messages[level]->inc();
+
+    // localtime and the level names are not thread safe either
+    lock_guard<mutex> lock(streamMutex);
+
     stringstream logHeader;
 
     auto now = std::chrono::system_clock::now();
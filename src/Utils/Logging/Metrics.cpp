@@ -0,0 +1,260 @@
+#include <Utils/Logging/Metrics.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <sstream>
+#include <charconv>
+#include <stdexcept>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+using namespace nlohmann;
+
+namespace {
+    /** @brief Shortest form of the number that reads back the same value, e.g. 0.1 and 1 */
+    string formatValue(double v)
+    {
+        char buffer[32];
+        auto result = to_chars(buffer, buffer + sizeof(buffer), v);
+        return string(buffer, result.ptr);
+    }
+}
+
+
+// MetricHistogram
+MetricHistogram::MetricHistogram(const vector<double>& bounds) :
+    bounds(bounds),
+    counts(new atomic<uint64_t>[bounds.size() + 1])
+{
+    for (size_t i = 0; i <= bounds.size(); i++) {
+        counts[i].store(0, memory_order_relaxed);
+    }
+}
+
+vector<uint64_t> MetricHistogram::cumulativeCounts() const
+{
+    vector<uint64_t> cumulative(bounds.size() + 1);
+    uint64_t total = 0;
+    for (size_t i = 0; i <= bounds.size(); i++) {
+        total += counts[i].load(memory_order_relaxed);
+        cumulative[i] = total;
+    }
+    return cumulative;
+}
+
+
+// MetricsRegistry
+MetricsRegistry& MetricsRegistry::getInstance()
+{
+    static MetricsRegistry instance;
+    return instance;
+}
+
+template<typename T>
+T& MetricsRegistry::add(const string& name, const string& help, Type type, const MetricLabels& labels, function<shared_ptr<T>()> create)
+{
+    lock_guard<std::mutex> lock(mutex);
+    auto it = families.find(name);
+    if (it == families.end()) {
+        it = families.emplace(name, Family{help, type, {}}).first;
+    } else if (it->second.type != type) {
+        throw invalid_argument("Metric " + name + " is registered with another type");
+    }
+    for (auto& metric: it->second.metrics) {
+        if (metric.first == labels) return *static_pointer_cast<T>(metric.second);
+    }
+    shared_ptr<T> metric = create();
+    it->second.metrics.emplace_back(labels, metric);
+    return *metric;
+}
+
+MetricCounter& MetricsRegistry::counter(const string& name, const string& help, const MetricLabels& labels)
+{
+    return add<MetricCounter>(name, help, Type::COUNTER, labels, []() { return make_shared<MetricCounter>(); });
+}
+
+MetricGauge& MetricsRegistry::gauge(const string& name, const string& help, const MetricLabels& labels)
+{
+    return add<MetricGauge>(name, help, Type::GAUGE, labels, []() { return make_shared<MetricGauge>(); });
+}
+
+MetricHistogram& MetricsRegistry::histogram(const string& name, const string& help, const MetricLabels& labels, const vector<double>& bounds)
+{
+    return add<MetricHistogram>(name, help, Type::HISTOGRAM, labels, [&bounds]() { return make_shared<MetricHistogram>(bounds); });
+}
+
+string MetricsRegistry::labelString(const MetricLabels& labels, const string& extra)
+{
+    if (labels.empty() && extra.empty()) return "";
+    string s = "{";
+    for (const auto& label: labels) {
+        if (s.size() > 1) s += ",";
+        s += label.first + "=\"";
+        for (char c: label.second) {
+            if (c == '\\' || c == '"') s += '\\';
+            if (c == '\n') { s += "\\n"; continue; }
+            s += c;
+        }
+        s += "\"";
+    }
+    if (!extra.empty()) {
+        if (s.size() > 1) s += ",";
+        s += extra;
+    }
+    return s + "}";
+}
+
+string MetricsRegistry::render()
+{
+    static const char* typeNames[] = {"counter", "gauge", "histogram"};
+
+    lock_guard<std::mutex> lock(mutex);
+    ostringstream out;
+    for (const auto& [name, family]: families) {
+        out << "# HELP " << name << " " << family.help << "\n";
+        out << "# TYPE " << name << " " << typeNames[static_cast<int>(family.type)] << "\n";
+        for (const auto& [labels, metric]: family.metrics) {
+            if (family.type == Type::COUNTER) {
+                out << name << labelString(labels) << " " << static_pointer_cast<MetricCounter>(metric)->get() << "\n";
+            } else if (family.type == Type::GAUGE) {
+                out << name << labelString(labels) << " " << formatValue(static_pointer_cast<MetricGauge>(metric)->get()) << "\n";
+            } else {
+                auto histogram = static_pointer_cast<MetricHistogram>(metric);
+                const vector<double>& bounds = histogram->getBounds();
+                vector<uint64_t> cumulative = histogram->cumulativeCounts();
+                for (size_t i = 0; i < bounds.size(); i++) {
+                    out << name << "_bucket" << labelString(labels, "le=\"" + formatValue(bounds[i]) + "\"") << " " << cumulative[i] << "\n";
+                }
+                out << name << "_bucket" << labelString(labels, "le=\"+Inf\"") << " " << cumulative.back() << "\n";
+                out << name << "_sum" << labelString(labels) << " " << formatValue(histogram->getSum()) << "\n";
+                out << name << "_count" << labelString(labels) << " " << cumulative.back() << "\n";
+            }
+        }
+    }
+    return out.str();
+}
+
+
+// MetricsServer
+unique_ptr<MetricsServer> MetricsServer::instancePtr;
+mutex MetricsServer::instanceMutex;
+
+MetricsServer::MetricsServer(int port)
+{
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        throw runtime_error("Metrics endpoint: cannot create a socket, " + string(strerror(errno)));
+    }
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (bind(listenFd, (sockaddr*)&address, sizeof(address)) != 0 || listen(listenFd, 4) != 0) {
+        string error = strerror(errno);
+        close(listenFd);
+        throw runtime_error("Metrics endpoint: cannot listen on port " + to_string(port) + ", " + error);
+    }
+    socklen_t length = sizeof(address);
+    getsockname(listenFd, (sockaddr*)&address, &length);
+    this->port = ntohs(address.sin_port);
+
+    if (pipe(wakePipe) != 0) {
+        close(listenFd);
+        throw runtime_error("Metrics endpoint: cannot create a pipe, " + string(strerror(errno)));
+    }
+    thread = std::thread(&MetricsServer::run, this);
+}
+
+MetricsServer::~MetricsServer()
+{
+    char c = 0;
+    if (write(wakePipe[1], &c, 1) < 0) {
+        // the thread is stopped when the pipe is closed
+    }
+    if (thread.joinable()) thread.join();
+    close(wakePipe[0]);
+    close(wakePipe[1]);
+    close(listenFd);
+}
+
+int MetricsServer::getPort() const
+{
+    return port;
+}
+
+void MetricsServer::run()
+{
+    while (true) {
+        pollfd fds[2] = {{listenFd, POLLIN, 0}, {wakePipe[0], POLLIN, 0}};
+        if (poll(fds, 2, -1) < 0) continue;
+        if (fds[1].revents) return;
+        if (fds[0].revents & POLLIN) {
+            int client = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client < 0) continue;
+            serve(client);
+            close(client);
+        }
+    }
+}
+
+void MetricsServer::serve(int client)
+{
+    // one request per connection, the scrapes are short and rare
+    timeval timeout = {1, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == string::npos && request.size() < 8192) {
+        ssize_t n = recv(client, buffer, sizeof(buffer), 0);
+        if (n <= 0) return;
+        request.append(buffer, n);
+    }
+
+    string status = "200 OK";
+    string body;
+    // the path of the request line up to the query or the protocol
+    string path;
+    if (request.compare(0, 4, "GET ") == 0) {
+        path = request.substr(4, request.find_first_of("? \r\n", 4) - 4);
+    }
+    if (path == "/metrics") {
+        body = MetricsRegistry::getInstance().render();
+    } else {
+        status = "404 Not Found";
+        body = "Not found, the metrics are served on /metrics\n";
+    }
+    string response = "HTTP/1.1 " + status + "\r\n"
+        "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+        "Content-Length: " + to_string(body.size()) + "\r\n"
+        "Connection: close\r\n\r\n" + body;
+    size_t sent = 0;
+    while (sent < response.size()) {
+        ssize_t n = send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return;
+        sent += n;
+    }
+}
+
+bool MetricsServer::start(const ordered_json& protocols, const string& processName)
+{
+    lock_guard<std::mutex> lock(instanceMutex);
+    if (instancePtr) return true;
+    if (!protocols.contains("metrics") || !protocols["metrics"].contains(processName)) return false;
+
+    int port = protocols["metrics"][processName].get<int>();
+    try {
+        instancePtr = make_unique<MetricsServer>(port);
+        LoggerStream::getInstance() << INFO << "Metrics are served on port " << instancePtr->getPort() << " (/metrics).";
+    } catch (runtime_error& e) {
+        LoggerStream::getInstance() << ERROR << e.what();
+        return false;
+    }
+    return true;
+}
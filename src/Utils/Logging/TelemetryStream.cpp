@@ -0,0 +1,238 @@
+#include <Utils/Logging/TelemetryStream.h>
+#include <Utils/Timing/VirtualClock.h>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <iomanip>
+
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+
+TelemetryStream::TelemetryStream(string name, vector<TelemetryChannel> channels, size_t blockSize) :
+    fName(name + ".tlm"),
+    telemetryDir(fs::path(getenv("ILVO_PATH")) / "logs"),
+    channels(channels),
+    blockSize(blockSize),
+    row(channels.size(), 0.0),
+    columns(channels.size())
+{
+    timestamps.reserve(blockSize);
+    for (auto& column: columns) {
+        column.reserve(blockSize);
+    }
+
+    fs::create_directories(telemetryDir);
+    // every process start gets a fresh file, the previous one is kept as backup
+    if (fs::exists(telemetryDir / fName)) {
+        rotate();
+    }
+    open();
+}
+
+TelemetryStream::~TelemetryStream()
+{
+    flush();
+    if (fstream.is_open()) {
+        fstream.close();
+    }
+}
+
+void TelemetryStream::open()
+{
+    fstream.open(telemetryDir / fName, ofstream::out | ofstream::binary | ofstream::trunc);
+    writeHeader();
+}
+
+void TelemetryStream::rotate()
+{
+    if (fstream.is_open()) {
+        fstream.close();
+    }
+    string backupName = fName + "1";
+    if (fs::exists(telemetryDir / backupName)) fs::remove(telemetryDir / backupName); // remove suffix file if exists
+    fs::rename(telemetryDir / fName, telemetryDir / backupName);
+}
+
+void TelemetryStream::writeHeader()
+{
+    uint32_t channelCount = channels.size();
+    fstream.write(TELEMETRY_MAGIC, sizeof(TELEMETRY_MAGIC));
+    fstream.write(reinterpret_cast<const char*>(&channelCount), sizeof(channelCount));
+    for (const auto& channel: channels) {
+        uint8_t type = channel.type;
+        uint16_t nameLength = channel.name.size();
+        fstream.write(reinterpret_cast<const char*>(&type), sizeof(type));
+        fstream.write(reinterpret_cast<const char*>(&nameLength), sizeof(nameLength));
+        fstream.write(channel.name.data(), nameLength);
+    }
+    fstream.flush();
+}
+
+size_t TelemetryStream::channel(const string& name) const
+{
+    for (size_t i = 0; i < channels.size(); i++) {
+        if (channels[i].name == name) return i;
+    }
+    throw invalid_argument("Telemetry channel " + name + " does not exist");
+}
+
+const vector<TelemetryChannel>& TelemetryStream::getChannels() const
+{
+    return channels;
+}
+
+fs::path TelemetryStream::getFilePath() const
+{
+    return telemetryDir / fName;
+}
+
+void TelemetryStream::commit()
+{
+    auto now = chrono::time_point_cast<chrono::microseconds>(Ilvo::Utils::Timing::systemNow());
+    timestamps.push_back(now.time_since_epoch().count());
+    for (size_t i = 0; i < channels.size(); i++) {
+        columns[i].push_back(row[i]);
+    }
+
+    if (timestamps.size() >= blockSize) {
+        flush();
+    }
+}
+
+void TelemetryStream::flush()
+{
+    if (timestamps.empty() || !fstream.is_open()) return;
+
+    uint32_t rowCount = timestamps.size();
+    fstream.write(reinterpret_cast<const char*>(&rowCount), sizeof(rowCount));
+    fstream.write(reinterpret_cast<const char*>(timestamps.data()), rowCount * sizeof(int64_t));
+    for (size_t i = 0; i < channels.size(); i++) {
+        const vector<double>& column = columns[i];
+        switch (channels[i].type) {
+            case FLOAT64:
+                fstream.write(reinterpret_cast<const char*>(column.data()), rowCount * sizeof(double));
+                break;
+            case INT32: {
+                vector<int32_t> values(column.begin(), column.end());
+                fstream.write(reinterpret_cast<const char*>(values.data()), rowCount * sizeof(int32_t));
+                break;
+            }
+            case BOOL: {
+                vector<uint8_t> values(rowCount);
+                for (size_t j = 0; j < rowCount; j++) values[j] = column[j] != 0.0;
+                fstream.write(reinterpret_cast<const char*>(values.data()), rowCount * sizeof(uint8_t));
+                break;
+            }
+        }
+    }
+    fstream.flush();
+
+    timestamps.clear();
+    for (auto& column: columns) {
+        column.clear();
+    }
+
+    if (fs::file_size(telemetryDir / fName) > TELEMETRY_FILE_MAX_SIZE) {
+        rotate();
+        open();
+    }
+}
+
+
+TelemetryReader::TelemetryReader(fs::path path)
+{
+    fstream.open(path, ifstream::in | ifstream::binary);
+    if (!fstream.is_open()) {
+        throw runtime_error("Telemetry file " + path.string() + " can not be opened");
+    }
+
+    char magic[sizeof(TELEMETRY_MAGIC)];
+    fstream.read(magic, sizeof(magic));
+    if (!fstream || memcmp(magic, TELEMETRY_MAGIC, sizeof(magic)) != 0) {
+        throw runtime_error("File " + path.string() + " is not a telemetry file");
+    }
+
+    uint32_t channelCount = 0;
+    fstream.read(reinterpret_cast<char*>(&channelCount), sizeof(channelCount));
+    for (uint32_t i = 0; i < channelCount; i++) {
+        uint8_t type;
+        uint16_t nameLength;
+        fstream.read(reinterpret_cast<char*>(&type), sizeof(type));
+        fstream.read(reinterpret_cast<char*>(&nameLength), sizeof(nameLength));
+        string name(nameLength, '\0');
+        fstream.read(name.data(), nameLength);
+        channels.push_back({name, static_cast<TelemetryType>(type)});
+    }
+    if (!fstream) {
+        throw runtime_error("Telemetry file " + path.string() + " has a corrupt header");
+    }
+}
+
+const vector<TelemetryChannel>& TelemetryReader::getChannels() const
+{
+    return channels;
+}
+
+bool TelemetryReader::readBlock(vector<int64_t>& timestamps, vector<vector<double>>& columns)
+{
+    uint32_t rowCount = 0;
+    if (!fstream.read(reinterpret_cast<char*>(&rowCount), sizeof(rowCount))) return false;
+
+    timestamps.resize(rowCount);
+    fstream.read(reinterpret_cast<char*>(timestamps.data()), rowCount * sizeof(int64_t));
+    columns.resize(channels.size());
+    for (size_t i = 0; i < channels.size(); i++) {
+        vector<double>& column = columns[i];
+        column.resize(rowCount);
+        switch (channels[i].type) {
+            case FLOAT64:
+                fstream.read(reinterpret_cast<char*>(column.data()), rowCount * sizeof(double));
+                break;
+            case INT32: {
+                vector<int32_t> values(rowCount);
+                fstream.read(reinterpret_cast<char*>(values.data()), rowCount * sizeof(int32_t));
+                column.assign(values.begin(), values.end());
+                break;
+            }
+            case BOOL: {
+                vector<uint8_t> values(rowCount);
+                fstream.read(reinterpret_cast<char*>(values.data()), rowCount * sizeof(uint8_t));
+                column.assign(values.begin(), values.end());
+                break;
+            }
+        }
+    }
+    // a truncated block (e.g. process killed during a write) is dropped
+    return static_cast<bool>(fstream);
+}
+
+void TelemetryReader::toCsv(ostream& out)
+{
+    out << "timestamp";
+    for (const auto& channel: channels) {
+        out << "," << channel.name;
+    }
+    out << "\n";
+
+    vector<int64_t> timestamps;
+    vector<vector<double>> columns;
+    out << setprecision(12);
+    while (readBlock(timestamps, columns)) {
+        for (size_t j = 0; j < timestamps.size(); j++) {
+            out << timestamps[j];
+            for (size_t i = 0; i < channels.size(); i++) {
+                out << ",";
+                if (channels[i].type == FLOAT64) {
+                    out << columns[i][j];
+                } else {
+                    out << static_cast<int64_t>(columns[i][j]);
+                }
+            }
+            out << "\n";
+        }
+    }
+}
@@ -5,6 +5,7 @@
 #include <sstream>
 #include <Utils/Geometry/Transform.h>
 #include <Utils/String/String.h>
+#include <Utils/Logging/Metrics.h>
 #include <string>
 #include <iostream>
 
@@ -12,8 +13,33 @@
 using namespace Ilvo::Utils::Nmea;
 using namespace Ilvo::Utils::Geometry;
 using namespace Ilvo::Utils::String;
+using namespace Ilvo::Utils::Logging;
 using namespace std;
 
+namespace {
+    /** @brief Sentence rates and checksum failures of the received lines, registered at the first line */
+    struct NmeaMetrics
+    {
+        MetricCounter& gga = sentences("GGA");
+        MetricCounter& hdt = sentences("HDT");
+        MetricCounter& vtg = sentences("VTG");
+        MetricCounter& hrp = sentences("HRP");
+        MetricCounter& other = sentences("other");
+        MetricCounter& checksumFailures = MetricsRegistry::getInstance().counter("ilvo_nmea_checksum_failures_total", "NMEA lines with a wrong checksum.");
+
+        static MetricCounter& sentences(const string& type)
+        {
+            return MetricsRegistry::getInstance().counter("ilvo_nmea_sentences_total", "NMEA sentences with a valid checksum per type.", {{"type", type}});
+        }
+    };
+
+    NmeaMetrics& nmeaMetrics()
+    {
+        static NmeaMetrics metrics;
+        return metrics;
+    }
+}
+
 
 NmeaLine::NmeaLine(vector<char>& nmeaLine) : 
     nmeaLineStr(string(nmeaLine.begin(), nmeaLine.end())) 
@@ -21,7 +47,9 @@ NmeaLine::NmeaLine(vector<char>& nmeaLine) :
     // perform checksum
     if (nmeaChecksum()) {
         parse();
-    } 
+    } else {
+        nmeaMetrics().checksumFailures.inc();
+    }
 }
 
 NmeaLine::NmeaLine(NmeaLine& nmeaLine) : 
@@ -38,16 +66,21 @@ void NmeaLine::parse() {
     if (nmeaLineStr.find("GGA") != string::npos) {
         type = NmeaMessageType::GGA;
         fields = GGA_MESSAGE_FORMAT;
+        nmeaMetrics().gga.inc();
     } else if (nmeaLineStr.find("HDT") != string::npos) {
         type = NmeaMessageType::HDT;
         fields = HDT_MESSAGE_FORMAT;
+        nmeaMetrics().hdt.inc();
     } else if (nmeaLineStr.find("VTG") != string::npos) {
         type = NmeaMessageType::VTG;
         fields = VTG_MESSAGE_FORMAT;
+        nmeaMetrics().vtg.inc();
     } else if (nmeaLineStr.find("HRP") != string::npos) {
         type = NmeaMessageType::HRP;
         fields = HRP_MESSAGE_FORMAT;
+        nmeaMetrics().hrp.inc();
     } else {
+        nmeaMetrics().other.inc();
         nmeaLineStr = "";
         return;
     }     
@@ -9,6 +9,7 @@ NmeaMessagePack::NmeaMessagePack(const NmeaMessagePack& other) {
     vtg = make_shared<NmeaLine>(*other.vtg);
     hrp = make_shared<NmeaLine>(*other.hrp);
     hdt = make_shared<NmeaLine>(*other.hdt);
+    received = other.received;
 }
 
 void NmeaMessagePack::addNmeaLine(shared_ptr<NmeaLine> line)
@@ -18,6 +19,7 @@ void NmeaMessagePack::addNmeaLine(shared_ptr<NmeaLine> line)
     case NmeaMessageType::GGA:
         gga = line;
         updated_gga = true;
+        received = chrono::steady_clock::now();
         break;
     case NmeaMessageType::VTG:
         vtg = line;
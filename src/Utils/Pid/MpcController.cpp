@@ -0,0 +1,187 @@
+#include <Utils/Pid/MpcController.h>
+#include <ThirdParty/Eigen/Dense>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace Ilvo::Utils::Pid;
+
+using namespace std;
+
+namespace {
+    /**
+     * @brief MPC with a QP of a fixed size
+     *
+     * @details With the inputs U (angular velocities), the stacked errors X = F x0 + G (U + D) of the
+     * disturbance D = -v c, the cost X'QX + r U'U + rRate |SU - s0 uPrevious|^2 is U'HU + 2g'U + const with
+     *     H = G'QG + r I + rRate S'S
+     *     g = G'Q (F x0 + G D) - rRate uPrevious e0
+     * H and its Cholesky factorization only depend on the velocity and are kept until it changes.
+     */
+    template<int N>
+    class FixedMpcController: public MpcController
+    {
+    private:
+        typedef Eigen::Matrix<double, N, N> MatrixN;
+        typedef Eigen::Matrix<double, N, 1> VectorN;
+        typedef Eigen::Matrix<double, 2 * N, N> MatrixG;
+        typedef Eigen::Matrix<double, 2 * N, 1> VectorX;
+
+        MpcSettings settings;
+
+        /** @brief Velocity of H, NaN to rebuild */
+        double velocity;
+        MatrixG G;
+        VectorX Q;
+        MatrixN H;
+        Eigen::LLT<MatrixN> llt;
+        /** @brief Gershgorin bound of the largest eigenvalue of H, the inverse step of the gradient method */
+        double lipschitz;
+
+        /** @brief Previous solution, the warm start of the next solve */
+        VectorN previous;
+        bool hasPrevious;
+        /** @brief Applied angular velocity of the previous solve */
+        double previousAngular;
+
+        // work vectors of the solve
+        VectorN g, U, Y, next, disturbance;
+        VectorX free;
+
+        /** @brief Cost of the inputs without the constant term, U'HU/2 + g'U */
+        double cost(const VectorN& inputs) const
+        {
+            return 0.5 * inputs.dot(H * inputs) + g.dot(inputs);
+        }
+
+        void build(double v)
+        {
+            const double dt = settings.dt;
+            // columns of A^m B, A = [1 v dt; 0 1], B = [v dt^2/2; dt]
+            G.setZero();
+            for (int k = 0; k < N; k++) {
+                for (int j = 0; j <= k; j++) {
+                    G(2 * k, j) = v * dt * dt * (k - j + 0.5);
+                    G(2 * k + 1, j) = dt;
+                }
+                Q(2 * k) = settings.qLateral;
+                Q(2 * k + 1) = settings.qHeading;
+            }
+            H.noalias() = G.transpose() * Q.asDiagonal() * G;
+            for (int i = 0; i < N; i++) {
+                H(i, i) += settings.rAngular + settings.rRate * (i < N - 1 ? 2.0 : 1.0);
+                if (i > 0) {
+                    H(i, i - 1) -= settings.rRate;
+                    H(i - 1, i) -= settings.rRate;
+                }
+            }
+            llt.compute(H);
+            lipschitz = H.cwiseAbs().rowwise().sum().maxCoeff();
+            velocity = v;
+        }
+    public:
+        FixedMpcController() :
+            velocity(numeric_limits<double>::quiet_NaN()),
+            lipschitz(1.0),
+            hasPrevious(false),
+            previousAngular(0.0)
+        {
+        }
+
+        int getHorizon() const override { return N; }
+
+        void setSettings(const MpcSettings& settings) override
+        {
+            this->settings = settings;
+            velocity = numeric_limits<double>::quiet_NaN();
+        }
+
+        const MpcSettings& getSettings() const override { return settings; }
+
+        void applied(double angular) override
+        {
+            previousAngular = angular;
+        }
+
+        void reset() override
+        {
+            hasPrevious = false;
+            previousAngular = 0.0;
+        }
+
+        MpcResult solve(double lateral, double heading, double v, const double* curvature) override
+        {
+            auto start = chrono::steady_clock::now();
+            MpcResult result;
+
+            if (v != velocity) build(v);
+
+            // free response F x0 + G D
+            const double dt = settings.dt;
+            for (int k = 0; k < N; k++) {
+                disturbance(k) = -v * curvature[k];
+                free(2 * k) = lateral + (k + 1) * v * dt * heading;
+                free(2 * k + 1) = heading;
+            }
+            free.noalias() += G * disturbance;
+            g.noalias() = G.transpose() * Q.cwiseProduct(free);
+            g(0) -= settings.rRate * previousAngular;
+
+            const double limit = settings.maxAngular;
+            U = llt.solve(-g);
+            if (U.cwiseAbs().maxCoeff() > limit) {
+                // accelerated projected gradient on the box |U| <= limit, from the previous solution shifted by one
+                // step or the clipped unconstrained solution, the one with the lower cost
+                U = U.cwiseMax(-limit).cwiseMin(limit);
+                if (hasPrevious) {
+                    Y.template head<N - 1>() = previous.template tail<N - 1>();
+                    Y(N - 1) = previous(N - 1);
+                    if (cost(Y) < cost(U)) U = Y;
+                }
+                Y = U;
+                double t = 1.0;
+                bool converged = false;
+                while (result.iterations < settings.maxIterations) {
+                    result.iterations++;
+                    next = (Y - (H * Y + g) / lipschitz).cwiseMax(-limit).cwiseMin(limit);
+                    double step = (next - U).cwiseAbs().maxCoeff();
+                    double tNext = (1.0 + sqrt(1.0 + 4.0 * t * t)) / 2.0;
+                    Y = next + ((t - 1.0) / tNext) * (next - U);
+                    U = next;
+                    t = tNext;
+                    if (step < settings.tolerance) {
+                        converged = true;
+                        break;
+                    }
+                    if ((result.iterations & 7) == 0 && chrono::steady_clock::now() - start > settings.budget) break;
+                }
+                result.valid = converged;
+            } else {
+                result.valid = true;
+            }
+
+            // the iterate is feasible, it is the warm start of the next solve also when the budget was exceeded
+            previous = U;
+            hasPrevious = true;
+            result.angular = U(0);
+            result.solveTime = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+            if (result.solveTime > settings.budget.count()) result.valid = false;
+            if (result.valid) previousAngular = result.angular;
+            return result;
+        }
+    };
+}
+
+
+unique_ptr<MpcController> MpcController::create(int horizon)
+{
+    switch (horizon) {
+    case 10: return make_unique<FixedMpcController<10>>();
+    case 20: return make_unique<FixedMpcController<20>>();
+    case 30: return make_unique<FixedMpcController<30>>();
+    case 40: return make_unique<FixedMpcController<40>>();
+    default:
+        throw invalid_argument("No MPC with a horizon of " + to_string(horizon) + " steps");
+    }
+}
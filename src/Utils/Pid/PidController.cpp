@@ -1,4 +1,5 @@
 #include <Utils/Pid/PidController.h>
+#include <Utils/Timing/VirtualClock.h>
 
 using namespace Ilvo::Utils::Pid;
 
@@ -7,12 +8,12 @@ PidController::PidController()
     : kp(0.0), ki(0.0), kd(0.0), 
     previousError(0.0), integral(0.0), derivative(0.0), output(0.0),
     saturationMax(100.0), saturationMin(-100.0), saturationEnabled(false),
-    lastTime(std::chrono::steady_clock::now())
+    lastTime(Ilvo::Utils::Timing::steadyNow())
 {
 }
 
 double PidController::update(double error) {
-    auto timestamp = std::chrono::steady_clock::now();
+    auto timestamp = Ilvo::Utils::Timing::steadyNow();
     std::chrono::duration<double> elapsed = timestamp - lastTime;
 
     // derivative term
@@ -92,6 +93,6 @@ void PidController::reset()
     previousError = 0.0;
     integral = 0.0;
     derivative = 0.0;
-    lastTime = std::chrono::steady_clock::now();
+    lastTime = Ilvo::Utils::Timing::steadyNow();
     saturationEnabled = false;
 }
\ No newline at end of file
@@ -0,0 +1,285 @@
+#include <Utils/Redis/LocalStore.h>
+
+#include <fnmatch.h>
+#include <algorithm>
+
+using namespace Ilvo::Utils::Redis;
+using namespace nlohmann;
+using namespace std;
+
+
+bool LocalStore::exists(const string& key)
+{
+    lock_guard<std::mutex> lock(mutex);
+    return values.count(key) > 0 || hashValues.count(key) > 0 || jsonValues.count(key) > 0;
+}
+
+vector<string> LocalStore::keys()
+{
+    lock_guard<std::mutex> lock(mutex);
+    vector<string> result;
+    result.reserve(values.size() + hashValues.size() + jsonValues.size());
+    for (const auto& it: values) result.push_back(it.first);
+    for (const auto& it: hashValues) result.push_back(it.first);
+    for (const auto& it: jsonValues) result.push_back(it.first);
+    return result;
+}
+
+string LocalStore::type(const string& key)
+{
+    lock_guard<std::mutex> lock(mutex);
+    if (values.count(key) > 0) return "string";
+    if (hashValues.count(key) > 0) return "hash";
+    if (jsonValues.count(key) > 0) return "ReJSON-RL";
+    return "none";
+}
+
+string LocalStore::get(const string& key)
+{
+    lock_guard<std::mutex> lock(mutex);
+    auto it = values.find(key);
+    return it == values.end() ? "" : it->second;
+}
+
+void LocalStore::set(const string& key, const string& value)
+{
+    {
+        lock_guard<std::mutex> lock(mutex);
+        values[key] = value;
+    }
+    notifyKeyspace({key}, "set");
+}
+
+vector<string> LocalStore::mget(const vector<string>& keys)
+{
+    lock_guard<std::mutex> lock(mutex);
+    vector<string> result;
+    result.reserve(keys.size());
+    for (const string& key: keys) {
+        auto it = values.find(key);
+        result.push_back(it == values.end() ? "" : it->second);
+    }
+    return result;
+}
+
+void LocalStore::mget(const vector<string>& keys, vector<string>& result, vector<bool>& nil, size_t offset)
+{
+    lock_guard<std::mutex> lock(mutex);
+    if (result.size() < offset + keys.size()) result.resize(offset + keys.size());
+    if (nil.size() < offset + keys.size()) nil.resize(offset + keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        auto it = values.find(keys[i]);
+        nil[offset + i] = it == values.end();
+        if (it == values.end()) result[offset + i].clear();
+        else result[offset + i].assign(it->second);
+    }
+}
+
+void LocalStore::mset(const vector<string>& keyValues)
+{
+    vector<string> keys;
+    {
+        lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i + 1 < keyValues.size(); i += 2) {
+            values[keyValues[i]] = keyValues[i + 1];
+        }
+        if (patternSubscribers.empty() && !changeHook) return;
+    }
+    for (size_t i = 0; i + 1 < keyValues.size(); i += 2) {
+        keys.push_back(keyValues[i]);
+    }
+    notifyKeyspace(keys, "set");
+}
+
+vector<string> LocalStore::hmget(const string& key, const vector<string>& fields)
+{
+    lock_guard<std::mutex> lock(mutex);
+    vector<string> result(fields.size());
+    auto hash = hashValues.find(key);
+    if (hash == hashValues.end()) return result;
+    for (size_t i = 0; i < fields.size(); i++) {
+        auto it = hash->second.find(fields[i]);
+        if (it != hash->second.end()) result[i] = it->second;
+    }
+    return result;
+}
+
+void LocalStore::hmget(const string& key, const vector<string>& fields, vector<string>& result, vector<bool>& nil, size_t offset)
+{
+    lock_guard<std::mutex> lock(mutex);
+    if (result.size() < offset + fields.size()) result.resize(offset + fields.size());
+    if (nil.size() < offset + fields.size()) nil.resize(offset + fields.size());
+    auto hash = hashValues.find(key);
+    for (size_t i = 0; i < fields.size(); i++) {
+        result[offset + i].clear();
+        nil[offset + i] = true;
+        if (hash == hashValues.end()) continue;
+        auto it = hash->second.find(fields[i]);
+        if (it != hash->second.end()) {
+            result[offset + i].assign(it->second);
+            nil[offset + i] = false;
+        }
+    }
+}
+
+vector<string> LocalStore::hgetall(const string& key)
+{
+    lock_guard<std::mutex> lock(mutex);
+    vector<string> result;
+    auto it = hashValues.find(key);
+    if (it == hashValues.end()) return result;
+    // sorted, the same hash gives the same vector
+    map<string, string> sorted(it->second.begin(), it->second.end());
+    for (const auto& field: sorted) {
+        result.push_back(field.first);
+        result.push_back(field.second);
+    }
+    return result;
+}
+
+void LocalStore::hset(const string& key, const vector<string>& fieldValues)
+{
+    {
+        lock_guard<std::mutex> lock(mutex);
+        auto& hash = hashValues[key];
+        for (size_t i = 0; i + 1 < fieldValues.size(); i += 2) {
+            hash[fieldValues[i]] = fieldValues[i + 1];
+        }
+    }
+    notifyKeyspace({key}, "hset");
+}
+
+int LocalStore::hdel(const string& key, const vector<string>& fields)
+{
+    int deleted = 0;
+    {
+        lock_guard<std::mutex> lock(mutex);
+        auto hash = hashValues.find(key);
+        if (hash == hashValues.end()) return 0;
+        for (const string& field: fields) {
+            deleted += hash->second.erase(field);
+        }
+        if (hash->second.empty()) hashValues.erase(hash);
+    }
+    // like the server, only a deletion is notified
+    if (deleted > 0) notifyKeyspace({key}, "hdel");
+    return deleted;
+}
+
+int LocalStore::del(const vector<string>& keys)
+{
+    vector<string> deletedKeys;
+    {
+        lock_guard<std::mutex> lock(mutex);
+        for (const string& key: keys) {
+            if (values.erase(key) + hashValues.erase(key) + jsonValues.erase(key) > 0) deletedKeys.push_back(key);
+        }
+    }
+    // like the server, keys that did not exist are not notified
+    if (!deletedKeys.empty()) notifyKeyspace(deletedKeys, "del");
+    return deletedKeys.size();
+}
+
+json LocalStore::getJson(const string& key)
+{
+    lock_guard<std::mutex> lock(mutex);
+    auto it = jsonValues.find(key);
+    return it == jsonValues.end() ? json() : it->second;
+}
+
+void LocalStore::setJson(const string& key, const json& value)
+{
+    {
+        lock_guard<std::mutex> lock(mutex);
+        jsonValues[key] = value;
+    }
+    notifyKeyspace({key}, "json.set");
+}
+
+int LocalStore::publish(const string& channel, const string& message)
+{
+    function<void(const string&, const string&)> hook;
+    {
+        lock_guard<std::mutex> lock(mutex);
+        hook = publishHook;
+    }
+    if (hook) hook(channel, message);
+    return deliver(channel, message);
+}
+
+int LocalStore::deliver(const string& channel, const string& message)
+{
+    vector<function<void(const string_view&)>> callbacks;
+    vector<function<void(const string&, const string_view&)>> patternCallbacks;
+    {
+        lock_guard<std::mutex> lock(mutex);
+        auto it = subscribers.find(channel);
+        if (it != subscribers.end()) callbacks = it->second;
+        for (const PatternSubscriber& subscriber: patternSubscribers) {
+            if (fnmatch(subscriber.pattern.c_str(), channel.c_str(), 0) == 0) {
+                patternCallbacks.push_back(subscriber.callback);
+            }
+        }
+    }
+    // callbacks are called without the lock, so they can use the store
+    for (auto& callback: callbacks) {
+        callback(message);
+    }
+    for (auto& callback: patternCallbacks) {
+        callback(channel, message);
+    }
+    return callbacks.size() + patternCallbacks.size();
+}
+
+void LocalStore::notifyKeyspace(const vector<string>& keys, const string& event)
+{
+    function<void(const string&)> hook;
+    bool notify;
+    {
+        lock_guard<std::mutex> lock(mutex);
+        hook = changeHook;
+        notify = !patternSubscribers.empty();
+    }
+    for (const string& key: keys) {
+        if (hook) hook(key);
+        if (notify) deliver("__keyspace@0__:" + key, event);
+    }
+}
+
+void LocalStore::subscribe(const string& channel, function<void(const string_view&)> callback)
+{
+    lock_guard<std::mutex> lock(mutex);
+    subscribers[channel].push_back(callback);
+}
+
+void LocalStore::unsubscribe(const string& channel)
+{
+    lock_guard<std::mutex> lock(mutex);
+    subscribers.erase(channel);
+}
+
+int LocalStore::psubscribe(const string& pattern, function<void(const string&, const string_view&)> callback)
+{
+    lock_guard<std::mutex> lock(mutex);
+    patternSubscribers.push_back({nextPatternId, pattern, callback});
+    return nextPatternId++;
+}
+
+void LocalStore::punsubscribe(int id)
+{
+    lock_guard<std::mutex> lock(mutex);
+    patternSubscribers.erase(remove_if(patternSubscribers.begin(), patternSubscribers.end(), 
+        [id](const PatternSubscriber& subscriber) { return subscriber.id == id; }), patternSubscribers.end());
+}
+
+void LocalStore::setChangeHook(function<void(const string&)> hook)
+{
+    lock_guard<std::mutex> lock(mutex);
+    changeHook = hook;
+}
+
+void LocalStore::setPublishHook(function<void(const string&, const string&)> hook)
+{
+    lock_guard<std::mutex> lock(mutex);
+    publishHook = hook;
+}
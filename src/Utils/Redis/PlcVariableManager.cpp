@@ -1,4 +1,5 @@
 #include <Utils/Redis/PlcVariableManager.h>
+#include <Utils/Redis/VariableSchemaGenerated.h>
 #include <Utils/String/String.h>
 #include <ThirdParty/snap7/snap7.h>
 #include <ThirdParty/ieee754_types.hpp>
@@ -18,10 +19,37 @@ using bprinter::TablePrinter;
 
 // TODO make it an abstract class whereby different plc types can be used
 
+PlcVariableManager::PlcIoMetrics PlcVariableManager::PlcIoMetrics::of(const string& op)
+{
+    MetricsRegistry& registry = MetricsRegistry::getInstance();
+    return {
+        registry.histogram("ilvo_plc_io_seconds", "Duration of a data block read or write of the PLC.", {{"op", op}}),
+        registry.counter("ilvo_plc_errors_total", "Failed data block reads and writes of the PLC.", {{"op", op}}),
+        registry.gauge("ilvo_plc_last_error_code", "Snap7 error code of the last failed data block read or write of the PLC.", {{"op", op}})
+    };
+}
+
 PlcVariableManager::PlcVariableManager(string processName) : 
     VariableManager(processName), 
     monitorSize(0), controlSize(0),
-    byteCount(0), bitCount(0), previousEntity("")
+    monitorData(nullptr), controlData(nullptr),
+    plcRead(PlcIoMetrics::of("read")),
+    plcWrite(PlcIoMetrics::of("write"))
+{
+    groupVariables();
+}
+
+PlcVariableManager::PlcVariableManager(string processName, shared_ptr<LocalStore> store) : 
+    VariableManager(processName, store), 
+    monitorSize(0), controlSize(0),
+    monitorData(nullptr), controlData(nullptr),
+    plcRead(PlcIoMetrics::of("read")),
+    plcWrite(PlcIoMetrics::of("write"))
+{
+    groupVariables();
+}
+
+void PlcVariableManager::groupVariables()
 {
     for(string key: variableMapKeyOrder) {
         VariablePtr var = variableMap[key];
@@ -33,6 +61,8 @@ PlcVariableManager::PlcVariableManager(string processName) :
             pcVariables.push_back(var);
         }
     }
+    plcMonitorFields = toFields(plcMonitorVariables);
+    plcControlFields = toFields(plcControlVariables);
 }
 
 PlcVariableManager::~PlcVariableManager()
@@ -41,55 +71,40 @@ PlcVariableManager::~PlcVariableManager()
     delete[] monitorData;
 }
 
-void PlcVariableManager::resetCount() {
-    byteCount = 0;
-    bitCount = 0;
-    previousEntity = "";
-}
+vector<PlcVariableManager::PlcField> PlcVariableManager::toFields(const vector<VariablePtr>& variables)
+{
+    static const map<string, PlcDataType> dataTypes = {
+        {"int8", PlcDataType::INT8}, {"uint8", PlcDataType::UINT8}, {"int16", PlcDataType::INT16}, {"uint16", PlcDataType::UINT16},
+        {"int32", PlcDataType::INT32}, {"uint32", PlcDataType::UINT32}, {"float", PlcDataType::FLOAT}, {"lfloat", PlcDataType::LFLOAT},
+        {"string", PlcDataType::STRING}, {"bool", PlcDataType::BOOL}
+    };
 
-void PlcVariableManager::beginCount(VariablePtr var) {
-    string newEntity = var->getEntity();
-    if (var->getType() != "bool" || newEntity != previousEntity) {
-        if (bitCount != 0) {
-            bitCount = 0;
-            byteCount += 2;
+    vector<PlcField> fields;
+    for (VariablePtr var: variables) {
+        auto it = dataTypes.find(var->getType());
+        if (it == dataTypes.end()) {
+            throw PlcNoSuchDataTypeException(var);
         }
+        fields.push_back({var, it->second, var->getPlcByte(), var->getPlcBit()});
     }
-    previousEntity = newEntity;
-}
-
-void PlcVariableManager::endCount(VariablePtr var) {
-    if (var->getType() == "bool") {
-        bitCount += 1;
-        if (bitCount == 8) {
-            bitCount = 0;
-            byteCount += 1;
-        } 
-    } else {
-        bitCount = 0;
-        byteCount += var->getSize();
-    }
+    return fields;
 }
 
 void PlcVariableManager::setSize(PlcType plcType) 
 {
-    vector<VariablePtr> variables;
-    if (plcType == PlcType::MONITOR) {
-        variables = plcMonitorVariables;
-    } else if (plcType == PlcType::CONTROL) {
-        variables = plcControlVariables;
-    }
-
-    resetCount();
-    for (VariablePtr var: variables) {
-        beginCount(var);
-        endCount(var);
+    int size = 0;
+    if (usesCompiledSchema()) {
+        size = plcType == PlcType::MONITOR ? Schema::monitorSize : Schema::controlSize;
+    } else {
+        for (const PlcField& field: (plcType == PlcType::MONITOR ? plcMonitorFields : plcControlFields)) {
+            size = max(size, field.byte + (field.type == PlcDataType::BOOL ? 1 : field.var->getSize()));
+        }
     }
 
     if (plcType == PlcType::MONITOR) {
-        monitorSize  = byteCount + (bitCount > 0 ? 1 : 0);
+        monitorSize = size;
     } else if (plcType == PlcType::CONTROL) {
-        controlSize  = byteCount + (bitCount > 0 ? 1 : 0);
+        controlSize = size;
     }
 }
 
@@ -105,12 +120,9 @@ void PlcVariableManager::printRapport(LoggerStream& logger, vector<VariablePtr>&
     tp.AddColumn("Value", 15);
     tp.AddColumn("Plc byte.bit", 15);
 
-    resetCount();
     tp.PrintHeader();
     for (VariablePtr var: variables) {
-        beginCount(var);
-
-        string byteBitStr = (var->getPlcType() != PlcType::NONE) ? to_string(byteCount) + "." + to_string(bitCount) : "";
+        string byteBitStr = (var->getPlcType() != PlcType::NONE) ? to_string(var->getPlcByte()) + "." + to_string(var->getPlcBit()) : "";
 
         // fill in variables
         if (var->getType().find("int") != string::npos) {
@@ -124,8 +136,6 @@ void PlcVariableManager::printRapport(LoggerStream& logger, vector<VariablePtr>&
         } else {
             throw PlcNoSuchDataTypeException(var);
         }
-
-        endCount(var);
     }
 
     tp.PrintFooter();
@@ -139,44 +149,45 @@ void PlcVariableManager::writeControlValuesToPlc()
         controlData[i] = 0;
     }
 
-    resetCount();
-    for (VariablePtr var: plcControlVariables) {
-        beginCount(var);
+    for (const PlcField& field: plcControlFields) {
+        const VariablePtr& var = field.var;
+        const int byteCount = field.byte;
+        const int bitCount = field.bit;
 
         // fill in variables
-        if (var->getType() == "int8") {
+        if (field.type == PlcDataType::INT8) {
             int8_t val = var->getValue<int>();
             unsigned char *val_char = reinterpret_cast<unsigned char*>(&val);
             controlData[byteCount+0] = (unsigned char) (*val_char & 0xFF);
-        } else if (var->getType() == "uint8") {
+        } else if (field.type == PlcDataType::UINT8) {
             uint8_t val = var->getValue<int>();
             unsigned char *val_char = reinterpret_cast<unsigned char*>(&val);
             controlData[byteCount+0] = (unsigned char) (*val_char & 0xFF);
-        } else if (var->getType() == "int16") {
+        } else if (field.type == PlcDataType::INT16) {
             int16_t val = var->getValue<int>();
             unsigned char *val_char = reinterpret_cast<unsigned char*>(&val);
             controlData[byteCount+1] = (unsigned char) (*val_char & 0xFF);
             controlData[byteCount+0] = (unsigned char) ((*val_char >> 8) & 0xFF);
-        } else if (var->getType() == "uint16") {
+        } else if (field.type == PlcDataType::UINT16) {
             uint16_t val = var->getValue<int>();
             unsigned char *val_char = reinterpret_cast<unsigned char*>(&val);
             controlData[byteCount+1] = (unsigned char) (*val_char & 0xFF);
             controlData[byteCount+0] = (unsigned char) ((*val_char >> 8) & 0xFF);
-        } else if (var->getType() == "int32") {
+        } else if (field.type == PlcDataType::INT32) {
             int32_t val = var->getValue<int>();
             unsigned char *val_char = reinterpret_cast<unsigned char*>(&val);
             controlData[byteCount+3] = (unsigned char) (*val_char & 0xFF);
             controlData[byteCount+2] = (unsigned char) ((*val_char >> 8) & 0xFF);
             controlData[byteCount+1] = (unsigned char) ((*val_char >> 16) & 0xFF);
             controlData[byteCount+0] = (unsigned char) ((*val_char >> 24) & 0xFF);
-        } else if (var->getType() == "uint32") {
+        } else if (field.type == PlcDataType::UINT32) {
             uint32_t val = var->getValue<uint>();
             unsigned char *val_char = reinterpret_cast<unsigned char*>(&val);
             controlData[byteCount+3] = (unsigned char) (*val_char & 0xFF);
             controlData[byteCount+2] = (unsigned char) ((*val_char >> 8) & 0xFF);
             controlData[byteCount+1] = (unsigned char) ((*val_char >> 16) & 0xFF);
             controlData[byteCount+0] = (unsigned char) ((*val_char >> 24) & 0xFF);
-        } else if (var->getType() == "float") {
+        } else if (field.type == PlcDataType::FLOAT) {
             double value = var->getValue<double>();
             IEEE_754::_2008::Binary<32> val(value);
             unsigned char *val_char = reinterpret_cast<unsigned char*>(&val);
@@ -184,7 +195,7 @@ void PlcVariableManager::writeControlValuesToPlc()
             controlData[byteCount+2] = (unsigned char) val_char[1];
             controlData[byteCount+1] = (unsigned char) val_char[2];
             controlData[byteCount+0] = (unsigned char) val_char[3];
-        } else if (var->getType() == "lfloat") {
+        } else if (field.type == PlcDataType::LFLOAT) {
             double value = var->getValue<double>();
             IEEE_754::_2008::Binary<64> val(value);
             unsigned char *val_char = reinterpret_cast<unsigned char*>(&val);
@@ -196,11 +207,11 @@ void PlcVariableManager::writeControlValuesToPlc()
             controlData[byteCount+2] = (unsigned char) val_char[5];
             controlData[byteCount+1] = (unsigned char) val_char[6];
             controlData[byteCount+0] = (unsigned char) val_char[7];
-        } else if (var->getType() == "string") {
+        } else if (field.type == PlcDataType::STRING) {
             string val = var->getValue<string>();
             unsigned char* val_char = reinterpret_cast<unsigned char*>(&val);
             memcpy((void*) (controlData[byteCount]), val_char, 16);  // TODO compile warning on this!
-        } else if (var->getType() == "bool") {
+        } else if (field.type == PlcDataType::BOOL) {
             int val = var->getValue<bool>();
             unsigned char *val_char = reinterpret_cast<unsigned char*>(&val);
 
@@ -211,13 +222,15 @@ void PlcVariableManager::writeControlValuesToPlc()
         } else {
             throw PlcNoSuchDataTypeException(var);
         }
-
-        endCount(var);
     }
 
     // write data to plc
+    int64_t start = traceNow();
     longword err = plcPtr->DBWrite(plcPtr->writeDb, 0, controlSize, controlData);
+    plcWrite.duration.observe((traceNow() - start) * 1e-6);
     if (err != 0) {
+        plcWrite.errors.inc();
+        plcWrite.errorCode.set(err);
         throw PlcWriteException(err);
     } 
 }
@@ -226,60 +239,63 @@ void PlcVariableManager::readMonitorValuesFromPlc()
 {
     // read data from plc
     if (monitorSize > 0) {
+        int64_t start = traceNow();
         longword err = plcPtr->DBRead(plcPtr->readDb, 0, monitorSize, monitorData);
+        plcRead.duration.observe((traceNow() - start) * 1e-6);
         if (err != 0) {
+            plcRead.errors.inc();
+            plcRead.errorCode.set(err);
             throw PlcReadException(err);
         }
     }
 
     // extract read values
-    resetCount();
-    for (VariablePtr var: plcMonitorVariables) {
-        beginCount(var);
+    for (const PlcField& field: plcMonitorFields) {
+        const VariablePtr& var = field.var;
+        const int byteCount = field.byte;
+        const int bitCount = field.bit;
 
         // extract variables
-        if (var->getType() == "int8") {
+        if (field.type == PlcDataType::INT8) {
             int8_t val = (int8_t) (monitorData[byteCount+0]);
             var->setValue(val);
-        } else if (var->getType() == "uint8") {
+        } else if (field.type == PlcDataType::UINT8) {
             uint8_t val = (uint8_t) (monitorData[byteCount+0]);
             var->setValue(val);
-        } else if (var->getType() == "int16") {
+        } else if (field.type == PlcDataType::INT16) {
             int16_t val = (int16_t) ((monitorData[byteCount+0] << 8) | monitorData[byteCount+1]);
             var->setValue(val);
-        } else if (var->getType() == "uint16") {
+        } else if (field.type == PlcDataType::UINT16) {
             uint16_t val = (uint16_t) ((monitorData[byteCount+0] << 8) | monitorData[byteCount+1]);
             var->setValue(val);
-        } else if (var->getType() == "int32") {
+        } else if (field.type == PlcDataType::INT32) {
             int32_t val = (int32_t) ((monitorData[byteCount+0] << 24) | (monitorData[byteCount+1] << 16) | (monitorData[byteCount+2] << 8) | monitorData[byteCount+3]);
             var->setValue(val);
-        } else if (var->getType() == "uint32") {
+        } else if (field.type == PlcDataType::UINT32) {
             uint32_t val = (uint32_t) ((monitorData[byteCount+0] << 24) | (monitorData[byteCount+1] << 16) | (monitorData[byteCount+2] << 8) | monitorData[byteCount+3]);
             var->setValue(val);
-        } else if (var->getType() == "float") {
+        } else if (field.type == PlcDataType::FLOAT) {
             int const plc_size = 4;
             IEEE_754::_2008::Binary<32> f;
             unsigned char b[] = {monitorData[byteCount+3], monitorData[byteCount+2], monitorData[byteCount+1], monitorData[byteCount+0]};
             memcpy(&f, &b, plc_size);
             var->setValue((double) f);
-        } else if (var->getType() == "lfloat") {
+        } else if (field.type == PlcDataType::LFLOAT) {
             int const plc_size = 8;
             IEEE_754::_2008::Binary<64> f;
             unsigned char b[] = {monitorData[byteCount+7], monitorData[byteCount+6], monitorData[byteCount+5], monitorData[byteCount+4], monitorData[byteCount+3], monitorData[byteCount+2], monitorData[byteCount+1], monitorData[byteCount+0]};
             memcpy(&f, &b, plc_size);
             var->setValue((double) f);
-        } else if (var->getType() == "string") {
+        } else if (field.type == PlcDataType::STRING) {
             char val_data[17] = {'\0'};
             memcpy(val_data, monitorData + byteCount, 16);
             string val(val_data);
             var->setValue(trim(val));
-        } else if (var->getType() == "bool") {
+        } else if (field.type == PlcDataType::BOOL) {
             var->setValue((bool) ((monitorData[byteCount+0] >> bitCount) & 0x01));
         } else {
             throw PlcNoSuchDataTypeException(var);
         }
-
-        endCount(var);
     }
 }
 
@@ -306,6 +322,8 @@ void PlcVariableManager::init()
     // load data arrays
 
 
+    traceVariable = existsVariable("pc.navigation.trace") ? getVariable("pc.navigation.trace") : nullptr;
+
     // connect to plc
     plcPtr = make_unique<Plc>(jConfig["protocols"]["snap7"]);
     
@@ -314,7 +332,15 @@ void PlcVariableManager::init()
 void PlcVariableManager::serverTick() 
 {
     if (plcPtr->Connected()) {
+        // the fix of the control variables is traced until they are written in the data block
+        if (traceVariable) {
+            trace = TraceContext::fromString(traceVariable->getValue<string>());
+        }
+        int64_t writeStart = traceNow();
         writeControlValuesToPlc();
+        if (isTraceNew()) {
+            traceSpan(processName, writeStart, traceNow(), TraceFlow::END);
+        }
         readMonitorValuesFromPlc();
     } else {
         throw PlcNotFound(plcPtr->ip);
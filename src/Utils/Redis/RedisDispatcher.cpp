@@ -0,0 +1,457 @@
+#include <Utils/Redis/RedisDispatcher.h>
+#include <Utils/Redis/RespReader.h>
+#include <Utils/Logging/LoggerStream.h>
+
+#include <charconv>
+#include <algorithm>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Utils::Logging;
+using namespace std;
+
+namespace {
+    const size_t queueCapacity = 1024;
+
+    /** @brief Connect a TCP socket, -1 on failure */
+    int connectSocket(const string& ip, int port)
+    {
+        addrinfo hints = {};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* addresses = nullptr;
+        if (getaddrinfo(ip.c_str(), to_string(port).c_str(), &hints, &addresses) != 0) {
+            return -1;
+        }
+        int fd = -1;
+        for (addrinfo* address = addresses; address != nullptr; address = address->ai_next) {
+            fd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            if (fd < 0) continue;
+            if (connect(fd, address->ai_addr, address->ai_addrlen) == 0) break;
+            close(fd);
+            fd = -1;
+        }
+        freeaddrinfo(addresses);
+        return fd;
+    }
+
+    bool sendAll(int fd, const string& data)
+    {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            sent += n;
+        }
+        return true;
+    }
+
+    /** @brief Position after the \r\n of the line at pos, npos if the line is incomplete */
+    size_t lineEnd(const string& buffer, size_t pos)
+    {
+        size_t end = buffer.find("\r\n", pos);
+        return end == string::npos ? string::npos : end + 2;
+    }
+
+    long long toInteger(const string& buffer, size_t begin, size_t end)
+    {
+        long long value = 0;
+        from_chars(buffer.data() + begin, buffer.data() + end, value);
+        return value;
+    }
+
+    /**
+     * @brief Parse one array reply from pos, the elements are views into the buffer
+     *
+     * @return false if the reply is not completely received yet, pos is then unchanged
+     */
+    bool parseArray(const string& buffer, size_t& pos, vector<string_view>& items)
+    {
+        items.clear();
+        size_t cursor = pos;
+        size_t end = lineEnd(buffer, cursor);
+        if (end == string::npos) return false;
+        if (buffer[cursor] != '*') {
+            // not an array (e.g. an error reply), skip the line
+            pos = end;
+            return true;
+        }
+        long long size = toInteger(buffer, cursor + 1, end - 2);
+        cursor = end;
+        for (long long i = 0; i < size; i++) {
+            end = lineEnd(buffer, cursor);
+            if (end == string::npos) return false;
+            if (buffer[cursor] == '$') {
+                long long length = toInteger(buffer, cursor + 1, end - 2);
+                if (length < 0) {
+                    items.emplace_back();
+                    cursor = end;
+                    continue;
+                }
+                if (buffer.size() < end + length + 2) return false;
+                items.emplace_back(buffer.data() + end, length);
+                cursor = end + length + 2;
+            } else {
+                items.emplace_back(buffer.data() + cursor + 1, end - cursor - 3);
+                cursor = end;
+            }
+        }
+        pos = cursor;
+        return true;
+    }
+}
+
+
+RedisMessageQueue::RedisMessageQueue(size_t capacity) :
+    enqueuePosition(0),
+    dequeuePosition(0),
+    dropped(0)
+{
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    cells = make_unique<Cell[]>(size);
+    mask = size - 1;
+    for (size_t i = 0; i < size; i++) {
+        cells[i].sequence.store(i, memory_order_relaxed);
+    }
+}
+
+bool RedisMessageQueue::push(string_view pattern, string_view channel, string_view message)
+{
+    Cell* cell;
+    size_t position = enqueuePosition.load(memory_order_relaxed);
+    for (;;) {
+        cell = &cells[position & mask];
+        size_t sequence = cell->sequence.load(memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, memory_order_relaxed)) break;
+        } else if (difference < 0) {
+            dropped++;
+            return false;  // full
+        } else {
+            position = enqueuePosition.load(memory_order_relaxed);
+        }
+    }
+    cell->message.pattern.assign(pattern);
+    cell->message.channel.assign(channel);
+    cell->message.message.assign(message);
+    cell->sequence.store(position + 1, memory_order_release);
+    return true;
+}
+
+bool RedisMessageQueue::pop(RedisMessage& message, size_t until)
+{
+    size_t position = dequeuePosition.load(memory_order_relaxed);
+    if (position >= until) {
+        return false;
+    }
+    Cell* cell = &cells[position & mask];
+    size_t sequence = cell->sequence.load(memory_order_acquire);
+    if ((intptr_t)sequence - (intptr_t)(position + 1) < 0) {
+        return false;  // empty
+    }
+    dequeuePosition.store(position + 1, memory_order_relaxed);
+    // swap keeps the capacity of the strings in the cell and in the message
+    swap(message.pattern, cell->message.pattern);
+    swap(message.channel, cell->message.channel);
+    swap(message.message, cell->message.message);
+    cell->sequence.store(position + mask + 1, memory_order_release);
+    return true;
+}
+
+size_t RedisMessageQueue::position() const
+{
+    return enqueuePosition.load(memory_order_acquire);
+}
+
+size_t RedisMessageQueue::takeDropped()
+{
+    return dropped.exchange(0);
+}
+
+
+RedisDispatcher::RedisDispatcher(string ip, int port, chrono::milliseconds reconnectPeriod) :
+    ip(ip),
+    port(port),
+    nextId(0),
+    queue(make_shared<RedisMessageQueue>(queueCapacity)),
+    running(false),
+    isConnected(false),
+    reconnectPeriod(reconnectPeriod),
+    wakeFd{-1, -1}
+{
+}
+
+RedisDispatcher::RedisDispatcher(shared_ptr<LocalStore> store) :
+    port(0),
+    store(store),
+    nextId(0),
+    queue(make_shared<RedisMessageQueue>(queueCapacity)),
+    running(false),
+    isConnected(true),
+    reconnectPeriod(0),
+    wakeFd{-1, -1}
+{
+}
+
+RedisDispatcher::~RedisDispatcher()
+{
+    if (store) {
+        for (auto& it: storeSubscriptions) {
+            store->punsubscribe(it.second);
+        }
+    }
+    if (thread.joinable()) {
+        {
+            lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        stopCondition.notify_all();
+        [[maybe_unused]] ssize_t n = write(wakeFd[1], "x", 1);
+        thread.join();
+    }
+    if (wakeFd[0] >= 0) close(wakeFd[0]);
+    if (wakeFd[1] >= 0) close(wakeFd[1]);
+}
+
+void RedisDispatcher::start()
+{
+    if (thread.joinable()) return;
+    if (pipe(wakeFd) != 0) {
+        LoggerStream::getInstance() << ERROR << "Redis dispatcher could not create its wake pipe";
+        return;
+    }
+    fcntl(wakeFd[0], F_SETFL, O_NONBLOCK);
+    running = true;
+    thread = std::thread(&RedisDispatcher::run, this);
+}
+
+void RedisDispatcher::run()
+{
+    string buffer;
+    string requestBuffer;
+    vector<string_view> items;
+    char chunk[4096];
+    bool reported = false;
+
+    while (running) {
+        int fd = connectSocket(ip, port);
+        if (fd >= 0) {
+            // (re)subscribe everything, commands queued before are covered
+            requestBuffer.clear();
+            {
+                lock_guard<std::mutex> lock(mutex);
+                pendingCommands.clear();
+                vector<string> names;
+                for (auto it = channels.begin(); it != channels.end(); it = channels.upper_bound(*it)) names.push_back(*it);
+                if (!names.empty()) RespReader::appendCommand(requestBuffer, "SUBSCRIBE", names);
+                names.clear();
+                for (auto it = patterns.begin(); it != patterns.end(); it = patterns.upper_bound(*it)) names.push_back(*it);
+                if (!names.empty()) RespReader::appendCommand(requestBuffer, "PSUBSCRIBE", names);
+            }
+            if (sendAll(fd, requestBuffer)) {
+                isConnected = true;
+                reported = false;
+                LoggerStream::getInstance() << INFO << "Redis dispatcher connected to " << ip << ":" << port;
+                resync();
+            }
+            buffer.clear();
+
+            while (running && isConnected) {
+                pollfd fds[2] = {{fd, POLLIN, 0}, {wakeFd[0], POLLIN, 0}};
+                if (poll(fds, 2, -1) < 0) continue;
+
+                if (fds[1].revents & POLLIN) {
+                    while (read(wakeFd[0], chunk, sizeof(chunk)) > 0) {}
+                    requestBuffer.clear();
+                    {
+                        lock_guard<std::mutex> lock(mutex);
+                        for (const auto& command: pendingCommands) {
+                            RespReader::appendCommand(requestBuffer, command.front(), vector<string>(command.begin() + 1, command.end()));
+                        }
+                        pendingCommands.clear();
+                    }
+                    if (!requestBuffer.empty() && !sendAll(fd, requestBuffer)) {
+                        isConnected = false;
+                    }
+                }
+
+                if (fds[0].revents & (POLLIN | POLLHUP | POLLERR)) {
+                    ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+                    if (n <= 0) {
+                        isConnected = false;
+                        break;
+                    }
+                    buffer.append(chunk, n);
+                    size_t pos = 0;
+                    while (pos < buffer.size() && parseArray(buffer, pos, items)) {
+                        if (items.size() == 3 && items[0] == "message") {
+                            queue->push("", items[1], items[2]);
+                        } else if (items.size() == 4 && items[0] == "pmessage") {
+                            queue->push(items[1], items[2], items[3]);
+                        }
+                    }
+                    buffer.erase(0, pos);
+                }
+            }
+            close(fd);
+        }
+
+        if (running) {
+            isConnected = false;
+            if (!reported) {
+                LoggerStream::getInstance() << WARN << "Redis dispatcher not connected to " << ip << ":" << port << ", reconnecting";
+                reported = true;
+            }
+            unique_lock<std::mutex> lock(mutex);
+            stopCondition.wait_for(lock, reconnectPeriod, [this]() { return !running; });
+        }
+    }
+}
+
+void RedisDispatcher::request(vector<string> command)
+{
+    {
+        lock_guard<std::mutex> lock(mutex);
+        pendingCommands.push_back(std::move(command));
+    }
+    [[maybe_unused]] ssize_t n = write(wakeFd[1], "x", 1);
+}
+
+int RedisDispatcher::add(bool isPattern, const string& name, RedisMessageCallback callback)
+{
+    int id = nextId++;
+    subscriptions.push_back({id, isPattern, name, callback});
+
+    if (store) {
+        string storeKey = (isPattern ? "p:" : "c:") + name;
+        if (storeSubscriptions.count(storeKey) == 0) {
+            // a channel is subscribed as a pattern of itself, the store only removes patterns by id
+            string storePattern = isPattern ? name : keyspacePattern(name).substr(string("__keyspace@*__:").size());
+            storeSubscriptions[storeKey] = store->psubscribe(storePattern,
+                [queue = queue, isPattern, name](const string& channel, const string_view& message) {
+                    queue->push(isPattern ? string_view(name) : string_view(), channel, message);
+                });
+        }
+    } else {
+        bool first;
+        {
+            lock_guard<std::mutex> lock(mutex);
+            auto& names = isPattern ? patterns : channels;
+            first = names.count(name) == 0;
+            names.insert(name);
+        }
+        if (!thread.joinable()) {
+            start();
+        } else if (first) {
+            request({isPattern ? "PSUBSCRIBE" : "SUBSCRIBE", name});
+        }
+    }
+
+    // the state before the subscription is unknown to the callback
+    resync();
+    return id;
+}
+
+int RedisDispatcher::subscribe(const string& channel, RedisMessageCallback callback)
+{
+    return add(false, channel, callback);
+}
+
+int RedisDispatcher::psubscribe(const string& pattern, RedisMessageCallback callback)
+{
+    return add(true, pattern, callback);
+}
+
+void RedisDispatcher::unsubscribe(int id)
+{
+    auto it = find_if(subscriptions.begin(), subscriptions.end(), [id](const Subscription& s) { return s.id == id; });
+    if (it == subscriptions.end()) return;
+    bool isPattern = it->isPattern;
+    string name = it->name;
+    subscriptions.erase(it);
+
+    bool last = none_of(subscriptions.begin(), subscriptions.end(),
+        [&](const Subscription& s) { return s.isPattern == isPattern && s.name == name; });
+    if (store) {
+        string storeKey = (isPattern ? "p:" : "c:") + name;
+        if (last && storeSubscriptions.count(storeKey) > 0) {
+            store->punsubscribe(storeSubscriptions[storeKey]);
+            storeSubscriptions.erase(storeKey);
+        }
+    } else {
+        {
+            lock_guard<std::mutex> lock(mutex);
+            auto& names = isPattern ? patterns : channels;
+            auto found = names.find(name);
+            if (found != names.end()) names.erase(found);
+        }
+        if (last) {
+            request({isPattern ? "PUNSUBSCRIBE" : "UNSUBSCRIBE", name});
+        }
+    }
+}
+
+size_t RedisDispatcher::dispatch(size_t until)
+{
+    size_t lost = queue->takeDropped();
+    if (lost > 0) {
+        // the dropped messages are unknown, every callback is called like after a (re)connection; resync() can not be
+        // used, the queue is full
+        LoggerStream::getInstance() << WARN << "Redis dispatcher queue full, " << lost << " messages dropped, resync";
+        deliver(RedisMessage());
+    }
+
+    size_t count = 0;
+    while (queue->pop(received, until)) {
+        count++;
+        deliver(received);
+    }
+    return count;
+}
+
+void RedisDispatcher::deliver(const RedisMessage& message)
+{
+    bool all = message.pattern.empty() && message.channel.empty();
+    // by index, a callback may add or remove subscriptions
+    for (size_t i = 0; i < subscriptions.size(); i++) {
+        const Subscription& subscription = subscriptions[i];
+        bool match = all || (subscription.isPattern ?
+            subscription.name == message.pattern :
+            message.pattern.empty() && subscription.name == message.channel);
+        if (match) {
+            RedisMessageCallback callback = subscription.callback;
+            callback(message);
+        }
+    }
+}
+
+size_t RedisDispatcher::queued() const
+{
+    return queue->position();
+}
+
+void RedisDispatcher::resync()
+{
+    queue->push("", "", "");
+}
+
+bool RedisDispatcher::connected() const
+{
+    return isConnected;
+}
+
+string RedisDispatcher::keyspacePattern(const string& key)
+{
+    string pattern = "__keyspace@*__:";
+    for (char c: key) {
+        if (c == '*' || c == '?' || c == '[' || c == ']' || c == '\\') pattern += '\\';
+        pattern += c;
+    }
+    return pattern;
+}
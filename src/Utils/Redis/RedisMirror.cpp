@@ -0,0 +1,284 @@
+#include <Utils/Redis/RedisMirror.h>
+#include <Utils/Logging/LoggerStream.h>
+
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Utils::Logging;
+using namespace nlohmann;
+using namespace std;
+
+namespace {
+    /** @brief Channel prefix of the keyspace notifications of the store and of database 0 of the server */
+    const string keyspacePrefix = "__keyspace@0__:";
+    /** @brief Period of the full reads of the server without keyspace notifications */
+    const chrono::seconds pullPeriod(1);
+
+    string joinFields(const vector<string>& fieldValues)
+    {
+        string s;
+        for (const string& item: fieldValues) {
+            s += item;
+            s += '\0';
+        }
+        return s;
+    }
+
+    /** @brief Fields of the mirrored value of a hash that are not in fieldValues, none if the value is not a hash */
+    vector<string> removedFields(const string& value, const vector<string>& fieldValues)
+    {
+        vector<string> removed;
+        if (value.empty() || value[0] != 'h') return removed;
+        unordered_set<string> fields;
+        for (size_t i = 0; i < fieldValues.size(); i += 2) {
+            fields.insert(fieldValues[i]);
+        }
+        // the fields and values alternate, each followed by a '\0'
+        bool isField = true;
+        for (size_t start = 1, end; start < value.size(); start = end + 1) {
+            end = value.find('\0', start);
+            if (isField && fields.count(value.substr(start, end - start)) == 0) {
+                removed.push_back(value.substr(start, end - start));
+            }
+            isField = !isField;
+        }
+        return removed;
+    }
+}
+
+
+RedisMirror::RedisMirror(shared_ptr<LocalStore> store, const json& redis, chrono::milliseconds period) :
+    store(store),
+    redis(redis),
+    rs(redis),
+    dispatcher(redis["ip"], redis["port"]),
+    period(period),
+    running(false)
+{
+    init();
+}
+
+RedisMirror::RedisMirror(shared_ptr<LocalStore> store, shared_ptr<LocalStore> server, chrono::milliseconds period) :
+    store(store),
+    server(server),
+    rs(server),
+    dispatcher(server),
+    period(period),
+    running(false)
+{
+    init();
+}
+
+void RedisMirror::init()
+{
+    store->setChangeHook([this](const string& key) {
+        lock_guard<std::mutex> lock(mutex);
+        dirty.insert(key);
+    });
+    store->setPublishHook([this](const string& channel, const string& message) {
+        lock_guard<std::mutex> lock(mutex);
+        published.emplace_back(channel, message);
+    });
+
+    keyspaceEvents = rs.enableKeyspaceEvents();
+    if (keyspaceEvents) {
+        dispatcher.psubscribe(keyspacePrefix + "*", [this](const RedisMessage& message) {
+            // an empty message after a (re)connection, notifications may have been missed
+            changed.push_back(message.channel.empty() ? "" : message.channel.substr(keyspacePrefix.size()));
+        });
+    } else {
+        LoggerStream::getInstance() << WARN << "No redis keyspace notifications, the mirror reads all keys every " << pullPeriod.count() << " s.";
+    }
+}
+
+RedisMirror::~RedisMirror()
+{
+    stop();
+    store->setChangeHook(nullptr);
+    store->setPublishHook(nullptr);
+}
+
+string RedisMirror::storeValue(const string& key)
+{
+    string type = store->type(key);
+    if (type == "string") return "s" + store->get(key);
+    if (type == "hash") return "h" + joinFields(store->hgetall(key));
+    if (type == "ReJSON-RL") return "j" + store->getJson(key).dump();
+    return "";
+}
+
+void RedisMirror::pullKey(const string& key)
+{
+    string type = rs.getRedisType(key);
+    string value;
+    vector<string> fieldValues;
+    json j;
+    if (type == "string") {
+        value = "s" + rs.getRedisValue(key);
+    } else if (type == "hash") {
+        fieldValues = rs.getRedisHashAll(key);
+        value = "h" + joinFields(fieldValues);
+    } else if (type == "ReJSON-RL") {
+        j = rs.getRedisJsonValue(key);
+        value = "j" + j.dump();
+    } else if (type != "none") {
+        return;  // lists, sets, streams, ... are not used by the variable managers
+    }
+
+    auto it = mirrored.find(key);
+    if (it != mirrored.end() ? it->second == value : value.empty()) {
+        return;
+    }
+    // the change of the store is skipped by the next sync, the value equals the mirrored value
+    if (value.empty()) {
+        mirrored.erase(key);
+        store->del({key});
+    } else {
+        vector<string> removed = it != mirrored.end() ? removedFields(it->second, fieldValues) : vector<string>();
+        mirrored[key] = value;
+        if (type == "string") {
+            store->set(key, value.substr(1));
+        } else if (type == "hash") {
+            store->hset(key, fieldValues);
+            if (!removed.empty()) store->hdel(key, removed);
+        } else {
+            store->setJson(key, j);
+        }
+    }
+}
+
+void RedisMirror::pull()
+{
+    echoes.clear();
+    for (const string& key: rs.getRedisKeys()) {
+        pullKey(key);
+    }
+    lastPull = chrono::steady_clock::now();
+}
+
+void RedisMirror::sync()
+{
+    // store -> server
+    unordered_set<string> keys;
+    vector<pair<string, string>> messages;
+    {
+        lock_guard<std::mutex> lock(mutex);
+        swap(keys, dirty);
+        swap(messages, published);
+    }
+
+    vector<string> hashKeys;
+    vector<vector<string>> hashFieldValues;
+    vector<string> flatValues;
+    vector<pair<string, vector<string>>> removedHashFields;
+    for (const string& key: keys) {
+        string value = storeValue(key);
+        auto it = mirrored.find(key);
+        if (it != mirrored.end() ? it->second == value : value.empty()) {
+            continue;  // unchanged, or copied from the server
+        }
+        if (value.empty()) {
+            mirrored.erase(key);
+            // the server only notifies the deletion of a key it has
+            if (rs.delRedisValues(key) > 0 && keyspaceEvents) echoes[key]++;
+            continue;
+        }
+        if (value[0] == 's') {
+            flatValues.push_back(key);
+            flatValues.push_back(value.substr(1));
+        } else if (value[0] == 'h') {
+            vector<string> fieldValues = store->hgetall(key);
+            vector<string> removed = it != mirrored.end() ? removedFields(it->second, fieldValues) : vector<string>();
+            if (!removed.empty()) removedHashFields.emplace_back(key, removed);
+            hashKeys.push_back(key);
+            hashFieldValues.push_back(std::move(fieldValues));
+        } else {
+            rs.setRedisJsonValue(key, store->getJson(key));
+        }
+        mirrored[key] = value;
+        if (keyspaceEvents) echoes[key]++;
+    }
+    if (!hashKeys.empty() || !flatValues.empty()) {
+        rs.setRedisHashValues(hashKeys, hashFieldValues, flatValues);
+    }
+    // after the new fields are set, the hash is never empty on the server in between
+    for (const auto& hash: removedHashFields) {
+        if (rs.delRedisHashFields(hash.first, hash.second) > 0 && keyspaceEvents) echoes[hash.first]++;
+    }
+    for (const auto& message: messages) {
+        rs.publishRedisValue(message.first, message.second);
+    }
+
+    // server -> store
+    if (keyspaceEvents) {
+        dispatcher.dispatch();
+        bool all = false;
+        for (const string& key: changed) {
+            if (key.empty()) {
+                all = true;
+                continue;
+            }
+            auto echo = echoes.find(key);
+            if (echo != echoes.end()) {
+                if (--echo->second == 0) echoes.erase(echo);
+                continue;
+            }
+            pullKey(key);
+        }
+        changed.clear();
+        if (all) pull();
+    } else if (chrono::steady_clock::now() - lastPull >= pullPeriod) {
+        pull();
+    }
+}
+
+void RedisMirror::reconnect()
+{
+    rs = server ? RedisStream(server) : RedisStream(redis);
+    mirrored.clear();
+    echoes.clear();
+    vector<string> keys = store->keys();
+    lock_guard<std::mutex> lock(mutex);
+    dirty.insert(keys.begin(), keys.end());
+}
+
+void RedisMirror::run()
+{
+    bool failed = false;
+    while (running) {
+        auto start = chrono::steady_clock::now();
+        try {
+            if (failed) reconnect();
+            sync();
+            if (failed) LoggerStream::getInstance() << INFO << "Redis mirror synchronised again.";
+            failed = false;
+        } catch (std::exception& e) {
+            if (!failed) LoggerStream::getInstance() << ERROR << "Redis mirror: " << e.what();
+            failed = true;
+        }
+        unique_lock<std::mutex> lock(mutex);
+        stopCondition.wait_until(lock, start + period, [this]() { return !running; });
+    }
+}
+
+void RedisMirror::start()
+{
+    if (thread.joinable()) return;
+    running = true;
+    thread = std::thread(&RedisMirror::run, this);
+}
+
+void RedisMirror::stop()
+{
+    if (!thread.joinable()) return;
+    {
+        lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    stopCondition.notify_all();
+    thread.join();
+    // the last changes of the core loops
+    try {
+        sync();
+    } catch (std::exception& e) {
+        LoggerStream::getInstance() << ERROR << "Redis mirror: " << e.what();
+    }
+}
@@ -1,11 +1,34 @@
 #include <Utils/Redis/RedisStream.h>
 #include <Utils/Logging/LoggerStream.h>
+#include <Exceptions/RedisExceptions.hpp>
+
+#include <fnmatch.h>
 
 using namespace Ilvo::Utils::Redis;
 using namespace nlohmann;
 using namespace std;
 using namespace rediscpp;
 using namespace Ilvo::Utils::Logging;
+using namespace Ilvo::Exception;
+
+namespace {
+    /** @brief Elements of an array reply, nil elements are empty strings */
+    vector<string> toStrings(const rediscpp::value& response)
+    {
+        auto arr = std::get<deserialization::array>(response.get()).get();
+        vector<string> result;
+        result.reserve(arr.size());
+        for (auto& item: arr) {
+            auto* bulk = std::get_if<deserialization::bulk_string>(&item);
+            if (bulk && bulk->is_null()) {
+                result.emplace_back();  // nil
+            } else {
+                result.emplace_back(rediscpp::value(item).as_string());
+            }
+        }
+        return result;
+    }
+}
 
 RedisStream::RedisStream(json j) : RedisStream(j["ip"], j["port"]) {}
 
@@ -13,10 +36,15 @@ RedisStream::RedisStream(string ip, int port) : ip(ip), port(port) {
     stream = make_stream(ip, to_string(port));
 }
 
-RedisStream::~RedisStream() {
-    for (auto& it : subscriberThreads) {
-        it.second.second->store(true);
-        it.second.first->join();
+RedisStream::RedisStream(shared_ptr<LocalStore> store) : port(0), store(store) {}
+
+void RedisStream::dropConnection()
+{
+    LoggerStream::getInstance() << WARN << "Redis reply out of step, reconnecting to " << ip << ":" << port;
+    try {
+        stream = make_stream(ip, to_string(port));
+    } catch (std::exception& e) {
+        LoggerStream::getInstance() << ERROR << "Redis reconnect to " << ip << ":" << port << ": " << e.what();
     }
 }
 
@@ -27,6 +55,10 @@ bool RedisStream::isRedisValueNil(string key) {
 
 bool RedisStream::setRedisValues(std::vector<std::string> values) 
 {
+    if (store) {
+        store->mset(values);
+        return false;
+    }
     if (values.size() > 0) {
         auto response = execute(*(stream), "MSET", values);
         return response.as_string().compare("OK") != 0;
@@ -34,15 +66,150 @@ bool RedisStream::setRedisValues(std::vector<std::string> values)
     return true;
 }
 
-deserialization::array::items_type RedisStream::getRedisValues(std::vector<std::string> values)
+vector<string> RedisStream::getRedisValues(std::vector<std::string> values)
 {
+    if (store) {
+        return store->mget(values);
+    }
     auto response = execute(*(stream), "MGET", values);
-    auto arr = std::get<deserialization::array>(response.get()).get();
-    return arr;
+    return toStrings(response);
+}
+
+vector<vector<string>> RedisStream::getRedisHashValues(const vector<string>& keys, const vector<vector<string>>& fields)
+{
+    vector<vector<string>> result;
+    result.reserve(keys.size());
+    if (store) {
+        for (size_t i = 0; i < keys.size(); i++) {
+            result.push_back(store->hmget(keys[i], fields[i]));
+        }
+        return result;
+    }
+    for (size_t i = 0; i < keys.size(); i++) {
+        vector<string> args;
+        args.reserve(fields[i].size() + 1);
+        args.push_back(keys[i]);
+        args.insert(args.end(), fields[i].begin(), fields[i].end());
+        execute_no_flush(*(stream), "HMGET", args);
+    }
+    std::flush(*(stream));
+    // all replies are read before an error reply is thrown, the next command reads its own reply
+    vector<rediscpp::value> responses;
+    responses.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        responses.emplace_back(*(stream));
+    }
+    for (auto& response: responses) {
+        if (response.is_error_message()) {
+            throw RedisErrorReplyException(string(response.as_error_message()));
+        }
+        result.push_back(toStrings(response));
+    }
+    return result;
+}
+
+const vector<string_view>& RedisStream::storeValueViews(size_t count)
+{
+    storeViews.clear();
+    for (size_t i = 0; i < count; i++) {
+        storeViews.emplace_back(storeNil[i] ? string_view() : string_view(storeValues[i]));
+    }
+    return storeViews;
+}
+
+const vector<string_view>& RedisStream::getRedisValueViews(const vector<string>& keys)
+{
+    if (store) {
+        store->mget(keys, storeValues, storeNil, 0);
+        return storeValueViews(keys.size());
+    }
+    request.clear();
+    RespReader::appendCommand(request, "MGET", keys);
+    stream->write(request.data(), request.size());
+    std::flush(*(stream));
+
+    reader.begin();
+    try {
+        reader.readArray(*(stream));
+    } catch (RedisErrorReplyException&) {
+        throw;
+    } catch (std::exception&) {
+        dropConnection();
+        throw;
+    }
+    return reader.values();
+}
+
+const vector<string_view>& RedisStream::getRedisHashValueViews(const vector<string>& keys, const vector<vector<string>>& fields)
+{
+    if (store) {
+        size_t offset = 0;
+        for (size_t i = 0; i < keys.size(); i++) {
+            store->hmget(keys[i], fields[i], storeValues, storeNil, offset);
+            offset += fields[i].size();
+        }
+        return storeValueViews(offset);
+    }
+    request.clear();
+    for (size_t i = 0; i < keys.size(); i++) {
+        RespReader::appendCommand(request, "HMGET", keys[i], fields[i]);
+    }
+    stream->write(request.data(), request.size());
+    std::flush(*(stream));
+
+    reader.begin();
+    try {
+        reader.readArrays(*(stream), keys.size());
+    } catch (RedisErrorReplyException&) {
+        throw;  // the replies of all commands are read
+    } catch (std::exception&) {
+        dropConnection();
+        throw;
+    }
+    return reader.values();
+}
+
+bool RedisStream::setRedisHashValues(const vector<string>& keys, const vector<vector<string>>& fieldValues, const vector<string>& flatValues)
+{
+    if (store) {
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (!fieldValues[i].empty()) store->hset(keys[i], fieldValues[i]);
+        }
+        store->mset(flatValues);
+        return false;
+    }
+    int commands = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (fieldValues[i].empty()) continue;
+        vector<string> args;
+        args.reserve(fieldValues[i].size() + 1);
+        args.push_back(keys[i]);
+        args.insert(args.end(), fieldValues[i].begin(), fieldValues[i].end());
+        execute_no_flush(*(stream), "HSET", args);
+        commands++;
+    }
+    if (!flatValues.empty()) {
+        execute_no_flush(*(stream), "MSET", flatValues);
+        commands++;
+    }
+    std::flush(*(stream));
+    bool failed = false;
+    for (int i = 0; i < commands; i++) {
+        rediscpp::value response{*(stream)};
+        if (response.is_error_message()) {
+            LoggerStream::getInstance() << ERROR << "Redis set hash values: " << response.as_error_message();
+            failed = true;
+        }
+    }
+    return failed;
 }
 
 bool RedisStream::setRedisJsonValue(string name, const nlohmann::json& j)
 {
+    if (store) {
+        store->setJson(name, j.empty() ? json::object() : j);
+        return false;
+    }
     string value = j.empty() ? "{}" : j.dump();
     auto response = execute(*(stream), "JSON.SET", name, "$", value);
     return response.as_string().compare("OK") != 0;
@@ -50,12 +217,13 @@ bool RedisStream::setRedisJsonValue(string name, const nlohmann::json& j)
 
 json RedisStream::getRedisJsonValue(string name)
 {
+    if (store) {
+        return store->getJson(name);
+    }
     auto response = execute(*(stream), "JSON.GET", name);
     try {
-        string value {response.as<string>()};
-        std::string s = (std::string) response.as_string();
-        // LoggerStream::getInstance() << DEBUG << "value: " << s << std::endl;
-        return json::parse(value);
+        string_view value = response.as<string_view>();
+        return json::parse(value.begin(), value.end());
     } catch(std::logic_error& e) {
         LoggerStream::getInstance() << ERROR << "Redis Get Json Value logic error for \"" << name << "\", " << e.what();
         return json();
@@ -70,12 +238,18 @@ json RedisStream::getRedisJsonValue(string name)
 
 json RedisStream::getRedisJsonValue(string name, json initIfNotExists)
 {
+    if (store) {
+        json j = store->getJson(name);
+        if (j.is_null()) {
+            setRedisJsonValue(name, initIfNotExists);
+            return initIfNotExists;
+        }
+        return j;
+    }
     auto response = execute(*(stream), "JSON.GET", name);
     try {
-        string value {response.as<string>()};
-        std::string s = (std::string) response.as_string();
-        // LoggerStream::getInstance() << DEBUG << "value: " << s << std::endl;
-        return json::parse(value);
+        string_view value = response.as<string_view>();
+        return json::parse(value.begin(), value.end());
     } catch(std::logic_error& e) {
         setRedisJsonValue(name, initIfNotExists);
         LoggerStream::getInstance() << ERROR << "Redis Get Json Value logic error for \"" << name << "\", " << e.what();
@@ -87,53 +261,96 @@ json RedisStream::getRedisJsonValue(string name, json initIfNotExists)
 }
 
 
-void RedisStream::subscribeRedisValue(std::string& name,std::function<void(const std::string_view&)>& callback) {
-    auto detached = std::make_shared<std::atomic<bool>>(false);
-    auto thread = std::make_shared<boost::thread>(
-        [this, name, callback]
-        {
-            auto response = rediscpp::execute(*this->stream, "subscribe", name);
-            // An almost endless loop for getting messages from the queues.
-            while (!this->subscriberThreads[name].second->load())
-            {
-                // Reading / waiting for a message.
-                rediscpp::value value{*stream};
-                // Message extraction.
-                std::visit(rediscpp::resp::detail::overloaded{
-                        // We're wondered only an array in response.
-                        // Otherwise, there is an error.
-                        [callback, name] (rediscpp::resp::deserialization::array const &arr)
-                        {
-                            for (int i = 2; i < arr.size(); i++) {
-                                auto const &item = arr.get()[i];
-                                using namespace rediscpp::resp::deserialization;
-                                std::visit(rediscpp::resp::detail::overloaded{
-                                    [callback] (bulk_string const &item)
-                                    { callback(item.get());},
-                                    [name] (auto const &)
-                                    { LoggerStream::getInstance() << ERROR << "Redis SUBSCRIBE " << name << "Unexpected value type."; }
-                                }, item);
-                            }
-                        },
-                        // An error in a response.
-                        [name] (rediscpp::resp::deserialization::error_message const &err)
-                        { LoggerStream::getInstance() << ERROR << "Redis SUBSCRIBE " << name << ": " << err.get(); },
-                        // An unexpected response.
-                        [name] (auto const &)
-                        { LoggerStream::getInstance() << ERROR << "Redis SUBSCRIBE " << name << "Unexpected value type."; }
-                    }, value.get());
-            }
+string RedisStream::getRedisType(const string& key)
+{
+    if (store) {
+        return store->type(key);
+    }
+    auto response = execute(*(stream), "TYPE", key);
+    return string(response.as_string());
+}
+
+vector<string> RedisStream::getRedisKeys(const string& pattern)
+{
+    if (store) {
+        vector<string> keys;
+        for (const string& key: store->keys()) {
+            if (fnmatch(pattern.c_str(), key.c_str(), 0) == 0) keys.push_back(key);
+        }
+        return keys;
+    }
+    vector<string> keys;
+    string cursor = "0";
+    do {
+        auto response = execute(*(stream), "SCAN", cursor, "MATCH", pattern, "COUNT", "1000");
+        auto arr = std::get<deserialization::array>(response.get()).get();
+        cursor = rediscpp::value(arr[0]).as_string();
+        for (const string& key: toStrings(rediscpp::value(arr[1]))) {
+            keys.push_back(key);
         }
-    );
+    } while (cursor != "0");
+    return keys;
+}
 
-    subscriberThreads[name] = std::make_pair(std::move(thread), std::move(detached));
+vector<string> RedisStream::getRedisHashAll(const string& key)
+{
+    if (store) {
+        return store->hgetall(key);
+    }
+    auto response = execute(*(stream), "HGETALL", key);
+    vector<string> fieldValues = toStrings(response);
+    map<string, string> sorted;
+    for (size_t i = 0; i + 1 < fieldValues.size(); i += 2) {
+        sorted[fieldValues[i]] = fieldValues[i + 1];
+    }
+    vector<string> result;
+    result.reserve(fieldValues.size());
+    for (const auto& field: sorted) {
+        result.push_back(field.first);
+        result.push_back(field.second);
+    }
+    return result;
 }
 
-void RedisStream::detachSubscribeRedisValue(std::string& name) {
-    subscriberThreads[name].second->store(true);
+int RedisStream::delRedisHashFields(const string& key, const vector<string>& fields)
+{
+    if (store) {
+        return store->hdel(key, fields);
+    }
+    vector<string> args;
+    args.reserve(fields.size() + 1);
+    args.push_back(key);
+    args.insert(args.end(), fields.begin(), fields.end());
+    auto response = execute(*(stream), "HDEL", args);
+    return response.as_integer();
 }
 
-void RedisStream::unsubscribeRedisValue(std::string& name) {
-    subscriberThreads[name].first->join();
-    subscriberThreads.erase(name);
+bool RedisStream::enableKeyspaceEvents()
+{
+    if (store) {
+        return true;  // the store always publishes them
+    }
+    auto current = execute(*(stream), "CONFIG", "GET", "notify-keyspace-events");
+    if (current.is_error_message()) {
+        LoggerStream::getInstance() << WARN << "Redis keyspace events: " << current.as_error_message();
+        return false;
+    }
+    vector<string> reply = toStrings(current);
+    string configured = reply.size() > 1 ? reply[1] : "";
+    // K: keyspace channels, $: strings, h: hashes, g: DEL and other generic commands, d: module types (RedisJSON).
+    // Lists, sets, sorted sets, streams, expiry and eviction are not used by the variables and stay off, the
+    // notifications are published for every key of the server. Flags set by others are kept.
+    for (string events: {"K$hgd", "K$hg"}) {
+        string flags = configured;
+        for (char flag: events) {
+            if (flags.find(flag) == string::npos) flags += flag;
+        }
+        auto response = execute(*(stream), "CONFIG", "SET", "notify-keyspace-events", flags);
+        if (!response.is_error_message()) {
+            return true;
+        }
+        // servers before 7.0 have no 'd', RedisJSON then notifies as a generic command
+        LoggerStream::getInstance() << WARN << "Redis keyspace events " << flags << ": " << response.as_error_message();
+    }
+    return false;
 }
\ No newline at end of file
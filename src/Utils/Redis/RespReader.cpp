@@ -0,0 +1,150 @@
+#include <Utils/Redis/RespReader.h>
+#include <Exceptions/RedisExceptions.hpp>
+
+#include <charconv>
+
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Exception;
+using namespace std;
+
+namespace {
+    /** @brief Content of a header line without its type prefix and \r */
+    string_view content(const string& line)
+    {
+        size_t end = (!line.empty() && line.back() == '\r') ? line.size() - 1 : line.size();
+        return line.size() > 1 ? string_view(line.data() + 1, end - 1) : string_view();
+    }
+
+    long long toInteger(const string& line)
+    {
+        string_view s = content(line);
+        long long value = 0;
+        auto result = from_chars(s.data(), s.data() + s.size(), value);
+        if (result.ec != errc()) {
+            throw RedisCommandExectionException("Invalid RESP header \"" + string(s) + "\"");
+        }
+        return value;
+    }
+
+    void appendHeader(string& request, char type, size_t size)
+    {
+        char digits[24];
+        auto result = to_chars(digits, digits + sizeof(digits), size);
+        request += type;
+        request.append(digits, result.ptr);
+        request += "\r\n";
+    }
+
+    void appendBulk(string& request, string_view s)
+    {
+        appendHeader(request, '$', s.size());
+        request.append(s);
+        request += "\r\n";
+    }
+}
+
+void RespReader::begin()
+{
+    buffer.clear();
+    spans.clear();
+}
+
+void RespReader::readLine(istream& is)
+{
+    getline(is, line);
+    if (!is || line.empty()) {
+        throw RedisCommandExectionException("Redis connection lost while reading a reply");
+    }
+}
+
+size_t RespReader::readArray(istream& is)
+{
+    readLine(is);
+    if (line[0] == '-') {
+        throw RedisErrorReplyException(string(content(line)));
+    }
+    return readElements(is);
+}
+
+size_t RespReader::readArrays(istream& is, size_t count)
+{
+    string error;
+    size_t elements = 0;
+    for (size_t i = 0; i < count; i++) {
+        readLine(is);
+        if (line[0] == '-') {
+            if (error.empty()) error = content(line);
+            continue;
+        }
+        elements += readElements(is);
+    }
+    if (!error.empty()) {
+        throw RedisErrorReplyException(error);
+    }
+    return elements;
+}
+
+size_t RespReader::readElements(istream& is)
+{
+    if (line[0] != '*') {
+        throw RedisCommandExectionException("Unexpected reply \"" + line + "\", expected an array");
+    }
+
+    long long size = toInteger(line);
+    for (long long i = 0; i < size; i++) {
+        readLine(is);
+        if (line[0] == '$') {
+            long long length = toInteger(line);
+            if (length < 0) {
+                spans.emplace_back(buffer.size(), string::npos);  // nil
+                continue;
+            }
+            size_t offset = buffer.size();
+            buffer.resize(offset + length);
+            is.read(buffer.data() + offset, length);
+            // \r\n, read instead of ignored, ignore peeks at the next reply and blocks on the socket
+            char crlf[2];
+            is.read(crlf, 2);
+            if (!is) {
+                throw RedisCommandExectionException("Redis connection lost while reading a reply");
+            }
+            spans.emplace_back(offset, length);
+        } else if (line[0] == '+' || line[0] == ':') {
+            string_view s = content(line);
+            spans.emplace_back(buffer.size(), s.size());
+            buffer.append(s);
+        } else {
+            throw RedisCommandExectionException("Unexpected array element \"" + line + "\"");
+        }
+    }
+    return size > 0 ? size : 0;
+}
+
+const vector<string_view>& RespReader::values()
+{
+    views.clear();
+    for (const auto& span: spans) {
+        // buffer.data() is never null, an empty string stays distinguishable from nil
+        views.emplace_back(span.second == string::npos ? string_view() : string_view(buffer.data() + span.first, span.second));
+    }
+    return views;
+}
+
+void RespReader::appendCommand(string& request, string_view cmd, const vector<string>& args)
+{
+    appendHeader(request, '*', args.size() + 1);
+    appendBulk(request, cmd);
+    for (const string& arg: args) {
+        appendBulk(request, arg);
+    }
+}
+
+void RespReader::appendCommand(string& request, string_view cmd, string_view key, const vector<string>& args)
+{
+    appendHeader(request, '*', args.size() + 2);
+    appendBulk(request, cmd);
+    appendBulk(request, key);
+    for (const string& arg: args) {
+        appendBulk(request, arg);
+    }
+}
@@ -0,0 +1,206 @@
+#include <Utils/Redis/TrajectPublisher.h>
+#include <Utils/Redis/RedisStream.h>
+#include <Utils/Geometry/PathEncoding.h>
+#include <Utils/Logging/LoggerStream.h>
+#include <ThirdParty/json.hpp>
+#include <algorithm>
+
+using namespace Ilvo::Utils::Redis;
+using namespace Ilvo::Utils::Geometry;
+using namespace Ilvo::Utils::Settings;
+using namespace Ilvo::Utils::Logging;
+
+using namespace std;
+using json = nlohmann::json;
+
+namespace {
+    const int precision = 3;
+    const char* interpolationNames[2] = {"linear", "curvy"};
+
+    /** @brief Prefix of the chunk keys of a version, 'traject.<interpolation>.<version>.' */
+    string chunkPrefix(int type, int version)
+    {
+        return string("traject.") + interpolationNames[type] + "." + to_string(version) + ".";
+    }
+
+    string chunkKey(int type, int version, size_t chunk)
+    {
+        return chunkPrefix(type, version) + to_string(chunk);
+    }
+}
+
+
+TrajectPublisher::TrajectPublisher(string ip, int port, size_t chunkSize) :
+    ip(ip),
+    port(port),
+    chunkSize(max<size_t>(chunkSize, 1)),
+    stopping(false),
+    busy(false),
+    interpolationType(InterpolationType::LINEAR),
+    interpolationChanged(false)
+{
+    thread = std::thread(&TrajectPublisher::run, this);
+}
+
+TrajectPublisher::TrajectPublisher(shared_ptr<LocalStore> store, size_t chunkSize) :
+    port(0),
+    store(store),
+    chunkSize(max<size_t>(chunkSize, 1)),
+    stopping(false),
+    busy(false),
+    interpolationType(InterpolationType::LINEAR),
+    interpolationChanged(false)
+{
+    thread = std::thread(&TrajectPublisher::run, this);
+}
+
+TrajectPublisher::~TrajectPublisher()
+{
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    thread.join();
+}
+
+void TrajectPublisher::publish(Traject& traject)
+{
+    if (traject.empty()) return;
+
+    auto snapshot = make_unique<Snapshot>();
+    snapshot->name = traject.getField().getName();
+    snapshot->raw = traject.getRawPoints();
+    for (const CornerPointPtr& corner: traject.getCorners()) {
+        snapshot->corners.push_back(make_shared<Point>(corner->point));
+    }
+    for (const bgPoint2D& p: traject.getField().getGeofence().geometry().outer()) {
+        snapshot->geofence.push_back(make_shared<Point>(p.x(), p.y()));
+    }
+    for (InterpolationType type: {InterpolationType::LINEAR, InterpolationType::CURVY}) {
+        snapshot->skeleton[type] = traject.getSkeleton(type);
+        snapshot->interpolation[type] = traject.getInterpolation(type);
+    }
+
+    {
+        lock_guard<std::mutex> lock(mutex);
+        pending = std::move(snapshot);
+        interpolationType = traject.getInterpolationType();
+        interpolationChanged = true;
+    }
+    wake.notify_all();
+}
+
+void TrajectPublisher::setInterpolation(InterpolationType type)
+{
+    {
+        lock_guard<std::mutex> lock(mutex);
+        interpolationType = type;
+        interpolationChanged = true;
+    }
+    wake.notify_all();
+}
+
+bool TrajectPublisher::waitIdle(chrono::milliseconds timeout)
+{
+    unique_lock<std::mutex> lock(mutex);
+    return idle.wait_for(lock, timeout, [this]() { return !busy && !pending && !interpolationChanged; });
+}
+
+void TrajectPublisher::run()
+{
+    unique_ptr<RedisStream> rs;
+    json header;
+    int version = 0;
+    size_t writtenChunks[2] = {0, 0};
+    // the chunks of the version before are kept for the clients that read its header before the new one was written
+    int previousVersion = 0;
+    size_t previousChunks[2] = {0, 0};
+
+    unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this]() { return stopping || pending || interpolationChanged; });
+        if (stopping) return;
+        unique_ptr<Snapshot> snapshot = std::move(pending);
+        InterpolationType type = interpolationType;
+        interpolationChanged = false;
+        busy = true;
+        lock.unlock();
+
+        try {
+            if (!rs) {
+                rs = store ? make_unique<RedisStream>(store) : make_unique<RedisStream>(ip, port);
+                if (version == 0 && rs->getRedisType("traject") == "ReJSON-RL") {
+                    // continue the versions of a previous run, a chunk key is never reused for another traject
+                    json previous = rs->getRedisJsonValue("traject");
+                    version = previous.value("version", 0);
+                    for (int t: {LINEAR, CURVY}) {
+                        writtenChunks[t] = previous.contains(interpolationNames[t]) ? previous[interpolationNames[t]].value("chunks", 0) : 0;
+                    }
+                    // chunks of older versions of the previous run
+                    for (const string& key: rs->getRedisKeys("traject.*")) {
+                        if (key.rfind(chunkPrefix(LINEAR, version), 0) != 0 && key.rfind(chunkPrefix(CURVY, version), 0) != 0) {
+                            rs->delRedisValues(key);
+                        }
+                    }
+                }
+            }
+
+            if (snapshot) {
+                auto start = chrono::steady_clock::now();
+                const vector<PointPtr>& origins = snapshot->raw.empty() ? snapshot->interpolation[LINEAR] : snapshot->raw;
+                Point origin = origins.empty() ? Point() : *origins.front();
+                json published;
+                published["name"] = snapshot->name;
+                published["version"] = ++version;
+                published["precision"] = precision;
+                published["origin"] = origin.toJson();
+                published["raw"] = encodePath(snapshot->raw, origin, precision);
+                published["corners"] = encodePath(snapshot->corners, origin, precision);
+                published["geofence"] = encodePath(snapshot->geofence, origin, precision);
+
+                for (int t: {LINEAR, CURVY}) {
+                    const vector<PointPtr>& points = snapshot->interpolation[t];
+                    size_t chunks = (points.size() + chunkSize - 1) / chunkSize;
+                    for (size_t c = 0; c < chunks; c++) {
+                        PathEncoder encoder(origin, precision);
+                        for (size_t i = c * chunkSize; i < min(points.size(), (c + 1) * chunkSize); i++) {
+                            encoder.add(*points[i]);
+                        }
+                        rs->setRedisValue(chunkKey(t, version, c), encoder.str());
+                    }
+                    // the chunks of the version before last are no longer referred to by a header
+                    for (size_t c = 0; c < previousChunks[t]; c++) {
+                        rs->delRedisValues(chunkKey(t, previousVersion, c));
+                    }
+                    previousChunks[t] = writtenChunks[t];
+                    writtenChunks[t] = chunks;
+
+                    json jInterpolation;
+                    jInterpolation["points"] = points.size();
+                    jInterpolation["chunks"] = chunks;
+                    jInterpolation["skeleton"] = encodePath(snapshot->skeleton[t], origin, precision);
+                    published[interpolationNames[t]] = jInterpolation;
+                }
+                header = published;
+                previousVersion = version - 1;
+                double duration = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+                LoggerStream::getInstance() << INFO << "Published traject '" << snapshot->name << "' version " << version
+                                            << " in " << duration << " ms";
+            }
+
+            if (!header.empty()) {
+                header["interpolation"] = interpolationNames[type == CURVY ? CURVY : LINEAR];
+                rs->setRedisJsonValue("traject", header);
+                rs->publishRedisValue<int>("traject", version);
+            }
+        } catch (const exception& e) {
+            LoggerStream::getInstance() << ERROR << "Traject publication failed, " << e.what();
+            rs.reset();
+        }
+
+        lock.lock();
+        busy = false;
+        idle.notify_all();
+    }
+}
@@ -5,6 +5,7 @@
 #include <iomanip>
 #include <cctype>
 #include <algorithm>
+#include <charconv>
 
 using namespace Ilvo::Utils::Redis;
 using namespace Ilvo::Utils::Logging;
@@ -12,30 +13,20 @@ using namespace Ilvo::Exception;
 using namespace nlohmann;
 using namespace std;
 
-namespace Ilvo {
-namespace Utils {
-namespace Redis {
-    std::map<std::string, int> typeSizeMap = {
-        {"int8", 1},
-        {"uint8", 1},
-        {"int16", 2},
-        {"uint16", 2},
-        {"int32", 4},
-        {"uint32", 4},
-        {"float", 4},
-        {"lfloat", 8},
-        {"string", 8},
-        {"bool", 1},
-        {"int", sizeof(int)},
-        {"double", sizeof(double)}
-    };
-}
-}
-}
-
 Variable::Variable(string name, string group, string entity, string type, PlcType plcType) : 
-   name(name), group(group), entity(entity), type(type), plcType(plcType), updated(false) 
+   name(name), group(group), entity(entity), type(type), plcType(plcType), plcByte(-1), plcBit(-1), updated(false) 
 {
+    if (type.find("int") != string::npos) {
+        valueType = ValueType::INT;
+    } else if (type.find("float") != string::npos || type == "double") {
+        valueType = ValueType::DOUBLE;
+    } else if (type == "bool") {
+        valueType = ValueType::BOOL;
+    } else if (type == "string") {
+        valueType = ValueType::STRING;
+    } else {
+        valueType = ValueType::UNKNOWN;
+    }
 }
 
 const string& Variable::getName() const
@@ -58,37 +49,66 @@ const PlcType& Variable::getPlcType() const
 {
     return plcType;
 }
+int Variable::getPlcByte() const
+{
+    return plcByte;
+}
+int Variable::getPlcBit() const
+{
+    return plcBit;
+}
+void Variable::setPlcOffset(int byte, int bit)
+{
+    plcByte = byte;
+    plcBit = bit;
+}
 const int Variable::getSize()
 {
     return typeSizeMap[type];
 }
 
-void Variable::setValueString(string valueStr)
+namespace {
+    /** @brief Parse a number like stoi and stod, leading white space and '+' are skipped and trailing characters are ignored */
+    template <typename T>
+    bool parseNumber(string_view s, T& number)
+    {
+        size_t begin = 0;
+        while (begin < s.size() && isspace(static_cast<unsigned char>(s[begin]))) begin++;
+        if (begin < s.size() && s[begin] == '+') begin++;
+        return from_chars(s.data() + begin, s.data() + s.size(), number).ec == errc();
+    }
+
+    bool equalsIgnoreCase(string_view s, string_view lower)
+    {
+        if (s.size() != lower.size()) return false;
+        for (size_t i = 0; i < s.size(); i++) {
+            if (tolower(static_cast<unsigned char>(s[i])) != lower[i]) return false;
+        }
+        return true;
+    }
+}
+
+void Variable::setValueString(string_view valueStr)
 {
     bool valueIsNil = valueStr.empty();
-    try {
-        if (type.find("int") != string::npos) {
-            if (valueIsNil) value =  (int) 0;
-            else value = stoi(valueStr);
-        } else if (type.find("float") != string::npos || type == "double") {
-            if (valueIsNil) value = (double) 0.0;
-            else value = stod(valueStr);
-        } else if (type == "bool") {
-            if (valueIsNil) {
-                value = false;
-            } else {
-                transform(valueStr.begin(), valueStr.end(), valueStr.begin(), ::tolower);
-                value = (valueStr == "true" || valueStr == "1");
-            }
-        } else if (type == "string") {
-            value = valueStr;
-        } else {
-            throw Ilvo::Exception::RedisTypeNotFoundException(type);
-        }
-    } catch(const bad_cast& e) {
-        throw RedisVariableBadDefaultValueCastExceptions(name, type);
-    } catch (const exception& e) {
-        LoggerStream::getInstance() << ERROR << "Unexpected exception for variable \'" << name << "\': " << e.what() << ", value: " << valueStr;
+    if (valueType == ValueType::INT) {
+        int number = 0;
+        if (valueIsNil) value = (int) 0;
+        else if (parseNumber(valueStr, number)) value = number;
+        else LoggerStream::getInstance() << ERROR << "Unexpected exception for variable \'" << name << "\': invalid integer, value: " << valueStr;
+    } else if (valueType == ValueType::DOUBLE) {
+        double number = 0.0;
+        if (valueIsNil) value = (double) 0.0;
+        else if (parseNumber(valueStr, number)) value = number;
+        else LoggerStream::getInstance() << ERROR << "Unexpected exception for variable \'" << name << "\': invalid number, value: " << valueStr;
+    } else if (valueType == ValueType::BOOL) {
+        value = !valueIsNil && (equalsIgnoreCase(valueStr, "true") || valueStr == "1");
+    } else if (valueType == ValueType::STRING) {
+        // reuse the capacity of the current string
+        if (auto* s = get_if<string>(&value)) s->assign(valueStr);
+        else value = string(valueStr);
+    } else {
+        throw Ilvo::Exception::RedisTypeNotFoundException(type);
     }
 }
 
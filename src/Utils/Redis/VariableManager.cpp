@@ -1,5 +1,6 @@
 #include <Utils/Redis/VariableManager.h>
 #include <Utils/Redis/RedisStream.h>
+#include <Utils/Redis/VariableSchemaGenerated.h>
 #include <Utils/Settings/Task.h>
 #include <Utils/Settings/Gps.h>
 #include <Utils/String/String.h>
@@ -43,10 +44,46 @@ VariableManager::VariableManager(string processName, chrono::milliseconds proces
     processName(processName),
     clk(Clk{processPeriod}),
     platform(Platform::getInstance()),
-    heartbeatPulse(500ms)
+    heartbeatPulse(500ms),
+    tracer(processName),
+    traceSeq(0),
+    traceOrigin(false)
 {
     LoggerStream::getInstance() << INFO << "### \t Welcome to the stdout of process \'" << processName << "\'! \t ###";
 
+    loadConfig();
+    // Setup redis stream
+    rs = RedisStream(jConfig["protocols"]["redis"]);
+    dispatcher = make_unique<RedisDispatcher>(jConfig["protocols"]["redis"]["ip"], jConfig["protocols"]["redis"]["port"]);
+    keyspaceEvents = false;
+    registerMetrics();
+    startTraceExport();
+    // Load variables
+    this->load();
+}
+
+VariableManager::VariableManager(string processName, shared_ptr<LocalStore> store):
+    processName(processName),
+    clk(Clk{20ms}),
+    platform(Platform::getInstance()),
+    heartbeatPulse(500ms),
+    tracer(processName),
+    traceSeq(0),
+    traceOrigin(false)
+{
+    LoggerStream::getInstance() << INFO << "### \t Welcome to the stdout of process \'" << processName << "\' (in-process store)! \t ###";
+
+    loadConfig();
+    rs = RedisStream(store);
+    dispatcher = make_unique<RedisDispatcher>(store);
+    keyspaceEvents = false;
+    registerMetrics();
+    startTraceExport();
+    this->load();
+}
+
+void VariableManager::loadConfig()
+{
     // check config file
     string pathConfig = string(getenv("ILVO_PATH")) + "/config.json";
     if ( !exists(pathConfig) ) {
@@ -68,10 +105,27 @@ VariableManager::VariableManager(string processName, chrono::milliseconds proces
         LoggerStream::getInstance() << ERROR << "Configuration file parse error, file path: \"" << pathConfig << "\", " << e.what();
         throw runtime_error("Configuration file parse error, " + std::string(e.what()));
     }
-    // Setup redis stream
-    rs = RedisStream(jConfig["protocols"]["redis"]);
-    // Load variables
-    this->load();
+}
+
+void VariableManager::startTraceExport()
+{
+    // opt-in: "trace": {"export": true, "period": 10000} in the protocols of config.json
+    const ordered_json& jProtocols = jConfig["protocols"];
+    if (jProtocols.contains("trace") && jProtocols["trace"].value("export", false)) {
+        tracer.startExport(chrono::milliseconds(jProtocols["trace"].value("period", 10000)));
+    }
+}
+
+void VariableManager::registerMetrics()
+{
+    MetricsRegistry& metrics = MetricsRegistry::getInstance();
+    tickDuration = &metrics.histogram("ilvo_tick_duration_seconds", "Duration of a tick of the control loop.", {{"process", processName}});
+    tickOverruns = &metrics.counter("ilvo_tick_overruns_total", "Ticks that took longer than the period of the control loop.", {{"process", processName}});
+    redisReadDuration = &metrics.histogram("ilvo_redis_roundtrip_seconds", "Duration of the redis read and write of the variables of a tick.", {{"process", processName}, {"op", "read"}});
+    redisWriteDuration = &metrics.histogram("ilvo_redis_roundtrip_seconds", "Duration of the redis read and write of the variables of a tick.", {{"process", processName}, {"op", "write"}});
+    if (jConfig.contains("protocols")) {
+        MetricsServer::start(jConfig["protocols"], processName);
+    }
 }
 
 Platform& VariableManager::getPlatform()
@@ -79,93 +133,163 @@ Platform& VariableManager::getPlatform()
     return platform;
 }
 
+void VariableManager::setPeriod(chrono::milliseconds processPeriod)
+{
+    clk = Clk{processPeriod};
+}
+
 void VariableManager::load()
 {
-    loadVariables("plc.monitor", jConfig["variables"]["plc"]["monitor"], PlcType::MONITOR);
-    loadVariables("plc.control", jConfig["variables"]["plc"]["control"], PlcType::CONTROL);
-    loadVariables("pc", jConfig["variables"]["pc"], PlcType::NONE);
+    compiledSchema = Schema::fingerprint == schemaFingerprint(jConfig["variables"], jTypes);
+    if (compiledSchema) {
+        for (const VariableDescriptor& d: Schema::variables) {
+            addVariable(d.name, d.group, d.entity, d.type, d.plcType, d.byteOffset, d.bitOffset);
+        }
+    } else {
+        // site specific configuration
+        LoggerStream::getInstance() << INFO << "The variables of $ILVO_PATH differ from the compiled schema, they are expanded at runtime.";
+        for (const VariableSpec& spec: expandVariables(jConfig["variables"], jTypes)) {
+            addVariable(spec.name, spec.group, spec.entity, spec.type, spec.plcType, spec.byteOffset, spec.bitOffset);
+        }
+    }
+
+    // Bind the keys of the compiled schema
+    schemaVariables.resize(Schema::variableCount);
+    for (size_t i = 0; i < Schema::variableCount; i++) {
+        if (compiledSchema) {
+            schemaVariables[i] = variableOrder[i];
+        } else {
+            auto it = variableMap.find(Schema::variables[i].name);
+            schemaVariables[i] = it != variableMap.end() ? it->second : nullptr;
+        }
+    }
+
+    // Group the variables of the configuration per entity, the heartbeat remains a flat key for the system manager
+    const ordered_json& jRedis = jConfig["protocols"]["redis"];
+    layout = jRedis.value("layout", "flat") == "hash" ? RedisLayout::HASH : RedisLayout::FLAT;
+    flatMirror = jRedis.value("flat_mirror", false);
+    loadHashes();
+
     // Add the heartbeat variable to the map
     addVariable(getHeartbeatVariableName(processName), "pc", "execution", "bool", PlcType::NONE);
+    variableHash.push_back(-1);
+
+    // Initialize the variables that are nil to their default value, one request for the entire variable table.
+    // A string set to "" is not nil and keeps its value.
+    if (layout == RedisLayout::HASH) {
+        const vector<string_view>& values = rs.getRedisHashValueViews(hashKeys, hashFields);
+        size_t v = 0;
+        for (size_t h = 0; h < hashKeys.size(); h++) {
+            for (size_t f = 0; f < hashIndices[h].size(); f++, v++) {
+                if (values[v].data() == nullptr) {
+                    variableOrder[hashIndices[h][f]]->setDefaultValue();
+                    variableOrder[hashIndices[h][f]]->setUpdated(true);
+                }
+            }
+        }
+        variableOrder.back()->setDefaultValue();
+        variableOrder.back()->setUpdated(true);
+    } else {
+        const vector<string_view>& values = rs.getRedisValueViews(variableMapKeyOrder);
+        for (size_t i = 0; i < variableOrder.size(); i++) {
+            if (values[i].data() == nullptr) {
+                variableOrder[i]->setDefaultValue();
+                variableOrder[i]->setUpdated(true);
+            }
+        }
+    }
     // Propagate all default values of the variables that are nil in the redis database
     writeRedisVariables();
 }
 
-// Iterative completion of the variable map
-void VariableManager::loadVariables(string name, const ordered_json& variable, PlcType plcType, string group, string entity)
+void VariableManager::loadHashes()
 {
-    for (auto it = variable.begin(); it != variable.end(); ++it) {
-        string key = it.key();
-        if (it.value().is_string()) {
-            string type = it.value();
-
-            if (jTypes.contains(type)) {
-                loadVariables(name + "." + key, jTypes[type], plcType, group.empty() ? name : group, entity.empty() ? key : entity);
-            } else {
-                // Effective addition of the variables
-                if (type.find("array") != string::npos) {
-                    // Process array variables
-                    string arrayType = type.substr(type.find("of ") + 3);
-                    string arraySizeStr = type.substr(type.find("[") + 1, type.find("]") - type.find("[") - 1);
-                    int arraySize = stoi(arraySizeStr);
-
-                    for (int i = 0; i < arraySize; i++) {
-                        string variableName = name + "." + key + "." + to_string(i);
-                        addVariable(variableName, group, entity, arrayType, plcType);
-                    }
-                } else {
-                    // Process other variables
-                    string variableName = name + "." + key;
-                    addVariable(variableName, group, entity, type, plcType);
-                }
-            }
-        } else {
-            loadVariables(name + "." + key, it.value(), plcType);
+    map<string, int> hashes;
+    variableHash.assign(variableOrder.size(), -1);
+    if (layout != RedisLayout::HASH) return;
+
+    for (size_t i = 0; i < variableOrder.size(); i++) {
+        const Variable& var = *variableOrder[i];
+        const string& name = var.getName();
+        // the hash of an entity of a composed type, else the parent of the variable
+        string key = var.getGroup() + "." + var.getEntity();
+        if (var.getEntity().empty() || name.compare(0, key.size() + 1, key + ".") != 0) {
+            key = name.substr(0, name.rfind('.'));
         }
+
+        auto inserted = hashes.insert({key, hashKeys.size()});
+        if (inserted.second) {
+            hashKeys.push_back(key);
+            hashFields.emplace_back();
+            hashIndices.emplace_back();
+        }
+        int h = inserted.first->second;
+        hashFields[h].push_back(name.substr(key.size() + 1));
+        hashIndices[h].push_back(i);
+        variableHash[i] = h;
     }
+    LoggerStream::getInstance() << INFO << "Redis hash layout, " << variableOrder.size() << " variables in " << hashKeys.size() << " hashes.";
 }
 
-void VariableManager::addVariable(string name, string group, string entity, string type, PlcType plcType)
+void VariableManager::addVariable(string name, string group, string entity, string type, PlcType plcType, int plcByte, int plcBit)
 {
     // add the variable to the map
     VariablePtr var = make_shared<Variable>(name, group, entity, type, plcType);
-    variableMap.insert(pair<string, VariablePtr>(var->getName(), var));
+    var->setPlcOffset(plcByte, plcBit);
+    auto inserted = variableMap.insert(pair<string, VariablePtr>(var->getName(), var));
     variableMapKeyOrder.push_back(var->getName());
+    variableOrder.push_back(inserted.first->second);
+}
 
-    // initialize the variable that are nil to default value
-    if (rs.isRedisValueNil(var->getName())) {
-        var->setDefaultValue();
-        var->setUpdated(true);
+void VariableManager::setValueString(size_t index, string_view valueStr)
+{
+    bool valueIsNil = valueStr.data() == nullptr;
+    if (valueIsNil) {
+        LoggerStream::getInstance() << INFO << "Variable \'" << variableMapKeyOrder[index] << "\' is (nil).";
     }
+
+    variableOrder[index]->setValueString(valueStr);
 }
 
 void VariableManager::readRedisVariables()
 {
-    auto arr = rs.getRedisValues(variableMapKeyOrder);
-    
-    for (int i = 0; i < variableMapKeyOrder.size(); i++) {
-        string key = variableMapKeyOrder[i];
-        string valueStr{rediscpp::value(arr[i]).as_string()};
-
-        bool valueIsNil = valueStr.empty();
-        if (valueIsNil) {
-            LoggerStream::getInstance() << INFO << "Variable \'" << key << "\' is (nil).";
+    if (layout == RedisLayout::HASH) {
+        // the flat heartbeat is only written by this process
+        const vector<string_view>& arr = rs.getRedisHashValueViews(hashKeys, hashFields);
+        size_t i = 0;
+        for (size_t h = 0; h < hashKeys.size(); h++) {
+            for (size_t index: hashIndices[h]) {
+                setValueString(index, arr[i++]);
+            }
         }
+        return;
+    }
 
-        VariablePtr var = variableMap.at(key);
-        var->setValueString(valueStr);
+    // the values are views in the receive buffer of the redis stream, a warm read allocates nothing
+    const vector<string_view>& arr = rs.getRedisValueViews(variableMapKeyOrder);
+    
+    for (int i = 0; i < variableOrder.size(); i++) {
+        setValueString(i, arr[i]);
     }
 }
 
 void VariableManager::writeRedisVariables()
 {
     vector<string> values;
+    vector<vector<string>> hashValues(hashKeys.size());
 
-    for (int i = 0; i < variableMapKeyOrder.size(); i++) {
-        VariablePtr var = getVariable(variableMapKeyOrder[i]);
-
+    for (size_t i = 0; i < variableOrder.size(); i++) {
+        const VariablePtr& var = variableOrder[i];
         if (var->isUpdated()) {
-            values.push_back(var->getName());
-            values.push_back(var->getValueAsString());
+            int h = variableHash[i];
+            if (h >= 0) {
+                hashValues[h].push_back(var->getName().substr(hashKeys[h].size() + 1));
+                hashValues[h].push_back(var->getValueAsString());
+            }
+            if (h < 0 || flatMirror) {
+                values.push_back(var->getName());
+                values.push_back(var->getValueAsString());
+            }
             var->setUpdated(false);
         }
     }
@@ -174,7 +298,22 @@ void VariableManager::writeRedisVariables()
     values.push_back(getHeartbeatVariableName(processName));
     values.push_back((heartbeatPulse.getValue() ? "true" : "false"));
 
-    rs.setRedisValues(values);
+    if (layout == RedisLayout::HASH) {
+        rs.setRedisHashValues(hashKeys, hashValues, values);
+    } else {
+        rs.setRedisValues(values);
+    }
+}
+
+VariablePtr VariableManager::getSchemaVariable(size_t index, const char* name) {
+    if (index >= schemaVariables.size() || !schemaVariables[index]) {
+        throw RedisNoSuchVariableException(name);
+    }
+    return schemaVariables[index];
+}
+
+bool VariableManager::usesCompiledSchema() const {
+    return compiledSchema;
 }
 
 bool VariableManager::existsVariable(std::string key)  {
@@ -215,18 +354,78 @@ void VariableManager::run()
     // main loop
     LoggerStream::getInstance() << DEBUG << "Starting main loop of VariableManager.";
     while (true) {
-        clk.start();
-        readRedisVariables();
+        tick();
+        clk.stop();
 
-        serverTick();
+        if( quit.load() ) break;    // exit normally after SIGINT
+    }
+}
 
-        getVariable(getHeartbeatVariableName(processName))->setValue<bool>(heartbeatPulse.generatePulse());
+void VariableManager::tick()
+{
+    clk.start();
+    int64_t tickStart = traceNow();
+    // the callbacks of the notifications received before the read see the written values
+    size_t queued = dispatcher->queued();
+    readRedisVariables();
+    int64_t readEnd = traceNow();
+    redisReadDuration->observe((readEnd - tickStart) * 1e-6);
+    if (!keyspaceEvents || !dispatcher->connected()) {
+        dispatcher->resync();  // poll
+        queued = dispatcher->queued();
+    }
+    dispatcher->dispatch(queued);
 
-        writeRedisVariables();
-        rs.publishRedisValue(processName + "-tick", clk.poll()); 
-        clk.stop();
+    serverTick();
 
-        if( quit.load() ) break;    // exit normally after SIGINT
+    getVariable(getHeartbeatVariableName(processName))->setValue<bool>(heartbeatPulse.generatePulse());
+
+    int64_t writeStart = traceNow();
+    writeRedisVariables();
+    int64_t tickEnd = traceNow();
+    redisWriteDuration->observe((tickEnd - writeStart) * 1e-6);
+    tickDuration->observe((tickEnd - tickStart) * 1e-6);
+    if (tickEnd - tickStart > clk.getIntervalMs() * 1000) tickOverruns->inc();
+    traceTick(tickStart);
+    // the poll time is zero under a virtual clock, the start time advances with the simulated time
+    rs.publishRedisValue(processName + "-tick", clk.getStartTime());
+}
+
+void VariableManager::startTrace(int64_t stamp)
+{
+    trace = TraceContext{++traceSeq, stamp};
+    traceOrigin = true;
+}
+
+bool VariableManager::isTraceNew() const
+{
+    return trace.valid() && !(trace == tracedContext);
+}
+
+void VariableManager::traceSpan(const string& name, int64_t start, int64_t end, TraceFlow flow)
+{
+    tracer.record(name, trace, start, end, flow);
+    tracedContext = trace;
+}
+
+void VariableManager::traceTick(int64_t tickStart)
+{
+    // the span of the origin starts when the fix is received
+    if (isTraceNew()) {
+        traceSpan(processName, traceOrigin ? trace.stamp : tickStart, traceNow(), traceOrigin ? TraceFlow::BEGIN : TraceFlow::STEP);
+    }
+
+    auto now = chrono::steady_clock::now();
+    if (now - lastLatencyPublish >= 1s) {
+        lastLatencyPublish = now;
+        if (tracer.samples() > 0) {
+            rs.setRedisJsonValue(processName + ".latency", tracer.histogram());
+        }
+        // the trace file is written by the export thread of the tracer, its errors are logged by this thread
+        string exportError = tracer.takeExportError();
+        if (!exportError.empty()) {
+            LoggerStream::getInstance() << WARN << "Trace file of " << processName << " not written: " << exportError;
+        }
     }
 }
 
@@ -235,10 +434,42 @@ RedisStream& VariableManager::getStream()
     return rs;
 }
 
+RedisDispatcher& VariableManager::getDispatcher()
+{
+    return *dispatcher;
+}
+
+int VariableManager::onKeyChanged(const string& key, function<void()> callback)
+{
+    if (!keyspaceEvents) {
+        keyspaceEvents = rs.enableKeyspaceEvents();
+        if (!keyspaceEvents) {
+            LoggerStream::getInstance() << WARN << "No redis keyspace notifications, the change callbacks are called every tick.";
+        }
+    }
+    return dispatcher->psubscribe(RedisDispatcher::keyspacePattern(key), [callback](const RedisMessage&) { callback(); });
+}
+
+int VariableManager::onVariableChanged(const string& name, function<void(VariablePtr)> callback)
+{
+    VariablePtr var = getVariable(name);
+    string key = var->getName();
+    auto it = find(variableMapKeyOrder.begin(), variableMapKeyOrder.end(), key);
+    if (layout == RedisLayout::HASH && it != variableMapKeyOrder.end()) {
+        int h = variableHash[it - variableMapKeyOrder.begin()];
+        if (h >= 0) key = hashKeys[h];
+    }
+    return onKeyChanged(key, [var, callback]() { callback(var); });
+}
+
 void VariableManager::setRedisJsonStates(Platform& platform, State& rawState)
 {
     // states
-    rs.setRedisJsonValue("gps.raw.state", rawState.toJson(platform.gps.utm_zone));                   
+    json rawJson = rawState.toJson(platform.gps.utm_zone);
+    if (trace.valid()) {
+        rawJson["trace"] = trace.toJson();
+    }
+    rs.setRedisJsonValue("gps.raw.state", rawJson);
     rs.setRedisJsonValue("gps.ref.state", platform.gps.getState().toJson(platform.gps.utm_zone));                   
     rs.setRedisJsonValue("robot.ref.state", platform.robot.getState().toJson(platform.gps.utm_zone));                   
     rs.setRedisJsonValue("robot.center.state", platform.robot.getCenterState().toJson(platform.gps.utm_zone));                   
@@ -282,7 +513,7 @@ void VariableManager::setRedisJsonStatus(Platform& platform)
 {
     // status
     json errorJson;
-    double distance_error = getVariable("pc.path.distance_error")->getValue<double>();
+    double distance_error = getValue(Vars::pc_path_distance_error);
     double navAbsError = abs(distance_error);
     stringstream ss;
     ss << std::fixed << std::setprecision(2);
@@ -297,10 +528,10 @@ void VariableManager::setRedisJsonStatus(Platform& platform)
 
     json statusJson;
     statusJson["error"] = errorJson;
-    statusJson["simulation_active"] = getVariable("pc.simulation.active")->getValue<bool>();
-    statusJson["fix"] = fixNumber[getVariable("pc.gps.fix")->getValue<int>()];
-    statusJson["notification"] = getVariable("pc.execution.notification")->getValue<string>();
-    statusJson["heartbeat"] = getVariable("plc.control.navigation.heartbeat")->getValue<bool>();
+    statusJson["simulation_active"] = getValue(Vars::pc_simulation_active);
+    statusJson["fix"] = fixNumber[getValue(Vars::pc_gps_fix)];
+    statusJson["notification"] = getValue(Vars::pc_execution_notification);
+    statusJson["heartbeat"] = getValue(Vars::plc_control_navigation_heartbeat);
 
     if (existsVariable("plc.monitor.power_source.data.soc")) {
         statusJson["power_level"] = getVariable("plc.monitor.power_source.data.soc")->getValue<double>();
@@ -310,8 +541,8 @@ void VariableManager::setRedisJsonStatus(Platform& platform)
         statusJson["power_level"] = 0.0;
     }
     for (AutoMode state: platform.auto_modes) {
-        if (getVariable("pc.simulation.active")->getValue<bool>()) {
-           statusJson["current_state"] = getVariable("pc.simulation.auto")->getValue<bool>() ? "auto" : "normal" ;
+        if (getValue(Vars::pc_simulation_active)) {
+           statusJson["current_state"] = getValue(Vars::pc_simulation_auto) ? "auto" : "normal" ;
         } else {
             if (getVariable("plc.monitor.state." + state.name)->getValue<bool>()) {
                 statusJson["current_state"] = state.name;
@@ -341,5 +572,13 @@ State VariableManager::getRedisState(string name)
 
 void VariableManager::updatePlatformState()
 {
-    platform.updateState(getRedisState("gps.raw").asAffine());
+    json jState = rs.getRedisJsonValue("gps.raw.state");
+    if (jState.empty()) {
+        platform.updateState(getRedisState("gps.raw").asAffine());  // initializes the state
+        return;
+    }
+    platform.updateState(State(jState).asAffine());
+    // the outputs of this tick derive from the fix of the raw state
+    trace = jState.contains("trace") ? TraceContext::fromJson(jState["trace"]) : TraceContext();
+    traceOrigin = false;
 }
@@ -0,0 +1,129 @@
+#include <Utils/Redis/VariableSchema.h>
+
+#include <stdexcept>
+
+using namespace Ilvo::Utils::Redis;
+
+using namespace std;
+using namespace nlohmann;
+
+namespace Ilvo {
+namespace Utils {
+namespace Redis {
+    std::map<std::string, int> typeSizeMap = {
+        {"int8", 1},
+        {"uint8", 1},
+        {"int16", 2},
+        {"uint16", 2},
+        {"int32", 4},
+        {"uint32", 4},
+        {"float", 4},
+        {"lfloat", 8},
+        {"string", 8},
+        {"bool", 1},
+        {"int", sizeof(int)},
+        {"double", sizeof(double)}
+    };
+}
+}
+}
+
+namespace {
+    void expand(vector<VariableSpec>& specs, const string& name, const ordered_json& variable, const ordered_json& types, PlcType plcType, const string& group = "", const string& entity = "")
+    {
+        for (auto it = variable.begin(); it != variable.end(); ++it) {
+            string key = it.key();
+            if (it.value().is_string()) {
+                string type = it.value();
+
+                if (types.contains(type)) {
+                    expand(specs, name + "." + key, types[type], types, plcType, group.empty() ? name : group, entity.empty() ? key : entity);
+                } else if (type.find("array") != string::npos) {
+                    // Process array variables
+                    string arrayType = type.substr(type.find("of ") + 3);
+                    string arraySizeStr = type.substr(type.find("[") + 1, type.find("]") - type.find("[") - 1);
+                    int arraySize = stoi(arraySizeStr);
+
+                    for (int i = 0; i < arraySize; i++) {
+                        specs.push_back({name + "." + key + "." + to_string(i), group, entity, arrayType, plcType});
+                    }
+                } else {
+                    specs.push_back({name + "." + key, group, entity, type, plcType});
+                }
+            } else {
+                expand(specs, name + "." + key, it.value(), types, plcType);
+            }
+        }
+    }
+
+    /** @brief Offsets of one data block, bools are packed per entity and a new word starts after the bools */
+    void assignOffsets(vector<VariableSpec>& specs, PlcType plcType)
+    {
+        int byteCount = 0, bitCount = 0;
+        string previousEntity = "";
+        for (VariableSpec& spec: specs) {
+            if (spec.plcType != plcType) continue;
+
+            if (spec.type != "bool" || spec.entity != previousEntity) {
+                if (bitCount != 0) {
+                    bitCount = 0;
+                    byteCount += 2;
+                }
+            }
+            previousEntity = spec.entity;
+            spec.byteOffset = byteCount;
+            spec.bitOffset = bitCount;
+
+            if (spec.type == "bool") {
+                bitCount += 1;
+                if (bitCount == 8) {
+                    bitCount = 0;
+                    byteCount += 1;
+                }
+            } else {
+                bitCount = 0;
+                byteCount += typeSizeMap.count(spec.type) ? typeSizeMap.at(spec.type) : 0;
+            }
+        }
+    }
+}
+
+vector<VariableSpec> Ilvo::Utils::Redis::expandVariables(const ordered_json& variables, const ordered_json& types)
+{
+    vector<VariableSpec> specs;
+    if (variables.contains("plc")) {
+        if (variables["plc"].contains("monitor")) expand(specs, "plc.monitor", variables["plc"]["monitor"], types, PlcType::MONITOR);
+        if (variables["plc"].contains("control")) expand(specs, "plc.control", variables["plc"]["control"], types, PlcType::CONTROL);
+    }
+    if (variables.contains("pc")) expand(specs, "pc", variables["pc"], types, PlcType::NONE);
+
+    assignOffsets(specs, PlcType::MONITOR);
+    assignOffsets(specs, PlcType::CONTROL);
+    return specs;
+}
+
+int Ilvo::Utils::Redis::plcDataSize(const vector<VariableSpec>& specs, PlcType plcType)
+{
+    int size = 0;
+    for (const VariableSpec& spec: specs) {
+        if (spec.plcType != plcType) continue;
+        int end = spec.byteOffset + (spec.type == "bool" ? 1 : (typeSizeMap.count(spec.type) ? typeSizeMap.at(spec.type) : 0));
+        size = max(size, end);
+    }
+    return size;
+}
+
+uint64_t Ilvo::Utils::Redis::schemaFingerprint(const ordered_json& variables, const ordered_json& types)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (const string& s: {variables.dump(), types.dump()}) {
+        for (unsigned char c: s) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+        hash ^= 0xff;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
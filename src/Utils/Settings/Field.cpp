@@ -149,6 +149,11 @@ Field& Field::operator=(const Field& other)
     return *this;
 }
 
+const string& Field::getName() const
+{
+    return name;
+}
+
 const std::vector<PointPtr>& Field::getTrajectPoints() const
 {
     return trajectPoints;
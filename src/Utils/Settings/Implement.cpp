@@ -133,9 +133,45 @@ json Implement::visualizeJson(int zone) const
     json j = json();
     j["name"] = name;
     j["sections"] = json::array();
+    if (UtmProjection::isValidZone(zone) && sections.size() > TANGENT_PLANE_MIN_SECTIONS) {
+        // all sections lie within meters of the implement, one local tangent plane replaces the projection per vertex
+        Point center = sections[0]->getPolygon().center();
+        LocalTangentPlane plane(UtmProjection::get(zone), center.x(), center.y());
+        for (auto section: sections) {
+            j["sections"].push_back(section->visualizeJson(plane));
+        }
+    } else {
+        for (auto section: sections) {
+            j["sections"].push_back(section->visualizeJson(zone));
+        }
+    }
+    return j;
+}
+
+bool Implement::visualizationChanged() const
+{
     for (auto section: sections) {
-        j["sections"].push_back(section->visualizeJson(zone));
-    } 
+        if (section->visualizationChanged(VISUALIZATION_EPSILON)) return true;
+    }
+    return false;
+}
+
+json Implement::visualize(int zone)
+{
+    json j = json();
+    j["name"] = name;
+    j["sections"] = json::array();
+    if (UtmProjection::isValidZone(zone) && sections.size() > TANGENT_PLANE_MIN_SECTIONS) {
+        Point center = sections[0]->getPolygon().center();
+        LocalTangentPlane plane(UtmProjection::get(zone), center.x(), center.y());
+        for (auto section: sections) {
+            j["sections"].push_back(section->visualize(plane, VISUALIZATION_EPSILON));
+        }
+    } else {
+        for (auto section: sections) {
+            j["sections"].push_back(section->visualize(zone, VISUALIZATION_EPSILON));
+        }
+    }
     return j;
 }
 
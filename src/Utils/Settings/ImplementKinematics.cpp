@@ -0,0 +1,78 @@
+#include <Utils/Settings/ImplementKinematics.h>
+#include <Utils/Geometry/Transform.h>
+#include <cmath>
+#include <stdexcept>
+
+using namespace Ilvo::Utils::Settings;
+using namespace Ilvo::Utils::Geometry;
+using namespace Eigen;
+using namespace std;
+
+ImplementKinematics::ImplementKinematics() :
+    hitchAngle(NAN),
+    linkLength(NAN),
+    hinge(Affine3d::Identity())
+{}
+
+size_t ImplementKinematics::update(Hitch& hitch, double hitchAngle, const vector<SectionPtr>& sections)
+{
+    const size_t n = sections.size();
+    if (n != this->sections.size()) {
+        this->sections.assign(n, nullptr);
+        parallelAngles.assign(n, NAN);
+        chain.resize(n);
+        transforms.resize(n);
+        corners.resize(2, 4 * n);
+    }
+
+    bool hitchMoved = hitchAngle != this->hitchAngle || hitch.link_length != linkLength;
+    if (hitchMoved) {
+        this->hitchAngle = hitchAngle;
+        linkLength = hitch.link_length;
+        hinge = calculateHingeTransform(linkLength, hitchAngle);
+    }
+
+    size_t recalculated = 0;
+    for (size_t i = 0; i < n; i++) {
+        Section* section = sections[i].get();
+        double parallelAngle = section->getParallelAngle();
+        if (hitchMoved || section != this->sections[i] || parallelAngle != parallelAngles[i]) {
+            chain[i] = hinge * section->getParallelTransform();
+            this->sections[i] = section;
+            parallelAngles[i] = parallelAngle;
+            recalculated++;
+        }
+    }
+
+    // compose with the hitch and transform the corners of all footprints
+    const Affine3d reference = hitch.getState().asAffine();
+    for (size_t i = 0; i < n; i++) {
+        const Section& section = *sections[i];
+        if (section.width <= 0) {
+            throw invalid_argument("Width must be positive");
+        }
+        transforms[i] = reference * chain[i];
+
+        Matrix<double, 2, 4> local;
+        local << -section.width / 2, section.width / 2, section.width / 2, -section.width / 2,
+                 -section.down,      -section.down,     section.up,        section.up;
+        corners.middleCols<4>(4 * i).noalias() = transforms[i].linear().topLeftCorner<2, 2>() * local;
+        corners.middleCols<4>(4 * i).colwise() += transforms[i].translation().head<2>();
+    }
+    return recalculated;
+}
+
+size_t ImplementKinematics::getNumSections() const
+{
+    return sections.size();
+}
+
+const Affine3d& ImplementKinematics::getTransform(size_t section) const
+{
+    return transforms[section];
+}
+
+Matrix<double, 2, 4> ImplementKinematics::getCorners(size_t section) const
+{
+    return corners.middleCols<4>(4 * section);
+}
@@ -0,0 +1,87 @@
+#include <Utils/Settings/Plant.h>
+
+using namespace Ilvo::Utils::Settings;
+
+using namespace nlohmann;
+using namespace std;
+
+
+Actuator::Actuator() : time_constant(0.0), max_acceleration(0.0), max_jerk(0.0)
+{}
+
+Actuator::Actuator(json j) : Actuator()
+{
+    if (j.contains("time_constant")) time_constant = j["time_constant"];
+    if (j.contains("max_acceleration")) max_acceleration = j["max_acceleration"];
+    if (j.contains("max_jerk")) max_jerk = j["max_jerk"];
+}
+
+bool Actuator::isIdeal() const
+{
+    return time_constant <= 0.0 && max_acceleration <= 0.0 && max_jerk <= 0.0;
+}
+
+json Actuator::toJson() const {
+    json j;
+    j["time_constant"] = time_constant;
+    j["max_acceleration"] = max_acceleration;
+    j["max_jerk"] = max_jerk;
+    return j;
+}
+
+Plant::Plant() :
+    longitudinal_slip(0.0), angular_slip(0.0),
+    creep_velocity(0.0), creep_gain(0.0),
+    gnss_noise(0.0), gnss_heading_noise(0.0), gnss_latency(0.0), gnss_seed(0)
+{}
+
+Plant::Plant(json j) : Plant()
+{
+    if (j.contains("actuators")) {
+        json jActuators = j["actuators"];
+        if (jActuators.contains("longitudinal")) longitudinal = Actuator(jActuators["longitudinal"]);
+        if (jActuators.contains("lateral")) lateral = Actuator(jActuators["lateral"]);
+        if (jActuators.contains("angular")) angular = Actuator(jActuators["angular"]);
+    }
+    if (j.contains("slip")) {
+        json jSlip = j["slip"];
+        if (jSlip.contains("longitudinal")) longitudinal_slip = jSlip["longitudinal"];
+        if (jSlip.contains("angular")) angular_slip = jSlip["angular"];
+    }
+    if (j.contains("creep")) {
+        json jCreep = j["creep"];
+        if (jCreep.contains("velocity")) creep_velocity = jCreep["velocity"];
+        if (jCreep.contains("gain")) creep_gain = jCreep["gain"];
+    }
+    if (j.contains("gnss")) {
+        json jGnss = j["gnss"];
+        if (jGnss.contains("noise")) gnss_noise = jGnss["noise"];
+        if (jGnss.contains("heading_noise")) gnss_heading_noise = jGnss["heading_noise"];
+        if (jGnss.contains("latency")) gnss_latency = jGnss["latency"];
+        if (jGnss.contains("seed")) gnss_seed = jGnss["seed"];
+    }
+}
+
+bool Plant::isIdeal() const
+{
+    return longitudinal.isIdeal() && lateral.isIdeal() && angular.isIdeal()
+        && longitudinal_slip == 0.0 && angular_slip == 0.0
+        && creep_velocity == 0.0 && creep_gain == 0.0
+        && gnss_noise == 0.0 && gnss_heading_noise == 0.0 && gnss_latency == 0.0;
+}
+
+json Plant::toJson() const {
+    json j;
+    j["actuators"]["longitudinal"] = longitudinal.toJson();
+    j["actuators"]["lateral"] = lateral.toJson();
+    j["actuators"]["angular"] = angular.toJson();
+    j["slip"]["longitudinal"] = longitudinal_slip;
+    j["slip"]["angular"] = angular_slip;
+    j["creep"]["velocity"] = creep_velocity;
+    j["creep"]["gain"] = creep_gain;
+    j["gnss"]["noise"] = gnss_noise;
+    j["gnss"]["heading_noise"] = gnss_heading_noise;
+    j["gnss"]["latency"] = gnss_latency;
+    j["gnss"]["seed"] = gnss_seed;
+    return j;
+}
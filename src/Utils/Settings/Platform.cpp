@@ -18,6 +18,13 @@ using namespace nlohmann;
 using namespace boost::filesystem;
 using namespace Eigen;
 
+thread_local std::unique_ptr<Platform> Platform::threadInstancePtr;
+
+void Platform::createThreadInstance()
+{
+    threadInstancePtr.reset(new Platform());
+}
+
 // throws error 'std::logic_error'  what():  basic_string::_M_construct null not valid
 Platform::Platform() : Platform(string(getenv("ILVO_PATH")))
 {
@@ -98,6 +105,8 @@ void Platform::load(const json& j)
         }
 
         gps = Gps(j["gps"]);
+
+        if (j.contains("plant")) plant = Plant(j["plant"]);
     } catch(const exception& e) {
         LoggerStream::getInstance() << WARN << "settings.json file is mallformed: " << e.what();
     }
@@ -152,6 +161,7 @@ json Platform::toJson() const {
         j["hitches"].push_back(hitch.toJson());
     }
     j["gps"] = gps.toJson();
+    j["plant"] = plant.toJson();
     return j;
 }
 
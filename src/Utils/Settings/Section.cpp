@@ -10,15 +10,17 @@ using namespace nlohmann;
 using namespace std;
 
 Section::Section(string id, double width, double up, double down, double link_length, TransformMatrix parallel_transform) : 
-    id(id), width(width), active(false), up(up), down(down), link_length(link_length), parallel_transform(parallel_transform), parallel_angle(0.0)
+    id(id), width(width), active(false), up(up), down(down), link_length(link_length), parallel_transform(parallel_transform), parallel_angle(0.0), visualizedActive(false)
 {}
 
 Section::Section(Section& section) : 
-    StateFull(section.getRefTransform()), id(section.id), width(section.width), up(section.up), down(section.down), link_length(section.link_length), parallel_transform(section.parallel_transform), parallel_angle(section.parallel_angle)
+    StateFull(section.getRefTransform()), id(section.id), width(section.width), up(section.up), down(section.down), link_length(section.link_length), parallel_transform(section.parallel_transform), parallel_angle(section.parallel_angle), visualizedActive(false)
 {}
 
 Section::Section(json j) :
-    StateFull(j["transform"])
+    StateFull(j["transform"]),
+    parallel_angle(0.0),
+    visualizedActive(false)
 {
     if (j.contains("id")) id = j["id"].get<string>(); else id = "";
 
@@ -42,7 +44,7 @@ Section::Section(json j) :
         repeats = 1;
     };
     if (j.contains("offset")) offset = j["offset"]; else offset = 0.0;
-    if (j.contains("link_length")) link_length = j["link_length"];
+    if (j.contains("link_length")) link_length = j["link_length"]; else link_length = 0.0;
     if (j.contains("parallel_transform")) parallel_transform = TransformMatrix(j["parallel_transform"]);
 }
 
@@ -52,6 +54,11 @@ void Section::updatePolygon()
     p.update(getState().asAffine(), width, up, -down);
 }
 
+void Section::setFootprint(const Matrix<double, 2, 4>& corners)
+{
+    p.update(corners);
+}
+
 const Polygon& Section::getPolygon() const
 {
     return p;
@@ -93,12 +100,23 @@ void Section::clearActivationGeometry()
     activation_geometry_points_section_cs.clear();
 }
 
-void Section::addActivationGeometry(Geometry::PointPtr p)
+Affine3d Section::getWorldToSectionTransform()
 {
     Affine3d sectionAffine = getState().asAffine();
     sectionAffine(2, 3) = 0.0; // zero ground level
+    // the section state is rigid, its inverse is the transposed rotation
+    return sectionAffine.inverse(Eigen::Isometry);
+}
+
+void Section::addActivationGeometry(Geometry::PointPtr p)
+{
+    addActivationGeometry(p, getWorldToSectionTransform());
+}
+
+void Section::addActivationGeometry(Geometry::PointPtr p, const Affine3d& worldToSection)
+{
     Vector4d point_world_cs = {p->x(), p->y(), 0.0, 1};
-    Vector4d p_section_cs = sectionAffine.inverse() * point_world_cs;
+    Vector4d p_section_cs = worldToSection * point_world_cs;
     
     activation_geometry_points_section_cs.push_back(make_shared<Point>(p_section_cs(0), p_section_cs(1)));
     activation_geometry_points.push_back(p);
@@ -106,8 +124,9 @@ void Section::addActivationGeometry(Geometry::PointPtr p)
 
 void Section::setActivationGeometry(PolygonPtr g) 
 {
+    Affine3d worldToSection = getWorldToSectionTransform();
     for (auto p: g->geometry().outer()) {
-        addActivationGeometry(make_shared<Point>(p.x(), p.y()));
+        addActivationGeometry(make_shared<Point>(p.x(), p.y()), worldToSection);
     }
 }
 
@@ -149,4 +168,55 @@ nlohmann::json Section::visualizeJson(int zone) const
     j["active"] = active;
 
     return j;
-}
\ No newline at end of file
+}
+
+nlohmann::json Section::visualizeJson(const LocalTangentPlane& plane) const
+{
+    vector<vector<double>> robotLatLng;
+    vector<vector<double>> robotXY;
+    getPolygon().contour(robotLatLng, robotXY, plane);
+    json j = json();
+    j["latlng"] = robotLatLng;
+    j["xy"] = robotXY;
+    j["id"] = id;
+    j["active"] = active;
+
+    return j;
+}
+
+bool Section::visualizationChanged(double epsilon) const
+{
+    if (visualization.is_null() || active != visualizedActive) return true;
+
+    const auto& contour = p.geometry().outer();
+    if (contour.size() != visualizedContour.size()) return true;
+    const double epsilon2 = epsilon * epsilon;
+    for (size_t i = 0; i < contour.size(); i++) {
+        double dx = contour[i].x() - visualizedContour[i].x();
+        double dy = contour[i].y() - visualizedContour[i].y();
+        if (dx * dx + dy * dy > epsilon2) return true;
+    }
+    return false;
+}
+
+template<typename Projection>
+const json& Section::visualize(const Projection& projection)
+{
+    visualization = visualizeJson(projection);
+    const auto& contour = p.geometry().outer();
+    visualizedContour.assign(contour.begin(), contour.end());
+    visualizedActive = active;
+    return visualization;
+}
+
+const json& Section::visualize(int zone, double epsilon)
+{
+    if (!visualizationChanged(epsilon)) return visualization;
+    return visualize(zone);
+}
+
+const json& Section::visualize(const LocalTangentPlane& plane, double epsilon)
+{
+    if (!visualizationChanged(epsilon)) return visualization;
+    return visualize(plane);
+}
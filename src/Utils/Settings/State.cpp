@@ -1,6 +1,6 @@
 #include <Utils/Settings/State.h>
 #include <Utils/Geometry/Transform.h>
-#include <ThirdParty/UTM.hpp>
+#include <Utils/Geometry/UtmProjection.h>
 
 using namespace Eigen;
 using namespace Ilvo::Utils::Settings;
@@ -202,8 +202,8 @@ vector<double> State::latlng(int zone) const
 {
     double lat, lng;
     vector<double> xy_ = xy();
-    UTMXYToLatLon(xy_[0], xy_[1], zone, false, lat, lng);
-    return {RadToDeg(lat), RadToDeg(lng)};
+    UtmProjection::get(zone).toLatLon(xy_[0], xy_[1], lat, lng);
+    return {lat, lng};
 }
 
 double State::heading()
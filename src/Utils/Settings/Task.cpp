@@ -13,6 +13,7 @@
 #include <boost/geometry/algorithms/centroid.hpp>
 #include <boost/geometry/algorithms/covered_by.hpp>
 #include <boost/geometry/algorithms/overlaps.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
 #include <boost/filesystem.hpp>
 #include <iostream>
 #include <bits/stdc++.h>
@@ -60,11 +61,16 @@ Task::Task(string baseFilePath, json j_task, int gpsZoneId) :
     vector<string> xFields{"Easting", "X"};
     vector<string> yFields{"Northing", "Y"};
     bool polygon = true;
+    // the rows of a polygon task map are split into polygons on the series column
+    vector<string> seriesFields;
+    if (type.compare("discrete") != 0 && type.compare("intermittent") != 0) {
+        seriesFields = {"Series", "Polygon"};
+    }
 
     string filepath_taskmap = searchFileWithExtension(taskmappath, ".csv");
     if (filepath_taskmap.size() > 0) {
         PointCsvFile f(polygon);
-        f.init(filepath_taskmap, xFields, yFields);
+        f.init(filepath_taskmap, xFields, yFields, seriesFields);
         initVariant(f);
     } else {
         filepath_taskmap = searchFileWithExtension(taskmappath, ".shp");
@@ -84,6 +90,7 @@ void Task::initVariant(PointData& f)
      if (type.compare("discrete") == 0 || type.compare("intermittent") == 0) { // discrete --> save as points
         geometryType = GeometryType::POINTS;
         PointVector geometries(f.getPoints(0));
+        pointIndex = PointIndex(geometries);
         this->points = geometries;
     } else { // continous or hitch task --> save as polygons
         geometryType = GeometryType::POLYGONS;
@@ -96,32 +103,21 @@ void Task::initVariant(PointData& f)
     }
 }
 
-bool Task::compareClosePoints(IndexPointPtr p1, IndexPointPtr p2) 
+bool Task::compareClosePoints(const PathMatch& p1, const PathMatch& p2) 
 {
-    return p1->index < p2->index;
+    return p1.along < p2.along;
 }
 
-bool Task::equalClosePoints(IndexPointPtr p1, IndexPointPtr p2) 
+bool Task::equalClosePoints(const PathMatch& p1, const PathMatch& p2) 
 {
-    return p1->index == p2->index;
+    // points that project within a millimeter are executed once
+    return abs(p1.along - p2.along) < 1e-3;
 }
 
-void Task::createPathPointsDiscr(vector<PointPtr> trajectPoints)
+void Task::createPathPointsDiscr(const PathMatcher& matcher)
 {
-    for (PointPtr p_task: get<PointVector>(points)) {
-        IndexPoint p;
-        double d = trajectPoints[0]->distance(*p_task);
-        for (int i = 1; i < trajectPoints.size(); i++) {
-            double d_to_traj = trajectPoints[i]->distance(*p_task);
-            if (d_to_traj < d) {
-                p = *trajectPoints[i];
-                p.index = i;
-                d = d_to_traj;
-            }
-        }
-        discr_path_points.push_back(make_shared<IndexPoint>(p));
-    }
-    sort(discr_path_points.begin(), discr_path_points.end(), this->compareClosePoints);
+    discr_path_points = matcher.match(get<PointVector>(points));
+    stable_sort(discr_path_points.begin(), discr_path_points.end(), this->compareClosePoints);
     discr_path_points.erase(unique(discr_path_points.begin(), discr_path_points.end(), this->equalClosePoints), discr_path_points.end());
 }
 
@@ -157,9 +153,11 @@ void Task::printRapport(LoggerStream& logger)
             tp.AddColumn("idx", 10);
             tp.AddColumn("X_path [m]", 15);
             tp.AddColumn("Y_path [m]", 15);
+            tp.AddColumn("Along [m]", 15);
+            tp.AddColumn("Offset [m]", 15);
             tp.PrintHeader();
-            for (int i = 0; i < discr_path_points.size(); i++) {
-                tp << discr_path_points.at(i)->index << discr_path_points.at(i)->x() << discr_path_points.at(i)->y();
+            for (const PathMatch& m: discr_path_points) {
+                tp << m.index << m.point.x() << m.point.y() << m.along << m.offset;
             }
         } else {
             tp.AddColumn("X [m]", 15);
@@ -176,22 +174,32 @@ void Task::printRapport(LoggerStream& logger)
 
 void Task::updateState(VariableManager* manager)
 {
-    double actualHitchAngle = manager->getVariable("plc.monitor." + hitch.getEntityName() + ".angle")->getValue<double>();
+    vector<SectionPtr>& sections = implement.getSections();
+    if (hitchAngleName.empty() || sectionFeedbackNames.size() != sections.size()) {
+        hitchAngleName = "plc.monitor." + hitch.getEntityName() + ".angle";
+        sectionFeedbackNames.clear();
+        for (size_t i = 0; i < sections.size(); i++) {
+            sectionFeedbackNames.push_back("plc.monitor." + hitch.getEntityName() + ".feedback_sections." + to_string(i));
+        }
+    }
+    double actualHitchAngle = manager->getVariable(hitchAngleName)->getValue<double>();
     
-    // calculate new section states
-    for (int i = 0; i < implement.getSections().size(); i++) {
-        auto section = implement.getSections().at(i);
-
+    for (size_t i = 0; i < sections.size(); i++) {
         double actualParallelAngle = 0.0;
-        string sectionFeedbackName = "plc.monitor." + hitch.getEntityName() + ".feedback_sections." + to_string(i);
+        const string& sectionFeedbackName = sectionFeedbackNames[i];
         if (manager->existsVariable(sectionFeedbackName)) {
             actualParallelAngle = manager->getVariable(sectionFeedbackName)->getValue<double>();
         } else {
             manager->getStream().setRedisValue(sectionFeedbackName, actualParallelAngle);
         }
-        section->setParallelAngle(actualParallelAngle);
-        section->updateState(hitch.getBallState(actualHitchAngle) * section->getParallelTransform());
-        section->updatePolygon();
+        sections[i]->setParallelAngle(actualParallelAngle);
+    }
+
+    // calculate new section states
+    kinematics.update(hitch, actualHitchAngle, sections);
+    for (size_t i = 0; i < sections.size(); i++) {
+        sections[i]->updateState(kinematics.getTransform(i));
+        sections[i]->setFootprint(kinematics.getCorners(i));
     }
 }
 
@@ -227,25 +235,33 @@ bool Task::onHitch(string name)
     return getHitch().name.compare(name) == 0;
 }
 
-const vector<IndexPointPtr>& Task::getPathPointsDiscr()
+const vector<PathMatch>& Task::getPathPointsDiscr()
 {
     return discr_path_points;
 }
 
-bool Task::updateSections(VariableManager* manager, bool disable)
+bool Task::updateSections(VariableManager* manager, bool disable, CoverageMap* coverage, double overlap)
 {
     bool activeSections = false;
 
     for (int i = 0; i < implement.getSections().size(); i++) {
         auto section = implement.getSections().at(i);
+        const bgPolygon2D& footprint = section->getPolygon().geometry();
         string name = "plc.control." + hitch.getEntityName() + ".activate_sections." + to_string(i);
         if (getImplement().worksOnTaskmap()) {
-            section->setActive(insideTaskMap(section, disable));
+            bool active = insideTaskMap(section, disable);
+            if (active && coverage && overlap > 0.0 && coverage->overlap(i, footprint) >= overlap) {
+                active = false;  // ground is worked already
+            }
+            section->setActive(active);
             manager->getVariable(name)->setValue<int>((int) section->getActive());
         } else {
             bool active = manager->getVariable(name)->getValue<bool>();
             section->setActive(active);
         }
+        if (coverage) {
+            if (section->getActive()) coverage->cover(i, footprint); else coverage->lift(i);
+        }
         if (section->getActive()) {
             activeSections = true;
         }
@@ -281,7 +297,6 @@ void Task::activateSection(string id, bool value)
 bool Task::insideTaskMap(shared_ptr<Section> section, bool disable)
 {
     const Polygon& polygonSection = section->getPolygon();
-    Point currentPosition(section->getState().getT().asVector());
     section->clearActivationGeometry();
 
     if (type.compare("continuous") == 0) { 
@@ -299,14 +314,18 @@ bool Task::insideTaskMap(shared_ptr<Section> section, bool disable)
             }
         } 
     } else if (type.compare("intermittent") == 0) {
-        PointVector vec = get<PointVector>(points);
-        std::vector<PointPtr> points = vec.nearby(currentPosition, 40);
-        for (PointPtr point: points) {
-            if (covered_by(point->geometry(), polygonSection.geometry())) {
-                section->addActivationGeometry(point);
+        // only the points inside the envelope of the section footprint
+        const PointVector& vec = get<PointVector>(points);
+        model::box<bgPoint2D> envelopeSection;
+        envelope(polygonSection.geometry(), envelopeSection);
+        pointIndex.inBox(envelopeSection.min_corner().x(), envelopeSection.min_corner().y(),
+                         envelopeSection.max_corner().x(), envelopeSection.max_corner().y(), candidates);
+        for (int i: candidates) {
+            if (covered_by(vec[i]->geometry(), polygonSection.geometry())) {
+                section->addActivationGeometry(vec[i]);
                 return !disable;
             }
-        }   
+        }
     }
 
     return false;
@@ -0,0 +1,122 @@
+#include <Utils/Settings/TaskPool.h>
+#include <algorithm>
+
+using namespace Ilvo::Utils::Settings;
+
+using namespace std;
+
+namespace {
+    /** @brief The thread runs a chunk of a loop, a nested loop runs sequentially */
+    thread_local bool inLoop = false;
+}
+
+
+TaskPool::TaskPool(unsigned workers) :
+    stopping(false),
+    generation(0),
+    body(nullptr),
+    count(0),
+    grain(1),
+    next(0),
+    active(0)
+{
+    if (workers == 0) {
+        unsigned hardware = thread::hardware_concurrency();
+        workers = hardware > 1 ? hardware - 1 : 0;
+    }
+    for (unsigned i = 0; i < workers; i++) {
+        this->workers.emplace_back(&TaskPool::work, this);
+    }
+}
+
+TaskPool::~TaskPool()
+{
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread& worker: workers) {
+        worker.join();
+    }
+}
+
+TaskPool& TaskPool::getInstance()
+{
+    static TaskPool instance;
+    return instance;
+}
+
+unsigned TaskPool::getConcurrency() const
+{
+    return workers.size() + 1;
+}
+
+void TaskPool::work()
+{
+    unsigned long seen = 0;
+    unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [&]() { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+
+        lock.unlock();
+        inLoop = true;
+        runChunks();
+        inLoop = false;
+        lock.lock();
+
+        if (--active == 0) done.notify_one();
+    }
+}
+
+void TaskPool::runChunks()
+{
+    size_t begin;
+    while ((begin = next.fetch_add(grain)) < count) {
+        try {
+            (*body)(begin, min(begin + grain, count));
+        } catch (...) {
+            lock_guard<std::mutex> lock(mutex);
+            if (!error) error = current_exception();
+        }
+    }
+}
+
+void TaskPool::parallelFor(size_t count, const function<void(size_t begin, size_t end)>& body, size_t grain)
+{
+    grain = max<size_t>(grain, 1);
+    unique_lock<std::mutex> loopLock(loopMutex, defer_lock);
+    if (workers.empty() || count <= grain || inLoop || !loopLock.try_lock()) {
+        for (size_t begin = 0; begin < count; begin += grain) {
+            body(begin, min(begin + grain, count));
+        }
+        return;
+    }
+
+    {
+        lock_guard<std::mutex> lock(mutex);
+        this->body = &body;
+        this->count = count;
+        this->grain = grain;
+        next.store(0);
+        active = workers.size();
+        error = nullptr;
+        generation++;
+    }
+    wake.notify_all();
+
+    inLoop = true;
+    runChunks();
+    inLoop = false;
+
+    exception_ptr error;
+    {
+        unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&]() { return active == 0; });
+        this->body = nullptr;
+        swap(error, this->error);
+    }
+    if (error) rethrow_exception(error);
+}
@@ -1,4 +1,5 @@
 #include <Utils/Settings/Traject.h>
+#include <Utils/Settings/TaskPool.h>
 #include <Utils/Geometry/Transform.h>
 #include <Utils/Geometry/GeometryVector.h>
 #include <Utils/File/File.h>
@@ -6,8 +7,11 @@
 #include <Utils/File/PointShapeFile.h>
 #include <Utils/File/PointCsvFile.h>
 #include <Utils/Geometry/Arc.h>
+#include <Utils/Geometry/Angle.h>
 #include <ThirdParty/json.hpp>
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <chrono>
 #include <Exceptions/FileExceptions.hpp>
 #include <Exceptions/RobotExceptions.hpp>
 
@@ -24,30 +28,45 @@ using namespace boost::filesystem;
 using namespace boost::geometry;
 
 Traject::Traject() : 
-    loaded(false)
+    loaded(false),
+    matcher(&matcherLinear)
 {
 }
 
 
 void Traject::load(std::string fieldName, int utmZoneId, double cornerDetectionAngle, double interpolationDistance, double turnRadius, InterpolationType type) 
 {
+    // duration of the stages [ms]
+    auto stageStart = chrono::steady_clock::now();
+    auto lap = [&stageStart]() {
+        auto now = chrono::steady_clock::now();
+        double duration = chrono::duration<double, milli>(now - stageStart).count();
+        stageStart = now;
+        return duration;
+    };
+
     // load the field
     field = std::make_shared<Field>(fieldName, utmZoneId);
+    double fieldTime = lap();
 
     // Doing the initialization
     if (field->getTrajectPoints().size() > 1 && interpolationDistance > 0 && cornerDetectionAngle > 0) {
+        // The per-segment work (interpolations and arcs) runs on the task pool into preallocated ranges, the stages
+        // that depend on the previous points (corner detection and skeleton cleaning) run sequentially. The points
+        // are the same as the ones of a sequential load.
+        TaskPool& pool = TaskPool::getInstance();
+        const vector<PointPtr>& rawPoints = getRawPoints();
+        const int rawLength = rawPoints.size();
 
         // helper objects
         Line l1, l2;
-        Arc a;
 
         // ** Clear all old data
         // clear corners and add first point
         corners.clear();
         int cornerIndex = 0;
-        corners.push_back(make_shared<CornerPoint>(0, *getRawPoints().at(0), 0, cornerIndex, Point(), *getRawPoints().at(1)));
+        corners.push_back(make_shared<CornerPoint>(0, *rawPoints.at(0), 0, cornerIndex, Point(), *rawPoints.at(1)));
         cornerIndex++;
-        LoggerStream::getInstance() << DEBUG << *corners.back();
 
         // clear interpolation linear
         interpolationLinear.clear();
@@ -59,22 +78,17 @@ void Traject::load(std::string fieldName, int utmZoneId, double cornerDetectionA
         // clear skeletonCurvy
         skeletonCurvy.clear();
 
-        // ** Detect Corners and linear interpolation
-        int i = 0;
-        while (i < rawPointsLength()-1) {
-            PointPtr p1 = getRawPoints().at(i);
-            PointPtr p2 = getRawPoints().at(i+1);
+        // ** Detect Corners, the offsets of the segments in the linear interpolation
+        vector<size_t> offsets(rawLength, 0);
+        for (int i = 0; i < rawLength-1; i++) {
+            PointPtr p1 = rawPoints[i];
+            PointPtr p2 = rawPoints[i+1];
             l1 = Line(*p1, *p2);
-
-            // Add point to skeleton
-            skeletonLinear.push_back(p1);
-            // Add interpolated line
-            auto newInterpolationData = l1.interpolate(interpolationDistance);
-            interpolationLinear.insert(interpolationLinear.end(), newInterpolationData.begin(), newInterpolationData.end());
+            offsets[i+1] = offsets[i] + l1.interpolationLength(interpolationDistance);
 
             // corner detection
-            if (i < rawPointsLength()-2) {
-                PointPtr p3 = getRawPoints().at(i+2);
+            if (i < rawLength-2) {
+                PointPtr p3 = rawPoints[i+2];
                 l2 = Line(*p2, *p3);
 
                 // determine corner angle
@@ -88,11 +102,11 @@ void Traject::load(std::string fieldName, int utmZoneId, double cornerDetectionA
                 }
 
                 if (cornerDetection) {
-                    corners.push_back(make_shared<CornerPoint>(interpolationLinear.size()-1, *p2, cornerAngle, cornerIndex, *p1, *p3));
+                    corners.push_back(make_shared<CornerPoint>(int(offsets[i+1])-1, *p2, cornerAngle, cornerIndex, *p1, *p3));
                     cornerIndex += 1;
                     // headland detection
-                    if (i < rawPointsLength()-3) {
-                        PointPtr p4 = getRawPoints().at(i+3);
+                    if (i < rawLength-3) {
+                        PointPtr p4 = rawPoints[i+3];
                         Line l3(*p3, *p4);
 
                         double pathAngleDifference = calcSmallestAngleAbsolute(l1.alpha(), l3.alpha());
@@ -101,68 +115,74 @@ void Traject::load(std::string fieldName, int utmZoneId, double cornerDetectionA
                             corners.back()->setHeadland(distance);
                         }
                     }
-                    LoggerStream::getInstance() << DEBUG << *corners.back();
                 }
-            }         
-
-            // update i
-            i++;
+            }
         }
 
-        // add last point to skeleton
-        skeletonLinear.push_back(getRawPoints().at(i));
         // add last point as corner
-        l1 = Line(getRawPoints().at(i-1), getRawPoints().at(i));
-        corners.push_back(make_shared<CornerPoint>(interpolationLinear.size()-1, *getRawPoints().at(i), 0, cornerIndex, *getRawPoints().at(i-1), Point()));
-        LoggerStream::getInstance() << DEBUG << *corners.back();
+        int last = rawLength-1;
+        corners.push_back(make_shared<CornerPoint>(int(offsets[last])-1, *rawPoints.at(last), 0, cornerIndex, *rawPoints.at(last-1), Point()));
+        double cornerTime = lap();
+
+        // ** Interpolation Linear, the skeleton are the raw points
+        skeletonLinear = rawPoints;
+        interpolationLinear.resize(offsets[last]);
+        pool.parallelFor(rawLength-1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                Line(*rawPoints[i], *rawPoints[i+1]).interpolate(interpolationDistance, interpolationLinear.begin() + offsets[i]);
+            }
+        }, 64);
+        double linearTime = lap();
+        double arcTime = 0.0, skeletonTime = 0.0, curvyTime = 0.0;
 
         // ** Interpolation Curvy
         if (cornersLength() == 2) {
             // If one line just add the interpolated line
             l1 = Line(corners.at(0)->point, corners.at(1)->point);
             interpolationCurvy = l1.interpolate(interpolationDistance, true);
+            curvyTime = lap();
         } else {
-            // iterate over new corners
-            vector<PointPtr> interpolationCurvySkeleton;
-            interpolationCurvySkeleton.push_back(make_shared<Point>(corners.at(0)->point));
-
-            double arcInterpolationDistance = 0.5;
+            // the corners that are passed, a headland skips the next corner
+            vector<int> steps;
             int i = 1;
             while (i < cornersLength()) { 
-                CornerPointPtr c1 = corners.at(i);
-
-                if (c1->nextRawPoint.isEmpty()) { // Last point
-                    interpolationCurvySkeleton.push_back(make_shared<Point>(c1->point));
-                    // update i
-                    i += 1;
-                } else if (c1->isHeadland) { // It is a headland
-                    a = Arc(c1->point, c1->nextRawPoint, c1->previousRawPoint, turnRadius);
-                    vector<PointPtr> aInterpolation = a.interpolate(arcInterpolationDistance);
-
-                    interpolationCurvySkeleton.insert(interpolationCurvySkeleton.end(), aInterpolation.begin(), aInterpolation.end());
-                    // update i
-                    i += 2;  // Skip the next point
-                } else {  // It is a normal corner
-                    l1 = Line(c1->previousRawPoint, c1->point);
-                    l2 = Line(c1->point, c1->nextRawPoint);
-                    a = Arc(l1, l2, turnRadius);
-                    vector<PointPtr> aInterpolation = a.interpolate(arcInterpolationDistance);
-
-                    interpolationCurvySkeleton.insert(interpolationCurvySkeleton.end(), aInterpolation.begin(), aInterpolation.end());
-                    // update i
-                    i += 1;
+                steps.push_back(i);
+                i += (!corners.at(i)->nextRawPoint.isEmpty() && corners.at(i)->isHeadland) ? 2 : 1;
+            }
+
+            // arc of every corner
+            double arcInterpolationDistance = 0.5;
+            vector<vector<PointPtr>> arcs(steps.size());
+            pool.parallelFor(steps.size(), [&](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; k++) {
+                    CornerPointPtr c1 = corners.at(steps[k]);
+                    if (c1->nextRawPoint.isEmpty()) { // Last point
+                        arcs[k].push_back(make_shared<Point>(c1->point));
+                    } else if (c1->isHeadland) { // It is a headland
+                        Arc a(c1->point, c1->nextRawPoint, c1->previousRawPoint, turnRadius);
+                        arcs[k] = a.interpolate(arcInterpolationDistance);
+                    } else {  // It is a normal corner
+                        Arc a(Line(c1->previousRawPoint, c1->point), Line(c1->point, c1->nextRawPoint), turnRadius);
+                        arcs[k] = a.interpolate(arcInterpolationDistance);
+                    }
                 }
+            });
+
+            vector<PointPtr> interpolationCurvySkeleton;
+            interpolationCurvySkeleton.push_back(make_shared<Point>(corners.at(0)->point));
+            for (const vector<PointPtr>& arc: arcs) {
+                interpolationCurvySkeleton.insert(interpolationCurvySkeleton.end(), arc.begin(), arc.end());
             }
+            arcTime = lap();
 
             // Clean other directions
             skeletonCurvy.push_back(interpolationCurvySkeleton.at(0)); // Add first point
             skeletonCurvy.push_back(interpolationCurvySkeleton.at(1)); // Add second point
 
-            i = 2;
-            while (i < interpolationCurvySkeleton.size()) {
+            for (size_t j = 2; j < interpolationCurvySkeleton.size(); j++) {
                 PointPtr p1 = skeletonCurvy.at(skeletonCurvy.size()-2);
                 PointPtr p2 = skeletonCurvy.at(skeletonCurvy.size()-1);
-                PointPtr pNew = interpolationCurvySkeleton.at(i);
+                PointPtr pNew = interpolationCurvySkeleton.at(j);
                 l1 = Line(*p1, *p2);
                 l2 = Line(*p2, *pNew);
                 double angle = l1.corner(l2);
@@ -172,29 +192,33 @@ void Traject::load(std::string fieldName, int utmZoneId, double cornerDetectionA
                     double radius = (pCurvy != nullptr) ? pCurvy->radius : 0.0;
                     skeletonCurvy.push_back(make_shared<CurvyPoint>(pNew->x(), pNew->y(), radius));
                 } 
-
-                // update i
-                i += 1;
             }
-
-            // add points to interpolation curvy
-            i = 0;
-            while (i < skeletonCurvy.size()-1)
-            {
-                PointPtr p1 = skeletonCurvy.at(i);
-                PointPtr p2 = skeletonCurvy.at(i+1);
-                CurvyPoint* p1Curvy = dynamic_cast<CurvyPoint*>(p1.get());
-                l1 = Line(p1, p2);
-                double radius = (p1Curvy != nullptr && l1.length() < arcInterpolationDistance + 0.01) ? p1Curvy->radius : 0.0;
-                for (PointPtr p : l1.interpolate(interpolationDistance)) {
-                    interpolationCurvy.push_back(make_shared<CurvyPoint>(p->x(), p->y(), radius));
-                }
-                // update i
-                i += 1;
+            skeletonTime = lap();
+
+            // add points to interpolation curvy, the radius of the arc is kept on its short segments
+            const size_t segments = skeletonCurvy.size()-1;
+            vector<size_t> curvyOffsets(segments+1, 0);
+            vector<double> radii(segments, 0.0);
+            for (size_t j = 0; j < segments; j++) {
+                CurvyPoint* p1Curvy = dynamic_cast<CurvyPoint*>(skeletonCurvy[j].get());
+                l1 = Line(skeletonCurvy[j], skeletonCurvy[j+1]);
+                radii[j] = (p1Curvy != nullptr && l1.length() < arcInterpolationDistance + 0.01) ? p1Curvy->radius : 0.0;
+                curvyOffsets[j+1] = curvyOffsets[j] + l1.interpolationLength(interpolationDistance);
             }
-            
+            interpolationCurvy.resize(curvyOffsets[segments]);
+            pool.parallelFor(segments, [&](size_t begin, size_t end) {
+                for (size_t j = begin; j < end; j++) {
+                    Line(skeletonCurvy[j], skeletonCurvy[j+1]).interpolate(interpolationDistance, interpolationCurvy.begin() + curvyOffsets[j], true, radii[j]);
+                }
+            }, 64);
+            curvyTime = lap();
         }
 
+        // ** Segment index of the interpolations for the map matching
+        matcherLinear = PathMatcher(interpolationLinear);
+        matcherCurvy = PathMatcher(interpolationCurvy);
+        double indexTime = lap();
+
         LoggerStream::getInstance() << INFO << "Loaded traject with: ";
         LoggerStream::getInstance() << INFO << "- " << getRawPoints().size() << " field traject points";
         LoggerStream::getInstance() << INFO << "- " << interpolationLinear.size() << " interpolated points";
@@ -202,6 +226,10 @@ void Traject::load(std::string fieldName, int utmZoneId, double cornerDetectionA
         LoggerStream::getInstance() << INFO << "- " << interpolationCurvy.size() << " interpolated curvy points";
         LoggerStream::getInstance() << INFO << "- " << skeletonCurvy.size() << " skeleton curvy points";
         LoggerStream::getInstance() << INFO << "- " << corners.size() << " corners";
+        LoggerStream::getInstance() << INFO << "Traject load stages [ms] on " << pool.getConcurrency() << " threads: field " << fieldTime
+                                    << ", corners " << cornerTime << ", linear " << linearTime << ", arcs " << arcTime
+                                    << ", skeleton " << skeletonTime << ", curvy " << curvyTime
+                                    << ", index " << indexTime;
 
         setInterpolation(type);
         loaded = true;
@@ -231,6 +259,17 @@ const vector<PointPtr>& Traject::getInterpolation(InterpolationType type) const
     }
 }
 
+const vector<PointPtr>& Traject::getSkeleton(InterpolationType type) const
+{ 
+    if (type == InterpolationType::CURRENT) {
+        return *skeleton;
+    } else if (type == InterpolationType::LINEAR) {
+        return skeletonLinear;
+    } else {
+        return skeletonCurvy;
+    }
+}
+
 InterpolationType Traject::getInterpolationType() const
 {
     return interpolationType;
@@ -242,12 +281,19 @@ void Traject::setInterpolation(InterpolationType type)
     if (interpolationType == InterpolationType::CURVY) {
         interpolation = &interpolationCurvy;
         skeleton = &skeletonCurvy;
+        matcher = &matcherCurvy;
     } else {
         interpolation = &interpolationLinear;
         skeleton = &skeletonLinear;
+        matcher = &matcherLinear;
     }
 }
 
+const PathMatcher& Traject::getPathMatcher() const
+{
+    return *matcher;
+}
+
 const vector<CornerPointPtr>& Traject::getCorners() const
 { 
     return corners; 
@@ -384,6 +430,19 @@ Line Traject::pathLine(int idx)
     return line;
 }
 
+double Traject::pathCurvature(int idx, double distance)
+{
+    // change of the orientation of the path lines over the distance
+    int last = interpolationLength() - 2;
+    if (last < 1) return 0.0;
+    int start = clamp(idx, 0, last);
+    double spacing = pathLine(start).length();
+    int end = clamp(start + max(1, int(distance / max(spacing, 1e-6) + 0.5)), 0, last);
+    if (end <= start || spacing <= 0.0) return 0.0;
+    double angle = DegToRad(calcSmallestAngle(pathLine(end).alpha(), pathLine(start).alpha()));
+    return angle / ((end - start) * spacing);
+}
+
 int Traject::isPointLeft(int index, Point& point)
 {
     Line line = pathLine(index);
@@ -419,20 +478,19 @@ bool Traject::insideAnyTask(Point point)
     return false;
 }
 
-double Traject::distanceToNextDiscrPoint(Task& task, double interpolationDistance) 
+double Traject::distanceToNextDiscrPoint(Task& task) 
 {
     int s = task.getPathPointsDiscr().size();
     if (s > 0) { // only if discrete task
-        IndexPoint closestPointToCurrentPosition;
+        PathMatch currentPosition;
         if (task.getImplement().getSections().size() > 0) {
-            closestPointToCurrentPosition = closestPoint(task.getImplement().getSections().at(0)->getState().asAffine());
+            currentPosition = matcher->match(task.getImplement().getSections().at(0)->getState().asAffine());
         } else {
-            closestPointToCurrentPosition = closestPoint(task.getHitch().getState().asAffine());
+            currentPosition = matcher->match(task.getHitch().getState().asAffine());
         }
         // if the last index is already passed do not increment points
         if (task.nextDiscreteImplementIndex < s) {
-            int numberOfPoints = task.getPathPointsDiscr().at(task.nextDiscreteImplementIndex)->index - closestPointToCurrentPosition.index;
-            return interpolationDistance * numberOfPoints;
+            return task.getPathPointsDiscr().at(task.nextDiscreteImplementIndex).along - currentPosition.along;
         }
     } 
     // return large value to illustrate there is no approaching point
@@ -445,7 +503,7 @@ void Traject::incrDiscrPoint(Task& task)
     if (s > 0) { // only if discrete task
         task.nextDiscreteImplementIndex++;
         if (task.nextDiscreteImplementIndex < (s-1) ) {
-            LoggerStream::getInstance() << DEBUG << "new idx is: " << task.nextDiscreteImplementIndex << " and in path: " << task.getPathPointsDiscr()[task.nextDiscreteImplementIndex]->index;
+            LoggerStream::getInstance() << DEBUG << "new idx is: " << task.nextDiscreteImplementIndex << " and along the path: " << task.getPathPointsDiscr()[task.nextDiscreteImplementIndex].along << " m";
         } else {
             LoggerStream::getInstance() << DEBUG << "last point is finished!";
         }
@@ -457,14 +515,14 @@ void Traject::onDiscrReset(Point point)
 {
     for (Task& task: field->getTasks()) {
         if (task.getGeometry<PointVector>().size() > 0) { // only if discrete task
-            IndexPoint closestPointToCurrentPosition = closestPoint(point);
-            task.createPathPointsDiscr(*this->interpolation);
+            PathMatch currentPosition = matcher->match(point);
+            task.createPathPointsDiscr(*matcher);
             task.printRapport(LoggerStream::getInstance());
             task.nextDiscreteImplementIndex = 0;
             int s = task.getPathPointsDiscr().size();
             int i = 0;
             while (i < s) {
-                if (closestPointToCurrentPosition.index < task.getPathPointsDiscr().at(i)->index) {
+                if (currentPosition.along < task.getPathPointsDiscr().at(i).along) {
                     break;
                 }
                 i++;
@@ -475,7 +533,7 @@ void Traject::onDiscrReset(Point point)
                 task.nextDiscreteImplementIndex = s-1;
             }
             
-            LoggerStream::getInstance() << DEBUG << "RESET -- closestPointToCurrentPosition.index: " << closestPointToCurrentPosition.index << ", task.nextDiscreteImplementIndex: " << task.nextDiscreteImplementIndex;
+            LoggerStream::getInstance() << DEBUG << "RESET -- currentPosition.along: " << currentPosition.along << ", task.nextDiscreteImplementIndex: " << task.nextDiscreteImplementIndex;
         }
     }
 }
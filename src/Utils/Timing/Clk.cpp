@@ -1,4 +1,5 @@
 #include <Utils/Timing/Clk.h>
+#include <Utils/Timing/VirtualClock.h>
 #include <sstream>   
 
 using namespace Ilvo::Utils::Timing;
@@ -22,28 +23,34 @@ Clk::Clk() :
 {}
 
 void Clk::start() {
-    startTime = system_clock::now();
+    startTime = systemNow();
 }
 
 double Clk::poll() {
-    auto endTime = system_clock::now();
+    auto endTime = systemNow();
     duration<double, milli> elapsed {endTime - startTime};
     return elapsed.count();
 }
 
+double Clk::getStartTime() {
+    return duration<double, milli>(startTime.time_since_epoch()).count();
+}
+
 void Clk::stop() {
+    // the simulation engine steps the virtual time itself
+    if (isVirtualTime()) return;
     this_thread::sleep_until(startTime+interval);
 }
 
 void Clk::startTimer(milliseconds timerInterval) {
     this->timerInterval = timerInterval;
-    this->timerStartTime = system_clock::now();
+    this->timerStartTime = systemNow();
     timerOn = true;
 }
 
 bool Clk::checkTimerBusy() {
     if (timerOn) {
-        auto endTime = system_clock::now();
+        auto endTime = systemNow();
         // duration<double, milli> elapsed {endTime - timerStartTime};
         auto elapsed = duration_cast<milliseconds>(endTime - timerStartTime);
         // LoggerStream::getInstance() << DEBUG << elapsed.count() << ", " << timerInterval.count() << endl;
@@ -58,7 +65,7 @@ bool Clk::checkTimerBusy() {
 
 bool Clk::checkTimerExpired() {
     if (timerOn) {
-        auto endTime = system_clock::now();
+        auto endTime = systemNow();
         // duration<double, milli> elapsed {endTime - timerStartTime};
         auto elapsed = duration_cast<milliseconds>(endTime - timerStartTime);
         return (elapsed > timerInterval);